@@ -0,0 +1,451 @@
+#pragma ident "$Id: AntennaTable.cpp $"
+
+/**
+ * @file AntennaTable.cpp
+ * Table of satellite and receiver antennas resolved out of Antenna objects,
+ * with flat phase center variation grids.
+ */
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//============================================================================
+
+
+#include <cmath>
+#include "AntennaTable.hpp"
+
+
+
+namespace gpstk
+{
+
+      // Number of satellite systems a satellite index is made for
+   static const int numSatSystems( SatID::systemIRNSS );
+
+
+      // Default constructor
+   AntennaTable::Entry::Entry()
+      : validFrom( CommonTime::BEGINNING_OF_TIME ),
+        validUntil( CommonTime::END_OF_TIME ),
+        zen1(0.0), zen2(0.0), dzen(0.0), dazi(0.0)
+   {
+
+      for( int f = 0; f < numFreqTypes; ++f )
+      {
+         hasEcc[f] = false;
+         eccUEN[f][0] = eccUEN[f][1] = eccUEN[f][2] = 0.0;
+         noAziRow[f] = -1;
+         noAziSize[f] = 0;
+         aziFirst[f] = -1;
+         aziCount[f] = 0;
+      }
+
+   }  // End of constructor 'AntennaTable::Entry::Entry()'
+
+
+
+      /* Common constructor.
+       *
+       * @param[in] antenna   Antenna to be resolved.
+       */
+   AntennaTable::Entry::Entry( const Antenna& antenna )
+      : validFrom( antenna.getAntennaValidFrom() ),
+        validUntil( antenna.getAntennaValidUntil() ),
+        zen1( antenna.getZen1() ), zen2( antenna.getZen2() ),
+        dzen( antenna.getDzen() ), dazi( antenna.getDazi() )
+   {
+
+      for( int f = 0; f < numFreqTypes; ++f )
+      {
+         hasEcc[f] = false;
+         eccUEN[f][0] = eccUEN[f][1] = eccUEN[f][2] = 0.0;
+         noAziRow[f] = -1;
+         noAziSize[f] = 0;
+         aziFirst[f] = -1;
+         aziCount[f] = 0;
+      }
+
+         // Eccentricities are kept by Antenna in NEU: turn them to UEN
+      Antenna::AntennaEccDataMap eccMap( antenna.getAntennaEccMap() );
+      for( Antenna::AntennaEccDataMap::const_iterator it = eccMap.begin();
+           it != eccMap.end();
+           ++it )
+      {
+         const int f( (*it).first );
+
+         hasEcc[f] = true;
+         eccUEN[f][0] = (*it).second[2];
+         eccUEN[f][1] = (*it).second[1];
+         eccUEN[f][2] = (*it).second[0];
+      }
+
+         // Non-azimuth dependent patterns, one row each
+      Antenna::NoAziDataMap noAziMap( antenna.getAntennaNoAziMap() );
+      for( Antenna::NoAziDataMap::const_iterator it = noAziMap.begin();
+           it != noAziMap.end();
+           ++it )
+      {
+         const int f( (*it).first );
+
+         noAziRow[f] = grid.size();
+         noAziSize[f] = (*it).second.size();
+         grid.insert( grid.end(), (*it).second.begin(), (*it).second.end() );
+      }
+
+         // Azimuth dependent patterns, one row per azimuth step. Antenna
+         // looks the rows up by their exact azimuth value, so rows whose
+         // azimuth is not a multiple of 'dazi' are left out, as Antenna
+         // would never find them.
+      if( dazi > 0.0 )
+      {
+         Antenna::PCDataMap pcMap( antenna.getAntennaPCMap() );
+         for( Antenna::PCDataMap::const_iterator it = pcMap.begin();
+              it != pcMap.end();
+              ++it )
+         {
+            const int f( (*it).first );
+
+            if( (*it).second.empty() ) continue;
+
+            const int count( static_cast<int>(
+                     std::floor( (*it).second.rbegin()->first/dazi + 0.5 ) )
+                             + 1 );
+
+            aziFirst[f] = aziRows.size();
+            aziCount[f] = count;
+            aziRows.resize( aziRows.size() + count, -1 );
+            aziSizes.resize( aziSizes.size() + count, 0 );
+
+            for( Antenna::AzimuthDataMap::const_iterator it2 =
+                                                      (*it).second.begin();
+                 it2 != (*it).second.end();
+                 ++it2 )
+            {
+               const int k( static_cast<int>(
+                                 std::floor( (*it2).first/dazi + 0.5 ) ) );
+
+               if( k < 0 || k >= count || k*dazi != (*it2).first ) continue;
+
+               aziRows[ aziFirst[f] + k ] = grid.size();
+               aziSizes[ aziFirst[f] + k ] = (*it2).second.size();
+               grid.insert( grid.end(),
+                            (*it2).second.begin(),
+                            (*it2).second.end() );
+            }
+         }
+
+      }  // End of 'if( dazi > 0.0 )'
+
+   }  // End of constructor 'AntennaTable::Entry::Entry()'
+
+
+
+      /* Get the non-azimuth dependent phase center variation, as
+       * Antenna::getAntennaPCVariation() does.
+       *
+       * @param[in]  freq        Frequency
+       * @param[in]  elevation   Elevation (degrees)
+       * @param[out] pcv         Phase center variation, in meters
+       *
+       * @return false if 'elevation' is out of the grid, or there is
+       * no pattern for 'freq'.
+       */
+   bool AntennaTable::Entry::getPCVariation( Antenna::frequencyType freq,
+                                             double elevation,
+                                             double& pcv ) const
+   {
+
+         // The angle should be measured respect to zenith
+      double angle( 90.0 - elevation );
+
+         // Check that angle is within limits
+      if( ( angle < zen1 ) ||
+          ( angle > zen2 ) )
+      {
+         return false;
+      }
+
+      if( noAziRow[freq] < 0 ) return false;
+
+      return interpolate( noAziRow[freq],
+                          noAziSize[freq],
+                          (angle-zen1)/dzen,
+                          pcv );
+
+   }  // End of method 'AntennaTable::Entry::getPCVariation()'
+
+
+
+      /* Get the azimuth dependent phase center variation, as
+       * Antenna::getAntennaPCVariation() does.
+       *
+       * @param[in]  freq        Frequency
+       * @param[in]  elevation   Elevation (degrees)
+       * @param[in]  azimuth     Azimuth (degrees)
+       * @param[out] pcv         Phase center variation, in meters
+       *
+       * @return false if 'elevation' is out of the grid, or there is
+       * no pattern for 'freq' and 'azimuth'.
+       */
+   bool AntennaTable::Entry::getPCVariation( Antenna::frequencyType freq,
+                                             double elevation,
+                                             double azimuth,
+                                             double& pcv ) const
+   {
+
+         // The angle should be measured respect to zenith
+      double angle( 90.0 - elevation );
+
+         // Check that angle is within limits
+      if( ( angle < zen1 ) ||
+          ( angle > zen2 ) )
+      {
+         return false;
+      }
+
+         // Reduce azimuth to 0 <= azimuth < 360 interval
+      while( azimuth < 0.0 )
+      {
+         azimuth += 360.0;
+      }
+      while( azimuth >= 360.0 )
+      {
+         azimuth -= 360.0;
+      }
+
+      if( aziFirst[freq] < 0 ) return false;
+
+         // Get the right azimuth interval
+      const double lowerIndex( std::floor(azimuth/dazi) );
+      const double lowerAzimuth( lowerIndex * dazi );
+      const double upperAzimuth( lowerAzimuth + dazi );
+
+      const int k( static_cast<int>(lowerIndex) );
+
+         // Rows of 'lowerAzimuth' and 'upperAzimuth'
+      const int row1( ( k < aziCount[freq] ) ? aziRows[aziFirst[freq]+k]
+                                             : -1 );
+      const int row2( ( k+1 < aziCount[freq] ) ? aziRows[aziFirst[freq]+k+1]
+                                               : -1 );
+
+         // Find the fraction from 'lowerAzimuth'
+      const double fractionalAzimuth( ( azimuth - lowerAzimuth ) /
+                                      ( upperAzimuth - lowerAzimuth ) );
+
+         // Get the normalized angle
+      const double normalizedAngle( (angle-zen1)/dzen );
+
+         // Check if 'azimuth' exactly corresponds to a row
+      if( fractionalAzimuth == 0.0 )
+      {
+         if( row1 < 0 ) return false;
+
+         return interpolate( row1,
+                             aziSizes[aziFirst[freq]+k],
+                             normalizedAngle,
+                             pcv );
+      }
+
+         // We have to interpolate
+      if( row1 < 0 || row2 < 0 ) return false;
+
+      double val1, val2;
+      if( !interpolate( row1, aziSizes[aziFirst[freq]+k],
+                        normalizedAngle, val1 ) ||
+          !interpolate( row2, aziSizes[aziFirst[freq]+k+1],
+                        normalizedAngle, val2 ) )
+      {
+         return false;
+      }
+
+      pcv = val1 + (val2-val1) * fractionalAzimuth;
+
+      return true;
+
+   }  // End of method 'AntennaTable::Entry::getPCVariation()'
+
+
+
+      /* Linear interpolation of a row of 'grid', as
+       * Antenna::linearInterpol().
+       *
+       * @param[in]  row                Offset of the row in 'grid'
+       * @param[in]  size               Length of the row
+       * @param[in]  normalizedAngle    Normalized angle
+       * @param[out] value              Interpolated value
+       */
+   bool AntennaTable::Entry::interpolate( int row,
+                                          int size,
+                                          double normalizedAngle,
+                                          double& value ) const
+   {
+
+         // Get the index value 'normalizedAngle' is equivalent to
+      const double lower( std::floor(normalizedAngle) );
+      const int index( static_cast<int>(lower) );
+
+         // Find the fraction from 'index'
+      const double fraction( normalizedAngle - lower );
+
+      if( index < 0 || index >= size ) return false;
+
+         // Check if 'normalizedAngle' is exactly a value of the row
+      if( fraction == 0.0 )
+      {
+         value = grid[row+index];
+         return true;
+      }
+
+      if( index+1 >= size ) return false;
+
+         // In this case, we have to interpolate
+      const double val1( grid[row+index] );
+      const double val2( grid[row+index+1] );
+
+      value = val1 + (val2-val1) * fraction;
+
+      return true;
+
+   }  // End of method 'AntennaTable::Entry::interpolate()'
+
+
+
+      // Index of a satellite in 'satEntries', or -1 if it has none
+   int AntennaTable::satIndex( const SatID& sat )
+   {
+
+      if( sat.id < 0 ||
+          sat.system < SatID::systemGPS ||
+          sat.system > SatID::systemIRNSS )
+      {
+         return -1;
+      }
+
+      return sat.id * numSatSystems + ( sat.system - SatID::systemGPS );
+
+   }  // End of method 'AntennaTable::satIndex()'
+
+
+
+      /* Returns the entry of a satellite valid at an epoch, or NULL if
+       * there is none in the table.
+       *
+       * @param[in] sat       Satellite
+       * @param[in] epoch     Epoch of interest
+       */
+   const AntennaTable::Entry* AntennaTable::findSatellite(
+                                             const SatID& sat,
+                                             const CommonTime& epoch ) const
+   {
+
+      const int index( satIndex(sat) );
+
+      if( index < 0 || index >= static_cast<int>( satEntries.size() ) )
+      {
+         return NULL;
+      }
+
+      const std::vector<Entry>& entries( satEntries[index] );
+
+      for( size_t i = 0; i < entries.size(); ++i )
+      {
+         if( entries[i].isValidAt(epoch) ) return &entries[i];
+      }
+
+      return NULL;
+
+   }  // End of method 'AntennaTable::findSatellite()'
+
+
+
+      /* Adds the antenna of a satellite, for its validity interval.
+       *
+       * @param[in] sat       Satellite
+       * @param[in] antenna   Satellite antenna, as AntexReader gives it
+       *
+       * @return the entry added.
+       */
+   const AntennaTable::Entry& AntennaTable::addSatellite(
+                                                   const SatID& sat,
+                                                   const Antenna& antenna )
+      throw(InvalidRequest)
+   {
+
+      const int index( satIndex(sat) );
+
+      if( index < 0 )
+      {
+         InvalidRequest e("Satellite can't be kept in an AntennaTable.");
+         GPSTK_THROW(e);
+      }
+
+      if( index >= static_cast<int>( satEntries.size() ) )
+      {
+         satEntries.resize( index + 1 );
+      }
+
+      satEntries[index].push_back( Entry(antenna) );
+
+      return satEntries[index].back();
+
+   }  // End of method 'AntennaTable::addSatellite()'
+
+
+
+      /* Returns the entry of a receiver antenna type, or NULL if there
+       * is none in the table.
+       *
+       * @param[in] type      Antenna type (model and radome)
+       */
+   const AntennaTable::Entry* AntennaTable::findReceiver(
+                                             const std::string& type ) const
+   {
+
+      std::map< std::string, Entry >::const_iterator it(
+                                                   rcvEntries.find(type) );
+
+      return ( it != rcvEntries.end() ) ? &(*it).second : NULL;
+
+   }  // End of method 'AntennaTable::findReceiver()'
+
+
+
+      /* Adds (or replaces) the antenna of a receiver antenna type.
+       *
+       * @param[in] type      Antenna type (model and radome)
+       * @param[in] antenna   Receiver antenna, as AntexReader gives it
+       *
+       * @return the entry added.
+       */
+   const AntennaTable::Entry& AntennaTable::addReceiver(
+                                                   const std::string& type,
+                                                   const Antenna& antenna )
+   {
+
+      Entry& entry( rcvEntries[type] );
+
+      entry = Entry(antenna);
+
+      return entry;
+
+   }  // End of method 'AntennaTable::addReceiver()'
+
+
+
+}  // End of namespace gpstk
@@ -0,0 +1,313 @@
+#pragma ident "$Id: AntennaTable.hpp $"
+
+/**
+ * @file AntennaTable.hpp
+ * Table of satellite and receiver antennas resolved out of Antenna objects,
+ * with flat phase center variation grids.
+ */
+
+#ifndef GPSTK_ANTENNA_TABLE_HPP
+#define GPSTK_ANTENNA_TABLE_HPP
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//============================================================================
+
+
+#include <vector>
+#include <map>
+#include <string>
+
+#include "CommonTime.hpp"
+#include "Triple.hpp"
+#include "SatID.hpp"
+#include "Exception.hpp"
+#include "Antenna.hpp"
+
+
+
+namespace gpstk
+{
+
+      /** @addtogroup DataStructures */
+      //@{
+
+      /** This class holds satellite and receiver antennas resolved out of
+       *  Antenna objects, so that their phase center offsets (PCO) and
+       *  variations (PCV) are found with a couple of array reads.
+       *
+       * Antenna keeps its data in maps keyed by frequency (and by azimuth),
+       * and AntexReader::getAntenna() reopens the Antex file and walks its
+       * antenna buffer at every call. An AntennaTable::Entry instead keeps,
+       * for one antenna and validity interval:
+       *
+       * \li The PCO of each frequency, in UEN, in an array indexed by
+       *     Antenna::frequencyType.
+       * \li The PCV of each frequency as flat grids: one row of zenith
+       *     values for the non-azimuth dependent pattern, and one row per
+       *     azimuth step for the azimuth dependent one.
+       *
+       * The interpolation is done with the same arithmetic as Antenna, so
+       * the results are the same.
+       *
+       * Satellite entries are kept in a vector indexed by SatID, each with
+       * the list of its validity intervals; receiver entries are kept by
+       * antenna type. The table is filled by the user, typically the first
+       * time an antenna is asked for:
+       *
+       * @code
+       *   AntennaTable table;
+       *
+       *   const AntennaTable::Entry* pEntry( table.findSatellite(sat, epoch) );
+       *   if( pEntry == NULL )
+       *   {
+       *      pEntry = &table.addSatellite( sat,
+       *                                    antexReader.getAntenna("G07", epoch) );
+       *   }
+       *
+       *   Triple pco;
+       *   double pcv;
+       *   if( pEntry->getEccentricity(Antenna::G01, pco) &&
+       *       pEntry->getPCVariation(Antenna::G01, elevation, pcv) )
+       *   {
+       *      ...
+       *   }
+       * @endcode
+       *
+       * @warning The references and pointers to entries returned by this
+       * class are only valid until the next entry is added.
+       *
+       * @sa Antenna.hpp and AntexReader.hpp.
+       */
+   class AntennaTable
+   {
+   public:
+
+         /// Number of frequencies of Antenna::frequencyType
+      static const int numFreqTypes = Antenna::I09 + 1;
+
+
+         /// Antenna data of one validity interval, resolved to flat arrays
+      class Entry
+      {
+      public:
+
+            /// Default constructor
+         Entry();
+
+
+            /** Common constructor.
+             *
+             * @param[in] antenna   Antenna to be resolved.
+             */
+         Entry( const Antenna& antenna );
+
+
+            /// Returns if 'epoch' is within the validity interval.
+         bool isValidAt( const CommonTime& epoch ) const
+         { return ( epoch >= validFrom && epoch <= validUntil ); };
+
+
+            /// Get start of antenna validity period.
+         const CommonTime& getValidFrom() const
+         { return validFrom; };
+
+
+            /// Get end of antenna validity period.
+         const CommonTime& getValidUntil() const
+         { return validUntil; };
+
+
+            /// Get first zenith (or nadir) angle of the grid, in degrees.
+         double getZen1() const
+         { return zen1; };
+
+
+            /// Get last zenith (or nadir) angle of the grid, in degrees.
+         double getZen2() const
+         { return zen2; };
+
+
+            /** Get antenna eccentricity (phase center offset), in UEN.
+             *
+             * @param[in]  freq     Frequency
+             * @param[out] ecc      Eccentricity, in meters, UEN
+             *
+             * @return false if there is no eccentricity for 'freq'.
+             */
+         bool getEccentricity( Antenna::frequencyType freq,
+                               Triple& ecc ) const
+         {
+            if( !hasEcc[freq] ) return false;
+            ecc = Triple( eccUEN[freq][0], eccUEN[freq][1], eccUEN[freq][2] );
+            return true;
+         };
+
+
+            /** Get the non-azimuth dependent phase center variation, as
+             *  Antenna::getAntennaPCVariation() does.
+             *
+             * @param[in]  freq        Frequency
+             * @param[in]  elevation   Elevation (degrees)
+             * @param[out] pcv         Phase center variation, in meters
+             *
+             * @return false if 'elevation' is out of the grid, or there is
+             * no pattern for 'freq'.
+             */
+         bool getPCVariation( Antenna::frequencyType freq,
+                              double elevation,
+                              double& pcv ) const;
+
+
+            /** Get the azimuth dependent phase center variation, as
+             *  Antenna::getAntennaPCVariation() does.
+             *
+             * @param[in]  freq        Frequency
+             * @param[in]  elevation   Elevation (degrees)
+             * @param[in]  azimuth     Azimuth (degrees)
+             * @param[out] pcv         Phase center variation, in meters
+             *
+             * @return false if 'elevation' is out of the grid, or there is
+             * no pattern for 'freq' and 'azimuth'.
+             */
+         bool getPCVariation( Antenna::frequencyType freq,
+                              double elevation,
+                              double azimuth,
+                              double& pcv ) const;
+
+
+      private:
+
+
+            /// Validity interval
+         CommonTime validFrom;
+         CommonTime validUntil;
+
+            /// Zenith grid and azimuth step, in degrees
+         double zen1;
+         double zen2;
+         double dzen;
+         double dazi;
+
+            /// Eccentricities, in UEN, by frequency
+         bool hasEcc[numFreqTypes];
+         double eccUEN[numFreqTypes][3];
+
+            /// Non-azimuth dependent pattern of each frequency: offset of
+            /// its row in 'grid' (-1 if none) and row length
+         int noAziRow[numFreqTypes];
+         int noAziSize[numFreqTypes];
+
+            /// Azimuth dependent pattern of each frequency: offset in
+            /// 'aziRows' of its first row (-1 if none), and number of rows
+         int aziFirst[numFreqTypes];
+         int aziCount[numFreqTypes];
+
+            /// Offset in 'grid' (-1 if missing) and length of each azimuth
+            /// row; row k is for azimuth k*dazi
+         std::vector<int> aziRows;
+         std::vector<int> aziSizes;
+
+            /// All the pattern values
+         std::vector<double> grid;
+
+
+            /// Linear interpolation of a row, as Antenna::linearInterpol()
+         bool interpolate( int row,
+                           int size,
+                           double normalizedAngle,
+                           double& value ) const;
+
+      }; // End of class 'AntennaTable::Entry'
+
+
+         /// Default constructor
+      AntennaTable() {};
+
+
+         /** Returns the entry of a satellite valid at an epoch, or NULL if
+          *  there is none in the table.
+          *
+          * @param[in] sat       Satellite
+          * @param[in] epoch     Epoch of interest
+          */
+      const Entry* findSatellite( const SatID& sat,
+                                  const CommonTime& epoch ) const;
+
+
+         /** Adds the antenna of a satellite, for its validity interval.
+          *
+          * @param[in] sat       Satellite
+          * @param[in] antenna   Satellite antenna, as AntexReader gives it
+          *
+          * @return the entry added.
+          */
+      const Entry& addSatellite( const SatID& sat,
+                                 const Antenna& antenna )
+         throw(InvalidRequest);
+
+
+         /** Returns the entry of a receiver antenna type, or NULL if there
+          *  is none in the table.
+          *
+          * @param[in] type      Antenna type (model and radome)
+          */
+      const Entry* findReceiver( const std::string& type ) const;
+
+
+         /** Adds (or replaces) the antenna of a receiver antenna type.
+          *
+          * @param[in] type      Antenna type (model and radome)
+          * @param[in] antenna   Receiver antenna, as AntexReader gives it
+          *
+          * @return the entry added.
+          */
+      const Entry& addReceiver( const std::string& type,
+                                const Antenna& antenna );
+
+
+         /// Removes all the entries.
+      void clear()
+      { satEntries.clear(); rcvEntries.clear(); };
+
+
+         /// Destructor
+      virtual ~AntennaTable() {};
+
+
+   private:
+
+
+         /// Index of a satellite in 'satEntries', or -1 if it has none
+      static int satIndex( const SatID& sat );
+
+
+         /// Validity intervals of each satellite, by satIndex()
+      std::vector< std::vector<Entry> > satEntries;
+
+         /// Receiver antennas, by type
+      std::map< std::string, Entry > rcvEntries;
+
+   }; // End of class 'AntennaTable'
+
+      //@}
+
+}  // End of namespace gpstk
+
+#endif   // GPSTK_ANTENNA_TABLE_HPP
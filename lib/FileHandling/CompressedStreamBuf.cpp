@@ -0,0 +1,903 @@
+#pragma ident "$Id: CompressedStreamBuf.cpp $"
+
+/**
+ * @file CompressedStreamBuf.cpp
+ * Stream buffers decoding compressed (gzip, Unix compress) input on the fly.
+ */
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//============================================================================
+
+
+#include "CompressedStreamBuf.hpp"
+#include <cstring>
+#include <algorithm>
+
+using namespace std;
+
+namespace gpstk
+{
+
+      // Number of characters decoded at a time
+   static const size_t decodeBufferSize(65536);
+
+      // Number of characters already read kept for seeking back
+   static const size_t decodeKeepSize(65536);
+
+
+   DecodeStreamBuf::DecodeStreamBuf(std::streambuf* source)
+      : pSource(source),
+        buffer(decodeKeepSize + decodeBufferSize),
+        bufferPosition(0)
+   {
+      setg(&buffer[0], &buffer[0], &buffer[0]);
+   }
+
+
+      // Fills the buffer with decoded data.
+   DecodeStreamBuf::int_type DecodeStreamBuf::underflow()
+   {
+      if( gptr() < egptr() )
+      {
+         return traits_type::to_int_type(*gptr());
+      }
+
+         // Keep the end of the data read so far at the start of the
+         // buffer, so that seeks may go back into it
+      std::streamsize used( egptr() - eback() );
+      std::streamsize keep( std::min( used,
+                                      std::streamsize(decodeKeepSize) ) );
+
+      if( keep > 0 )
+      {
+         std::memmove(&buffer[0], egptr() - keep, keep);
+      }
+
+      bufferPosition += used - keep;
+
+      char* start( &buffer[0] + keep );
+      std::streamsize n(0);
+
+      if( error.empty() )
+      {
+         std::streamsize size( decodeBufferSize );
+
+         try
+         {
+            while( n < size )
+            {
+               std::streamsize k( decode(start + n, size - n) );
+               if( k <= 0 ) break;
+               n += k;
+            }
+         }
+         catch(Exception& e)
+         {
+            error = e.getText();
+         }
+         catch(std::exception& e)
+         {
+            error = e.what();
+         }
+      }
+
+      setg(&buffer[0], start, start + n);
+
+      if( n == 0 )
+      {
+         return traits_type::eof();
+      }
+
+      return traits_type::to_int_type(*start);
+
+   }  // End of method 'DecodeStreamBuf::underflow()'
+
+
+      // Returns or changes the position in the decoded data.
+   DecodeStreamBuf::pos_type DecodeStreamBuf::seekoff(
+                                             off_type off,
+                                             std::ios_base::seekdir dir,
+                                             std::ios_base::openmode which )
+   {
+      std::streamoff current( bufferPosition + (gptr() - eback()) );
+
+      if( dir == std::ios_base::cur )
+      {
+         return seekpos(pos_type(current + off), which);
+      }
+      else if( dir == std::ios_base::beg )
+      {
+         return seekpos(pos_type(off), which);
+      }
+
+      return pos_type(off_type(-1));
+
+   }  // End of method 'DecodeStreamBuf::seekoff()'
+
+
+      // Changes the position in the decoded data.
+   DecodeStreamBuf::pos_type DecodeStreamBuf::seekpos(
+                                             pos_type pos,
+                                             std::ios_base::openmode which )
+   {
+      std::streamoff target(pos);
+
+      if( !(which & std::ios_base::in)   ||
+          target < bufferPosition        ||
+          target > bufferPosition + (egptr() - eback()) )
+      {
+         return pos_type(off_type(-1));
+      }
+
+      setg(eback(), eback() + (target - bufferPosition), egptr());
+
+      return pos;
+
+   }  // End of method 'DecodeStreamBuf::seekpos()'
+
+
+
+      // Tables of the deflate length and distance codes
+   static const unsigned short lengthBase[29] =
+      { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+        35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+
+   static const unsigned char lengthExtra[29] =
+      { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+        3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+
+   static const unsigned short distBase[30] =
+      { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+        257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+        8193, 12289, 16385, 24577 };
+
+   static const unsigned char distExtra[30] =
+      { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+        7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+      // Order of the code length code lengths in a dynamic block header
+   static const unsigned char codeLengthOrder[19] =
+      { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+
+   GZipStreamBuf::GZipStreamBuf(std::streambuf* source)
+      : DecodeStreamBuf(source), state(memberStart), members(0),
+        lastBlock(false), storedLeft(0), matchLeft(0), matchDist(0),
+        window(32768, 0), windowPos(0), bitBuf(0), bitCount(0),
+        padBytes(0), crc(0xffffffffUL), memberSize(0)
+   {
+
+      for(unsigned long n = 0; n < 256; ++n)
+      {
+         unsigned long c(n);
+         for(int k = 0; k < 8; ++k)
+         {
+            c = (c & 1) ? (0xedb88320UL ^ (c >> 1)) : (c >> 1);
+         }
+         crcTable[n] = c;
+      }
+
+   }  // End of constructor 'GZipStreamBuf::GZipStreamBuf()'
+
+
+      // Builds a Huffman code from the code lengths of its symbols.
+   void GZipStreamBuf::buildHuffman( Huffman& h,
+                                     const unsigned char* lengths,
+                                     int n )
+   {
+
+      int count[16] = { 0 };
+      h.maxBits = 0;
+
+      for(int i = 0; i < n; ++i)
+      {
+         ++count[lengths[i]];
+         if( lengths[i] > h.maxBits ) h.maxBits = lengths[i];
+      }
+
+      h.table.clear();
+      if( h.maxBits == 0 ) return;   // Valid for unused distance codes
+
+         // Check that the code is not over-subscribed
+      int left(1);
+      for(int len = 1; len < 16; ++len)
+      {
+         left = (left << 1) - count[len];
+         if( left < 0 )
+         {
+            Exception e("Invalid Huffman code in the compressed data");
+            GPSTK_THROW(e);
+         }
+      }
+
+      unsigned int next[16];
+      unsigned int code(0);
+      count[0] = 0;
+      for(int len = 1; len < 16; ++len)
+      {
+         code = (code + count[len - 1]) << 1;
+         next[len] = code;
+      }
+
+         // Codes are stored bit reversed, so that the table is indexed by
+         // the next bits of the stream, first bit as least significant
+      unsigned int size( 1U << h.maxBits );
+      h.table.assign(size, 0);
+
+      for(int sym = 0; sym < n; ++sym)
+      {
+         int len( lengths[sym] );
+         if( len == 0 ) continue;
+
+         unsigned int c( next[len]++ );
+         unsigned int r(0);
+         for(int k = 0; k < len; ++k)
+         {
+            r = (r << 1) | (c & 1);
+            c >>= 1;
+         }
+
+         for(unsigned int idx = r; idx < size; idx += (1U << len))
+         {
+            h.table[idx] = (static_cast<unsigned int>(sym) << 4) | len;
+         }
+      }
+
+   }  // End of method 'GZipStreamBuf::buildHuffman()'
+
+
+      // Makes sure there are at least 'n' bits (n <= 24) available.
+   void GZipStreamBuf::needBits(int n)
+   {
+
+      while( bitCount < n )
+      {
+         int_type c( pSource->sbumpc() );
+
+            // Pad with zeros at the end; it is an error to use the padding
+         if( traits_type::eq_int_type(c, traits_type::eof()) )
+         {
+            ++padBytes;
+            c = 0;
+         }
+
+         bitBuf |= static_cast<unsigned long>(c & 0xff) << bitCount;
+         bitCount += 8;
+      }
+
+   }  // End of method 'GZipStreamBuf::needBits()'
+
+
+      // Returns the next 'n' bits (n <= 24).
+   unsigned int GZipStreamBuf::getBits(int n)
+   {
+
+      needBits(n);
+
+      unsigned int v( bitBuf & ((1UL << n) - 1) );
+      bitBuf >>= n;
+      bitCount -= n;
+
+      if( bitCount < 8*padBytes )
+      {
+         Exception e("Unexpected end of the compressed data");
+         GPSTK_THROW(e);
+      }
+
+      return v;
+
+   }  // End of method 'GZipStreamBuf::getBits()'
+
+
+      // Decodes the next symbol with the given code.
+   int GZipStreamBuf::decodeSymbol(const Huffman& h)
+   {
+
+      if( h.maxBits == 0 )
+      {
+         Exception e("Invalid code in the compressed data");
+         GPSTK_THROW(e);
+      }
+
+      needBits(h.maxBits);
+
+      unsigned int entry( h.table[bitBuf & ((1UL << h.maxBits) - 1)] );
+      int len( entry & 15 );
+
+      if( len == 0 )
+      {
+         Exception e("Invalid code in the compressed data");
+         GPSTK_THROW(e);
+      }
+
+      bitBuf >>= len;
+      bitCount -= len;
+
+      if( bitCount < 8*padBytes )
+      {
+         Exception e("Unexpected end of the compressed data");
+         GPSTK_THROW(e);
+      }
+
+      return (entry >> 4);
+
+   }  // End of method 'GZipStreamBuf::decodeSymbol()'
+
+
+      // Returns the next byte, after skipping to a byte boundary.
+   int GZipStreamBuf::getAlignedByte()
+   {
+      getBits(bitCount % 8);
+      return getBits(8);
+   }
+
+
+      // Reads the header of a gzip member, returns false at the end.
+   bool GZipStreamBuf::readMemberHeader()
+   {
+
+      getBits(bitCount % 8);
+
+      if( bitCount == 0 &&
+          traits_type::eq_int_type( pSource->sgetc(), traits_type::eof() ) )
+      {
+         if( members == 0 )
+         {
+            Exception e("Empty gzip data");
+            GPSTK_THROW(e);
+         }
+
+         return false;
+      }
+
+      int id1( getAlignedByte() );
+      int id2( getAlignedByte() );
+
+      if( id1 != 0x1f || id2 != 0x8b )
+      {
+            // Like gzip, ignore trailing garbage after the first member
+         if( members > 0 ) return false;
+
+         Exception e("Not in gzip format");
+         GPSTK_THROW(e);
+      }
+
+      if( getAlignedByte() != 8 )
+      {
+         Exception e("Unknown gzip compression method");
+         GPSTK_THROW(e);
+      }
+
+      int flags( getAlignedByte() );
+
+         // Modification time, extra flags and operating system
+      for(int i = 0; i < 6; ++i) getAlignedByte();
+
+         // FEXTRA
+      if( flags & 4 )
+      {
+         int len( getAlignedByte() );
+         len |= getAlignedByte() << 8;
+         for(int i = 0; i < len; ++i) getAlignedByte();
+      }
+
+         // FNAME and FCOMMENT
+      if( flags & 8 )  while( getAlignedByte() != 0 ) ;
+      if( flags & 16 ) while( getAlignedByte() != 0 ) ;
+
+         // FHCRC
+      if( flags & 2 )
+      {
+         getAlignedByte();
+         getAlignedByte();
+      }
+
+      crc = 0xffffffffUL;
+      memberSize = 0;
+      ++members;
+
+      return true;
+
+   }  // End of method 'GZipStreamBuf::readMemberHeader()'
+
+
+      // Reads the trailer of a gzip member and checks it.
+   void GZipStreamBuf::readMemberTrailer()
+   {
+
+      unsigned long value[2];
+
+      for(int i = 0; i < 2; ++i)
+      {
+         value[i] = 0;
+         for(int k = 0; k < 4; ++k)
+         {
+            value[i] |= static_cast<unsigned long>(getAlignedByte())
+                                                                  << (8*k);
+         }
+      }
+
+      if( value[0] != ((crc ^ 0xffffffffUL) & 0xffffffffUL) )
+      {
+         Exception e("CRC error in the gzip data");
+         GPSTK_THROW(e);
+      }
+
+      if( value[1] != (memberSize & 0xffffffffUL) )
+      {
+         Exception e("Length error in the gzip data");
+         GPSTK_THROW(e);
+      }
+
+   }  // End of method 'GZipStreamBuf::readMemberTrailer()'
+
+
+      // Reads the header of the next deflate block.
+   void GZipStreamBuf::readBlockHeader()
+   {
+
+      lastBlock = (getBits(1) != 0);
+
+      int type( getBits(2) );
+
+      if( type == 0 )
+      {
+            // Stored block
+         getBits(bitCount % 8);
+
+         unsigned int len( getBits(16) );
+         unsigned int nlen( getBits(16) );
+
+         if( len != (~nlen & 0xffff) )
+         {
+            Exception e("Invalid stored block in the compressed data");
+            GPSTK_THROW(e);
+         }
+
+         storedLeft = len;
+         state = storedBlock;
+
+         return;
+      }
+
+      unsigned char lengths[320];
+
+      if( type == 1 )
+      {
+            // Fixed Huffman codes
+         int sym(0);
+         for( ; sym < 144; ++sym) lengths[sym] = 8;
+         for( ; sym < 256; ++sym) lengths[sym] = 9;
+         for( ; sym < 280; ++sym) lengths[sym] = 7;
+         for( ; sym < 288; ++sym) lengths[sym] = 8;
+         buildHuffman(litLenCode, lengths, 288);
+
+         for(sym = 0; sym < 30; ++sym) lengths[sym] = 5;
+         buildHuffman(distCode, lengths, 30);
+      }
+      else if( type == 2 )
+      {
+            // Dynamic Huffman codes
+         int nlen( getBits(5) + 257 );
+         int ndist( getBits(5) + 1 );
+         int ncode( getBits(4) + 4 );
+
+         if( nlen > 286 || ndist > 30 )
+         {
+            Exception e("Invalid block header in the compressed data");
+            GPSTK_THROW(e);
+         }
+
+         unsigned char codeLengths[19] = { 0 };
+         for(int i = 0; i < ncode; ++i)
+         {
+            codeLengths[codeLengthOrder[i]] = getBits(3);
+         }
+
+         Huffman lenCode;
+         buildHuffman(lenCode, codeLengths, 19);
+
+         int i(0);
+         while( i < nlen + ndist )
+         {
+            int sym( decodeSymbol(lenCode) );
+
+            if( sym < 16 )
+            {
+               lengths[i++] = sym;
+               continue;
+            }
+
+            int len(0);
+            int repeat;
+            if( sym == 16 )
+            {
+               if( i == 0 )
+               {
+                  Exception e("Invalid block header in the compressed data");
+                  GPSTK_THROW(e);
+               }
+               len = lengths[i - 1];
+               repeat = 3 + getBits(2);
+            }
+            else if( sym == 17 )
+            {
+               repeat = 3 + getBits(3);
+            }
+            else
+            {
+               repeat = 11 + getBits(7);
+            }
+
+            if( i + repeat > nlen + ndist )
+            {
+               Exception e("Invalid block header in the compressed data");
+               GPSTK_THROW(e);
+            }
+
+            while( repeat-- ) lengths[i++] = len;
+         }
+
+         if( lengths[256] == 0 )
+         {
+            Exception e("Invalid block header in the compressed data");
+            GPSTK_THROW(e);
+         }
+
+         buildHuffman(litLenCode, lengths, nlen);
+         buildHuffman(distCode, lengths + nlen, ndist);
+      }
+      else
+      {
+         Exception e("Invalid block type in the compressed data");
+         GPSTK_THROW(e);
+      }
+
+      state = codedBlock;
+
+   }  // End of method 'GZipStreamBuf::readBlockHeader()'
+
+
+      // Decodes up to 'n' characters into 'buf'.
+   std::streamsize GZipStreamBuf::decode(char* buf, std::streamsize n)
+   {
+
+      std::streamsize k(0);
+
+      while( k < n )
+      {
+         switch( state )
+         {
+
+            case memberStart:
+
+               state = readMemberHeader() ? blockStart : finished;
+               break;
+
+            case blockStart:
+
+               readBlockHeader();
+               break;
+
+            case storedBlock:
+
+               while( storedLeft > 0 && k < n )
+               {
+                  putByte(getBits(8), buf, k);
+                  --storedLeft;
+               }
+
+               if( storedLeft == 0 )
+               {
+                  if( lastBlock )
+                  {
+                     readMemberTrailer();
+                     state = memberStart;
+                  }
+                  else
+                  {
+                     state = blockStart;
+                  }
+               }
+               break;
+
+            case codedBlock:
+
+               if( matchLeft > 0 )
+               {
+                  while( matchLeft > 0 && k < n )
+                  {
+                     putByte( window[(windowPos - matchDist) & 0x7fff],
+                              buf, k );
+                     --matchLeft;
+                  }
+                  break;
+               }
+
+               {
+                  int sym( decodeSymbol(litLenCode) );
+
+                  if( sym < 256 )
+                  {
+                     putByte(sym, buf, k);
+                  }
+                  else if( sym == 256 )
+                  {
+                        // End of block
+                     if( lastBlock )
+                     {
+                        readMemberTrailer();
+                        state = memberStart;
+                     }
+                     else
+                     {
+                        state = blockStart;
+                     }
+                  }
+                  else
+                  {
+                     sym -= 257;
+                     if( sym >= 29 )
+                     {
+                        Exception e("Invalid length in the compressed data");
+                        GPSTK_THROW(e);
+                     }
+                     matchLeft = lengthBase[sym] + getBits(lengthExtra[sym]);
+
+                     int d( decodeSymbol(distCode) );
+                     if( d >= 30 )
+                     {
+                        Exception e("Invalid distance in the compressed data");
+                        GPSTK_THROW(e);
+                     }
+                     matchDist = distBase[d] + getBits(distExtra[d]);
+
+                     if( matchDist > memberSize )
+                     {
+                        Exception e("Invalid distance in the compressed data");
+                        GPSTK_THROW(e);
+                     }
+                  }
+               }
+               break;
+
+            case finished:
+
+               return k;
+
+         }  // End of 'switch( state )'
+      }
+
+      return k;
+
+   }  // End of method 'GZipStreamBuf::decode()'
+
+
+
+   LZWStreamBuf::LZWStreamBuf(std::streambuf* source)
+      : DecodeStreamBuf(source), started(false), maxBits(16),
+        blockMode(true), nBits(9), groupCount(0), maxCode(511),
+        freeEnt(257), oldCode(-1), finChar(0), bitBuf(0), bitCount(0),
+        inputEnd(false), prefix(65536, 0), suffix(65536, 0)
+   {
+
+      for(int i = 0; i < 256; ++i)
+      {
+         suffix[i] = i;
+      }
+
+   }  // End of constructor 'LZWStreamBuf::LZWStreamBuf()'
+
+
+      // Reads the next code, returns -1 at the end of the data.
+   int LZWStreamBuf::getCode()
+   {
+
+      while( bitCount < nBits )
+      {
+         int_type c( pSource->sbumpc() );
+
+            // The incomplete last code is ignored, as 'compress' does
+         if( traits_type::eq_int_type(c, traits_type::eof()) )
+         {
+            inputEnd = true;
+            return -1;
+         }
+
+         bitBuf |= static_cast<unsigned long>(c & 0xff) << bitCount;
+         bitCount += 8;
+      }
+
+      int code( bitBuf & ((1UL << nBits) - 1) );
+      bitBuf >>= nBits;
+      bitCount -= nBits;
+      ++groupCount;
+
+      return code;
+
+   }  // End of method 'LZWStreamBuf::getCode()'
+
+
+      // Skips the rest of the current group of 8 codes.
+   void LZWStreamBuf::skipGroup()
+   {
+
+         // 'compress' reads the codes in groups of 8, i.e. nBits bytes,
+         // and discards the rest of the group when the width changes
+      int rest( groupCount % 8 );
+      groupCount = 0;
+
+      if( rest == 0 ) return;
+
+      int skip( (8 - rest)*nBits );
+
+      while( skip > 0 )
+      {
+         if( bitCount == 0 )
+         {
+            int_type c( pSource->sbumpc() );
+            if( traits_type::eq_int_type(c, traits_type::eof()) )
+            {
+               inputEnd = true;
+               return;
+            }
+            bitBuf = (c & 0xff);
+            bitCount = 8;
+         }
+
+         int d( (skip < bitCount) ? skip : bitCount );
+         bitBuf >>= d;
+         bitCount -= d;
+         skip -= d;
+      }
+
+   }  // End of method 'LZWStreamBuf::skipGroup()'
+
+
+      // Decodes up to 'n' characters into 'buf'.
+   std::streamsize LZWStreamBuf::decode(char* buf, std::streamsize n)
+   {
+
+      if( !started )
+      {
+         int_type magic[3];
+         for(int i = 0; i < 3; ++i)
+         {
+            magic[i] = pSource->sbumpc();
+         }
+
+         if( magic[0] != 0x1f || magic[1] != 0x9d ||
+             traits_type::eq_int_type(magic[2], traits_type::eof()) )
+         {
+            Exception e("Not in compress (.Z) format");
+            GPSTK_THROW(e);
+         }
+
+         maxBits = magic[2] & 0x1f;
+         blockMode = (magic[2] & 0x80) != 0;
+
+         if( maxBits < 9 || maxBits > 16 )
+         {
+            Exception e("Unsupported number of bits in compress (.Z) data");
+            GPSTK_THROW(e);
+         }
+
+         freeEnt = blockMode ? 257 : 256;
+         started = true;
+      }
+
+      std::streamsize k(0);
+
+      while( k < n )
+      {
+            // Decoded string not yet output
+         if( !stack.empty() )
+         {
+            while( !stack.empty() && k < n )
+            {
+               buf[k++] = stack.back();
+               stack.pop_back();
+            }
+            continue;
+         }
+
+         if( inputEnd ) break;
+
+            // Code width increase
+         if( freeEnt > maxCode )
+         {
+            skipGroup();
+            ++nBits;
+            maxCode = (nBits == maxBits) ? (1 << maxBits)
+                                         : ((1 << nBits) - 1);
+            continue;
+         }
+
+         int code( getCode() );
+         if( code < 0 ) break;
+
+            // First code
+         if( oldCode == -1 )
+         {
+            if( code >= 256 )
+            {
+               Exception e("Corrupted compress (.Z) data");
+               GPSTK_THROW(e);
+            }
+            oldCode = finChar = code;
+            buf[k++] = code;
+            continue;
+         }
+
+            // Table reset
+         if( code == 256 && blockMode )
+         {
+            skipGroup();
+            freeEnt = 256;
+            nBits = 9;
+            maxCode = 511;
+            continue;
+         }
+
+         int inCode(code);
+
+            // The KwKwK case: the code being defined
+         if( code >= freeEnt )
+         {
+            if( code > freeEnt )
+            {
+               Exception e("Corrupted compress (.Z) data");
+               GPSTK_THROW(e);
+            }
+            stack.push_back(finChar);
+            code = oldCode;
+         }
+
+         while( code >= 256 )
+         {
+            stack.push_back(suffix[code]);
+            code = prefix[code];
+
+            if( stack.size() > 65536 )
+            {
+               Exception e("Corrupted compress (.Z) data");
+               GPSTK_THROW(e);
+            }
+         }
+
+         finChar = suffix[code];
+         stack.push_back(finChar);
+
+         if( freeEnt < (1 << maxBits) )
+         {
+            prefix[freeEnt] = oldCode;
+            suffix[freeEnt] = finChar;
+            ++freeEnt;
+         }
+
+         oldCode = inCode;
+      }
+
+      return k;
+
+   }  // End of method 'LZWStreamBuf::decode()'
+
+
+}  // End of namespace gpstk
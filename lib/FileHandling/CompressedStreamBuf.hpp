@@ -0,0 +1,309 @@
+#pragma ident "$Id: CompressedStreamBuf.hpp $"
+
+/**
+ * @file CompressedStreamBuf.hpp
+ * Stream buffers decoding compressed (gzip, Unix compress) input on the fly.
+ */
+
+#ifndef GPSTK_COMPRESSED_STREAM_BUF_HPP
+#define GPSTK_COMPRESSED_STREAM_BUF_HPP
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//============================================================================
+
+
+#include <streambuf>
+#include <string>
+#include <vector>
+#include "Exception.hpp"
+
+
+namespace gpstk
+{
+
+   /** @addtogroup formattedfile */
+   //@{
+
+      /** Base class of the read-only stream buffers that decode the data
+       *  of another stream buffer (the source) on the fly.
+       *
+       * Derived classes only implement 'decode()'. The position reported
+       * by 'tellg()' is the position in the decoded data, and 'seekg()'
+       * works from at least 64 KB before the current position to the end
+       * of the data decoded last (e.g. to go back to the start of the
+       * current record); other seeks fail.
+       */
+   class DecodeStreamBuf : public std::streambuf
+   {
+   public:
+
+         /** Common constructor.
+          *
+          * @param source     Stream buffer holding the encoded data. It is
+          *                   not owned, and must outlive this object.
+          */
+      explicit DecodeStreamBuf(std::streambuf* source);
+
+
+         /// Returns the error that stopped the decoding, if any.
+      const std::string& getError() const
+      { return error; };
+
+
+         /// Destructor.
+      virtual ~DecodeStreamBuf() {};
+
+
+   protected:
+
+         /** Decodes up to 'n' characters into 'buf'.
+          *
+          * @return Number of characters decoded, 0 at the end of the data.
+          * @throw Exception if the data are corrupted.
+          */
+      virtual std::streamsize decode(char* buf, std::streamsize n) = 0;
+
+
+         /// Fills the buffer with decoded data.
+      virtual int_type underflow();
+
+
+         /// Returns or changes the position in the decoded data.
+      virtual pos_type seekoff( off_type off,
+                                std::ios_base::seekdir dir,
+                                std::ios_base::openmode which );
+
+
+         /// Changes the position in the decoded data.
+      virtual pos_type seekpos( pos_type pos,
+                                std::ios_base::openmode which );
+
+
+         /// Stream buffer holding the encoded data
+      std::streambuf* pSource;
+
+
+   private:
+
+         /// Decoded data: the end of the data read before the last
+         /// refill, then the data decoded last
+      std::vector<char> buffer;
+
+         /// Position of the start of 'buffer' in the decoded data
+      std::streamoff bufferPosition;
+
+         /// Error that stopped the decoding
+      std::string error;
+
+   }; // End of class 'DecodeStreamBuf'
+
+
+
+      /** This class decodes gzip (RFC 1952) data, i.e. deflate (RFC 1951)
+       *  compressed data in one or more gzip members.
+       *
+       * The CRC and size of every member are checked.
+       */
+   class GZipStreamBuf : public DecodeStreamBuf
+   {
+   public:
+
+         /** Common constructor.
+          *
+          * @param source     Stream buffer holding the gzip data.
+          */
+      explicit GZipStreamBuf(std::streambuf* source);
+
+
+         /// Destructor.
+      virtual ~GZipStreamBuf() {};
+
+
+   protected:
+
+         /// Decodes up to 'n' characters into 'buf'.
+      virtual std::streamsize decode(char* buf, std::streamsize n);
+
+
+   private:
+
+         /// Canonical Huffman code, as a table indexed by the next bits
+      struct Huffman
+      {
+         int maxBits;
+            /// (symbol << 4) | code length, per value of the next maxBits
+         std::vector<unsigned int> table;
+      };
+
+
+         /// Builds a Huffman code from the code lengths of its symbols.
+      void buildHuffman(Huffman& h, const unsigned char* lengths, int n);
+
+         /// Decodes the next symbol with the given code.
+      int decodeSymbol(const Huffman& h);
+
+         /// Makes sure there are at least 'n' bits (n <= 24) available.
+      void needBits(int n);
+
+         /// Returns the next 'n' bits (n <= 24).
+      unsigned int getBits(int n);
+
+         /// Returns the next byte, after skipping to a byte boundary.
+      int getAlignedByte();
+
+         /// Reads the header of a gzip member, returns false at the end.
+      bool readMemberHeader();
+
+         /// Reads the trailer of a gzip member and checks it.
+      void readMemberTrailer();
+
+         /// Reads the header of the next deflate block.
+      void readBlockHeader();
+
+         /// Adds a decoded byte to the output and the window.
+      void putByte(unsigned char c, char* buf, std::streamsize& k)
+      {
+         buf[k++] = c;
+         window[windowPos] = c;
+         windowPos = (windowPos + 1) & 0x7fff;
+         crc = crcTable[(crc ^ c) & 0xff] ^ (crc >> 8);
+         ++memberSize;
+      };
+
+
+         /// State of the decoder
+      enum State
+      {
+         memberStart,   ///< Before the header of a gzip member
+         blockStart,    ///< Before the header of a deflate block
+         storedBlock,   ///< Inside a stored block
+         codedBlock,    ///< Inside a Huffman coded block
+         finished       ///< No more data
+      };
+
+      State state;
+
+         /// Number of gzip members read
+      int members;
+
+         /// Whether the current block is the last one of the member
+      bool lastBlock;
+
+         /// Bytes left in the current stored block
+      unsigned int storedLeft;
+
+         /// Codes of the current block
+      Huffman litLenCode;
+      Huffman distCode;
+
+         /// Pending match: bytes left and distance
+      unsigned int matchLeft;
+      unsigned int matchDist;
+
+         /// Last 32 KB of output
+      std::vector<unsigned char> window;
+      unsigned int windowPos;
+
+         /// Bit buffer
+      unsigned long bitBuf;
+      int bitCount;
+
+         /// Bytes added to the bit buffer after the end of the input
+      int padBytes;
+
+         /// CRC-32 and size of the current member
+      unsigned long crc;
+      unsigned long memberSize;
+
+         /// CRC-32 table
+      unsigned long crcTable[256];
+
+   }; // End of class 'GZipStreamBuf'
+
+
+
+      /** This class decodes Unix 'compress' (.Z, LZW) data.
+       */
+   class LZWStreamBuf : public DecodeStreamBuf
+   {
+   public:
+
+         /** Common constructor.
+          *
+          * @param source     Stream buffer holding the compressed data.
+          */
+      explicit LZWStreamBuf(std::streambuf* source);
+
+
+         /// Destructor.
+      virtual ~LZWStreamBuf() {};
+
+
+   protected:
+
+         /// Decodes up to 'n' characters into 'buf'.
+      virtual std::streamsize decode(char* buf, std::streamsize n);
+
+
+   private:
+
+         /// Reads the next code, returns -1 at the end of the data.
+      int getCode();
+
+         /// Skips the rest of the current group of 8 codes.
+      void skipGroup();
+
+
+         /// Header read
+      bool started;
+
+         /// Maximum code width and block (CLEAR) mode, from the header
+      int maxBits;
+      bool blockMode;
+
+         /// Current code width, codes read with it, largest code
+      int nBits;
+      int groupCount;
+      int maxCode;
+
+         /// Next free entry and previous code
+      int freeEnt;
+      int oldCode;
+      int finChar;
+
+         /// Bit buffer
+      unsigned long bitBuf;
+      int bitCount;
+      bool inputEnd;
+
+         /// String table
+      std::vector<unsigned short> prefix;
+      std::vector<unsigned char> suffix;
+
+         /// Decoded string not yet output, in reverse order
+      std::vector<unsigned char> stack;
+
+   }; // End of class 'LZWStreamBuf'
+
+   //@}
+
+}  // End of namespace gpstk
+
+#endif   // GPSTK_COMPRESSED_STREAM_BUF_HPP
@@ -0,0 +1,137 @@
+#pragma ident "$Id: FFTextStream.cpp $"
+
+/**
+ * @file FFTextStream.cpp
+ * An FFStream for text files
+ */
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//============================================================================
+
+
+#include "FFTextStream.hpp"
+#include "HatanakaStreamBuf.hpp"
+
+using namespace std;
+
+namespace gpstk
+{
+
+      /* Installs the stream buffers decoding the file, if it is open
+       * for reading only and compressed.
+       */
+   void FFTextStream::setupDecoding(std::ios::openmode mode)
+   {
+
+      if( !(mode & std::ios::in) || (mode & std::ios::out) || !is_open() )
+      {
+         return;
+      }
+
+      std::filebuf* pFile( std::fstream::rdbuf() );
+      std::streambuf* pSource( pFile );
+
+         // The format is recognized by reading the first bytes and going
+         // back: pipes and FIFOs can't go back, so they are read as is
+      if( pFile->pubseekoff(0, std::ios::cur, std::ios::in)
+                                                   == std::streampos(-1) )
+      {
+         return;
+      }
+
+         // gzip and compress files are recognized by their magic number
+      char magic[2];
+      std::streamsize n( pFile->sgetn(magic, 2) );
+      pFile->pubseekpos(0, std::ios::in);
+
+      if( n == 2 && magic[0] == '\x1f' )
+      {
+         if( magic[1] == '\x8b' )
+         {
+            pDecompressBuf = new GZipStreamBuf(pFile);
+         }
+         else if( magic[1] == '\x9d' )
+         {
+            pDecompressBuf = new LZWStreamBuf(pFile);
+         }
+
+         if( pDecompressBuf != NULL ) pSource = pDecompressBuf;
+      }
+
+         // Compact RINEX files by the label of their first line
+      char first[128];
+      n = pSource->sgetn(first, sizeof(first));
+      pSource->pubseekpos(0, std::ios::in);
+
+      std::string firstLine(first, n);
+      firstLine = firstLine.substr( 0, firstLine.find('\n') );
+
+      if( firstLine.find("CRINEX VERS   / TYPE") != std::string::npos )
+      {
+         pCRINEXBuf = new HatanakaStreamBuf(pSource);
+         pSource = pCRINEXBuf;
+      }
+
+      if( pSource != pFile )
+      {
+         std::ios::rdbuf(pSource);
+      }
+
+   }  // End of method 'FFTextStream::setupDecoding()'
+
+
+      // Removes the stream buffers decoding the file.
+   void FFTextStream::clearDecoding()
+   {
+
+      if( pDecompressBuf == NULL && pCRINEXBuf == NULL ) return;
+
+      std::ios::rdbuf( std::fstream::rdbuf() );
+
+      delete pCRINEXBuf;
+      pCRINEXBuf = NULL;
+
+      delete pDecompressBuf;
+      pDecompressBuf = NULL;
+
+   }  // End of method 'FFTextStream::clearDecoding()'
+
+
+      // Returns the error that stopped decoding the file, if any.
+   std::string FFTextStream::getDecodingError() const
+   {
+
+         // The decompression error comes first: it stops the CRINEX decoding
+      if( pDecompressBuf != NULL && !pDecompressBuf->getError().empty() )
+      {
+         return pDecompressBuf->getError();
+      }
+
+      if( pCRINEXBuf != NULL )
+      {
+         return pCRINEXBuf->getError();
+      }
+
+      return std::string();
+
+   }  // End of method 'FFTextStream::getDecodingError()'
+
+
+}  // End of namespace gpstk
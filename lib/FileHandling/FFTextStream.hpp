@@ -47,6 +47,7 @@
 
 
 #include "FFStream.hpp"
+#include "CompressedStreamBuf.hpp"
 
 namespace gpstk
 {
@@ -62,6 +63,15 @@ namespace gpstk
        * update the line number - the derived class or programmer
        * needs to make sure that the reader or writer increments
        * lineNumber in these cases.
+       *
+       * Files opened for reading only may be compressed with gzip or Unix
+       * 'compress', and RINEX observation files may be in Compact RINEX
+       * (Hatanaka) format: they are recognized by their content and
+       * decoded on the fly, transparently for the readers. In that case
+       * 'tellg()' and 'seekg()' work on the decoded data, and seeks may
+       * only go back up to 64 KB before the current position. Pipes and
+       * FIFOs are read as plain text, as recognizing the format would
+       * consume input that can't be put back.
        */
    class FFTextStream : public FFStream
    {
@@ -69,12 +79,13 @@ namespace gpstk
 
 
          /// Destructor
-      virtual ~FFTextStream() {};
+      virtual ~FFTextStream()
+      { clearDecoding(); };
 
 
          /// Default constructor
       FFTextStream()
-            : lineNumber(0) {};
+            : lineNumber(0), pDecompressBuf(NULL), pCRINEXBuf(NULL) {};
 
 
          /** Common constructor.
@@ -84,8 +95,9 @@ namespace gpstk
           */
       FFTextStream( const char* fn,
                     std::ios::openmode mode=std::ios::in )
-         : FFStream(fn, mode), lineNumber(0)
-      {};
+         : FFStream(fn, mode), lineNumber(0),
+           pDecompressBuf(NULL), pCRINEXBuf(NULL)
+      { setupDecoding(mode); };
 
 
          /** Common constructor.
@@ -95,14 +107,21 @@ namespace gpstk
           */
       FFTextStream( const std::string& fn,
                     std::ios::openmode mode=std::ios::in )
-         : FFStream( fn.c_str(), mode ), lineNumber(0)
-      {};
+         : FFStream( fn.c_str(), mode ), lineNumber(0),
+           pDecompressBuf(NULL), pCRINEXBuf(NULL)
+      { setupDecoding(mode); };
 
 
-         /// Overrides open to reset the line number.
+         /// Overrides open to reset the line number and set up the
+         /// decoding of compressed files.
       virtual void open( const char* fn,
                          std::ios::openmode mode )
-      { FFStream::open(fn, mode); lineNumber = 0; };
+      {
+         clearDecoding();
+         FFStream::open(fn, mode);
+         lineNumber = 0;
+         setupDecoding(mode);
+      };
 
 
          /// Overrides open to reset the line number.
@@ -184,6 +203,31 @@ namespace gpstk
 
       }
 
+
+   private:
+
+
+         /** Installs the stream buffers decoding the file, if it is open
+          *  for reading only and compressed. Files that can't seek, such
+          *  as pipes, are not decoded, so that no input is lost.
+          */
+      void setupDecoding(std::ios::openmode mode);
+
+
+         /// Removes the stream buffers decoding the file.
+      void clearDecoding();
+
+
+         /// Returns the error that stopped decoding the file, if any.
+      std::string getDecodingError() const;
+
+
+         /// Decompression (gzip, compress) of the file, or NULL
+      DecodeStreamBuf* pDecompressBuf;
+
+         /// Compact RINEX decoding of the file, or NULL
+      DecodeStreamBuf* pCRINEXBuf;
+
    }; // End of class 'FFTextStream'
 
 
@@ -223,7 +267,13 @@ namespace gpstk
             // catch EOF when stream exceptions are disabled
          if ((gcount() == 0) && eof())
          {
-            if (expectEOF)
+            std::string decodingError( getDecodingError() );
+            if (!decodingError.empty())
+            {
+               FFStreamError err("Error decoding the file: " + decodingError);
+               GPSTK_THROW(err);
+            }
+            else if (expectEOF)
             {
                EndOfFile err("EOF encountered");
                GPSTK_THROW(err);
@@ -241,7 +291,13 @@ namespace gpstk
             // catch EOF when exceptions are enabled
          if ( (gcount() == 0) && eof())
          {
-            if (expectEOF)
+            std::string decodingError( getDecodingError() );
+            if (!decodingError.empty())
+            {
+               FFStreamError err("Error decoding the file: " + decodingError);
+               GPSTK_THROW(err);
+            }
+            else if (expectEOF)
             {
                EndOfFile err("EOF encountered");
                GPSTK_THROW(err);
@@ -0,0 +1,564 @@
+#pragma ident "$Id: HatanakaStreamBuf.cpp $"
+
+/**
+ * @file HatanakaStreamBuf.cpp
+ * Stream buffer decoding Compact RINEX (Hatanaka) observation files on
+ * the fly.
+ */
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//============================================================================
+
+
+#include <cstdlib>
+#include "HatanakaStreamBuf.hpp"
+
+using namespace std;
+
+namespace gpstk
+{
+
+   namespace
+   {
+
+         // Removes the trailing blanks of a string.
+      void stripBlanks(std::string& s)
+      {
+         std::string::size_type end( s.find_last_not_of(' ') );
+         s.erase( (end == std::string::npos) ? 0 : end + 1 );
+      }
+
+
+         // Applies a CRINEX text difference: a blank keeps the character,
+         // '&' sets a blank, and any other character replaces it.
+      void applyTextDiff(std::string& s, const std::string& diff)
+      {
+         if( diff.size() > s.size() )
+         {
+            s.resize(diff.size(), ' ');
+         }
+
+         for(std::string::size_type i = 0; i < diff.size(); ++i)
+         {
+            char c( diff[i] );
+            if( c == ' ' ) continue;
+            s[i] = (c == '&') ? ' ' : c;
+         }
+      }
+
+
+         // Appends an integer number of units of 10^-decimals, with the
+         // given width, as the Fortran format F(width).(decimals).
+      void appendFixed( std::string& s,
+                        long long v,
+                        int decimals,
+                        int width )
+      {
+         char digits[32];
+         int n(0);
+
+         unsigned long long a( (v < 0) ? -static_cast<unsigned long long>(v)
+                                       : static_cast<unsigned long long>(v) );
+
+         for(int i = 0; i < decimals; ++i)
+         {
+            digits[n++] = '0' + static_cast<char>(a % 10);
+            a /= 10;
+         }
+
+         digits[n++] = '.';
+
+         do
+         {
+            digits[n++] = '0' + static_cast<char>(a % 10);
+            a /= 10;
+         }
+         while( a > 0 );
+
+         if( v < 0 ) digits[n++] = '-';
+
+         if( n < width ) s.append(width - n, ' ');
+
+         while( n > 0 ) s += digits[--n];
+      }
+
+
+         // Parses a signed integer.
+      long long parseInteger(const std::string& s, std::string::size_type pos)
+      {
+         bool negative(false);
+
+         if( pos < s.size() && (s[pos] == '-' || s[pos] == '+') )
+         {
+            negative = (s[pos] == '-');
+            ++pos;
+         }
+
+         if( pos >= s.size() )
+         {
+            Exception e("Invalid number in the CRINEX data: '" + s + "'");
+            GPSTK_THROW(e);
+         }
+
+         long long v(0);
+         for( ; pos < s.size(); ++pos)
+         {
+            if( s[pos] < '0' || s[pos] > '9' )
+            {
+               Exception e("Invalid number in the CRINEX data: '" + s + "'");
+               GPSTK_THROW(e);
+            }
+            v = 10*v + (s[pos] - '0');
+         }
+
+         return negative ? -v : v;
+      }
+
+   }  // End of unnamed namespace
+
+
+
+   HatanakaStreamBuf::HatanakaStreamBuf(std::streambuf* source)
+      : DecodeStreamBuf(source), version(0), headerDone(false), outputPos(0)
+   {}
+
+
+      // Reads the next line of the source, returns false at the end.
+   bool HatanakaStreamBuf::getLine(std::string& line)
+   {
+
+      line.clear();
+
+      bool newLine(false);
+
+      while( true )
+      {
+         int_type c( pSource->sbumpc() );
+
+         if( traits_type::eq_int_type(c, traits_type::eof()) ) break;
+
+         if( c == '\n' )
+         {
+            newLine = true;
+            break;
+         }
+
+         line += traits_type::to_char_type(c);
+      }
+
+      if( !line.empty() && line[line.size() - 1] == '\r' )
+      {
+         line.erase(line.size() - 1);
+      }
+
+      return ( newLine || !line.empty() );
+
+   }  // End of method 'HatanakaStreamBuf::getLine()'
+
+
+      // Appends a line to 'output', without trailing blanks.
+   void HatanakaStreamBuf::putLine(const std::string& line)
+   {
+
+      std::string::size_type end( line.find_last_not_of(' ') );
+
+      if( end != std::string::npos )
+      {
+         output.append(line, 0, end + 1);
+      }
+
+      output += '\n';
+
+   }  // End of method 'HatanakaStreamBuf::putLine()'
+
+
+      // Reads the header and decodes it into 'output'.
+   void HatanakaStreamBuf::readHeader()
+   {
+
+      std::string line;
+
+      if( !getLine(line) || line.find("CRINEX VERS") == std::string::npos )
+      {
+         Exception e("Not a Compact RINEX file");
+         GPSTK_THROW(e);
+      }
+
+      std::string::size_type first( line.find_first_not_of(' ') );
+      char major( (first == std::string::npos) ? ' ' : line[first] );
+
+      if( major == '1' )
+      {
+         version = 1;
+      }
+      else if( major == '3' )
+      {
+         version = 3;
+      }
+      else
+      {
+         Exception e("Unsupported CRINEX version: " + line.substr(0, 20));
+         GPSTK_THROW(e);
+      }
+
+         // CRINEX PROG / DATE
+      if( !getLine(line) )
+      {
+         Exception e("Unexpected end of the CRINEX header");
+         GPSTK_THROW(e);
+      }
+
+         // The RINEX header follows as it is
+      while( getLine(line) )
+      {
+         output += line;
+         output += '\n';
+
+         std::string label( (line.size() > 60) ? line.substr(60) : "" );
+         stripBlanks(label);
+
+         if( label == "# / TYPES OF OBSERV" )
+         {
+            if( line.find_first_not_of(' ') < 6 )
+            {
+               numTypes[' '] = std::atoi( line.substr(0, 6).c_str() );
+            }
+         }
+         else if( label == "SYS / # / OBS TYPES" )
+         {
+               // Continuation lines have no system
+            if( line[0] != ' ' )
+            {
+               numTypes[line[0]] = std::atoi( line.substr(3, 3).c_str() );
+            }
+         }
+         else if( label == "END OF HEADER" )
+         {
+            headerDone = true;
+            return;
+         }
+      }
+
+      Exception e("Unexpected end of the CRINEX header");
+      GPSTK_THROW(e);
+
+   }  // End of method 'HatanakaStreamBuf::readHeader()'
+
+
+      // Updates an arc with a field of the CRINEX file.
+   void HatanakaStreamBuf::updateArc( Arc& arc,
+                                      const std::string& field ) const
+   {
+
+         // "n&value" starts a new arc with differences up to order n
+      if( field.size() > 1 && field[1] == '&' )
+      {
+         if( field[0] < '0' || field[0] > '9' )
+         {
+            Exception e("Invalid arc in the CRINEX data: '" + field + "'");
+            GPSTK_THROW(e);
+         }
+
+         arc.arcOrder = field[0] - '0';
+         arc.order = 0;
+         arc.u[0] = parseInteger(field, 2);
+
+         return;
+      }
+
+      if( arc.order < 0 )
+      {
+         Exception e("CRINEX data without arc initialization");
+         GPSTK_THROW(e);
+      }
+
+      if( arc.order < arc.arcOrder )
+      {
+         ++arc.order;
+      }
+
+         // The field is the difference of the current order; integrate
+      arc.u[arc.order] = parseInteger(field, 0);
+
+      for(int k = arc.order; k > 0; --k)
+      {
+         arc.u[k - 1] += arc.u[k];
+      }
+
+   }  // End of method 'HatanakaStreamBuf::updateArc()'
+
+
+      // Decodes the next epoch into 'output', returns false at the end.
+   bool HatanakaStreamBuf::readEpoch()
+   {
+
+      std::string line;
+
+      if( !getLine(line) ) return false;
+
+         // Epoch line: initialized, or differences to the last one
+      std::string epoch;
+
+      if( !line.empty() && line[0] == ((version == 1) ? '&' : '>') )
+      {
+         epoch = line;
+         if( version == 1 ) epoch[0] = ' ';
+      }
+      else
+      {
+         if( epochLine.empty() )
+         {
+            Exception e("CRINEX epoch line without initialization");
+            GPSTK_THROW(e);
+         }
+
+         epoch = epochLine;
+         applyTextDiff(epoch, line);
+      }
+
+      std::string::size_type flagPos( (version == 1) ? 28 : 31 );
+      std::string::size_type satPos( (version == 1) ? 32 : 41 );
+
+      char flag( (epoch.size() > flagPos) ? epoch[flagPos] : '0' );
+      int numSV( (epoch.size() > flagPos + 1)
+                       ? std::atoi( epoch.substr(flagPos + 1, 3).c_str() ) : 0 );
+
+         // Events: the special records are not compressed
+      if( flag >= '2' && flag <= '5' )
+      {
+         putLine( epoch.substr(0, satPos) );
+
+         for(int i = 0; i < numSV; ++i)
+         {
+            if( !getLine(line) )
+            {
+               Exception e("Unexpected end of the CRINEX data");
+               GPSTK_THROW(e);
+            }
+
+            output += line;
+            output += '\n';
+         }
+
+         return true;
+      }
+
+      epochLine = epoch;
+
+         // Receiver clock offset, the line is empty if there is none
+      if( !getLine(line) )
+      {
+         Exception e("Unexpected end of the CRINEX data");
+         GPSTK_THROW(e);
+      }
+
+      stripBlanks(line);
+
+      bool hasClock( !line.empty() );
+      if( hasClock )
+      {
+         updateArc(clock, line);
+      }
+      else
+      {
+         clock.order = -1;
+      }
+
+      if( epoch.size() < satPos + 3*numSV )
+      {
+         Exception e("Incomplete satellite list in the CRINEX data");
+         GPSTK_THROW(e);
+      }
+
+      std::string out;
+
+      if( version == 1 )
+      {
+            // RINEX 2: 12 satellites per line, clock offset in F12.9
+         out.assign(epoch, 0, satPos);
+         out.append(epoch, satPos, 3*((numSV < 12) ? numSV : 12));
+
+         if( hasClock )
+         {
+            out.resize(68, ' ');
+            appendFixed(out, clock.u[0], 9, 12);
+         }
+
+         putLine(out);
+
+         for(int i = 12; i < numSV; i += 12)
+         {
+            out.assign(satPos, ' ');
+            out.append(epoch, satPos + 3*i, 3*((numSV - i < 12) ? numSV - i : 12));
+            putLine(out);
+         }
+      }
+      else
+      {
+            // RINEX 3: clock offset in F15.12
+         out.assign(epoch, 0, 35);
+         out.resize(35, ' ');
+
+         if( hasClock )
+         {
+            out.append(6, ' ');
+            appendFixed(out, clock.u[0], 12, 15);
+         }
+
+         putLine(out);
+      }
+
+         // Data records, one line per satellite
+      std::map<std::string, SatState> newState;
+
+      for(int i = 0; i < numSV; ++i)
+      {
+         std::string sat( epoch, satPos + 3*i, 3 );
+
+         if( !getLine(line) )
+         {
+            Exception e("Unexpected end of the CRINEX data");
+            GPSTK_THROW(e);
+         }
+
+         std::map<char, int>::const_iterator itType(
+                        numTypes.find( (version == 1) ? ' ' : sat[0] ) );
+         int ntype( (itType == numTypes.end()) ? 0 : itType->second );
+
+            // Continue the arcs of the last epoch, if the satellite was there
+         SatState& state( newState[sat] );
+         std::map<std::string, SatState>::iterator itOld( satState.find(sat) );
+         if( itOld != satState.end() )
+         {
+            state.obs.swap(itOld->second.obs);
+            state.flags.swap(itOld->second.flags);
+         }
+
+         if( state.obs.size() != static_cast<size_t>(ntype) )
+         {
+            state.obs.assign(ntype, Arc());
+            state.flags.assign(2*ntype, ' ');
+         }
+
+            // One field per type, each one followed by a blank, and then
+            // the differences of the flags
+         std::string::size_type pos(0);
+
+         for(int j = 0; j < ntype; ++j)
+         {
+            Arc& arc( state.obs[j] );
+
+            if( pos >= line.size() || line[pos] == ' ' )
+            {
+               arc.order = -1;
+               ++pos;
+               continue;
+            }
+
+            std::string::size_type end( line.find(' ', pos) );
+            if( end == std::string::npos ) end = line.size();
+
+            updateArc( arc, line.substr(pos, end - pos) );
+
+            pos = end + 1;
+         }
+
+         if( pos < line.size() )
+         {
+            applyTextDiff( state.flags, line.substr(pos) );
+            state.flags.resize(2*ntype, ' ');
+         }
+
+         out.clear();
+         if( version != 1 ) out = sat;
+
+         for(int j = 0; j < ntype; ++j)
+         {
+               // RINEX 2: 5 observations per line
+            if( version == 1 && j > 0 && j % 5 == 0 )
+            {
+               putLine(out);
+               out.clear();
+            }
+
+            const Arc& arc( state.obs[j] );
+
+            if( arc.order >= 0 )
+            {
+               appendFixed(out, arc.u[0], 3, 14);
+            }
+            else
+            {
+               out.append(14, ' ');
+            }
+
+            out += state.flags[2*j];
+            out += state.flags[2*j + 1];
+         }
+
+         putLine(out);
+      }
+
+      satState.swap(newState);
+
+      return true;
+
+   }  // End of method 'HatanakaStreamBuf::readEpoch()'
+
+
+      // Decodes up to 'n' characters into 'buf'.
+   std::streamsize HatanakaStreamBuf::decode(char* buf, std::streamsize n)
+   {
+
+      std::streamsize k(0);
+
+      while( k < n )
+      {
+         if( outputPos < output.size() )
+         {
+            std::streamsize m( output.size() - outputPos );
+            if( m > n - k ) m = n - k;
+
+            output.copy(buf + k, m, outputPos);
+            outputPos += m;
+            k += m;
+
+            continue;
+         }
+
+         output.clear();
+         outputPos = 0;
+
+         if( !headerDone )
+         {
+            readHeader();
+         }
+         else if( !readEpoch() )
+         {
+            break;
+         }
+      }
+
+      return k;
+
+   }  // End of method 'HatanakaStreamBuf::decode()'
+
+
+}  // End of namespace gpstk
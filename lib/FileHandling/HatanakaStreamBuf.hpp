@@ -0,0 +1,139 @@
+#pragma ident "$Id: HatanakaStreamBuf.hpp $"
+
+/**
+ * @file HatanakaStreamBuf.hpp
+ * Stream buffer decoding Compact RINEX (Hatanaka) observation files on
+ * the fly.
+ */
+
+#ifndef GPSTK_HATANAKA_STREAM_BUF_HPP
+#define GPSTK_HATANAKA_STREAM_BUF_HPP
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//============================================================================
+
+
+#include <map>
+#include "CompressedStreamBuf.hpp"
+
+
+namespace gpstk
+{
+
+   /** @addtogroup formattedfile */
+   //@{
+
+      /** This class decodes Compact RINEX (CRINEX 1.0 and 3.0, Hatanaka
+       *  2008) observation data into the RINEX 2 or 3 observation file
+       *  it was made from, as the 'crx2rnx' program does.
+       *
+       * The decoded lines have no trailing blanks, which the RINEX readers
+       * accept.
+       */
+   class HatanakaStreamBuf : public DecodeStreamBuf
+   {
+   public:
+
+         /** Common constructor.
+          *
+          * @param source     Stream buffer holding the CRINEX data.
+          */
+      explicit HatanakaStreamBuf(std::streambuf* source);
+
+
+         /// Destructor.
+      virtual ~HatanakaStreamBuf() {};
+
+
+   protected:
+
+         /// Decodes up to 'n' characters into 'buf'.
+      virtual std::streamsize decode(char* buf, std::streamsize n);
+
+
+   private:
+
+         /// Differenced quantity: an observation or a clock offset
+      struct Arc
+      {
+         Arc() : order(-1), arcOrder(0) {};
+
+            /// Current and maximum difference order, -1 if no value
+         int order;
+         int arcOrder;
+
+            /// Value and its differences, in the units of the file
+         long long u[10];
+      };
+
+
+         /// State of one satellite
+      struct SatState
+      {
+         std::vector<Arc> obs;
+         std::string flags;
+      };
+
+
+         /// Reads the next line of the source, returns false at the end.
+      bool getLine(std::string& line);
+
+         /// Reads the header and decodes it into 'output'.
+      void readHeader();
+
+         /// Decodes the next epoch into 'output', returns false at the end.
+      bool readEpoch();
+
+         /// Updates an arc with a field of the CRINEX file.
+      void updateArc(Arc& arc, const std::string& field) const;
+
+         /// Appends a line to 'output', without trailing blanks.
+      void putLine(const std::string& line);
+
+
+         /// CRINEX version (1 or 3)
+      int version;
+
+         /// Header read
+      bool headerDone;
+
+         /// Number of observation types per system (' ' for RINEX 2)
+      std::map<char, int> numTypes;
+
+         /// Last epoch line, to apply the differences to
+      std::string epochLine;
+
+         /// Receiver clock offset
+      Arc clock;
+
+         /// State of the satellites of the last epoch
+      std::map<std::string, SatState> satState;
+
+         /// Decoded text not yet returned
+      std::string output;
+      size_t outputPos;
+
+   }; // End of class 'HatanakaStreamBuf'
+
+   //@}
+
+}  // End of namespace gpstk
+
+#endif   // GPSTK_HATANAKA_STREAM_BUF_HPP
@@ -84,6 +84,90 @@ namespace gpstk
       }
    } // end of MSCStore::getXvt()
 
+   //--------------------------------------------------------------------------
+   //--------------------------------------------------------------------------
+
+   unsigned int MSCStore::getXvts(const vector<string>& stationIDs,
+                                  const CommonTime& t,
+                                  vector<Xvt>& xvts,
+                                  vector<bool>& valid) const
+   {
+      unsigned int numValid(0);
+      xvts.assign(stationIDs.size(), Xvt());
+      valid.assign(stationIDs.size(), false);
+
+         // MSCData::getXvt() takes a YDSTime, convert it only once
+      YDSTime yt;
+      try
+      {
+         yt = YDSTime(t);
+      }
+      catch(Exception&)
+      {
+         return 0;
+      }
+
+      for (size_t i = 0; i < stationIDs.size(); i++)
+      {
+         try
+         {
+            xvts[i] = findMSC( stationIDs[i], t ).getXvt(yt);
+            valid[i] = true;
+            numValid++;
+         }
+         catch(InvalidRequest&)
+         {
+         }
+      }
+
+      return numValid;
+   } // end of MSCStore::getXvts()
+
+   //--------------------------------------------------------------------------
+   //--------------------------------------------------------------------------
+
+   unsigned int MSCStore::getXvts(const string& stationID,
+                                  const vector<CommonTime>& times,
+                                  vector<Xvt>& xvts,
+                                  vector<bool>& valid) const
+   {
+      unsigned int numValid(0);
+      xvts.assign(times.size(), Xvt());
+      valid.assign(times.size(), false);
+
+      if (times.empty())
+      {
+         return 0;
+      }
+
+         // The station is looked up once: findMSC() returns the same
+         // entry whatever the time.
+      const MSCData* msc(NULL);
+      try
+      {
+         msc = &findMSC( stationID, times[0] );
+      }
+      catch(InvalidRequest&)
+      {
+         return 0;
+      }
+
+      for (size_t i = 0; i < times.size(); i++)
+      {
+         try
+         {
+            xvts[i] = msc->getXvt(times[i]);
+            valid[i] = true;
+            numValid++;
+         }
+         catch(Exception&)
+         {
+         }
+      }
+
+      return numValid;
+   } // end of MSCStore::getXvts()
+
    //--------------------------------------------------------------------------
    //--------------------------------------------------------------------------
    void MSCStore::dump(ostream& s, short detail) const
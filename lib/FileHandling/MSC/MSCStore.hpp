@@ -100,6 +100,32 @@ namespace gpstk
       Xvt getXvt(unsigned long& stationIDno, const CommonTime& t)
          const throw( gpstk::InvalidRequest );
 
+      /// Returns the Xvts of several stations at the same time, as getXvt()
+      /// does for each of them; the time is converted once for all of them.
+      /// @param[in] stationIDs id strings
+      /// @param[in] t the time to look up
+      /// @param[out] xvts the Xvts of the stations
+      /// @param[out] valid valid[i] is false if getXvt() would throw for
+      ///    stationIDs[i]
+      /// @return the number of valid Xvts
+      virtual unsigned int getXvts(const std::vector<std::string>& stationIDs,
+                                   const CommonTime& t,
+                                   std::vector<Xvt>& xvts,
+                                   std::vector<bool>& valid) const;
+
+      /// Returns the Xvts of one station at several times, as getXvt()
+      /// does for each of them; the station is looked up once.
+      /// @param[in] stationID id string
+      /// @param[in] times the times to look up
+      /// @param[out] xvts the Xvts of the station
+      /// @param[out] valid valid[i] is false if getXvt() would throw for
+      ///    times[i]
+      /// @return the number of valid Xvts
+      virtual unsigned int getXvts(const std::string& stationID,
+                                   const std::vector<CommonTime>& times,
+                                   std::vector<Xvt>& xvts,
+                                   std::vector<bool>& valid) const;
+
 
       /// A debugging function that outputs in human readable form,
       /// all data stored in this object.
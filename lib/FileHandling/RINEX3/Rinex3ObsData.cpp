@@ -38,6 +38,7 @@
 //=============================================================================
 
 #include <algorithm>
+#include <cstdlib>
 #include "StringUtils.hpp"
 #include "CivilTime.hpp"
 #include "TimeString.hpp"
@@ -51,6 +52,124 @@ using namespace gpstk::StringUtils;
 namespace gpstk
 {
 
+   namespace
+   {
+
+         // Powers of ten up to the number of decimals of a 14-character field
+      const double powersOfTen[15] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6,
+                                       1e7, 1e8, 1e9, 1e10, 1e11, 1e12,
+                                       1e13, 1e14 };
+
+
+         /* Returns the value of a fixed-width field of 'len' characters
+          * (at most 31), the same as 'asDouble(line.substr(pos, len))'.
+          *
+          * Plain decimal numbers as written in RINEX observation files are
+          * converted directly: their digits (14 at most) form an integer
+          * that is exactly represented by a double, so dividing it by the
+          * power of ten of the decimals is correctly rounded, as strtod()
+          * is. Anything else is handed to strtod().
+          */
+      double fixedAsDouble(const char* field, size_t len)
+      {
+         size_t i(0);
+         while(i < len && field[i] == ' ') ++i;
+
+         if(i == len) return 0.0;
+
+         bool negative(false);
+         if(field[i] == '-' || field[i] == '+')
+         {
+            negative = (field[i] == '-');
+            ++i;
+         }
+
+         double mantissa(0.0);
+         int digits(0), decimals(-1);
+
+         for( ; i < len; ++i)
+         {
+            char c(field[i]);
+
+            if(c >= '0' && c <= '9')
+            {
+               mantissa = mantissa*10.0 + (c - '0');
+               ++digits;
+               if(decimals >= 0) ++decimals;
+            }
+            else if(c == '.' && decimals < 0)
+            {
+               decimals = 0;
+            }
+            else
+            {
+               break;
+            }
+         }
+
+         while(i < len && field[i] == ' ') ++i;
+
+         if(i == len && digits > 0 && digits <= 14)
+         {
+            if(decimals > 0) mantissa /= powersOfTen[decimals];
+            return (negative ? -mantissa : mantissa);
+         }
+
+            // Exponents, embedded blanks, ...
+         char buffer[32];
+         if(len > 31) len = 31;
+         std::copy(field, field + len, buffer);
+         buffer[len] = '\0';
+
+         return strtod(buffer, 0);
+
+      }  // End of function 'fixedAsDouble()'
+
+
+         // Returns the value of a one-character field, the same as
+         // 'asInt(line.substr(pos, 1))'.
+      inline short charAsInt(char c)
+      { return ( (c >= '0' && c <= '9') ? short(c - '0') : short(0) ); }
+
+
+         /* Returns the satellite of a 3-character field, the same as
+          * 'RinexSatID(line.substr(pos, 3))' but without the string
+          * stream for the usual forms ("G05", "G 5").
+          */
+      RinexSatID fixedAsSatID(const std::string& line, size_t pos)
+      {
+         if(line.size() >= pos + 3)
+         {
+            char c(line[pos]), d1(line[pos+1]), d2(line[pos+2]);
+
+            SatID::SatelliteSystem system(SatID::systemUnknown);
+            switch(c)
+            {
+               case 'G': case 'g': system = SatID::systemGPS;     break;
+               case 'R': case 'r': system = SatID::systemGLONASS; break;
+               case 'E': case 'e': system = SatID::systemGalileo; break;
+               case 'S': case 's': system = SatID::systemSBAS;    break;
+               case 'J': case 'j': system = SatID::systemQZSS;    break;
+               case 'C': case 'c': system = SatID::systemBDS;     break;
+               case 'I': case 'i': system = SatID::systemIRNSS;   break;
+               default: break;
+            }
+
+            if( system != SatID::systemUnknown &&
+                (d1 == ' ' || (d1 >= '0' && d1 <= '9')) &&
+                (d2 >= '0' && d2 <= '9') )
+            {
+               int id( (d1 == ' ' ? 0 : 10*(d1 - '0')) + (d2 - '0') );
+               return RinexSatID( (id > 0 ? id : -1), system );
+            }
+         }
+
+         return RinexSatID(line.substr(pos, 3));
+
+      }  // End of function 'fixedAsSatID()'
+
+   }  // End of unnamed namespace
+
 
    void reallyPutRecordVer2( Rinex3ObsStream& strm,
                              const Rinex3ObsData& rod )
@@ -354,8 +473,6 @@ namespace gpstk
    void reallyGetRecordVer2(Rinex3ObsStream& strm, Rinex3ObsData& rod)
       throw(Exception)
    {
-      static CommonTime previousTime(CommonTime::BEGINNING_OF_TIME);
-
       // get the epoch line and check
       string line;
       while(line.empty())        // ignore blank lines in place of epoch lines
@@ -386,7 +503,7 @@ namespace gpstk
          GPSTK_THROW(e);
       }
       else if(noEpochTime)
-         rod.time = previousTime;
+         rod.time = strm.previousTime;
       else {
          try {
             // check if the spaces are in the right place - an easy
@@ -440,7 +557,7 @@ namespace gpstk
          // end rod.time = parseTime(line, strm.header);
 
          // save for next call
-         previousTime = rod.time;
+         strm.previousTime = rod.time;
       }
 
       // number of satellites
@@ -471,7 +588,7 @@ namespace gpstk
 
             // read the sat id
             try {
-               sat = RinexSatID(line.substr(30+isv*3-1, 3));
+               sat = fixedAsSatID(line, 30+isv*3-1);
                satIndex[ndx] = sat;
                //// if this system does not have obs types assigned, do so
                //string satsys = asString(sat.systemChar());
@@ -487,13 +604,29 @@ namespace gpstk
 
          // loop over all sats, reading obs data
          int numObs(strm.header.R2ObsTypes.size());// number of R2 OTs in header
+
+         // which R2 OTs map into a valid R3 ObsID, per system
+         map<char, vector<bool> > validObs;
+
          rod.obs.clear();
          for(isv=0; isv < rod.numSVs; isv++) {
             //strm.formattedGetLine(line);           // get a line
             //line.resize(80, ' ');                  // pad just in case
             sat = satIndex[isv];                   // sat for this data
-            satsys = asString(sat.systemChar());   // system for this sat
-            vector<RinexDatum> data;
+
+            vector<bool>& valid(validObs[sat.systemChar()]);
+            if(valid.empty() && numObs > 0) {
+               satsys = asString(sat.systemChar());   // system for this sat
+               valid.resize(numObs);
+               for(ndx=0; ndx < numObs; ndx++) {
+                  string R2ot(strm.header.R2ObsTypes[ndx]);
+                  string R3ot(strm.header.mapSysR2toR3ObsID[satsys][R2ot].asString());
+                  valid[ndx] = (R3ot != string("   "));
+               }
+            }
+
+            vector<RinexDatum>& data(rod.obs[sat]);
+            data.clear();
             // loop over data in the line
             for(ndx=0, line_ndx=0; ndx < numObs; ndx++, line_ndx++) {
                if(! (line_ndx % 5)) {              // get a new line
@@ -507,17 +640,15 @@ namespace gpstk
                }
 
                // does this R2 OT map into a valid R3 ObsID?
-               string R2ot(strm.header.R2ObsTypes[ndx]);
-               string R3ot(strm.header.mapSysR2toR3ObsID[satsys][R2ot].asString());
-               if(R3ot != string("   ")) {
+               if(valid[ndx]) {
+                  const char* field(line.data() + line_ndx*16);
                   RinexDatum tempData;
-                  tempData.data = asDouble(line.substr(line_ndx*16,   14));
-                  tempData.lli =     asInt(line.substr(line_ndx*16+14, 1));
-                  tempData.ssi =     asInt(line.substr(line_ndx*16+15, 1));
+                  tempData.data = fixedAsDouble(field, 14);
+                  tempData.lli = charAsInt(field[14]);
+                  tempData.ssi = charAsInt(field[15]);
                   data.push_back(tempData);
                }
             }
-            rod.obs[sat] = data;
 
          }  // end loop over sats to read obs data
       }
@@ -597,7 +728,7 @@ namespace gpstk
 
             // get the SV ID
             try {
-               satIndex[isv] = RinexSatID(line.substr(0,3));
+               satIndex[isv] = fixedAsSatID(line, 0);
             }
             catch (Exception& e) {
                FFStreamError ffse(e);
@@ -605,7 +736,7 @@ namespace gpstk
             }
 
             // get the # data items (# entries in ObsType map of maps from header)
-            string gnss = asString(satIndex[isv].systemChar());
+            string gnss(1, satIndex[isv].systemChar());
             int size = strm.header.mapObsTypes[gnss].size();
 
             // Some receivers leave blanks for missing Obs (which is OK by RINEX 3).
@@ -616,19 +747,16 @@ namespace gpstk
             if(line.size() < minSize)
                line += string(minSize-line.size(), ' ');
 
-            // get the data (# entries in ObsType map of maps from header)
-            vector<RinexDatum> data;
+            // get the data (# entries in ObsType map of maps from header),
+            // reading the fields in place
+            vector<RinexDatum>& data(obs[satIndex[isv]]);
+            data.assign(size, RinexDatum());
             for(int i = 0; i < size; i++) {
-               size_t pos = 3 + 16*i;
-               RinexDatum tempData;
-               tempData.data = asDouble(line.substr(pos   , 14));
-               if( line.size() > pos+14 )
-                  tempData.lli  = asInt( line.substr(pos+14,  1));
-               if( line.size() > pos+15 )
-                  tempData.ssi  = asInt( line.substr(pos+15,  1));
-               data.push_back(tempData);
+               const char* field(line.data() + 3 + 16*i);
+               data[i].data = fixedAsDouble(field, 14);
+               data[i].lli  = charAsInt(field[14]);
+               data[i].ssi  = charAsInt(field[15]);
             }
-            obs[satIndex[isv]] = data;
          }
       }
 
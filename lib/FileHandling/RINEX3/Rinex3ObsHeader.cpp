@@ -1713,6 +1713,7 @@ namespace gpstk
       // If we get here, we should have reached the end of header line.
       strm.header = *this;
       strm.headerRead = true;
+      strm.setHeaderCache(NULL);
 
       // determine the time system of epochs in this file; cf. R3.02 Table A2
       // 1.determine time system from time tag in TIME OF FIRST OBS record
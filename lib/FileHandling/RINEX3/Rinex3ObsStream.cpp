@@ -45,6 +45,7 @@ namespace gpstk
 {
    Rinex3ObsStream ::
    Rinex3ObsStream()
+         : pHeaderCache(NULL)
    {
       init();
    }
@@ -53,7 +54,7 @@ namespace gpstk
    Rinex3ObsStream ::
    Rinex3ObsStream( const char* fn,
                     std::ios::openmode mode )
-         : FFTextStream(fn, mode)
+         : FFTextStream(fn, mode), pHeaderCache(NULL)
    {
       init();
    }
@@ -62,7 +63,7 @@ namespace gpstk
    Rinex3ObsStream ::
    Rinex3ObsStream( const std::string fn,
                     std::ios::openmode mode )
-         : FFTextStream(fn.c_str(), mode)
+         : FFTextStream(fn.c_str(), mode), pHeaderCache(NULL)
    {
       init();
    }
@@ -71,6 +72,7 @@ namespace gpstk
    Rinex3ObsStream ::
    ~Rinex3ObsStream()
    {
+      delete pHeaderCache;
    }
 
 
@@ -88,6 +90,8 @@ namespace gpstk
       headerRead = false;
       header = Rinex3ObsHeader();
       timesystem = TimeSystem::GPS;
+      previousTime = CommonTime::BEGINNING_OF_TIME;
+      setHeaderCache(NULL);
    }
 
 
@@ -99,6 +103,17 @@ namespace gpstk
    }
 
 
+   void Rinex3ObsStream ::
+   setHeaderCache(HeaderCache* cache)
+   {
+      if(cache != pHeaderCache)
+      {
+         delete pHeaderCache;
+         pHeaderCache = cache;
+      }
+   }
+
+
    bool Rinex3ObsStream ::
    isRinex3ObsStream(std::istream& i)
    {
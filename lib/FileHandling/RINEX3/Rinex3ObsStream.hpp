@@ -110,12 +110,42 @@ namespace gpstk
          /// Time system for epochs in this file
       TimeSystem timesystem;
 
+         /// Time of the last epoch read from a RINEX 2 file, used by the
+         /// records without time (epoch flags 2-4)
+      CommonTime previousTime;
+
          /// Check if the input stream is the kind of Rinex3ObsStream
       static bool isRinex3ObsStream(std::istream& i);
 
+
+         /** Base class of the objects derived from the header that are
+          *  kept with the stream, e.g. how the observation types of the
+          *  header are converted. The stream owns the object, and deletes
+          *  it when a new header is read.
+          */
+      class HeaderCache
+      {
+      public:
+         virtual ~HeaderCache() {}
+      };
+
+
+         /// Returns the object derived from the current header, or NULL.
+      HeaderCache* getHeaderCache() const
+      { return pHeaderCache; }
+
+
+         /// Sets the object derived from the current header, deleting the
+         /// previous one. The stream takes ownership of it.
+      void setHeaderCache(HeaderCache* cache);
+
    private:
          /// Initialize internal data structures.
       void init();
+
+
+         /// Object derived from the current header
+      HeaderCache* pHeaderCache;
    }; // class 'Rinex3ObsStream'
 
       //@}
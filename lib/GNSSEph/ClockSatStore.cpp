@@ -41,6 +41,15 @@ namespace gpstk
       try {
          checkTimeSystem(ttag.getTimeSystem());
 
+         // usual case first: the interval straight from the uniform tables
+         UniformSatTable::Interval in;
+         if(findUniformInterval(sat, ttag, in)) {
+            double c[UniformSatTable::maxPoints], d[UniformSatTable::maxPoints];
+            if(interpType == 2)
+               UniformSatTable::lagrangeCoefficients(lagrangeWeights, in.x, in.step, c, d);
+            return getUniformValue(in, c, d);
+         }
+
          bool isExact;
          ClockRecord rec;
          DataTableIterator it1, it2, kt;        // cf. TabularSatStore.hpp
@@ -324,6 +333,7 @@ namespace gpstk
    {
       try {
          checkTimeSystem(ttag.getTimeSystem());
+         uniformTable.invalidate();
 
          if(rec.drift != 0.0) haveClockDrift = true;
          if(rec.accel != 0.0) haveClockAccel = true;
@@ -356,6 +366,7 @@ namespace gpstk
    {
       try {
          checkTimeSystem(ttag.getTimeSystem());
+         uniformTable.invalidate();
 
          if(tables.find(sat) != tables.end() &&
             tables[sat].find(ttag) != tables[sat].end()) {
@@ -384,6 +395,7 @@ namespace gpstk
    {
       try {
          checkTimeSystem(ttag.getTimeSystem());
+         uniformTable.invalidate();
 
          haveClockDrift = true;
 
@@ -414,6 +426,7 @@ namespace gpstk
    {
       try {
          checkTimeSystem(ttag.getTimeSystem());
+         uniformTable.invalidate();
 
          haveClockAccel = true;
 
@@ -437,4 +450,190 @@ namespace gpstk
       catch(InvalidRequest& ir) { GPSTK_RETHROW(ir); }
    }
 
+   // Columns of the rows of the uniform tables
+   enum UniformColumns { colBias=0, colDrift, colAccel,
+                         colSigBias, colSigDrift, colSigAccel, numUniformColumns };
+
+   // Copy the data tables to contiguous tables on uniform time grids
+   void ClockSatStore::buildUniformTables() throw()
+   {
+      uniformTable.reset(numUniformColumns);
+
+      vector<CommonTime> epochs;
+      vector<double> rows;
+
+      SatTable::const_iterator it;
+      for(it=tables.begin(); it!=tables.end(); ++it) {
+         epochs.clear();
+         rows.clear();
+
+         DataTableIterator jt;
+         for(jt=it->second.begin(); jt!=it->second.end(); ++jt) {
+            const ClockRecord& rec(jt->second);
+            epochs.push_back(jt->first);
+            rows.push_back(rec.bias);
+            rows.push_back(rec.drift);
+            rows.push_back(rec.accel);
+            rows.push_back(rec.sig_bias);
+            rows.push_back(rec.sig_drift);
+            rows.push_back(rec.sig_accel);
+         }
+
+         uniformTable.addSatellite(it->first, epochs, rows);
+      }
+   }
+
+   // Return values for several satellites at one time, or for one satellite
+   // at several times, as getValue() does for each of them.
+   unsigned int ClockSatStore::getValues(const vector<SatID>& sats,
+                                         const vector<CommonTime>& ttags,
+                                         vector<ClockRecord>& recs,
+                                         vector<bool>& valid)
+      const throw(InvalidRequest)
+   {
+      size_t i,n(sats.size() > ttags.size() ? sats.size() : ttags.size());
+      if((sats.size() != n && sats.size() != 1) ||
+         (ttags.size() != n && ttags.size() != 1))
+         GPSTK_THROW(InvalidRequest("Sizes of satellites and times do not match"));
+      if(sats.empty() || ttags.empty()) n = 0;
+
+      recs.assign(n, ClockRecord());
+      valid.assign(n, false);
+
+      // coefficients of the last interval; the intervals of the other
+      // satellites at the same time usually start at the same epoch
+      double c[UniformSatTable::maxPoints], d[UniformSatTable::maxPoints];
+      double x(0.0), step(0.0);
+
+      unsigned int numValid(0);
+      for(i=0; i<n; i++) {
+         const SatID& sat(sats[sats.size() == 1 ? 0 : i]);
+         const CommonTime& ttag(ttags[ttags.size() == 1 ? 0 : i]);
+         try {
+            checkTimeSystem(ttag.getTimeSystem());
+
+            UniformSatTable::Interval in;
+            if(findUniformInterval(sat, ttag, in)) {
+               if(interpType == 2 &&
+                  (step == 0.0 || in.x != x || in.step != step)) {
+                  UniformSatTable::lagrangeCoefficients(lagrangeWeights,
+                                                        in.x, in.step, c, d);
+                  x = in.x;
+                  step = in.step;
+               }
+               recs[i] = getUniformValue(in, c, d);
+            }
+            else if(isPresent(sat))
+               recs[i] = getValue(sat, ttag);
+            else {
+               recs[i] = ClockRecord();         // getValue() would throw
+               continue;
+            }
+
+            valid[i] = true;
+            numValid++;
+         }
+         catch(InvalidRequest&) { }
+      }
+
+      return numValid;
+   }
+
+   // Find the interval of a time in the uniform tables, if getValue() may use
+   // it: the time must be well inside the table, and the interval must pass
+   // the gap and interval checks unless the value is returned as is.
+   bool ClockSatStore::findUniformInterval(const SatID& sat,
+                                           const CommonTime& ttag,
+                                           UniformSatTable::Interval& in)
+      const throw(InvalidRequest)
+   {
+      return ((interpType != 2 || Nhalf > 1) &&
+              uniformTable.findInterval(sat, ttag, Nhalf, in) &&
+              ((in.exact && haveClockDrift) || acceptInterval(in.step, in.span, in.x)));
+   }
+
+   // Interpolate an interval of the uniform tables; this follows getValue(),
+   // with the times of the interval at multiples of the step.
+   ClockRecord ClockSatStore::getUniformValue(const UniformSatTable::Interval& in,
+                                              const double* c, const double* d)
+      const throw()
+   {
+      unsigned int Nlow(Nhalf-1),Nhi(Nhalf),Nmatch(Nhalf);
+      ClockRecord rec;
+
+      if(in.exact && haveClockDrift) {
+         rec.bias = in.at(Nmatch, colBias);
+         rec.drift = in.at(Nmatch, colDrift);
+         rec.accel = in.at(Nmatch, colAccel);
+         rec.sig_bias = in.at(Nmatch, colSigBias);
+         rec.sig_drift = in.at(Nmatch, colSigDrift);
+         rec.sig_accel = in.at(Nmatch, colSigAccel);
+         return rec;
+      }
+
+      bool lagrange(interpType == 2);
+
+      // the times of rows Nlow and Nhi, and the time between them
+      double dt(in.x), tlow(Nlow*in.step), step(in.step), slope;
+
+      // sigma of the bias
+      double sigBias(in.exact ? in.at(Nmatch, colSigBias)
+                              : RSS(in.at(Nhi, colSigBias), in.at(Nlow, colSigBias)));
+
+      rec.accel = rec.sig_accel = 0.0;              // defaults
+      if(haveClockDrift) {
+         if(lagrange) {
+            rec.bias = in.combine(c, colBias);                              // sec
+            rec.drift = in.combine(c, colDrift);                            // sec/sec
+         }
+         else {
+            slope = (in.at(Nhi, colBias)-in.at(Nlow, colBias)) / step;     // sec/sec
+            rec.bias = in.at(Nlow, colBias) + slope*(dt-tlow);              // sec
+            slope = (in.at(Nhi, colDrift)-in.at(Nlow, colDrift)) / step;
+            rec.drift = in.at(Nlow, colDrift) + slope*(dt-tlow);            // sec/sec
+         }
+
+         rec.sig_bias = sigBias;
+         rec.sig_drift = RSS(in.at(Nhi, colSigDrift), in.at(Nlow, colSigDrift));
+      }
+      else {                              // must interpolate biases to get drift
+         if(lagrange) {
+            rec.bias = in.combine(c, colBias);
+            rec.drift = in.combine(d, colBias);
+         }
+         else {
+            rec.drift = (in.at(Nhi, colBias)-in.at(Nlow, colBias)) / step;
+            rec.bias = in.at(Nlow, colBias) + (dt-tlow)*rec.drift;
+         }
+
+         rec.sig_bias = sigBias;
+         rec.sig_drift = rec.sig_bias/step;
+      }
+
+      if(haveClockAccel) {
+         if(lagrange) {
+            rec.accel = in.combine(c, colAccel);                            // sec/sec^2
+         }
+         else {
+            slope = (in.at(Nhi, colDrift)-in.at(Nlow, colDrift)) / step;   // sec/sec^2
+            rec.accel = in.at(Nlow, colAccel) + slope*(dt-tlow);            // sec/sec^2
+         }
+
+         if(in.exact)
+            rec.sig_accel = in.at(Nmatch, colSigAccel);
+         else
+            rec.sig_accel = RSS(in.at(Nhi, colSigAccel), in.at(Nlow, colSigAccel));
+      }
+      else if(haveClockDrift) {              // must interpolate drift to get accel
+         if(lagrange)
+            rec.accel = in.combine(d, colDrift);
+         else
+            rec.accel = (in.at(Nhi, colDrift)-in.at(Nlow, colDrift)) / step;
+
+         rec.sig_accel = rec.sig_drift/step;
+      }
+
+      return rec;
+   }
+
 }  // End of namespace gpstk
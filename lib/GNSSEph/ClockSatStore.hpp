@@ -14,6 +14,7 @@
 #include "SatID.hpp"
 #include "CommonTime.hpp"
 #include "TabularSatStore.hpp"
+#include "UniformSatTable.hpp"
 #include "FileStore.hpp"
 
 namespace gpstk
@@ -74,6 +75,12 @@ namespace gpstk
       /// Flag to reject bad clock data; default true
       bool rejectBadClockFlag;
 
+      /// Copy of the data tables on uniform time grids, see buildUniformTables()
+      UniformSatTable uniformTable;
+
+      /// Weights of Lagrange interpolation on interpOrder equally spaced points
+      std::vector<double> lagrangeWeights;
+
    // member functions
    public:
 
@@ -85,6 +92,7 @@ namespace gpstk
       {
          // NB. if interpType = 1, interpOrder = 2 (linear)
          interpOrder = 2*Nhalf;
+         UniformSatTable::lagrangeWeights(interpOrder, lagrangeWeights);
          haveClockBias = true;
          haveClockDrift = havePosition = haveVelocity = false;
       }
@@ -107,6 +115,24 @@ namespace gpstk
       virtual ClockRecord getValue(const SatID& sat, const CommonTime& ttag)
          const throw(InvalidRequest);
 
+      /// Return values for several satellites at one time, or for one
+      /// satellite at several times, as getValue() does for each of them.
+      /// Intervals found in the uniform tables at the same place on the grid
+      /// share the coefficients of the interpolation.
+      /// @param[in] sats the satellites of interest
+      /// @param[in] ttags the times of interest; either sats or ttags may
+      ///   have a single element, used with every element of the other;
+      ///   otherwise they must have the same size
+      /// @param[out] recs the values, one per satellite or time
+      /// @param[out] valid valid[i] is false if getValue() would throw
+      /// @return the number of valid values
+      /// @throw InvalidRequest if the sizes of sats and ttags do not match
+      unsigned int getValues(const std::vector<SatID>& sats,
+                             const std::vector<CommonTime>& ttags,
+                             std::vector<ClockRecord>& recs,
+                             std::vector<bool>& valid)
+         const throw(InvalidRequest);
+
       /// Return the clock bias for the given satellite at the given time
       /// @param[in] sat the SatID of the satellite of interest
       /// @param[in] ttag the time (CommonTime) of interest
@@ -185,8 +211,20 @@ namespace gpstk
          if(interpType == 2) Nhalf = (order+1)/2;
          else                Nhalf = 1;
          interpOrder = 2*Nhalf;
+         UniformSatTable::lagrangeWeights(interpOrder, lagrangeWeights);
       }
 
+      /// Copy the data tables to contiguous tables on uniform time grids
+      /// (see UniformSatTable), which getValue() then uses to find the
+      /// interpolation interval in constant time. Call this once the data
+      /// are loaded; adding or editing data drops the uniform tables, and
+      /// getValue() falls back to the std::map tables until it is called again.
+      void buildUniformTables() throw();
+
+      /// Drop the uniform tables when the data tables are modified.
+      virtual void tablesModified() throw()
+         { uniformTable.invalidate(); }
+
       /// Set the flag; if true then bad position values are rejected when
       /// adding data to the store.
       void rejectBadClocks(const bool flag)
@@ -200,6 +238,21 @@ namespace gpstk
       void setLinearInterp(void) throw()
          { interpType = 1; setInterpolationOrder(2); }
 
+   private:
+
+      /// Find the interval of a time in the uniform tables, if getValue()
+      /// may use it
+      bool findUniformInterval(const SatID& sat, const CommonTime& ttag,
+                               UniformSatTable::Interval& in)
+         const throw(InvalidRequest);
+
+      /// Interpolate an interval of the uniform tables, as getValue() does,
+      /// given the coefficients of the interval from lagrangeCoefficients()
+      /// (not used by linear interpolation)
+      ClockRecord getUniformValue(const UniformSatTable::Interval& in,
+                                  const double* c, const double* d)
+         const throw();
+
    }; // end class ClockSatStore
 
       //@}
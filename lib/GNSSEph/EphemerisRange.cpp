@@ -116,6 +116,33 @@ namespace gpstk
                         const XvtStore<SatID>& Eph)
       throw(InvalidRequest, Exception)
    {
+      return computeAtTransmitTime(tr_nom, pr, Rx, NULL, sat, Eph);
+   }
+
+
+      // Compute the corrected range at TRANSMIT time, as above, from the
+      // receiver of the topocentric frame Rx.
+   double CorrectedEphemerisRange::ComputeAtTransmitTime(
+                        const CommonTime& tr_nom,
+                        const double& pr,
+                        const StationFrame& Rx,
+                        const SatID sat,
+                        const XvtStore<SatID>& Eph)
+      throw(InvalidRequest, Exception)
+   {
+      return computeAtTransmitTime(tr_nom, pr, Rx.getPosition(), &Rx, sat, Eph);
+   }
+
+
+   double CorrectedEphemerisRange::computeAtTransmitTime(
+                        const CommonTime& tr_nom,
+                        const double& pr,
+                        const Position& Rx,
+                        const StationFrame* frame,
+                        const SatID sat,
+                        const XvtStore<SatID>& Eph)
+      throw(InvalidRequest, Exception)
+   {
 
       try {
          CommonTime tt;
@@ -148,7 +175,7 @@ namespace gpstk
                         svPosVel.x[1]-Rx.Y(),
                         svPosVel.x[2]-Rx.Z());
 
-         updateCER(Rx);
+         updateCER(Rx, frame);
 
          return (rawrange-svclkbias-relativity);
       }
@@ -158,7 +185,7 @@ namespace gpstk
       catch(gpstk::Exception& e) {
          GPSTK_RETHROW(e);
       }
-   }  // end CorrectedEphemerisRange::ComputeAtTransmitTime
+   }  // end CorrectedEphemerisRange::computeAtTransmitTime
 
 
    double CorrectedEphemerisRange::ComputeAtTransmitTime(
@@ -224,7 +251,8 @@ namespace gpstk
    }
 
 
-   void CorrectedEphemerisRange::updateCER(const Position& Rx)
+   void CorrectedEphemerisRange::updateCER(const Position& Rx,
+                                           const StationFrame* frame)
    {
       relativity = svPosVel.computeRelativityCorrection() * C_MPS;
 
@@ -238,8 +266,13 @@ namespace gpstk
       Position SV(svPosVel);
       elevation = Rx.elevation(SV);
       azimuth = Rx.azimuth(SV);
-      elevationGeodetic = Rx.elevationGeodetic(SV);
-      azimuthGeodetic = Rx.azimuthGeodetic(SV);
+      if(frame != NULL) {
+         frame->elevAzimGeodetic(SV, elevationGeodetic, azimuthGeodetic);
+      }
+      else {
+         elevationGeodetic = Rx.elevationGeodetic(SV);
+         azimuthGeodetic = Rx.azimuthGeodetic(SV);
+      }
    }
 
 
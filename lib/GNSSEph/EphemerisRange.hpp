@@ -46,6 +46,7 @@
 #include "CommonTime.hpp"
 #include "SatID.hpp"
 #include "Position.hpp"
+#include "StationFrame.hpp"
 #include "XvtStore.hpp"
 #include "MiscMath.hpp"
 
@@ -88,6 +89,18 @@ namespace gpstk
          const XvtStore<SatID>& Eph)
       throw(InvalidRequest, Exception);
 
+      /// Compute the corrected range at TRANSMIT time, as above, from the
+      /// receiver of the topocentric frame Rx. The geodetic elevation and
+      /// azimuth come from the frame, without the geodetic conversion of the
+      /// receiver position for each satellite.
+      double ComputeAtTransmitTime(
+         const CommonTime& tr_nom,
+         const double& pr,
+         const StationFrame& Rx,
+         const SatID sat,
+         const XvtStore<SatID>& Eph)
+      throw(InvalidRequest, Exception);
+
       /// Compute the corrected range at TRANSMIT time, from receiver at
       /// position Rx, to the GPS satellite given by SatID sat, as well as all
       /// the CER quantities, given the nominal receive time tr_nom and
@@ -140,7 +153,14 @@ namespace gpstk
 
    private:
       // These are just helper functions to keep from repeating code
-      void updateCER(const Position& Rx);
+      double computeAtTransmitTime(const CommonTime& tr_nom,
+                                   const double& pr,
+                                   const Position& Rx,
+                                   const StationFrame* frame,
+                                   const SatID sat,
+                                   const XvtStore<SatID>& Eph)
+         throw(InvalidRequest, Exception);
+      void updateCER(const Position& Rx, const StationFrame* frame = NULL);
       void rotateEarth(const Position& Rx);
 
    }; // end class CorrectedEphemerisRange
@@ -81,6 +81,49 @@ namespace gpstk
       catch(InvalidRequest& ir) { GPSTK_RETHROW(ir); }
    }
 
+   //---------------------------------------------------------------------------------
+   unsigned int OrbitEphStore::getXvts(const vector<SatID>& ids, const CommonTime& t,
+                                       vector<Xvt>& xvts, vector<bool>& valid) const
+   {
+      unsigned int numValid(0);
+      xvts.assign(ids.size(), Xvt());
+      valid.assign(ids.size(), false);
+
+      for(size_t i=0; i<ids.size(); i++) {
+         const OrbitEph *eph = findOrbitEph(ids[i],t);
+         if(!eph || (onlyHealthy && !eph->isHealthy()))
+            continue;
+
+         try { xvts[i] = eph->svXvt(t); valid[i] = true; numValid++; }
+         catch(InvalidRequest&) { }
+      }
+
+      return numValid;
+   }
+
+   //---------------------------------------------------------------------------------
+   unsigned int OrbitEphStore::getXvts(const SatID& id, const vector<CommonTime>& times,
+                                       vector<Xvt>& xvts, vector<bool>& valid) const
+   {
+      unsigned int numValid(0);
+      xvts.assign(times.size(), Xvt());
+      valid.assign(times.size(), false);
+
+      if(satTables.find(id) == satTables.end())
+         return 0;
+
+      for(size_t i=0; i<times.size(); i++) {
+         const OrbitEph *eph = findOrbitEph(id,times[i]);
+         if(!eph || (onlyHealthy && !eph->isHealthy()))
+            continue;
+
+         try { xvts[i] = eph->svXvt(times[i]); valid[i] = true; numValid++; }
+         catch(InvalidRequest&) { }
+      }
+
+      return numValid;
+   }
+
    //---------------------------------------------------------------------------------
    void OrbitEphStore::dump(ostream& os, short detail) const
    {
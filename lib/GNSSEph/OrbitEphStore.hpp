@@ -97,6 +97,33 @@ namespace gpstk
       ///        orbit elements at time t.
       virtual Xvt getXvt(const SatID& id, const CommonTime& t) const;
 
+      /// Returns the Xvts of several satellites at the same time, as getXvt()
+      /// does for each of them, without throwing for the satellites that
+      /// have no (healthy) orbit elements.
+      /// @param[in] ids the satellites
+      /// @param[in] t the time to look up
+      /// @param[out] xvts the Xvts of the satellites
+      /// @param[out] valid valid[i] is false if getXvt() would throw for ids[i]
+      /// @return the number of valid Xvts
+      virtual unsigned int getXvts(const std::vector<SatID>& ids,
+                                   const CommonTime& t,
+                                   std::vector<Xvt>& xvts,
+                                   std::vector<bool>& valid) const;
+
+      /// Returns the Xvts of one satellite at several times, as getXvt()
+      /// does for each of them, without throwing for the times that have no
+      /// (healthy) orbit elements.
+      /// @param[in] id the satellite
+      /// @param[in] times the times to look up
+      /// @param[out] xvts the Xvts of the satellite
+      /// @param[out] valid valid[i] is false if getXvt() would throw for
+      ///    times[i]
+      /// @return the number of valid Xvts
+      virtual unsigned int getXvts(const SatID& id,
+                                   const std::vector<CommonTime>& times,
+                                   std::vector<Xvt>& xvts,
+                                   std::vector<bool>& valid) const;
+
       /// Output summary of store data in human readable form, with detail:
       ///  0: Time limits and number of entries for entire store
       ///  1: Level 0 plus for each satellite: one line giving number and time limits
@@ -59,6 +59,16 @@ namespace gpstk
       const throw(InvalidRequest)
    {
       try {
+         // usual case first: the interval straight from the uniform tables
+         UniformSatTable::Interval in;
+         if(findUniformInterval(sat, ttag, in)) {
+            double c[UniformSatTable::maxPoints], d[UniformSatTable::maxPoints];
+            UniformSatTable::lagrangeCoefficients(lagrangeWeights, in.x, in.step, c, d);
+            PositionRecord rec;
+            getUniformValue(in, c, d, rec);
+            return rec;
+         }
+
          bool isExact;
          int i;
          PositionRecord rec;
@@ -325,6 +335,7 @@ namespace gpstk
    {
       try {
          checkTimeSystem(ttag.getTimeSystem());
+         uniformTable.invalidate();
 
          int i;
          if(!haveVelocity)
@@ -357,6 +368,7 @@ namespace gpstk
    {
       try {
          checkTimeSystem(ttag.getTimeSystem());
+         uniformTable.invalidate();
 
          if(tables.find(sat) != tables.end() &&
             tables[sat].find(ttag) != tables[sat].end()) {
@@ -384,6 +396,7 @@ namespace gpstk
    {
       try {
          checkTimeSystem(ttag.getTimeSystem());
+         uniformTable.invalidate();
 
          haveVelocity = true;
 
@@ -413,6 +426,7 @@ namespace gpstk
    {
       try {
          checkTimeSystem(ttag.getTimeSystem());
+         uniformTable.invalidate();
 
          haveAcceleration = true;
 
@@ -435,6 +449,171 @@ namespace gpstk
       catch(InvalidRequest& ir) { GPSTK_RETHROW(ir); }
    }
 
+   // Columns of the rows of the uniform tables
+   enum UniformColumns { colPos=0, colVel=3, colAcc=6,
+                         colSigPos=9, colSigVel=12, colSigAcc=15, numUniformColumns=18 };
+
+   // Copy the data tables to contiguous tables on uniform time grids
+   void PositionSatStore::buildUniformTables() throw()
+   {
+      uniformTable.reset(numUniformColumns);
+
+      vector<CommonTime> epochs;
+      vector<double> rows;
+
+      SatTable::const_iterator it;
+      for(it=tables.begin(); it!=tables.end(); ++it) {
+         epochs.clear();
+         rows.clear();
+
+         DataTableIterator jt;
+         for(jt=it->second.begin(); jt!=it->second.end(); ++jt) {
+            const PositionRecord& rec(jt->second);
+            epochs.push_back(jt->first);
+            int i;
+            for(i=0; i<3; i++) rows.push_back(rec.Pos[i]);
+            for(i=0; i<3; i++) rows.push_back(rec.Vel[i]);
+            for(i=0; i<3; i++) rows.push_back(rec.Acc[i]);
+            for(i=0; i<3; i++) rows.push_back(rec.sigPos[i]);
+            for(i=0; i<3; i++) rows.push_back(rec.sigVel[i]);
+            for(i=0; i<3; i++) rows.push_back(rec.sigAcc[i]);
+         }
+
+         uniformTable.addSatellite(it->first, epochs, rows);
+      }
+   }
+
+   // Return values for several satellites at one time, or for one satellite
+   // at several times, as getValue() does for each of them.
+   unsigned int PositionSatStore::getValues(const vector<SatID>& sats,
+                                            const vector<CommonTime>& ttags,
+                                            vector<PositionRecord>& recs,
+                                            vector<bool>& valid)
+      const throw(InvalidRequest)
+   {
+      size_t i,n(sats.size() > ttags.size() ? sats.size() : ttags.size());
+      if((sats.size() != n && sats.size() != 1) ||
+         (ttags.size() != n && ttags.size() != 1))
+         GPSTK_THROW(InvalidRequest("Sizes of satellites and times do not match"));
+      if(sats.empty() || ttags.empty()) n = 0;
+
+      // the records are filled in place, without new Triples if recs is
+      // reused from a previous call
+      recs.resize(n);
+      valid.assign(n, false);
+
+      // coefficients of the last interval; the intervals of the other
+      // satellites at the same time usually start at the same epoch
+      double c[UniformSatTable::maxPoints], d[UniformSatTable::maxPoints];
+      double x(0.0), step(0.0);
+
+      unsigned int numValid(0);
+      for(i=0; i<n; i++) {
+         const SatID& sat(sats[sats.size() == 1 ? 0 : i]);
+         const CommonTime& ttag(ttags[ttags.size() == 1 ? 0 : i]);
+         try {
+            UniformSatTable::Interval in;
+            if(findUniformInterval(sat, ttag, in)) {
+               if(step == 0.0 || in.x != x || in.step != step) {
+                  UniformSatTable::lagrangeCoefficients(lagrangeWeights,
+                                                        in.x, in.step, c, d);
+                  x = in.x;
+                  step = in.step;
+               }
+               getUniformValue(in, c, d, recs[i]);
+            }
+            else if(isPresent(sat))
+               recs[i] = getValue(sat, ttag);
+            else {
+               recs[i] = PositionRecord();         // getValue() would throw
+               continue;
+            }
+
+            valid[i] = true;
+            numValid++;
+         }
+         catch(InvalidRequest&) { recs[i] = PositionRecord(); }
+      }
+
+      return numValid;
+   }
+
+   // Find the interval of a time in the uniform tables, if getValue() may use
+   // it: the time must be well inside the table, and the interval must pass
+   // the gap and interval checks unless the value is returned as is.
+   bool PositionSatStore::findUniformInterval(const SatID& sat,
+                                              const CommonTime& ttag,
+                                              UniformSatTable::Interval& in)
+      const throw(InvalidRequest)
+   {
+      return (Nhalf > 1 && uniformTable.findInterval(sat, ttag, Nhalf, in) &&
+              ((in.exact && haveVelocity) || acceptInterval(in.step, in.span, in.x)));
+   }
+
+   // Interpolate an interval of the uniform tables; this follows getValue(),
+   // with the times of the interval at multiples of the step.
+   void PositionSatStore::getUniformValue(const UniformSatTable::Interval& in,
+                                          const double* c, const double* d,
+                                          PositionRecord& rec)
+      const throw()
+   {
+      int i;
+      unsigned int Nlow(Nhalf-1),Nhi(Nhalf),Nmatch(Nhalf);
+
+      if(in.exact && haveVelocity) {
+         for(i=0; i<3; i++) {
+            rec.Pos[i] = in.at(Nmatch, colPos+i);
+            rec.Vel[i] = in.at(Nmatch, colVel+i);
+            rec.Acc[i] = in.at(Nmatch, colAcc+i);
+            rec.sigPos[i] = in.at(Nmatch, colSigPos+i);
+            rec.sigVel[i] = in.at(Nmatch, colSigVel+i);
+            rec.sigAcc[i] = in.at(Nmatch, colSigAcc+i);
+         }
+         return;
+      }
+
+      for(i=0; i<3; i++) rec.sigAcc[i] = rec.Acc[i] = 0.0;     // default
+      if(haveVelocity) {
+         for(i=0; i<3; i++) {
+            rec.Pos[i] = in.combine(c, colPos+i);
+            if(haveAcceleration) {
+               rec.Vel[i] = in.combine(c, colVel+i);
+               rec.Acc[i] = in.combine(c, colAcc+i);
+            }
+            else {
+               // interpolate velocities(dm/s) to get V and A
+               rec.Vel[i] = in.combine(c, colVel+i);
+               rec.Acc[i] = in.combine(d, colVel+i) * 0.1;    // dm/s/s -> m/s/s
+            }
+
+            if(in.exact) {
+               rec.sigPos[i] = in.at(Nmatch, colSigPos+i);
+               rec.sigVel[i] = in.at(Nmatch, colSigVel+i);
+               if(haveAcceleration) rec.sigAcc[i] = in.at(Nmatch, colSigAcc+i);
+            }
+            else {
+               rec.sigPos[i] = RSS(in.at(Nhi, colSigPos+i), in.at(Nlow, colSigPos+i));
+               rec.sigVel[i] = RSS(in.at(Nhi, colSigVel+i), in.at(Nlow, colSigVel+i));
+               if(haveAcceleration)
+                  rec.sigAcc[i] = RSS(in.at(Nhi, colSigAcc+i), in.at(Nlow, colSigAcc+i));
+            }
+         }
+      }
+      else {               // no V data - must interpolate position to get velocity
+         for(i=0; i<3; i++) {
+            // interpolate positions(km) to get P and V
+            rec.Pos[i] = in.combine(c, colPos+i);
+            rec.Vel[i] = in.combine(d, colPos+i) * 10000.;   // km/sec -> dm/sec
+
+            if(in.exact)
+               rec.sigPos[i] = in.at(Nmatch, colSigPos+i);
+            else
+               rec.sigPos[i] = RSS(in.at(Nhi, colSigPos+i), in.at(Nlow, colSigPos+i));
+            rec.sigVel[i] = 0.0;
+         }
+      }
+   }
+
    //@}
 
 }  // End of namespace gpstk
@@ -10,6 +10,7 @@
 #include <iostream>
 
 #include "TabularSatStore.hpp"
+#include "UniformSatTable.hpp"
 #include "Exception.hpp"
 #include "SatID.hpp"
 #include "CommonTime.hpp"
@@ -73,6 +74,12 @@ namespace gpstk
       /// Store half the interpolation order, for convenience
       unsigned int Nhalf;
 
+      /// Copy of the data tables on uniform time grids, see buildUniformTables()
+      UniformSatTable uniformTable;
+
+      /// Weights of Lagrange interpolation on interpOrder equally spaced points
+      std::vector<double> lagrangeWeights;
+
    // member functions
    public:
 
@@ -81,6 +88,7 @@ namespace gpstk
                                    Nhalf(5)
       {
          interpOrder = 2*Nhalf;
+         UniformSatTable::lagrangeWeights(interpOrder, lagrangeWeights);
          havePosition = true;
          haveVelocity = false;
          haveClockBias = false;
@@ -105,6 +113,24 @@ namespace gpstk
       PositionRecord getValue(const SatID& sat, const CommonTime& ttag)
          const throw(InvalidRequest);
 
+      /// Return values for several satellites at one time, or for one
+      /// satellite at several times, as getValue() does for each of them.
+      /// Intervals found in the uniform tables at the same place on the grid
+      /// share the coefficients of the interpolation.
+      /// @param[in] sats the satellites of interest
+      /// @param[in] ttags the times of interest; either sats or ttags may
+      ///   have a single element, used with every element of the other;
+      ///   otherwise they must have the same size
+      /// @param[out] recs the values, one per satellite or time
+      /// @param[out] valid valid[i] is false if getValue() would throw
+      /// @return the number of valid values
+      /// @throw InvalidRequest if the sizes of sats and ttags do not match
+      unsigned int getValues(const std::vector<SatID>& sats,
+                             const std::vector<CommonTime>& ttags,
+                             std::vector<PositionRecord>& recs,
+                             std::vector<bool>& valid)
+         const throw(InvalidRequest);
+
       /// Return the position for the given satellite at the given time
       /// @param[in] sat the SatID of the satellite of interest
       /// @param[in] ttag the time (CommonTime) of interest
@@ -188,13 +214,42 @@ namespace gpstk
 
       /// Set the interpolation order; this routine forces the order to be even.
       void setInterpolationOrder(unsigned int order) throw()
-         { Nhalf = (order+1)/2; interpOrder = 2*Nhalf; }
+      {
+         Nhalf = (order+1)/2; interpOrder = 2*Nhalf;
+         UniformSatTable::lagrangeWeights(interpOrder, lagrangeWeights);
+      }
+
+      /// Copy the data tables to contiguous tables on uniform time grids
+      /// (see UniformSatTable), which getValue() then uses to find the
+      /// interpolation interval in constant time. Call this once the data
+      /// are loaded; adding or editing data drops the uniform tables, and
+      /// getValue() falls back to the std::map tables until it is called again.
+      void buildUniformTables() throw();
+
+      /// Drop the uniform tables when the data tables are modified.
+      virtual void tablesModified() throw()
+         { uniformTable.invalidate(); }
 
       /// Set the flag; if true then bad position values are rejected when
       /// adding data to the store.
       void rejectBadPositions(const bool flag)
          { rejectBadPosFlag=flag; }
 
+   private:
+
+      /// Find the interval of a time in the uniform tables, if getValue()
+      /// may use it
+      bool findUniformInterval(const SatID& sat, const CommonTime& ttag,
+                               UniformSatTable::Interval& in)
+         const throw(InvalidRequest);
+
+      /// Interpolate an interval of the uniform tables, as getValue() does,
+      /// given the coefficients of the interval from lagrangeCoefficients();
+      /// every member of rec is set
+      void getUniformValue(const UniformSatTable::Interval& in,
+                           const double* c, const double* d,
+                           PositionRecord& rec) const throw();
+
    }; // end class PositionSatStore
 
       //@}
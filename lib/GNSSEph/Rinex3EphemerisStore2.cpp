@@ -274,6 +274,104 @@ namespace gpstk
       catch(InvalidRequest& ir) { GPSTK_RETHROW(ir); }
    }
 
+   // Returns the Xvts of several satellites at the same time, as getXvt() does
+   // for each of them.
+   unsigned int Rinex3EphemerisStore2::getXvts(const vector<SatID>& sats,
+                                               const CommonTime& inttag,
+                                               vector<Xvt>& xvts,
+                                               vector<bool>& valid) const
+   {
+      unsigned int numValid(0);
+      xvts.assign(sats.size(), Xvt());
+      valid.assign(sats.size(), false);
+
+      static const SatID::SatelliteSystem systems[] = {
+         SatID::systemGPS, SatID::systemGalileo, SatID::systemBDS };
+
+      vector<size_t> index;
+      vector<SatID> ids;
+      vector<Xvt> sysXvts;
+      vector<bool> sysValid;
+
+      for(int k=0; k<3; k++) {
+         index.clear();
+         ids.clear();
+         for(size_t i=0; i<sats.size(); i++) {
+            if(sats[i].system != systems[k]) continue;
+            index.push_back(i);
+            ids.push_back(sats[i]);
+         }
+         if(ids.empty()) continue;
+
+         TimeSystem ts;
+         const OrbitEphStore *store = getSystemStore(systems[k], ts);
+
+         // the time is converted once for all the satellites of the system
+         CommonTime ttag;
+         try { ttag = correctTimeSystem(inttag, ts); }
+         catch(Exception&) { continue; }
+
+         store->getXvts(ids, ttag, sysXvts, sysValid);
+         for(size_t j=0; j<index.size(); j++) {
+            if(!sysValid[j]) continue;
+            xvts[index[j]] = sysXvts[j];
+            valid[index[j]] = true;
+            numValid++;
+         }
+      }
+
+      return numValid;
+   }
+
+   // Returns the Xvts of one satellite at several times, as getXvt() does for
+   // each of them.
+   unsigned int Rinex3EphemerisStore2::getXvts(const SatID& sat,
+                                               const vector<CommonTime>& inttags,
+                                               vector<Xvt>& xvts,
+                                               vector<bool>& valid) const
+   {
+      TimeSystem ts;
+      const OrbitEphStore *store = getSystemStore(sat.system, ts);
+      if(!store) {
+         xvts.assign(inttags.size(), Xvt());
+         valid.assign(inttags.size(), false);
+         return 0;
+      }
+
+      try {
+         vector<CommonTime> ttags(inttags.size());
+         for(size_t i=0; i<inttags.size(); i++)
+            ttags[i] = correctTimeSystem(inttags[i], ts);
+
+         return store->getXvts(sat, ttags, xvts, valid);
+      }
+      catch(Exception&) {
+         // some time could not be converted; do them one by one
+         return XvtStore<SatID>::getXvts(sat, inttags, xvts, valid);
+      }
+   }
+
+   // Return the store of the orbit-based system of a satellite, and its time
+   // system, or NULL if the system is not supported
+   const OrbitEphStore* Rinex3EphemerisStore2::getSystemStore(
+                                          const SatID::SatelliteSystem& sys,
+                                          TimeSystem& ts) const
+   {
+      switch(sys) {
+         case SatID::systemGPS:
+            ts = TimeSystem::GPS;
+            return &gpsStore;
+         case SatID::systemGalileo:
+            ts = TimeSystem::GAL;
+            return &galStore;
+         case SatID::systemBDS:
+            ts = TimeSystem::BDT;
+            return &bdsStore;
+         default:
+            return NULL;
+      }
+   }
+
    // Dump information about the store to an ostream.
    // @param[in] os ostream to receive the output; defaults to cout
    // @param[in] detail integer level of detail to provide; allowed values are
@@ -83,6 +83,11 @@ namespace gpstk
       GalEphemerisStore galStore;
       BDSEphemerisStore bdsStore;
 
+      /// Return the store of the orbit-based system of a satellite, and its
+      /// time system, or NULL if the system is not supported
+      const OrbitEphStore* getSystemStore(const SatID::SatelliteSystem& sys,
+                                          TimeSystem& ts) const;
+
    public:
 
       /// Rinex file header last read by loadFile()
@@ -136,6 +141,32 @@ namespace gpstk
       ///    information as to why the request failed.
       virtual Xvt getXvt(const SatID& sat, const CommonTime& ttag) const;
 
+      /// Returns the Xvts of several satellites at the same time, as getXvt()
+      /// does for each of them. The time is converted once per satellite
+      /// system, and the satellites of each system are passed together to the
+      /// store of the system.
+      /// @param[in] sats the satellites of interest
+      /// @param[in] ttag the time to look up
+      /// @param[out] xvts the Xvts of the satellites
+      /// @param[out] valid valid[i] is false if getXvt() would throw for sats[i]
+      /// @return the number of valid Xvts
+      virtual unsigned int getXvts(const std::vector<SatID>& sats,
+                                   const CommonTime& ttag,
+                                   std::vector<Xvt>& xvts,
+                                   std::vector<bool>& valid) const;
+
+      /// Returns the Xvts of one satellite at several times, as getXvt()
+      /// does for each of them, in one call to the store of its system.
+      /// @param[in] sat the satellite of interest
+      /// @param[in] ttags the times to look up
+      /// @param[out] xvts the Xvts of the satellite
+      /// @param[out] valid valid[i] is false if getXvt() would throw for ttags[i]
+      /// @return the number of valid Xvts
+      virtual unsigned int getXvts(const SatID& sat,
+                                   const std::vector<CommonTime>& ttags,
+                                   std::vector<Xvt>& xvts,
+                                   std::vector<bool>& valid) const;
+
       /// Dump information about the store to an ostream.
       /// @param[in] os ostream to receive the output; defaults to std::cout
       /// @param[in] detail integer level of detail to provide; allowed values are
@@ -90,27 +90,116 @@ namespace gpstk
       try { crec = clkStore.getValue(sat,ttag); }
       catch(InvalidRequest& e) { GPSTK_RETHROW(e); }
 
-      try {
-         Xvt retXvt;
-         for(int i=0; i<3; i++) {
-            retXvt.x[i] = prec.Pos[i] * 1000.0;    // km -> m
-            retXvt.v[i] = prec.Vel[i] * 0.1;       // dm/s -> m/s
+      Xvt retXvt;
+      makeXvt(prec, crec, retXvt);
+      return retXvt;
+   }
+
+      // Returns the Xvts of several satellites at the same time, as getXvt()
+      // does for each of them.
+   unsigned int SP3EphemerisStore::getXvts(const vector<SatID>& sats,
+                                           const CommonTime& ttag,
+                                           vector<Xvt>& xvts,
+                                           vector<bool>& valid) const
+   {
+      return computeXvts(sats, vector<CommonTime>(1, ttag), xvts, valid);
+   }
+
+      // Returns the Xvts of one satellite at several times, as getXvt()
+      // does for each of them.
+   unsigned int SP3EphemerisStore::getXvts(const SatID& sat,
+                                           const vector<CommonTime>& ttags,
+                                           vector<Xvt>& xvts,
+                                           vector<bool>& valid) const
+   {
+      return computeXvts(vector<SatID>(1, sat), ttags, xvts, valid);
+   }
+
+      // Compute the Xvts of several satellites at one time, or of one
+      // satellite at several times.
+   unsigned int SP3EphemerisStore::computeXvts(const vector<SatID>& sats,
+                                               const vector<CommonTime>& ttags,
+                                               vector<Xvt>& xvts,
+                                               vector<bool>& valid)
+      const throw()
+   {
+      vector<PositionRecord> precs;
+      vector<ClockRecord> crecs;
+      vector<bool> pvalid, cvalid;
+
+      posStore.getValues(sats, ttags, precs, pvalid);
+
+      size_t i,n(precs.size());
+      unsigned int numValid(0);
+
+      // the clocks are only needed where there is a position, as in getXvt()
+      vector<size_t> index;
+      for(i=0; i<n; i++)
+         if(pvalid[i]) index.push_back(i);
+
+      if(index.size() == n)
+         clkStore.getValues(sats, ttags, crecs, cvalid);
+      else if(!index.empty()) {
+         vector<SatID> csats;
+         vector<CommonTime> cttags;
+         vector<ClockRecord> subrecs;
+         vector<bool> subvalid;
+         for(i=0; i<index.size(); i++) {
+            if(sats.size() > 1) csats.push_back(sats[index[i]]);
+            if(ttags.size() > 1) cttags.push_back(ttags[index[i]]);
          }
-         if(useSP3clock) {                            // SP3
-            retXvt.clkbias = crec.bias * 1.e-6;       // microsec -> sec
-            retXvt.clkdrift = crec.drift * 1.e-6;     // microsec/sec -> sec/sec
+         clkStore.getValues(sats.size() > 1 ? csats : sats,
+                            ttags.size() > 1 ? cttags : ttags,
+                            subrecs, subvalid);
+
+         crecs.resize(n);
+         cvalid.assign(n, false);
+         for(i=0; i<index.size(); i++) {
+            crecs[index[i]] = subrecs[i];
+            cvalid[index[i]] = subvalid[i];
          }
-         else {                                       // RINEX clock
-            retXvt.clkbias = crec.bias;               // sec
-            retXvt.clkdrift = crec.drift;             // sec/sec
+      }
+
+      // the Xvts are filled in place, without new Triples if xvts is
+      // reused from a previous call
+      xvts.resize(n);
+      valid.assign(n, false);
+
+      for(i=0; i<n; i++) {
+         if(!pvalid[i] || !cvalid[i]) {
+            xvts[i] = Xvt();
+            continue;
          }
+         makeXvt(precs[i], crecs[i], xvts[i]);
+         valid[i] = true;
+         numValid++;
+      }
 
-            // compute relativity correction, in seconds
-         retXvt.computeRelativityCorrection();
+      return numValid;
+   }
 
-         return retXvt;
+      // Combine the position and clock records into an Xvt, in meters and
+      // seconds.
+   void SP3EphemerisStore::makeXvt(const PositionRecord& prec,
+                                   const ClockRecord& crec,
+                                   Xvt& retXvt) const throw()
+   {
+      for(int i=0; i<3; i++) {
+         retXvt.x[i] = prec.Pos[i] * 1000.0;    // km -> m
+         retXvt.v[i] = prec.Vel[i] * 0.1;       // dm/s -> m/s
       }
-      catch(InvalidRequest& e) { GPSTK_RETHROW(e); }
+      if(useSP3clock) {                            // SP3
+         retXvt.clkbias = crec.bias * 1.e-6;       // microsec -> sec
+         retXvt.clkdrift = crec.drift * 1.e-6;     // microsec/sec -> sec/sec
+      }
+      else {                                       // RINEX clock
+         retXvt.clkbias = crec.bias;               // sec
+         retXvt.clkdrift = crec.drift;             // sec/sec
+      }
+
+         // compute relativity correction, in seconds
+      retXvt.computeRelativityCorrection();
+      retXvt.frame = ReferenceFrame::Unknown;
    }
 
       // Determine the earliest time for which this object can successfully
@@ -528,6 +617,10 @@ namespace gpstk
             // close
          strm.close();
 
+            // the tables are complete, copy them to the uniform tables
+         posStore.buildUniformTables();
+         if(fillClockStore) clkStore.buildUniformTables();
+
       }
       catch (Exception& e)
       {
@@ -710,6 +803,8 @@ namespace gpstk
 
          strm.close();
 
+         clkStore.buildUniformTables();
+
       }
       catch(Exception& e)
       {
@@ -132,6 +132,22 @@ namespace gpstk
       void loadSP3Store(const std::string& filename, bool fillClockStore)
          throw(Exception);
 
+         /** Private utility routine used by getXvt() and getXvts().
+          * Combine the position and clock records into an Xvt, in
+          * meters and seconds; every member of the Xvt is set. */
+      void makeXvt(const PositionRecord& prec, const ClockRecord& crec,
+                   Xvt& xvt) const throw();
+
+         /** Private utility routine used by the getXvts() routines.
+          * Compute the Xvts of several satellites at one time, or of
+          * one satellite at several times, see
+          * PositionSatStore::getValues(). */
+      unsigned int computeXvts(const std::vector<SatID>& sats,
+                               const std::vector<CommonTime>& ttags,
+                               std::vector<Xvt>& xvts,
+                               std::vector<bool>& valid)
+         const throw();
+
    public:
 
          /// Default constructor
@@ -160,6 +176,34 @@ namespace gpstk
       virtual Xvt getXvt(const SatID& sat, const CommonTime& ttag)
          const throw(InvalidRequest);
 
+         /** Returns the Xvts of several satellites at the same time,
+          * as getXvt() does for each of them. The interpolation
+          * intervals are taken from the uniform tables, sharing the
+          * coefficients of the interpolation among the satellites.
+          * @param[in] sats the satellites of interest
+          * @param[in] ttag the time to look up
+          * @param[out] xvts the Xvts of the satellites
+          * @param[out] valid valid[i] is false if getXvt() would throw
+          *    for sats[i]
+          * @return the number of valid Xvts */
+      virtual unsigned int getXvts(const std::vector<SatID>& sats,
+                                   const CommonTime& ttag,
+                                   std::vector<Xvt>& xvts,
+                                   std::vector<bool>& valid) const;
+
+         /** Returns the Xvts of one satellite at several times, as
+          * getXvt() does for each of them.
+          * @param[in] sat the satellite of interest
+          * @param[in] ttags the times to look up
+          * @param[out] xvts the Xvts of the satellite
+          * @param[out] valid valid[i] is false if getXvt() would throw
+          *    for ttags[i]
+          * @return the number of valid Xvts */
+      virtual unsigned int getXvts(const SatID& sat,
+                                   const std::vector<CommonTime>& ttags,
+                                   std::vector<Xvt>& xvts,
+                                   std::vector<bool>& valid) const;
+
          /** Dump information about the store to an ostream.
           * @param[in] os ostream to receive the output; defaults to std::cout
           * @param[in] detail integer level of detail to provide;
@@ -200,6 +244,8 @@ namespace gpstk
       {
          posStore.edit(tmin, tmax);
          clkStore.edit(tmin, tmax);
+         posStore.buildUniformTables();
+         clkStore.buildUniformTables();
       }
 
          /// Clear the dataset, meaning remove all data
@@ -553,6 +599,18 @@ namespace gpstk
       void loadRinexClockFile(const std::string& filename) throw(Exception);
 
 
+         /** Copy the position and clock tables to the uniform tables
+          * used by getXvt() to interpolate in constant time (see
+          * PositionSatStore::buildUniformTables()). The load routines
+          * and edit() do this; call it after adding data with the
+          * addXXX() routines, which drop the uniform tables. */
+      void buildUniformTables() throw()
+      {
+         posStore.buildUniformTables();
+         clkStore.buildUniformTables();
+      }
+
+
          /** Add a complete PositionRecord to the store; this is the
           * preferred method of adding data to the tables.
           * @note If these addXXX() routines are used more than once
@@ -0,0 +1,194 @@
+/// @file UniformSatTable.cpp
+/// Contiguous, uniformly sampled tables of data vs time for several
+/// satellites, used by PositionSatStore and ClockSatStore to find the
+/// interpolation interval of a time in constant time.
+
+#include <cmath>
+
+#include "UniformSatTable.hpp"
+
+using namespace std;
+
+namespace gpstk
+{
+   /** @addtogroup ephemstore */
+   //@{
+
+   // Largest difference (seconds) between an epoch and its grid time
+   static const double gridTolerance = 1.e-9;
+
+   // Remove all the tables and set the number of values of the rows
+   void UniformSatTable::reset(unsigned int columns) throw()
+   {
+      tables.clear();
+      numColumns = columns;
+      valid = true;
+   }
+
+   // Remove all the tables
+   void UniformSatTable::invalidate() throw()
+   {
+      tables.clear();
+      valid = false;
+   }
+
+   // Add the table of a satellite
+   bool UniformSatTable::addSatellite(const SatID& sat,
+                                      const vector<CommonTime>& epochs,
+                                      const vector<double>& rows)
+      throw()
+   {
+      try {
+         size_t i,n(epochs.size());
+         if(!valid || n < 2 || rows.size() != n*numColumns) return false;
+
+         // the step of the grid is the smallest time between two epochs
+         double step(0.0);
+         for(i=1; i<n; i++) {
+            double dt(epochs[i] - epochs[i-1]);
+            if(dt <= 0.0) return false;
+            if(step == 0.0 || dt < step) step = dt;
+         }
+
+         // don't let a few odd epochs blow up the grid
+         double total(epochs[n-1] - epochs[0]);
+         if(total/step > 4.0*n + 16.0) return false;
+
+         size_t size(static_cast<size_t>(total/step + 0.5) + 1);
+
+         Table table;
+         table.step = step;
+         table.epochs.resize(size, epochs[0]);
+         table.runStart.resize(size);
+         table.rows.resize(size*numColumns, 0.0);
+
+         vector<bool> present(size, false);
+         for(i=0; i<n; i++) {
+            double dt(epochs[i] - epochs[0]);
+            size_t j(static_cast<size_t>(dt/step + 0.5));
+            if(j >= size || present[j] ||
+               std::abs(dt - j*step) > gridTolerance) return false;
+
+            present[j] = true;
+            table.epochs[j] = epochs[i];
+            std::copy(rows.begin() + i*numColumns,
+                      rows.begin() + (i+1)*numColumns,
+                      table.rows.begin() + j*numColumns);
+         }
+
+         for(i=0; i<size; i++) {
+            if(!present[i])                  table.runStart[i] = i+1;
+            else if(i > 0 && present[i-1])   table.runStart[i] = table.runStart[i-1];
+            else                             table.runStart[i] = i;
+         }
+
+         tables[sat] = table;
+
+         return true;
+      }
+      catch(...) { return false; }
+   }
+
+   // Find the interval of 2*nhalf rows centered on a time
+   bool UniformSatTable::findInterval(const SatID& sat,
+                                      const CommonTime& ttag,
+                                      unsigned int nhalf,
+                                      Interval& interval) const
+      throw(InvalidRequest)
+   {
+      if(!valid || nhalf == 0 || 2*nhalf > maxPoints) return false;
+
+      map<SatID, Table>::const_iterator it(tables.find(sat));
+      if(it == tables.end()) return false;
+
+      const Table& table(it->second);
+      size_t size(table.epochs.size());
+
+      // k is the first row not before ttag, as lower_bound() in the std::map
+      double r((ttag - table.epochs[0]) / table.step);
+      if(!(r > 0.0 && r < size)) return false;
+
+      size_t k(static_cast<size_t>(std::ceil(r)));
+      if(k < 1) k = 1;
+      if(k > size-1) k = size-1;
+
+      // rounding may put k one row off
+      if(table.runStart[k-1] <= k-1 && !(table.epochs[k-1] < ttag))
+         --k;
+      else if(table.runStart[k] <= k && table.epochs[k] < ttag)
+         ++k;
+
+      // the interval must lie inside the table, without missing rows; as
+      // in getTableInterval() the row before k must not be the first one
+      if(k < 2 || k < nhalf || k+nhalf > size) return false;
+
+      size_t first(k-nhalf), last(k+nhalf-1);
+      if(table.runStart[last] > first) return false;
+
+      if(!(table.epochs[k-1] < ttag) || table.epochs[k] < ttag) return false;
+
+      interval.rows = &table.rows[first*numColumns];
+      interval.numPoints = 2*nhalf;
+      interval.numColumns = numColumns;
+      interval.x = ttag - table.epochs[first];
+      interval.step = table.step;
+      interval.span = (2*nhalf-1) * table.step;
+      interval.exact = !(ttag < table.epochs[k]);
+
+      return true;
+   }
+
+   // Barycentric weights of Lagrange interpolation on n equally spaced
+   // points: w[j] = 1/PROD(i!=j)[j-i] = (-1)^(n-1-j) / (j! (n-1-j)!)
+   void UniformSatTable::lagrangeWeights(unsigned int n, vector<double>& weights)
+      throw()
+   {
+      weights.resize(n);
+      if(n == 0) return;
+
+      double w(1.0);
+      for(unsigned int i=1; i<n; i++) w /= -double(i);   // j=0
+      weights[0] = w;
+
+      for(unsigned int j=1; j<n; j++) {
+         w *= -double(n-j) / double(j);
+         weights[j] = w;
+      }
+   }
+
+   // Coefficients of the Lagrange polynomial and its derivative at x.
+   // With s = x/step, Lj(s) = w[j]*PROD(i!=j)[s-i]; the products are built
+   // from the left and from the right, along with their derivatives, so
+   // that no division by (s-j) is needed.
+   void UniformSatTable::lagrangeCoefficients(const vector<double>& weights,
+                                              double x, double step,
+                                              double* c, double* d)
+      throw()
+   {
+      unsigned int i,n(weights.size());
+      double s(x/step);
+      double left[maxPoints+1], dleft[maxPoints+1];
+      double right[maxPoints+1], dright[maxPoints+1];
+
+      left[0] = 1.0; dleft[0] = 0.0;
+      for(i=0; i<n; i++) {
+         left[i+1] = left[i] * (s-i);
+         dleft[i+1] = dleft[i] * (s-i) + left[i];
+      }
+
+      right[n] = 1.0; dright[n] = 0.0;
+      for(i=n; i>0; i--) {
+         right[i-1] = right[i] * (s-(i-1));
+         dright[i-1] = dright[i] * (s-(i-1)) + right[i];
+      }
+
+      for(i=0; i<n; i++) {
+         c[i] = weights[i] * left[i] * right[i+1];
+         if(d)
+            d[i] = weights[i] * (dleft[i]*right[i+1] + left[i]*dright[i+1]) / step;
+      }
+   }
+
+   //@}
+
+}  // End of namespace gpstk
@@ -0,0 +1,152 @@
+/// @file UniformSatTable.hpp
+/// Contiguous, uniformly sampled tables of data vs time for several
+/// satellites, used by PositionSatStore and ClockSatStore to find the
+/// interpolation interval of a time in constant time.
+
+#ifndef GPSTK_UNIFORM_SAT_TABLE_INCLUDE
+#define GPSTK_UNIFORM_SAT_TABLE_INCLUDE
+
+#include <map>
+#include <vector>
+
+#include "Exception.hpp"
+#include "SatID.hpp"
+#include "CommonTime.hpp"
+
+namespace gpstk
+{
+   /** @addtogroup ephemstore */
+   //@{
+
+   /// Tables of data vs time for several satellites, with the rows of each
+   /// satellite stored contiguously on a uniform time grid. The row of a
+   /// time is computed from the time, rather than searched for.
+   ///
+   /// The tables are a copy of the std::map tables of a TabularSatStore,
+   /// made once the data are loaded (see PositionSatStore::buildUniformTables()).
+   /// Epochs missing from the grid are allowed; findInterval() only returns
+   /// intervals without missing epochs, and satellites whose epochs do not
+   /// fit a grid have no table at all: the store then falls back to its
+   /// std::map tables, which also handle the ends of the tables.
+   ///
+   /// The interpolation is Lagrange interpolation in the first barycentric
+   /// form, the weights of equally spaced points being computed once by
+   /// lagrangeWeights(); the form is evaluated without divisions, so that
+   /// it stays accurate next to the points.
+   class UniformSatTable
+   {
+   public:
+
+      /// Interval of 2*nhalf rows around a time, see findInterval()
+      struct Interval
+      {
+         const double* rows;        ///< first row of the interval
+         unsigned int numPoints;    ///< number of rows, 2*nhalf
+         unsigned int numColumns;   ///< number of values per row
+         double x;                  ///< time from the first row, seconds
+         double step;               ///< time between two rows, seconds
+         double span;               ///< time from the first to the last row
+         bool exact;                ///< the time matches row nhalf
+
+         /// Return the value of a column of a row of the interval
+         double at(unsigned int row, unsigned int column) const throw()
+            { return rows[row*numColumns + column]; }
+
+         /// Return the sum of coef[j] times the column of row j
+         double combine(const double* coef, unsigned int column) const throw()
+         {
+            double sum(0.0);
+            const double* p(rows + column);
+            for(unsigned int j=0; j<numPoints; j++, p+=numColumns)
+               sum += coef[j] * (*p);
+            return sum;
+         }
+      };
+
+      /// Largest number of points of an interval
+      static const unsigned int maxPoints = 32;
+
+      /// Default constructor; the tables are not valid.
+      UniformSatTable() throw() : numColumns(0), valid(false) {}
+
+      /// Remove all the tables and set the number of values of the rows;
+      /// the (empty) tables are valid from now on.
+      void reset(unsigned int columns) throw();
+
+      /// Remove all the tables; findInterval() fails until reset() is called.
+      void invalidate() throw();
+
+      /// Return true if the tables are valid.
+      bool isValid() const throw() { return valid; }
+
+      /// Add the table of a satellite.
+      /// @param[in] sat the satellite
+      /// @param[in] epochs the times of the rows, increasing
+      /// @param[in] rows the values, numColumns per epoch
+      /// @return true if the satellite has a table; false if its epochs do
+      ///   not fit a uniform grid (or are too few), it is then left out.
+      bool addSatellite(const SatID& sat,
+                        const std::vector<CommonTime>& epochs,
+                        const std::vector<double>& rows) throw();
+
+      /// Find the interval of 2*nhalf rows centered on a time, the same
+      /// interval as TabularSatStore::getTableInterval() with exactReturn
+      /// false. Only the usual case is handled: a time well inside a table
+      /// without missing epochs; in any other case the caller must use
+      /// getTableInterval(). No gap or interval checks are done.
+      /// @param[in] sat the satellite of interest
+      /// @param[in] ttag the time of interest
+      /// @param[in] nhalf number of rows on each side of the time
+      /// @param[out] interval the interval found
+      /// @return true if the interval was found
+      /// @throw InvalidRequest if the time systems do not match
+      bool findInterval(const SatID& sat,
+                        const CommonTime& ttag,
+                        unsigned int nhalf,
+                        Interval& interval) const throw(InvalidRequest);
+
+      /// Compute the barycentric weights of Lagrange interpolation on n
+      /// equally spaced points 0,1,...,n-1.
+      static void lagrangeWeights(unsigned int n, std::vector<double>& weights)
+         throw();
+
+      /// Compute the coefficients of the Lagrange polynomial of equally
+      /// spaced points and of its derivative, at a given time:
+      /// y(x) = SUM[c[j]*Y[j]] and dy(x)/dx = SUM[d[j]*Y[j]].
+      /// @param[in] weights the weights from lagrangeWeights()
+      /// @param[in] x time from the first point
+      /// @param[in] step time between two points
+      /// @param[out] c the coefficients of the value (weights.size() of them)
+      /// @param[out] d the coefficients of the derivative, may be NULL
+      static void lagrangeCoefficients(const std::vector<double>& weights,
+                                       double x, double step,
+                                       double* c, double* d) throw();
+
+   private:
+
+      /// Table of one satellite
+      struct Table
+      {
+         double step;                        ///< time between two rows
+         std::vector<CommonTime> epochs;     ///< times of the rows
+         std::vector<unsigned int> runStart; ///< first row of the run of
+                                             ///< present rows, or row+1
+         std::vector<double> rows;           ///< values, numColumns per row
+      };
+
+      /// Number of values per row
+      unsigned int numColumns;
+
+      /// The tables are a copy of the current data
+      bool valid;
+
+      /// The tables
+      std::map<SatID, Table> tables;
+
+   }; // end class UniformSatTable
+
+   //@}
+
+}  // End of namespace gpstk
+
+#endif // GPSTK_UNIFORM_SAT_TABLE_INCLUDE
@@ -46,6 +46,7 @@
 #define GPSTK_XVTSTORE_INCLUDE
 
 #include <iostream>
+#include <vector>
 
 #include "Exception.hpp"
 #include "CommonTime.hpp"
@@ -76,6 +77,54 @@ namespace gpstk
       ///    information as to why the request failed.
       virtual Xvt getXvt(const IndexType& id, const CommonTime& t) const = 0;
 
+      /// Returns the Xvt of several objects at the same time, as getXvt()
+      /// does for each of them. Derived classes override this to share the
+      /// work common to all the objects (time system conversions, table
+      /// searches, interpolation weights); this default calls getXvt().
+      /// @param[in] ids the objects' identifiers
+      /// @param[in] t the time to look up
+      /// @param[out] xvts the Xvts of the objects, in the order of ids
+      /// @param[out] valid valid[i] is false if getXvt() would throw for
+      ///    ids[i]; xvts[i] is then a default Xvt
+      /// @return the number of valid Xvts
+      virtual unsigned int getXvts(const std::vector<IndexType>& ids,
+                                   const CommonTime& t,
+                                   std::vector<Xvt>& xvts,
+                                   std::vector<bool>& valid) const
+      {
+         unsigned int numValid(0);
+         xvts.assign(ids.size(), Xvt());
+         valid.assign(ids.size(), false);
+         for(size_t i=0; i<ids.size(); i++) {
+            try { xvts[i] = getXvt(ids[i], t); valid[i] = true; numValid++; }
+            catch(Exception&) { }
+         }
+         return numValid;
+      }
+
+      /// Returns the Xvt of one object at several times, as getXvt() does
+      /// for each of them; see the other getXvts().
+      /// @param[in] id the object's identifier
+      /// @param[in] times the times to look up
+      /// @param[out] xvts the Xvts of the object, in the order of times
+      /// @param[out] valid valid[i] is false if getXvt() would throw for
+      ///    times[i]; xvts[i] is then a default Xvt
+      /// @return the number of valid Xvts
+      virtual unsigned int getXvts(const IndexType& id,
+                                   const std::vector<CommonTime>& times,
+                                   std::vector<Xvt>& xvts,
+                                   std::vector<bool>& valid) const
+      {
+         unsigned int numValid(0);
+         xvts.assign(times.size(), Xvt());
+         valid.assign(times.size(), false);
+         for(size_t i=0; i<times.size(); i++) {
+            try { xvts[i] = getXvt(id, times[i]); valid[i] = true; numValid++; }
+            catch(Exception&) { }
+         }
+         return numValid;
+      }
+
       /// A debugging function that outputs in human readable form,
       /// all data stored in this object.
       /// @param[in] s the stream to receive the output; defaults to cout
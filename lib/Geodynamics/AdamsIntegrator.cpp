@@ -27,6 +27,10 @@
  */
 
 #include "AdamsIntegrator.hpp"
+
+#ifdef USE_OPENMP
+#include <omp.h>
+#endif
 #include "Epoch.hpp"
 
 using namespace std;
@@ -63,6 +67,60 @@ namespace gpstk
     };
 
 
+    // Add the weighted derivatives of the 9 epochs to the states.
+    void AdamsIntegrator::combine( satVectorMap& y,
+                                   const std::vector<satVectorMap>& dys,
+                                   const double* coef,
+                                   double forward )
+    {
+        // pointers to the vectors of each satellite, so that the
+        // satellites can be processed in parallel
+        int numSats( y.size() );
+        std::vector<Vector<double>*> yPtrs;
+        std::vector< std::vector<const Vector<double>*> > dyPtrs(9);
+        yPtrs.reserve(numSats);
+
+        for(satVectorMap::iterator it = y.begin();
+            it != y.end();
+            ++it)
+        {
+            yPtrs.push_back( &(it->second) );
+
+            for(int i=0; i<9; ++i)
+            {
+                satVectorMap::const_iterator dyIt( dys[8-i].find(it->first) );
+
+                if( dyIt == dys[8-i].end() )
+                {
+                    GPSTK_THROW(SatIDNotFound("SatID not found in map"));
+                }
+
+                dyPtrs[i].push_back( &(dyIt->second) );
+            }
+        }
+
+#ifdef _OPENMP
+   #pragma omp parallel for if(parallel)
+#endif
+        for(int n=0; n<numSats; ++n)
+        {
+            Vector<double>& yn( *yPtrs[n] );
+            int size( yn.size() );
+
+            for(int i=0; i<9; ++i)
+            {
+                const Vector<double>& dy( *dyPtrs[i][n] );
+
+                for(int e=0; e<size; ++e)
+                {
+                    yn[e] += stepSize/3628800*coef[i]*dy[e]*forward;
+                }
+            }
+        }
+
+    }  // End of method 'AdamsIntegrator::combine()'
+
+
     /// Real implementation of Adams
     satVectorMap AdamsIntegrator::integrateTo( const CommonTime& t_next )
     {
@@ -83,60 +141,37 @@ namespace gpstk
         }
 
         // Derivatives at t_curr[i] and y_curr[i]
-        vector<satVectorMap> dys;
+        vector<satVectorMap> dys(9);
 
-        satVectorMap dy_temp;
         for(int i=0; i<9; ++i)
         {
-            dy_temp = pEOM->getDerivatives(t_curr[i],y_curr[i]);
-            dys.push_back(dy_temp);
+            pEOM->getDerivatives(t_curr[i], y_curr[i], dys[i]);
         }
 
 
-        SatID sat;
-
         // Prediction
         satVectorMap yp(y_curr[8]);
-        for(int i=0; i<9; ++i)
-        {
-            for(satVectorMap::iterator it = yp.begin();
-                it != yp.end();
-                ++it)
-            {
-                sat = it->first;
-
-                it->second += stepSize/3628800*cb[i]*(dys[8-i])[sat]*forward;
-            }
-        }
+        combine(yp, dys, cb, forward);
 
 
         // Derivatives at t(n+1), computed with yp
         CommonTime t_np1;
         t_np1 = t_curr[8] + stepSize*forward;
 
-        satVectorMap dy_np1;
-        dy_np1 = pEOM->getDerivatives(t_np1, yp);
-
         dys.erase( dys.begin() );
-        dys.push_back( dy_np1 );
+        dys.push_back( satVectorMap() );
+
+        pEOM->getDerivatives(t_np1, yp, dys.back());
 
         // Correction
         satVectorMap yc(y_curr[8]);
-        for(int i=0; i<9; ++i)
-        {
-            for(satVectorMap::iterator it = yc.begin();
-                it != yc.end();
-                ++it)
-            {
-                sat = it->first;
-
-                it->second += stepSize/3628800*cm[i]*(dys[8-i])[sat]*forward;
-            }
-        }
+        combine(yc, dys, cm, forward);
 
         y_next = yc;
 
 
+        SatID sat;
+
         Vector<double> diff(3,0.0);
         Vector<double> pred, corr;
 
@@ -85,6 +85,13 @@ namespace gpstk
 
     private:
 
+        /// Add the weighted derivatives of the 9 epochs to the states.
+        void combine( satVectorMap& y,
+                      const std::vector<satVectorMap>& dys,
+                      const double* coef,
+                      double forward );
+
+
         /// Coefficients of Adams-Bashforth
         const static double cb[9];
 
@@ -50,17 +50,14 @@ namespace gpstk
         double jd_tt = JulianDate(tt).jd;
 
         SolarSystem::Planet center(SolarSystem::Earth);
-        SolarSystem::Planet target;
+        SolarSystem::Planet targets[2] = { SolarSystem::Sun, SolarSystem::Moon };
 
-        // sun position and velocity in ICRS, unit: km, km/day
-        double rv_sun[6] = {0.0};
-        target = SolarSystem::Sun;
-        pSolSys->computeState(jd_tt, target, center, rv_sun);
+        // sun and moon position and velocity in ICRS, unit: km, km/day
+        double rv_planets[2][6] = {{0.0}};
+        pSolSys->computeStates(jd_tt, targets, 2, center, rv_planets);
 
-        // moon position and velocity in ICRS, unit: km, km/day
-        double rv_moon[6] = {0.0};
-        target = SolarSystem::Moon;
-        pSolSys->computeState(jd_tt, target, center, rv_moon);
+        const double* rv_sun  = rv_planets[0];
+        const double* rv_moon = rv_planets[1];
 
         // sun position in ICRS, unit: m
         Vector<double> r_sun(3,0.0);
@@ -45,6 +45,8 @@
 #include "StringUtils.hpp"
 #include "Legendre.hpp"
 #include "Epoch.hpp"
+#include <vector>
+#include <algorithm>
 
 
 using namespace std;
@@ -65,6 +67,13 @@ namespace gpstk
             GPSTK_THROW(fme);
         }
 
+        // the coefficients are read up to the desired degree, and at least
+        // up to degree 20 for the time-variable corrections
+        egmData.maxDegree = std::max(desiredDegree, 20);
+
+        int size( indexTranslator(egmData.maxDegree,egmData.maxDegree) );
+        egmData.normalizedCS.resize(size,4,0.0);
+
         // First, file header
         string temp;
         while( getline(inpf,temp) )
@@ -100,7 +109,7 @@ namespace gpstk
 
             int id = indexTranslator(L,M)-1;
 
-            if(L<=20 && M<=20)
+            if(L<=egmData.maxDegree && M<=egmData.maxDegree)
             {
                 egmData.normalizedCS(id, 0) = C;
                 egmData.normalizedCS(id, 1) = S;
@@ -122,9 +131,73 @@ namespace gpstk
             GPSTK_THROW(fme);
         }
 
+        prepare();
+
     }  // End of method 'EGM08Model::loadFile()'
 
 
+    // Compute the coefficients of the Legendre recursion and the working
+    // copy of Cnm and Snm for the desired degree and order.
+    void EGM08Model::prepare()
+    {
+        sumDegree = std::max( std::min(desiredDegree, egmData.maxDegree), 0 );
+        sumOrder  = std::max( std::min(desiredOrder, sumDegree), 0 );
+
+        int size( indexTranslator(sumDegree,sumDegree) );
+
+        recA.assign(size, 0.0);
+        recB.assign(size, 0.0);
+        recK.assign(size, 0.0);
+
+        for(int n=1; n<=sumDegree; ++n)
+        {
+            int row( n*(n+1)/2 );
+
+            // gnm and hnm, see Legendre.cpp
+            for(int m=0; m<n; ++m)
+            {
+                recA[row+m] = std::sqrt((2*n+1.0)*(2*n-1.0)/(n+m)/(n-m));
+
+                if(m < n-1)
+                {
+                    recB[row+m] = std::sqrt((2*n+1.0)*(n-m-1.0)*(n+m-1.0)
+                                            /(2*n-3.0)/(n+m)/(n-m));
+                }
+            }
+
+            // fn of the sectorial P(n,n)
+            double delta( (1 == n) ? 1.0 : 0.0 );
+            recA[row+n] = std::sqrt((1.0+delta)*(2*n+1.0)/(2*n));
+        }
+
+        // knm; it stays zero for m = n, where P(n,m+1) is not used
+        for(int n=0; n<=sumDegree; ++n)
+        {
+            int row( n*(n+1)/2 );
+
+            for(int m=0; m<n; ++m)
+            {
+                double delta( (0 == m) ? 1.0 : 0.0 );
+                recK[row+m] = std::sqrt((2.0-delta)*(n-m)*(n+m+1.0)/2);
+            }
+        }
+
+        // Cnm and Snm, at least up to degree 4 for the corrections
+        int rows( std::max(size, indexTranslator(4,4)) );
+
+        workCS.resize(2*rows);
+
+        for(int i=0; i<rows; ++i)
+        {
+            workCS[2*i+0] = egmData.normalizedCS(i,0);
+            workCS[2*i+1] = egmData.normalizedCS(i,1);
+        }
+
+        numCorrected = 0;
+
+    }  // End of method 'EGM08Model::prepare()'
+
+
     /** Compute acceleration (and related partial derivatives) of EGM.
      * @param tt        TT
      * @param orbits    orbits
@@ -133,8 +206,22 @@ namespace gpstk
                               const satVectorMap& orbits )
     {
 
-        // make a copy of Spherical Harmonic Coefficients
-        Matrix<double> CS( egmData.normalizedCS );
+        // the desired degree or order may have changed since the last call
+        int degree( std::max(std::min(desiredDegree, egmData.maxDegree), 0) );
+        int order( std::max(std::min(desiredOrder, degree), 0) );
+
+        if(degree != sumDegree || order != sumOrder)
+        {
+            prepare();
+        }
+
+        // restore the Spherical Harmonic Coefficients corrected at the last
+        // epoch, rather than making a copy of all of them
+        for(int i=0; i<numCorrected; ++i)
+        {
+            workCS[2*i+0] = egmData.normalizedCS(i,0);
+            workCS[2*i+1] = egmData.normalizedCS(i,1);
+        }
 
         // compute time in years since J2000
         CommonTime utc( pRefSys->TT2UTC(tt) );
@@ -166,24 +253,20 @@ namespace gpstk
 
         // indexes for degree = 3
         int id30 = indexTranslator(3,0) - 1;
-        int id31 = indexTranslator(3,1) - 1;
-        int id32 = indexTranslator(3,2) - 1;
-        int id33 = indexTranslator(3,3) - 1;
 
         // indexes for degree = 4
         int id40 = indexTranslator(4,0) - 1;
-        int id41 = indexTranslator(4,1) - 1;
-        int id42 = indexTranslator(4,2) - 1;
-        int id43 = indexTranslator(4,3) - 1;
         int id44 = indexTranslator(4,4) - 1;
 
+        numCorrected = id44 + 1;
+
 
         // The instantaneous value of coefficients Cn0 to be used when computing
         // orbits
         // see IERS Conventions 2010, Equations 6.4
-        CS(id20, 0) = value[0] + ly1*rate[0];  // C20
-        CS(id30, 0) = value[1] + ly1*rate[1];  // C30
-        CS(id40, 0) = value[2] + ly1*rate[2];  // C40
+        workCS[2*id20] = value[0] + ly1*rate[0];  // C20
+        workCS[2*id30] = value[1] + ly1*rate[1];  // C30
+        workCS[2*id40] = value[2] + ly1*rate[2];  // C40
 
 
         // Coefficients of the IERS (2010) mean pole model
@@ -223,13 +306,13 @@ namespace gpstk
         // C21 = +sqrt(3)*xpm*C20 - xpm*C22 + ypm*S22
         // S21 = -sqrt(3)*ypm*C20 - ypm*C22 - xpm*S22
         //
-        double C20 = CS(id20,0);
-        double C22 = CS(id22,0); double S22 = CS(id22,1);
+        double C20 = workCS[2*id20];
+        double C22 = workCS[2*id22]; double S22 = workCS[2*id22+1];
 
         double C21 = +std::sqrt(3.0)*xpm*C20 - xpm*C22 + ypm*S22;
         double S21 = -std::sqrt(3.0)*ypm*C20 - ypm*C22 - xpm*S22;
 
-        CS(id21,0) = C21; CS(id21,1) = S21;
+        workCS[2*id21] = C21; workCS[2*id21+1] = S21;
 
 
         //// Tide corrections ////
@@ -241,326 +324,389 @@ namespace gpstk
         {
             // corrections of CS
             dCS = pSolidTide->getSolidTide(tt);
-
-            for(int i=0; i<dCS.rows(); ++i)
-            {
-                CS(i,0) += dCS(i,0);
-                CS(i,1) += dCS(i,1);
-            }
+            addCorrections(dCS);
         }
 
         // ocean tides
         if(pOceanTide != NULL)
         {
             dCS = pOceanTide->getOceanTide(tt);
-
-            for(int i=0; i<dCS.rows(); ++i)
-            {
-                CS(i,0) += dCS(i,0);
-                CS(i,1) += dCS(i,1);
-            }
+            addCorrections(dCS);
         }
 
         // solid Earth pole tide and ocean pole tide
         if(pPoleTide != NULL)
         {
             dCS = pPoleTide->getPoleTide(tt);
-
-            for(int i=0; i<dCS.rows(); ++i)
-            {
-                CS(i,0) += dCS(i,0);
-                CS(i,1) += dCS(i,1);
-            }
+            addCorrections(dCS);
         }
 
 
         // transformation matrixes between ICRS and ITRS
-        Matrix<double> C2T = pRefSys->C2TMatrix(utc);
-        Matrix<double> T2C = transpose(C2T);
+        Matrix<double> C2TMat = pRefSys->C2TMatrix(utc);
 
-        SatID sat;
-        Vector<double> orbit;
-
-        Vector<double> r_sat_icrs(3,0.0);
-        Vector<double> r_sat_itrs(3,0.0);
-        double rx(0.0), ry(0.0), rz(0.0);
-        double rho(0.0), lat(0.0), lon(0.0);
-        double slat(0.0), clat(0.0);
+        double C2T[3][3];
+        for(int i=0; i<3; ++i)
+        {
+            for(int j=0; j<3; ++j)
+            {
+                C2T[i][j] = C2TMat(i,j);
+            }
+        }
 
-        Vector<double> slon(desiredDegree+1,0.0);
-        Vector<double> clon(desiredDegree+1,0.0);
-        slon(0) = 0.0; clon(0) = 1.0;
+        // the map elements are created here, so that the satellites can
+        // be computed in parallel
+        int numSats( orbits.size() );
+        std::vector<satVectorMap::const_iterator> sats;
+        std::vector<Vector<double>*> accs;
+        std::vector<Matrix<double>*> partialRs;
+        sats.reserve(numSats);
+        accs.reserve(numSats);
+        partialRs.reserve(numSats);
 
-        Vector<double> leg0, leg1, leg2;
+        for( satVectorMap::const_iterator it = orbits.begin();
+             it != orbits.end();
+             ++it )
+        {
+            sats.push_back(it);
+            accs.push_back( &satAcc[it->first] );
+            partialRs.push_back( &satPartialR[it->first] );
+        }
 
-        // partials of (rho, lat, lon) in ITRS to (x, y, z) in ITRS
-        Matrix<double> b(3,3,0.0);
+        // P(n,m+1) is needed for the derivative of P(n,m)
+        int legOrder( std::min(order+1, degree) );
 
-        Matrix<double> db_drho(3,3,0.0);     // db / drho
-        Matrix<double> db_dlat(3,3,0.0);     // db / dlat
-        Matrix<double> db_dlon(3,3,0.0);     // db / dlon
+        const double* A( recA.empty() ? NULL : &recA[0] );
+        const double* B( recB.empty() ? NULL : &recB[0] );
+        const double* K( recK.empty() ? NULL : &recK[0] );
+        const double* CS( &workCS[0] );
 
-        ///////////// partials of v to (rho, lat, lon) in ITRS ////////////////
-        //                                                                   //
-        //                           | dv / drho |                           //
-        //                  f_rll =  | dv / dlat |                           //
-        //                           | dv / dlon |                           //
-        //                                                                   //
-        ///////////////////////////////////////////////////////////////////////
-        Vector<double> f_rll(3,0.0);
+#ifdef _OPENMP
+   #pragma omp parallel if(parallel)
+#endif
+        {
+            // fully normalized associated legendre functions P(n,m), at
+            // n*(n+1)/2+m; the extra element is P(n+1,0) of the last degree,
+            // read (and multiplied by knm = 0) for m = n
+            std::vector<double> leg( indexTranslator(degree,degree)+1, 0.0 );
+            double* P( &leg[0] );
 
+            // sin(m*lon) and cos(m*lon)
+            std::vector<double> slon(order+2,0.0), clon(order+2,0.0);
+            slon[0] = 0.0; clon[0] = 1.0;
 
-        ///////////// partials of f_rll to (rho, lat, lon) in ITRS ////////////
-        //                                                                   //
-        //         | df_rll(0) / drho, df_rll(0) / dlat, df_rll(0) / dlon |  //
-        // g_rll = | df_rll(1) / drho, df_rll(1) / dlat, df_rll(1) / dlon |  //
-        //         | df_rll(2) / drho, df_rll(2) / dlat, df_rll(2) / dlon |  //
-        //                                                                   //
-        ///////////////////////////////////////////////////////////////////////
-        Matrix<double> g_rll(3,3,0.0);
+            double r_itrs[3];
+            double rx(0.0), ry(0.0), rz(0.0);
+            double rho(0.0), lat(0.0), lon(0.0);
+            double slat(0.0), clat(0.0), tlat(0.0);
 
+            // partials of (rho, lat, lon) in ITRS to (x, y, z) in ITRS
+            double b[3][3];
+
+            double db_drho[3][3];     // db / drho
+            double db_dlat[3][3];     // db / dlat
+            double db_dlon[3][3];     // db / dlon
+
+            ///////////// partials of v to (rho, lat, lon) in ITRS ////////////////
+            //                                                                   //
+            //                           | dv / drho |                           //
+            //                  f_rll =  | dv / dlat |                           //
+            //                           | dv / dlon |                           //
+            //                                                                   //
+            ///////////////////////////////////////////////////////////////////////
+            double f_rll[3];
+
+
+            ///////////// partials of f_rll to (rho, lat, lon) in ITRS ////////////
+            //                                                                   //
+            //         | df_rll(0) / drho, df_rll(0) / dlat, df_rll(0) / dlon |  //
+            // g_rll = | df_rll(1) / drho, df_rll(1) / dlat, df_rll(1) / dlon |  //
+            //         | df_rll(2) / drho, df_rll(2) / dlat, df_rll(2) / dlon |  //
+            //                                                                   //
+            ///////////////////////////////////////////////////////////////////////
+            double g_rll[3][3];
+
+            double gm_r1(0.0), gm_r2(0.0), gm_r3(0.0);
+
+            // partials of gravitation acceleration in ITRS to (rho, lat, lon)
+            double df_itrs_drll[3][3];
+
+            // gravitation acceleration in ICRS
+            Vector<double> a(3,0.0);
+
+            // partials of gravitation acceleration in ICRS to (x, y, z) in ICRS
+            Matrix<double> da_dr(3,3,0.0);
+
+#ifdef _OPENMP
+   #pragma omp for schedule(dynamic)
+#endif
+            for(int k=0; k<numSats; ++k)
+            {
+                const Vector<double>& orbit = sats[k]->second;
 
-        ///// partials of df_rll to (Cnm, Snm), ([n*(n+1)/2] + (m+1)], 6) /////
-        //                                                                   //
-        //                  c_rll =  | df_rll(0:2) / dCnm |                  //
-        //                  s_rll =  | df_rll(0:2) / dSnm |                  //
-        //                                                                   //
-        //               df_itrs_dcs =  | c_rll, s_rll, ... |                //
-        //                                                                   //
-        ///////////////////////////////////////////////////////////////////////
-        Vector<double> c_rll(3,0.0), s_rll(3,0.0);
-        Matrix<double> df_itrs_dcs;
+                // satellite position in ITRS
+                for(int i=0; i<3; ++i)
+                {
+                    r_itrs[i] = C2T[i][0]*orbit(0)
+                              + C2T[i][1]*orbit(1)
+                              + C2T[i][2]*orbit(2);
+                }
+                rx = r_itrs[0];
+                ry = r_itrs[1];
+                rz = r_itrs[2];
+
+                // geocentric distance, latitude and longitude of satellite
+                // the latitude is in [-PI/2,+PI/2], the longitude is in [-PI,+PI]
+                rho = std::sqrt(rx*rx + ry*ry + rz*rz);
+                lat = std::atan( rz / std::sqrt(rx*rx + ry*ry) );
+                lon = std::atan2( ry, rx );
+
+                // sine, cosine and tangent of geocentric latitude
+                slat = std::sin(lat);
+                clat = std::cos(lat);
+                tlat = std::tan(lat);
+
+                // sine and cosine of geocentric longitude
+                //    slon(i) = slon(i-1)*cos(lon) + clon(i-1)*sin(lon)
+                //    clon(i) = clon(i-1)*cos(lon) - slon(i-1)*sin(lon)
+                slon[1] = std::sin(lon);  clon[1] = std::cos(lon);
+
+                for(int i=2; i<=order; ++i)
+                {
+                    slon[i] = slon[i-1]*clon[1] + clon[i-1]*slon[1];
+                    clon[i] = clon[i-1]*clon[1] - slon[i-1]*slon[1];
+                }
 
-        double gm_r1(0.0), gm_r2(0.0), gm_r3(0.0);
+                // P(n,m) up to order legOrder, by the forward column recursion
+                //    P(n,m) = gnm * sin(lat) * P(n-1,m) - hnm * P(n-2,m)
+                //    P(n,n) = fn * cos(lat) * P(n-1,n-1)
+                // the loop on m has no branch, so that it can be vectorized
+                P[0] = 1.0;
 
-        // (ae/rho)^n
-        double fct(0.0);
+                for(int n=1; n<=degree; ++n)
+                {
+                    int row( n*(n+1)/2 );
+                    int row1( row - n );
+                    int row2( row1 - (n-1) );
+                    int mEnd( std::min(n-2, legOrder) );
+
+                    for(int m=0; m<=mEnd; ++m)
+                    {
+                        P[row+m] = A[row+m]*slat*P[row1+m] - B[row+m]*P[row2+m];
+                    }
+
+                    if(n-1 <= legOrder)
+                    {
+                        P[row+n-1] = A[row+n-1]*slat*P[row1+n-1];
+                    }
+
+                    if(n <= legOrder)
+                    {
+                        P[row+n] = A[row+n]*clat*P[row1+n-1];
+                    }
+                }
+
+                // partials of (rho, lat, lon) in ITRS to (x, y, z) in ITRS
+                b[0][0] =  clat * clon[1];
+                b[0][1] =  clat * slon[1];
+                b[0][2] =  slat;
+                b[1][0] = -slat * clon[1] / rho;
+                b[1][1] = -slat * slon[1] / rho;
+                b[1][2] =  clat / rho;
+                b[2][0] = -slon[1] / (rho * clat);
+                b[2][1] =  clon[1] / (rho * clat);
+                b[2][2] =  0.0;
+
+                // partials of b to (rho, lat, lon) in ITRS
+                db_drho[0][0] =  0.0;
+                db_drho[0][1] =  0.0;
+                db_drho[0][2] =  0.0;
+                db_drho[1][0] =  slat * clon[1] / (rho*rho);
+                db_drho[1][1] =  slat * slon[1] / (rho*rho);
+                db_drho[1][2] = -clat / (rho*rho);
+                db_drho[2][0] =  slon[1] / (rho*rho * clat);
+                db_drho[2][1] = -clon[1] / (rho*rho * clat);
+                db_drho[2][2] =  0.0;
+
+                db_dlat[0][0] = -slat * clon[1];
+                db_dlat[0][1] = -slat * slon[1];
+                db_dlat[0][2] =  clat;
+                db_dlat[1][0] = -clat * clon[1] / rho;
+                db_dlat[1][1] = -clat * slon[1] / rho;
+                db_dlat[1][2] = -slat / rho;
+                db_dlat[2][0] = -slat * slon[1] / (rho * clat*clat);
+                db_dlat[2][1] =  slat * clon[1] / (rho * clat*clat);
+                db_dlat[2][2] =  0.0;
+
+                db_dlon[0][0] = -clat * slon[1];
+                db_dlon[0][1] =  clat * clon[1];
+                db_dlon[0][2] =  0.0;
+                db_dlon[1][0] =  slat * slon[1] / rho;
+                db_dlon[1][1] = -slat * clon[1] / rho;
+                db_dlon[1][2] =  0.0;
+                db_dlon[2][0] = -clon[1] / (rho * clat);
+                db_dlon[2][1] = -slon[1] / (rho * clat);
+                db_dlon[2][2] =  0.0;
+
+                // (GM/rho)^1, (GM/rho)^2, (GM/rho)^3
+                gm_r1 = egmData.GM / rho;
+                gm_r2 = gm_r1 / rho;
+                gm_r3 = gm_r2 / rho;
+
+                // sums over the degrees, weighted by (ae/rho)^n
+                double sf0(0.0), sf1(0.0), sf2(0.0);
+                double sg00(0.0), sg01(0.0), sg02(0.0);
+                double sg11(0.0), sg12(0.0), sg22(0.0);
+
+                double q( egmData.ae/rho );
+                double fct(1.0);
+
+                // loop for degree
+                for(int n=0; n<=degree; ++n, fct*=q)
+                {
+                    int row( n*(n+1)/2 );
+                    int mEnd( std::min(n, order) );
+                    double nn( n*(n+1.0) );
+
+                    // sums over the orders
+                    double s0(0.0), s1(0.0), s2(0.0), s3(0.0), s4(0.0), s5(0.0);
+
+                    // loop for order
+                    for(int m=0; m<=mEnd; ++m)
+                    {
+                        double P0 = P[row+m];
+
+                        // derivatives of Pnm wrt latitude
+                        double P1 = K[row+m]*P[row+m+1] - m*tlat*P0;
+                        double P2 = (m*m/clat/clat - nn)*P0 + tlat*P1;
+
+                        double Cnm = CS[2*(row+m)+0];
+                        double Snm = CS[2*(row+m)+1];
+
+                        double t1 =  Cnm*clon[m] + Snm*slon[m];
+                        double t2 = -Cnm*slon[m] + Snm*clon[m];
+
+                        s0 += P0*t1;
+                        s1 += P1*t1;
+                        s2 += m*P0*t2;
+                        s3 += P2*t1;
+                        s4 += m*P1*t2;
+                        s5 += m*m*P0*t1;
+                    }
+
+                    sf0  += (n+1)*fct*s0;
+                    sf1  += fct*s1;
+                    sf2  += fct*s2;
+                    sg00 += (n+1)*(n+2)*fct*s0;
+                    sg01 += (n+1)*fct*s1;
+                    sg02 += (n+1)*fct*s2;
+                    sg11 += fct*s3;
+                    sg12 += fct*s4;
+                    sg22 += fct*s5;
+
+                }   // End of 'for(int n=0; ...)'
+
+                // f_rll
+                f_rll[0] = -gm_r2*sf0;
+                f_rll[1] =  gm_r1*sf1;
+                f_rll[2] =  gm_r1*sf2;
+
+                // g_rll, with the symmetry of gradiometry
+                g_rll[0][0] =  gm_r3*sg00;
+                g_rll[0][1] = -gm_r2*sg01;
+                g_rll[0][2] = -gm_r2*sg02;
+                g_rll[1][1] =  gm_r1*sg11;
+                g_rll[1][2] =  gm_r1*sg12;
+                g_rll[2][2] = -gm_r1*sg22;
+
+                g_rll[1][0] = g_rll[0][1];
+                g_rll[2][0] = g_rll[0][2];
+                g_rll[2][1] = g_rll[1][2];
+
+                // a = T2C * transpose(b) * f_rll
+                double a_itrs[3];
+                for(int i=0; i<3; ++i)
+                {
+                    a_itrs[i] = b[0][i]*f_rll[0]
+                              + b[1][i]*f_rll[1]
+                              + b[2][i]*f_rll[2];
+                }
 
-        // index for (n,m)
-        int idnm(0);
+                for(int i=0; i<3; ++i)
+                {
+                    a(i) = C2T[0][i]*a_itrs[0]
+                         + C2T[1][i]*a_itrs[1]
+                         + C2T[2][i]*a_itrs[2];
+                }
 
-        // Pnm and its derivatives wrt latitude
-        double P0(0.0), P1(0.0), P2(0.0);
+                *accs[k] = a;
 
-        // Cnm, Snm
-        double Cnm(0.0), Snm(0.0);
+                for(int i=0; i<3; ++i)
+                {
+                    df_itrs_drll[i][0] = g_rll[0][0]*b[0][i] + f_rll[0]*db_drho[0][i]
+                                       + g_rll[1][0]*b[1][i] + f_rll[1]*db_drho[1][i]
+                                       + g_rll[2][0]*b[2][i] + f_rll[2]*db_drho[2][i];
+                    df_itrs_drll[i][1] = g_rll[0][1]*b[0][i] + f_rll[0]*db_dlat[0][i]
+                                       + g_rll[1][1]*b[1][i] + f_rll[1]*db_dlat[1][i]
+                                       + g_rll[2][1]*b[2][i] + f_rll[2]*db_dlat[2][i];
+                    df_itrs_drll[i][2] = g_rll[0][2]*b[0][i] + f_rll[0]*db_dlon[0][i]
+                                       + g_rll[1][2]*b[1][i] + f_rll[1]*db_dlon[1][i]
+                                       + g_rll[2][2]*b[2][i] + f_rll[2]*db_dlon[2][i];
+                }
+
+                // da_dr = T2C * df_itrs_drll * b * C2T
+                double m1[3][3], m2[3][3];
+                for(int i=0; i<3; ++i)
+                {
+                    for(int j=0; j<3; ++j)
+                    {
+                        m1[i][j] = df_itrs_drll[i][0]*b[0][j]
+                                 + df_itrs_drll[i][1]*b[1][j]
+                                 + df_itrs_drll[i][2]*b[2][j];
+                    }
+                }
+                for(int i=0; i<3; ++i)
+                {
+                    for(int j=0; j<3; ++j)
+                    {
+                        m2[i][j] = m1[i][0]*C2T[0][j]
+                                 + m1[i][1]*C2T[1][j]
+                                 + m1[i][2]*C2T[2][j];
+                    }
+                }
+                for(int i=0; i<3; ++i)
+                {
+                    for(int j=0; j<3; ++j)
+                    {
+                        da_dr(i,j) = C2T[0][i]*m2[0][j]
+                                   + C2T[1][i]*m2[1][j]
+                                   + C2T[2][i]*m2[2][j];
+                    }
+                }
 
-        // sin(m*lon) and cos(m*lon)
-        double smlon(0.0), cmlon(0.0);
+                *partialRs[k] = da_dr;
 
-        // gravitation acceleration in ICRS
-        Vector<double> a(3,0.0);
+            } // End of 'for(int k=0; ...)'
 
-        // partials of gravitation acceleration in ICRS to (x, y, z) in ICRS
-        Matrix<double> df_itrs_drll(3,3,0.0);
+        } // End of 'parallel'
 
-        Matrix<double> da_dr(3,3,0.0);
+    } // End of method 'EGM08Model::Compute(...)'
 
-        // partials of gravitation acceleration in ICRS to (vx, vy, vz) in ICRS
-        Matrix<double> da_dv(3,3,0.0);
 
-        // partials of gravitation acceleration in ICRS to (Cnm, Snm) in ICRS
-        Matrix<double> da_dEGM;
+    // Add time-variable corrections to the working Cnm and Snm; the
+    // corrections beyond the coefficients in use are ignored.
+    void EGM08Model::addCorrections(const Matrix<double>& dCS)
+    {
+        int rows( std::min<int>(dCS.rows(), workCS.size()/2) );
 
-        for( satVectorMap::const_iterator it = orbits.begin();
-             it != orbits.end();
-             ++it )
+        for(int i=0; i<rows; ++i)
         {
-            sat = it->first;
-            orbit = it->second;
-
-            // satellite position in ICRS
-            r_sat_icrs(0) = orbit(0);
-            r_sat_icrs(1) = orbit(1);
-            r_sat_icrs(2) = orbit(2);
-
-            // satellite position in ITRS
-            r_sat_itrs = C2T * r_sat_icrs;
-            rx = r_sat_itrs(0);
-            ry = r_sat_itrs(1);
-            rz = r_sat_itrs(2);
-
-            // geocentric distance, latitude and longitude of satellite
-            // the latitude is in [-PI/2,+PI/2], the longitude is in [-PI,+PI]
-            rho = norm(r_sat_itrs);
-            lat = std::atan( rz / std::sqrt(rx*rx + ry*ry) );
-            lon = std::atan2( ry, rx );
-
-            // sine and cosine of geocentric latitude
-            slat = std::sin(lat);
-            clat = std::cos(lat);
-
-            // sine and cosine of geocentric longitude
-            //    slon(0) = sin(0*lon);
-            //    slon(1) = sin(1*lon);
-            //        ......
-            //    slon(i) = slon(i-1)*cos(lon) + clon(i-1)*sin(lon)
-            //    clon(i) = clon(i-1)*cos(lon) - slon(i-1)*sin(lon)
-            slon(1) = std::sin(lon);  clon(1) = std::cos(lon);
-
-            for(int i=2; i<=desiredDegree; ++i)
-            {
-                slon(i) = slon(i-1)*clon(1) + clon(i-1)*slon(1);
-                clon(i) = clon(i-1)*clon(1) - slon(i-1)*slon(1);
-            }
-
-            // fully normalized associated legendre functions and its gradients
-            legendre(desiredDegree, lat, leg0, leg1, leg2, 2);
-
-            // partials of (rho, lat, lon) in ITRS to (x, y, z) in ITRS
-            b(0,0) =  clat * clon(1);
-            b(0,1) =  clat * slon(1);
-            b(0,2) =  slat;
-            b(1,0) = -slat * clon(1) / rho;
-            b(1,1) = -slat * slon(1) / rho;
-            b(1,2) =  clat / rho;
-            b(2,0) = -slon(1) / (rho * clat);
-            b(2,1) =  clon(1) / (rho * clat);
-
-
-            // partials of b to (rho, lat, lon) in ITRS
-            db_drho(1,0) =  slat * clon(1) / (rho*rho);
-            db_drho(1,1) =  slat * slon(1) / (rho*rho);
-            db_drho(1,2) = -clat / (rho*rho);
-            db_drho(2,0) =  slon(1) / (rho*rho * clat);
-            db_drho(2,1) = -clon(1) / (rho*rho * clat);
-
-            db_dlat(0,0) = -slat * clon(1);
-            db_dlat(0,1) = -slat * slon(1);
-            db_dlat(0,2) =  clat;
-            db_dlat(1,0) = -clat * clon(1) / rho;
-            db_dlat(1,1) = -clat * slon(1) / rho;
-            db_dlat(1,2) = -slat / rho;
-            db_dlat(2,0) = -slat * slon(1) / (rho * clat*clat);
-            db_dlat(2,1) =  slat * clon(1) / (rho * clat*clat);
-
-            db_dlon(0,0) = -clat * slon(1);
-            db_dlon(0,1) =  clat * clon(1);
-            db_dlon(1,0) =  slat * slon(1) / rho;
-            db_dlon(1,1) = -slat * clon(1) / rho;
-            db_dlon(2,0) = -clon(1) / (rho * clat);
-            db_dlon(2,1) = -slon(1) / (rho * clat);
-
-
-//            if(satGravimetry)     // need to do: consider Sn0 = 0 !!!
-//            {
-//                int size = indexTranslator(desiredDegree,desiredOrder) - 1;
-//                df_itrs_dcs.resize(3,size*2,0.0);
-//            }
-
-            // (GM/rho)^1, (GM/rho)^2, (GM/rho)^3
-            gm_r1 = egmData.GM / rho;
-            gm_r2 = gm_r1 / rho;
-            gm_r3 = gm_r2 / rho;
-
-            f_rll.resize(3,0.0);
-            g_rll.resize(3,3,0.0);
-
-            // loop for degree
-            for(int n=0; n<=desiredDegree; ++n)
-            {
-                fct = std::pow(egmData.ae/rho, n);
-
-                // loop for order
-                for(int m=0; m<=n && m<=desiredOrder; ++m)
-                {
-                    idnm = indexTranslator(n,m) - 1;
-
-                    P0 = leg0(idnm);
-                    P1 = leg1(idnm);
-                    P2 = leg2(idnm);
-
-                    Cnm = CS(idnm,0);
-                    Snm = CS(idnm,1);
-
-                    smlon = slon(m);
-                    cmlon = clon(m);
-
-                    // f_rll
-                    f_rll(0) += -gm_r2*(n+1)*fct*P0*(Cnm*cmlon+Snm*smlon);
-                    f_rll(1) +=  gm_r1*fct*P1*(Cnm*cmlon+Snm*smlon);
-                    f_rll(2) +=  gm_r1*m*fct*P0*(-Cnm*smlon+Snm*cmlon);
-
-                    // g_rll
-                    g_rll(0,0) +=  gm_r3*(n+1)*(n+2)*fct*P0*(Cnm*cmlon+Snm*smlon);
-                    g_rll(0,1) += -gm_r2*(n+1)*fct*P1*(Cnm*cmlon+Snm*smlon);
-                    g_rll(0,2) += -gm_r2*(n+1)*m*fct*P0*(-Cnm*smlon+Snm*cmlon);
-                    g_rll(1,1) +=  gm_r1*fct*P2*(Cnm*cmlon+Snm*smlon);
-                    g_rll(1,2) +=  gm_r1*m*fct*P1*(-Cnm*smlon+Snm*cmlon);
-                    g_rll(2,2) += -gm_r1*m*m*fct*P0*(Cnm*cmlon+Snm*smlon);
-
-//                    if(satGravimetry)
-//                    {
-//                        // c_rll
-//                        c_rll(0) = -gm_r2 * (n+1) * fct * P0 * cmlon;
-//                        c_rll(1) =  gm_r1 * fct * P1 * cmlon;
-//                        c_rll(2) = -gm_r1 * m * fct * P0 * smlon;
-//
-//                        // s_rll
-//                        s_rll(0) = -gm_r2 * (n+1) * fct * P0 * smlon;
-//                        s_rll(1) =  gm_r1 * fct * P1 * smlon;
-//                        s_rll(2) =  gm_r1 * m * fct * P0 * cmlon;
-//
-//                        // df_itrs_dcs
-//                        df_itrs_dcs(0,idnm+0) = c_rll(0)*b(0,0)
-//                                              + c_rll(1)*b(1,0)
-//                                              + c_rll(2)*b(2,0);
-//                        df_itrs_dcs(1,idnm+0) = c_rll(0)*b(0,1)
-//                                              + c_rll(1)*b(1,1)
-//                                              + c_rll(2)*b(2,1);
-//                        df_itrs_dcs(2,idnm+0) = c_rll(0)*b(0,2)
-//                                              + c_rll(1)*b(1,2)
-//                                              + c_rll(2)*b(2,2);
-//                        df_itrs_dcs(0,idnm+1) = s_rll(0)*b(0,0)
-//                                              + s_rll(1)*b(1,0)
-//                                              + s_rll(2)*b(2,0);
-//                        df_itrs_dcs(1,idnm+1) = s_rll(0)*b(0,1)
-//                                              + s_rll(1)*b(1,1)
-//                                              + s_rll(2)*b(2,1);
-//                        df_itrs_dcs(2,idnm+1) = s_rll(0)*b(0,2)
-//                                              + s_rll(1)*b(1,2)
-//                                              + s_rll(2)*b(2,2);
-//                    }
-
-                }   // End of 'for(int m=0; ...)'
-
-            }   // End of 'for(int n=0; ...)'
-
-
-            // symmetry of gradiometry
-            g_rll(1,0) = g_rll(0,1);
-            g_rll(2,0) = g_rll(0,2);
-            g_rll(2,1) = g_rll(1,2);
-
-            a = T2C * transpose(b) * f_rll;
-            satAcc[sat] = a;
-
-            for(int i=0; i<3; ++i)
-            {
-                df_itrs_drll(i,0) = g_rll(0,0)*b(0,i) + f_rll(0)*db_drho(0,i)
-                                  + g_rll(1,0)*b(1,i) + f_rll(1)*db_drho(1,i)
-                                  + g_rll(2,0)*b(2,i) + f_rll(2)*db_drho(2,i);
-                df_itrs_drll(i,1) = g_rll(0,1)*b(0,i) + f_rll(0)*db_dlat(0,i)
-                                  + g_rll(1,1)*b(1,i) + f_rll(1)*db_dlat(1,i)
-                                  + g_rll(2,1)*b(2,i) + f_rll(2)*db_dlat(2,i);
-                df_itrs_drll(i,2) = g_rll(0,2)*b(0,i) + f_rll(0)*db_dlon(0,i)
-                                  + g_rll(1,2)*b(1,i) + f_rll(1)*db_dlon(1,i)
-                                  + g_rll(2,2)*b(2,i) + f_rll(2)*db_dlon(2,i);
-            }
-
-            da_dr = T2C * df_itrs_drll * b * C2T;
-            satPartialR[sat] = da_dr;
-
-//            // partials of gravitation acceleration in ICRS to (Cnm, Snm)
-//            if(satGravimetry)
-//            {
-//                da_dEGM = T2C * df_itrs_dcs;
-//
-//                satPartialEGM[sat] = da_dEGM;
-//            }
+            workCS[2*i+0] += dCS(i,0);
+            workCS[2*i+1] += dCS(i,1);
+        }
 
-        } // End of 'for(satVectorMap::const_iterator...)'
+        numCorrected = std::max(numCorrected, rows);
 
-    } // End of method 'EGM08Model::Compute(...)'
+    } // End of method 'EGM08Model::addCorrections()'
 
 }   // End of namespace 'gpstk'
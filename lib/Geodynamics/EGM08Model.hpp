@@ -43,6 +43,7 @@
 #ifndef EGM08_MODEL_HPP
 #define EGM08_MODEL_HPP
 
+#include <vector>
 #include "EGMModel.hpp"
 
 namespace gpstk
@@ -52,6 +53,12 @@ namespace gpstk
 
     /** EGM08 Model.
      *
+     * The coefficients are read up to the desired degree, which may be well
+     * above 20 (e.g. 70 to 120 for low Earth orbiters). The fully normalized
+     * associated Legendre functions are computed by the standard forward
+     * column recursion, with its coefficients computed once when the file is
+     * loaded and the rows of each degree contiguous in memory, so that
+     * Compute() does not allocate anything per satellite.
      */
     class EGM08Model : public EGMModel
     {
@@ -61,7 +68,7 @@ namespace gpstk
          * @param m    Desired order
          */
         EGM08Model (int n = 0, int m = 0)
-            : EGMModel(n, m)
+            : EGMModel(n, m), sumDegree(-1), sumOrder(-1), numCorrected(0)
         {
             // model name
             egmData.modelName = "EGM08";
@@ -78,6 +85,9 @@ namespace gpstk
             // reference epoch
             egmData.refMJD =  51544.5;
 
+            // the coefficients allocated by EGMModel
+            egmData.maxDegree = 20;
+
         };  // End of constructor
 
 
@@ -104,6 +114,38 @@ namespace gpstk
         { return egmData.modelName; }
 
 
+    private:
+
+        /// Compute the coefficients of the Legendre recursion and the
+        /// working copy of Cnm and Snm for the desired degree and order.
+        void prepare();
+
+
+        /// Add time-variable corrections of Cnm and Snm (from the tide
+        /// models) to the working copy.
+        void addCorrections(const Matrix<double>& dCS);
+
+
+        /// Degree and order of the sums done by Compute()
+        int sumDegree;
+        int sumOrder;
+
+        /// Coefficients of the recursion of the fully normalized associated
+        /// Legendre functions P(n,m), at n*(n+1)/2+m:
+        ///   recA: gnm of P(n-1,m), or fn of P(n-1,n-1) if m = n
+        ///   recB: hnm of P(n-2,m)
+        ///   recK: knm of P(n,m+1) in the derivative of P(n,m)
+        std::vector<double> recA;
+        std::vector<double> recB;
+        std::vector<double> recK;
+
+        /// Cnm and Snm used by Compute(), interleaved at 2*(n*(n+1)/2+m):
+        /// those of the file, with the time-variable corrections of the
+        /// first 'numCorrected' (n,m) of the last epoch
+        std::vector<double> workCS;
+        int numCorrected;
+
+
     }; // End of class 'EGM08Model'
 
     // @}
@@ -166,17 +166,14 @@ namespace gpstk
 
         double jd = JulianDate(tt).jd;
         SolarSystem::Planet center(SolarSystem::Earth);
-        SolarSystem::Planet target;
+        SolarSystem::Planet targets[2] = { SolarSystem::Moon, SolarSystem::Sun };
 
-        // moon position and velocity in ICRS, unit: km, km/day
-        target = SolarSystem::Moon;
-        double rv_moon[6] = {0.0};
-        pSolSys->computeState(jd, target, center, rv_moon);
+        // moon and sun position and velocity in ICRS, unit: km, km/day
+        double rv_planets[2][6] = {{0.0}};
+        pSolSys->computeStates(jd, targets, 2, center, rv_planets);
 
-        // sun position and velocity in ICRS, unit: km, km/day
-        target = SolarSystem::Sun;
-        double rv_sun[6] = {0.0};
-        pSolSys->computeState(jd, target, center,rv_sun);
+        const double* rv_moon = rv_planets[0];
+        const double* rv_sun  = rv_planets[1];
 
         // moon position in ICRS, unit: m
         Vector<double> rm_icrs(3,0.0);
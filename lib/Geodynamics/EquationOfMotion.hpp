@@ -51,7 +51,7 @@ namespace gpstk
     {
     public:
         /// Default constructor
-        EquationOfMotion() {};
+        EquationOfMotion() : parallel(false) {};
 
         /// Default deconstructor
         virtual ~EquationOfMotion() {};
@@ -64,6 +64,40 @@ namespace gpstk
         virtual satVectorMap getDerivatives( const CommonTime&   time,
                                              const satVectorMap& states ) = 0;
 
+
+        /** Compute the derivatives into an existing map, reusing the
+         *  storage of its vectors.
+         *
+         * Integrators call this method at every stage, so that the
+         * derivatives of a step do not allocate new vectors. The default
+         * calls the method above.
+         *
+         * @params t        time or the independent variable.
+         * @params y        the required data.
+         * @params dy       the derivatives, with the satellites of y.
+         */
+        virtual void getDerivatives( const CommonTime&   time,
+                                     const satVectorMap& states,
+                                     satVectorMap&       dStates )
+        { dStates = getDerivatives(time, states); };
+
+
+        /** Set whether the per-satellite work may be shared among the
+         *  OpenMP threads. Integrators in parallel mode set it.
+         */
+        virtual EquationOfMotion& setParallel(bool parallelMode)
+        { parallel = parallelMode; return (*this); };
+
+        /// Get whether the per-satellite work may be done in parallel.
+        bool getParallel() const
+        { return parallel; };
+
+
+    protected:
+
+        /// Whether the per-satellite work may be done in parallel
+        bool parallel;
+
     }; // End of class 'EquationOfMotion'
 
     // @}
@@ -65,6 +65,7 @@ namespace gpstk
     public:
         /// Constructor
         ForceModel()
+            : parallel(false)
         {
             satAcc.clear();
             satPartialR.clear();
@@ -88,6 +89,21 @@ namespace gpstk
         {};
 
 
+        /** Set whether the satellites may be computed in parallel.
+         *
+         * The quantities common to all the satellites are computed first,
+         * then the satellites are shared among the OpenMP threads. Models
+         * with little per-satellite work ignore it.
+         */
+        ForceModel& setParallel(bool parallelMode)
+        { parallel = parallelMode; return (*this); };
+
+
+        /// Get whether the satellites may be computed in parallel.
+        bool getParallel() const
+        { return parallel; };
+
+
         /// Return the force model name
         inline virtual std::string forceModelName() const
         { return "ForceModel"; };
@@ -195,6 +211,77 @@ namespace gpstk
         };
 
 
+        /** Add acceleration of the satellite to a[3], without copying
+         *  the stored vector.
+         */
+        void addAcceleration(const SatID& sat, double* a) const
+            throw(SatIDNotFound)
+        {
+            satVectorMap::const_iterator it( satAcc.find(sat) );
+
+            if( it == satAcc.end() )
+            {
+                GPSTK_THROW(SatIDNotFound("SatID not found in map"));
+            }
+
+            for(int i=0; i<3; ++i) a[i] += (*it).second(i);
+        };
+
+
+        /** Add da_dr of the satellite to da_dr[3*3], stored by rows,
+         *  without copying the stored matrix.
+         */
+        void addDA_dR(const SatID& sat, double* da_dr) const
+            throw(SatIDNotFound)
+        {
+            satMatrixMap::const_iterator it( satPartialR.find(sat) );
+
+            if( it == satPartialR.end() )
+            {
+                GPSTK_THROW(SatIDNotFound("SatID not found in map"));
+            }
+
+            for(int i=0; i<3; ++i)
+            {
+                for(int j=0; j<3; ++j)
+                {
+                    da_dr[3*i+j] += (*it).second(i,j);
+                }
+            }
+        };
+
+
+        /** Add da_dSRP of the satellite to da_dp[3*np], stored by rows,
+         *  without copying the stored matrix.
+         *
+         * @throw InvalidRequest if the stored da_dSRP hasn't np columns,
+         *  i.e. the SRP model doesn't match the state of the satellite.
+         */
+        void addDA_dSRP(const SatID& sat, double* da_dp, int np) const
+            throw(SatIDNotFound, InvalidRequest)
+        {
+            satMatrixMap::const_iterator it( satPartialSRP.find(sat) );
+
+            if( it == satPartialSRP.end() )
+            {
+                GPSTK_THROW(SatIDNotFound("SatID not found in map"));
+            }
+
+            if( int((*it).second.cols()) != np )
+            {
+                GPSTK_THROW(InvalidRequest("SRP parameters don't match"));
+            }
+
+            for(int i=0; i<3; ++i)
+            {
+                for(int j=0; j<np; ++j)
+                {
+                    da_dp[np*i+j] += (*it).second(i,j);
+                }
+            }
+        };
+
+
         /// Get coefficient matrix of equation of variation
         Matrix<double> getCoeffMatOfEOV(const SatID& sat) const
             throw(SatIDNotFound)
@@ -300,6 +387,9 @@ namespace gpstk
         /// Partial derivatives of acceleration wrt SRP coefficients
         satMatrixMap satPartialSRP;
 
+        /// Whether the satellites may be computed in parallel
+        bool parallel;
+
     }; // End of class 'ForceModel'
 
     // @}
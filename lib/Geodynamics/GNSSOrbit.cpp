@@ -44,16 +44,133 @@
 #include "GNSSOrbit.hpp"
 #include "Epoch.hpp"
 #include "Counter.hpp"
+#include <algorithm>
+#include <vector>
+
+#ifdef USE_OPENMP
+#include <omp.h>
+#endif
 
 
 using namespace std;
 
 
+namespace
+{
+    /* Dot of the state of one satellite
+     *
+     *  y = (r,v, dr/dr0,dr/dv0,dv/dr0,dv/dv0, dr/dp0,dv/dp0)
+     * dy = (v,a, dv/dr0,dv/dv0,da/dr0,da/dv0, dv/dp0,da/dp0)
+     *
+     * with da/dr0 = da/dr * dr/dr0, da/dv0 = da/dr * dr/dv0 and
+     * da/dp0 = da/dr * dr/dp0 + da/dp, i.e. dphi = A * phi.
+     *
+     * da_dr is 3x3 and da_dp is 3xnp, both stored by rows. NP is the
+     * number of force model parameters if known at compile time, or -1
+     * to use np, so that the common SRP models get fixed-size loops.
+     */
+    template<int NP>
+    void satDerivatives( const double* y,
+                         const double* a,
+                         const double* da_dr,
+                         const double* da_dp,
+                         int           np,
+                         double*       dy )
+    {
+        const int n( (NP >= 0) ? NP : np );
+
+        // v, a
+        for(int i=0; i<3; ++i)
+        {
+            dy[0+i] = y[3+i];
+            dy[3+i] = a[i];
+        }
+
+        // dv/dr0, dv/dv0
+        for(int k=0; k<18; ++k)
+        {
+            dy[6+k] = y[24+k];
+        }
+
+        // da/dr0, da/dv0
+        for(int i=0; i<3; ++i)
+        {
+            for(int j=0; j<3; ++j)
+            {
+                double da_dr0(0.0), da_dv0(0.0);
+
+                for(int k=0; k<3; ++k)
+                {
+                    da_dr0 += da_dr[3*i+k] * y[ 6+3*k+j];
+                    da_dv0 += da_dr[3*i+k] * y[15+3*k+j];
+                }
+
+                dy[24+3*i+j] = da_dr0;
+                dy[33+3*i+j] = da_dv0;
+            }
+        }
+
+        // dv/dp0
+        for(int k=0; k<3*n; ++k)
+        {
+            dy[42+k] = y[42+3*n+k];
+        }
+
+        // da/dp0
+        for(int i=0; i<3; ++i)
+        {
+            for(int j=0; j<n; ++j)
+            {
+                double da_dp0( da_dp[n*i+j] );
+
+                for(int k=0; k<3; ++k)
+                {
+                    da_dp0 += da_dr[3*i+k] * y[42+n*k+j];
+                }
+
+                dy[42+n*(3+i)+j] = da_dp0;
+            }
+        }
+
+    }  // End of function 'satDerivatives()'
+
+}  // End of unnamed namespace
+
+
 namespace gpstk
 {
+    // set whether the satellites may be computed in parallel
+    GNSSOrbit& GNSSOrbit::setParallel(bool parallelMode)
+    {
+        parallel = parallelMode;
+
+        if(pEGM != NULL) pEGM->setParallel(parallel);
+        if(pThd != NULL) pThd->setParallel(parallel);
+        if(pSRP != NULL) pSRP->setParallel(parallel);
+        if(pRel != NULL) pRel->setParallel(parallel);
+
+        return (*this);
+
+    }  // End of method 'GNSSOrbit::setParallel()'
+
+
     // get derivative dy/dt
     satVectorMap GNSSOrbit::getDerivatives( const CommonTime&   tt,
                                             const satVectorMap& states )
+    {
+        satVectorMap dStates;
+
+        getDerivatives(tt, states, dStates);
+
+        return dStates;
+
+    }  // End of method 'GNSSOrbit::getDerivatives()'
+
+
+    // get derivative dy/dt, reusing the vectors of dStates
+    void GNSSOrbit::getDerivatives( const CommonTime&   tt,
+                                    const satVectorMap& states,
+                                    satVectorMap&       dStates )
     {
         /* Dot of current state
          *
@@ -61,148 +178,161 @@ namespace gpstk
          *
          */
 
-        satVectorMap dStates;
-
         if(pEGM != NULL) pEGM->Compute(tt, states);
         if(pThd != NULL) pThd->Compute(tt, states);
         if(pSRP != NULL) pSRP->Compute(tt, states);
         if(pRel != NULL) pRel->Compute(tt, states);
 
-        int size( (states.begin()->second).size() );
-        int numSRP( (size-42)/6 );
+        // the map elements are created first, so that the satellites can
+        // be computed in parallel
+        int numSats( states.size() );
+        std::vector<satVectorMap::const_iterator> sats;
+        std::vector<Vector<double>*> dStatePtrs;
+        sats.reserve(numSats);
+        dStatePtrs.reserve(numSats);
 
-        SatID sat;
-        Vector<double> state(size,0.0);
-        Vector<double> dState(size,0.0);
+        satVectorMap::iterator dIt( dStates.begin() );
 
         for( satVectorMap::const_iterator it = states.begin();
              it != states.end();
              ++it )
         {
-            sat = it->first;
-            state = it->second;
-
-            // current acceleration and partial derivatives
-            Vector<double> a(3,0.0);
-            Matrix<double> da_dr(3,3,0.0);
-            Matrix<double> da_dv(3,3,0.0);
-            Matrix<double> da_dp(3,numSRP,0.0);
+            const SatID& sat( it->first );
 
-            if(pEGM != NULL)
+            // drop the satellites not integrated any more
+            while( dIt != dStates.end() && dIt->first < sat )
             {
-                a += pEGM->getAcceleration(sat);
-                da_dr += pEGM->dA_dR(sat);
+                dStates.erase(dIt++);
             }
 
-            if(pThd != NULL)
+            if( dIt == dStates.end() || sat < dIt->first )
             {
-                a += pThd->getAcceleration(sat);
-                da_dr += pThd->dA_dR(sat);
+                dIt = dStates.insert( dIt,
+                          satVectorMap::value_type(sat, Vector<double>()) );
             }
 
-            if(pSRP != NULL)
-            {
-                a += pSRP->getAcceleration(sat);
-                da_dp += pSRP->dA_dSRP(sat);
-            }
+            // only grows the vector the first time
+            (dIt->second).resize( (it->second).size() );
 
-            if(pRel != NULL)
-            {
-                a += pRel->getAcceleration(sat);
-                da_dr += pRel->dA_dR(sat);
-            }
+            sats.push_back(it);
+            dStatePtrs.push_back( &(dIt->second) );
+
+            ++dIt;
+        }
+
+        dStates.erase(dIt, dStates.end());
+
+        bool failed(false);
+        SatIDNotFound failure;
 
+        bool mismatched(false);
+        InvalidRequest mismatch;
 
-            /* Transition Matrix, (6+np, 6+np)
-             *       |                           |
-             *       |   dr/dr0  dr/dv0  dr/dp0  |
-             *       |                           |
-             * phi = |   dv/dr0  dv/dv0  dv/dp0  |
-             *       |                           |
-             *       |   0       0       I       |
-             *       |                           |
-             */
+#ifdef _OPENMP
+   #pragma omp parallel for schedule(dynamic) if(parallel)
+#endif
+        for(int k=0; k<numSats; ++k)
+        {
+            const SatID& sat( sats[k]->first );
+
+            int size( (sats[k]->second).size() );
+            int numSRP( (size-42)/6 );
 
-            Matrix<double> dr_dr0(3,3,0.0), dr_dv0(3,3,0.0);
-            Matrix<double> dv_dr0(3,3,0.0), dv_dv0(3,3,0.0);
-            Matrix<double> dr_dp0(3,numSRP,0.0), dv_dp0(3,numSRP,0.0);
+            // da/dp of the usual SRP models fits on the stack
+            double da_dpBuf[3*9];
+            std::vector<double> da_dpVec;
 
-            for(int i=0; i<3; ++i)
+            double* da_dp( da_dpBuf );
+            if(numSRP > 9)
             {
-                for(int j=0; j<3; ++j)
-                {
-                    dr_dr0(i,j) = state( 6+3*i+j);
-                    dr_dv0(i,j) = state(15+3*i+j);
+                da_dpVec.resize(3*numSRP);
+                da_dp = &da_dpVec[0];
+            }
 
-                    dv_dr0(i,j) = state(24+3*i+j);
-                    dv_dv0(i,j) = state(33+3*i+j);
+            // current acceleration and partial derivatives
+            double a[3] = { 0.0, 0.0, 0.0 };
+            double da_dr[9] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+            std::fill(da_dp, da_dp+3*numSRP, 0.0);
+
+            try
+            {
+                if(pEGM != NULL)
+                {
+                    pEGM->addAcceleration(sat, a);
+                    pEGM->addDA_dR(sat, da_dr);
                 }
 
-                for(int j=0; j<numSRP; ++j)
+                if(pThd != NULL)
                 {
-                    dr_dp0(i,j) = state(42+numSRP*(i+0)+j);
-                    dv_dp0(i,j) = state(42+numSRP*(i+3)+j);
+                    pThd->addAcceleration(sat, a);
+                    pThd->addDA_dR(sat, da_dr);
                 }
-            }
 
+                if(pSRP != NULL)
+                {
+                    pSRP->addAcceleration(sat, a);
+                    pSRP->addDA_dSRP(sat, da_dp, numSRP);
+                }
 
-            /* Design Matrix, (6+np, 6+np)
-             *     |                           |
-             *     |   0       I       0       |
-             *     |                           |
-             * A = |   da/dr   da/dv   da/dp   |
-             *     |                           |
-             *     |   0       0       0       |
-             *     |                           |
-             */
-
-
-            /* Dot of Transition Matrix, (6+np,6+np)
-             *        |                          |
-             *        |  dv/dr0  dv/dv0  dv/dp0  |
-             *        |                          |
-             * dphi = |  da/dr0  da/dv0  da/dp0  | = A * phi
-             *        |                          |
-             *        |  0       0       0       |
-             *        |                          |
-             */
-
-            Matrix<double> da_dr0 = da_dr * dr_dr0;
-            Matrix<double> da_dv0 = da_dr * dr_dv0;
-            Matrix<double> da_dp0 = da_dr * dr_dp0 + da_dp;
-
-            // v
-            Vector<double> v(3,0.0);
-            v(0) = state(3); v(1) = state(4); v(2) = state(5);
-
-            // v, a
-            dState(0) = v(0); dState(1) = v(1); dState(2) = v(2);
-            dState(3) = a(0); dState(4) = a(1); dState(5) = a(2);
-
-            for(int i=0; i<3; ++i)
+                if(pRel != NULL)
+                {
+                    pRel->addAcceleration(sat, a);
+                    pRel->addDA_dR(sat, da_dr);
+                }
+            }
+            catch(SatIDNotFound& e)
             {
-                // dv/dr0, dv/dv0, da/dr0, da/dv0
-                for(int j=0; j<3; ++j)
+#ifdef _OPENMP
+   #pragma omp critical (GNSSOrbit_failure)
+#endif
                 {
-                    dState( 6+3*i+j) = dv_dr0(i,j);
-                    dState(15+3*i+j) = dv_dv0(i,j);
-                    dState(24+3*i+j) = da_dr0(i,j);
-                    dState(33+3*i+j) = da_dv0(i,j);
+                    failed = true;
+                    failure = e;
                 }
-
-                // dv/dp0, da/dp0
-                for(int j=0; j<numSRP; ++j)
+                continue;
+            }
+            catch(InvalidRequest& e)
+            {
+#ifdef _OPENMP
+   #pragma omp critical (GNSSOrbit_failure)
+#endif
                 {
-                    dState(42+numSRP*(0+i)+j) = dv_dp0(i,j);
-                    dState(42+numSRP*(3+i)+j) = da_dp0(i,j);
+                    mismatched = true;
+                    mismatch = e;
                 }
+                continue;
             }
 
-            dStates[sat] = dState;
+            const double* y( (sats[k]->second).begin() );
+            double* dy( dStatePtrs[k]->begin() );
 
-        } // End of 'for(satVectorMap::const_iterator...)'
+            switch(numSRP)
+            {
+                case 0:
+                    satDerivatives<0>(y, a, da_dr, da_dp, numSRP, dy);
+                    break;
+                case 5:
+                    satDerivatives<5>(y, a, da_dr, da_dp, numSRP, dy);
+                    break;
+                case 9:
+                    satDerivatives<9>(y, a, da_dr, da_dp, numSRP, dy);
+                    break;
+                default:
+                    satDerivatives<-1>(y, a, da_dr, da_dp, numSRP, dy);
+                    break;
+            }
 
-        return dStates;
+        } // End of 'for(int k=0; ...)'
+
+        if(failed)
+        {
+            GPSTK_THROW(failure);
+        }
+
+        if(mismatched)
+        {
+            GPSTK_THROW(mismatch);
+        }
 
     }  // End of method 'GNSSOrbit::getDerivatives()'
 
@@ -64,7 +64,7 @@ namespace gpstk
 
         /// Set EGM Model
         inline GNSSOrbit& setEGMModel(EGMModel& egm)
-        { pEGM = &egm; return (*this); };
+        { pEGM = &egm; pEGM->setParallel(parallel); return (*this); };
 
         /// Get EGM Model
         inline EGMModel* getEGMModel() const
@@ -73,7 +73,7 @@ namespace gpstk
 
         /// Set third body
         inline GNSSOrbit& setThirdBody(ThirdBody& thd)
-        { pThd = &thd; return (*this); };
+        { pThd = &thd; pThd->setParallel(parallel); return (*this); };
 
         /// Get third body
         inline ThirdBody* getThirdBody() const
@@ -82,7 +82,7 @@ namespace gpstk
 
         /// Set SRP Model
         inline GNSSOrbit& setSRPModel(SRPModel& srp)
-        { pSRP = &srp; return (*this); };
+        { pSRP = &srp; pSRP->setParallel(parallel); return (*this); };
 
         /// Get SRP Model
         inline SRPModel* getSRPModel() const
@@ -91,17 +91,30 @@ namespace gpstk
 
         /// Set relativity
         inline GNSSOrbit& setRelativity(Relativity& rel)
-        { pRel = &rel; return (*this); };
+        { pRel = &rel; pRel->setParallel(parallel); return (*this); };
 
         /// Get relativity
         inline Relativity* getRelativity() const
         { return pRel; };
 
 
+        /// Set whether the satellites may be computed in parallel, for
+        /// this object and its force models.
+        virtual GNSSOrbit& setParallel(bool parallelMode);
+
+
         /// Get derivatives
         virtual satVectorMap getDerivatives( const CommonTime&   tt,
                                              const satVectorMap& states );
 
+
+        /** Get derivatives into an existing map, reusing the storage of
+         *  its vectors.
+         */
+        virtual void getDerivatives( const CommonTime&   tt,
+                                     const satVectorMap& states,
+                                     satVectorMap&       dStates );
+
     private:
 
         /// Force models
@@ -50,7 +50,7 @@ namespace gpstk
     public:
         /// Default constructor
         Integrator(double step=1.0)
-            : stepSize(step)
+            : stepSize(step), parallel(false)
         { pEOM = NULL; };
 
 
@@ -69,13 +69,35 @@ namespace gpstk
 
         /// Set EquationOfMotion
         inline Integrator& setEquationOfMotion(EquationOfMotion& EOM)
-        { pEOM = &EOM; };
+        { pEOM = &EOM; pEOM->setParallel(parallel); return (*this); };
 
         /// Get EquationOfMotion
         inline EquationOfMotion* getEquationOfMotion() const
         { return pEOM; };
 
 
+        /** Set whether the satellites are processed in parallel.
+         *
+         * The satellites are integrated independently, each one with its
+         * own step control. The derivatives of all the satellites at the
+         * same time are still evaluated together, so that the force models
+         * compute their common quantities (Earth rotation, planets, ...)
+         * once, but the per-satellite work of the integrator and of the
+         * equation of motion is shared among the OpenMP threads. The
+         * returned states are the same as in serial mode.
+         */
+        inline Integrator& setParallel(bool parallelMode)
+        {
+            parallel = parallelMode;
+            if(pEOM != NULL) pEOM->setParallel(parallel);
+            return (*this);
+        };
+
+        /// Get whether the satellites are processed in parallel
+        inline bool getParallel() const
+        { return parallel; };
+
+
         /// Real implementation
         virtual satVectorMap integrateTo( const CommonTime& t_next ) = 0;
 
@@ -87,6 +109,9 @@ namespace gpstk
         /// Pointer to EquationOfMotion
         EquationOfMotion* pEOM;
 
+        /// Whether the satellites are processed in parallel
+        bool parallel;
+
     }; // End of class 'Integrator'
 
     // @}
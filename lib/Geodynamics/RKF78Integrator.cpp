@@ -28,6 +28,12 @@
  */
 
 #include "RKF78Integrator.hpp"
+#include <algorithm>
+#include <vector>
+
+#ifdef USE_OPENMP
+#include <omp.h>
+#endif
 
 
 using namespace std;
@@ -161,119 +167,213 @@ namespace gpstk
            stepSize = std::abs(t_next-t_curr);
         }
 
-        double dt(stepSize);
-
-        SatID sat;
-
+        /* Every satellite has its own step size. The satellites at the
+         * same time and with the same step size are integrated together,
+         * so that the derivatives of their stages are computed at common
+         * times. Usually all the satellites converge with the full step
+         * and there is only one group.
+         */
 
+        // time already integrated and step size, per satellite
+        map<SatID,double> satTime;
         map<SatID,double> satStep;
 
         for(satVectorMap::iterator it = y_curr.begin();
             it != y_curr.end();
             ++it)
         {
-            satStep[it->first] = dt;
+            satTime[it->first] = 0.0;
+            satStep[it->first] = stepSize;
         }
 
+        // derivatives at the current time of each satellite
+        satVectorMap k0;
+
         satVectorMap k[13];
+        satVectorMap y_temp;
 
-        CommonTime t_temp(t_curr);
-        satVectorMap y_temp(y_curr);
+        while( !satTime.empty() )
+        {
+            // group the satellites by time and step size
+            typedef map< pair<double,double>, vector<SatID> > SatGroupMap;
+            SatGroupMap groups;
 
-        Vector<double> k0, k10, k11, k12;
-        Vector<double> orbit;
-        Vector<double> diff(3,0.0);
-        double A(0.0);
+            for(map<SatID,double>::iterator it = satTime.begin();
+                it != satTime.end();
+                ++it)
+            {
+                double dt( std::min(satStep[it->first], stepSize-it->second) );
+                groups[ make_pair(it->second, dt) ].push_back(it->first);
+            }
 
-        k[0] = pEOM->getDerivatives(t_temp, y_temp);
+            for(SatGroupMap::iterator git = groups.begin();
+                git != groups.end();
+                ++git)
+            {
+                CommonTime t_group( t_curr + git->first.first*forward );
+                double dt( git->first.second );
 
-        while( true )
-        {
-            if(y_temp.empty()) break;
+                const vector<SatID>& sats( git->second );
+                int numSats( sats.size() );
 
-            for(int i=1; i<13; ++i)
-            {
-                // reset y_temp to y_curr
-                for(satVectorMap::iterator it = y_temp.begin();
-                    it != y_temp.end();
-                    ++it)
+                // states at the time of the group
+                y_temp.clear();
+                bool haveK0(true);
+                for(int n=0; n<numSats; ++n)
                 {
-                    sat = it->first;
-                    it->second = y_curr[sat];
+                    y_temp[sats[n]] = y_next[sats[n]];
+                    if(k0.find(sats[n]) == k0.end()) haveK0 = false;
                 }
 
-                for(int j=0; j<=i-1; ++j)
+                if(haveK0)
                 {
-                    for(satVectorMap::iterator it = y_temp.begin();
-                        it != y_temp.end();
-                        ++it)
+                    k[0].clear();
+                    for(int n=0; n<numSats; ++n)
                     {
-                        sat = it->first;
-
-                        dt = satStep[sat];
-
-                        t_temp = t_curr + a[i]*dt*forward;
-
-                        it->second += b[i][j]*(k[j])[sat]*dt*forward;
+                        k[0][sats[n]] = k0[sats[n]];
+                    }
+                }
+                else
+                {
+                    pEOM->getDerivatives(t_group, y_temp, k[0]);
+                    for(int n=0; n<numSats; ++n)
+                    {
+                        k0[sats[n]] = k[0][sats[n]];
                     }
                 }
 
-                k[i] = pEOM->getDerivatives(t_temp,y_temp);
-            }
+                // pointers to the vectors of each satellite, so that the
+                // satellites can be processed in parallel
+                vector<const Vector<double>*> y0(numSats);
+                vector<Vector<double>*> yt(numSats);
+                vector< vector<const Vector<double>*> > kp( 13,
+                                vector<const Vector<double>*>(numSats) );
 
-            // reset y_temp to y_curr
-            for(satVectorMap::iterator it = y_temp.begin();
-                it != y_temp.end();
-                ++it)
-            {
-                sat = it->first;
-                it->second = y_curr[sat];
-            }
+                for(int n=0; n<numSats; ++n)
+                {
+                    y0[n] = &y_next[sats[n]];
+                    yt[n] = &y_temp[sats[n]];
+                    kp[0][n] = &k[0][sats[n]];
+                }
 
-            // test convergence
-            for(satVectorMap::iterator it = y_temp.begin();
-                it != y_temp.end();
-                ++it)
-            {
-                sat = it->first;
-                dt = satStep[sat];
+                for(int i=1; i<13; ++i)
+                {
+                    CommonTime t_temp( t_group + a[i]*dt*forward );
 
-                k0  = (k[0])[sat];
-                k10 = (k[10])[sat];
-                k11 = (k[11])[sat];
-                k12 = (k[12])[sat];
+#ifdef _OPENMP
+   #pragma omp parallel for if(parallel)
+#endif
+                    for(int n=0; n<numSats; ++n)
+                    {
+                        Vector<double>& y( *yt[n] );
+                        int size( y.size() );
+
+                        // reset y_temp to the state at the group time
+                        for(int e=0; e<size; ++e)
+                        {
+                            y[e] = (*y0[n])[e];
+                        }
+
+                        for(int j=0; j<=i-1; ++j)
+                        {
+                            const Vector<double>& kj( *kp[j][n] );
+
+                            for(int e=0; e<size; ++e)
+                            {
+                                y[e] += b[i][j]*kj[e]*dt*forward;
+                            }
+                        }
+                    }
 
-                orbit = c1[0]*dt*(k0+k10-k11-k12);
+                    pEOM->getDerivatives(t_temp, y_temp, k[i]);
 
-                diff(0) = orbit(0);
-                diff(1) = orbit(1);
-                diff(2) = orbit(2);
+                    for(int n=0; n<numSats; ++n)
+                    {
+                        kp[i][n] = &k[i][sats[n]];
+                    }
+                }
 
-                A = norm(diff)/errorTol;
+                // test convergence
+                vector<char> converged(numSats, 0);
+                vector<double> newStep(numSats, dt);
 
-                // if converge, update y_next and remove this satellite
-                if(A < 1)
+#ifdef _OPENMP
+   #pragma omp parallel for if(parallel)
+#endif
+                for(int n=0; n<numSats; ++n)
                 {
-                    for(int i=0; i<13; ++i)
+                    const Vector<double>& k0n( *kp[0][n] );
+                    const Vector<double>& k10( *kp[10][n] );
+                    const Vector<double>& k11( *kp[11][n] );
+                    const Vector<double>& k12( *kp[12][n] );
+
+                    double diff[3];
+                    for(int e=0; e<3; ++e)
                     {
-                        it->second += c2[i]*(k[i])[sat]*dt*forward;
+                        diff[e] = c1[0]*dt*(k0n[e]+k10[e]-k11[e]-k12[e]);
                     }
 
-                    y_next[sat] = it->second;
+                    double A( std::sqrt( diff[0]*diff[0]
+                                       + diff[1]*diff[1]
+                                       + diff[2]*diff[2] )/errorTol );
+
+                    // if converge, update the state of this satellite
+                    if(A < 1)
+                    {
+                        Vector<double>& y( *yt[n] );
+                        int size( y.size() );
+
+                        for(int e=0; e<size; ++e)
+                        {
+                            y[e] = (*y0[n])[e];
+                        }
+
+                        for(int i=0; i<13; ++i)
+                        {
+                            const Vector<double>& ki( *kp[i][n] );
 
-                    y_temp.erase(sat);
+                            for(int e=0; e<size; ++e)
+                            {
+                                y[e] += c2[i]*ki[e]*dt*forward;
+                            }
+                        }
+
+                        converged[n] = 1;
+                    }
+                    // if not converge, update step size and continue
+                    else
+                    {
+                        newStep[n] = dt*std::pow(0.0025/A,1.0/16.0);
+                    }
                 }
-                // if not converge, update step size and continue
-                else
+
+                for(int n=0; n<numSats; ++n)
                 {
-                    dt *= std::pow(0.0025/A,1.0/16.0);
+                    const SatID& sat( sats[n] );
 
-                    satStep[sat] = dt;
+                    if( converged[n] )
+                    {
+                        y_next[sat] = *yt[n];
+                        k0.erase(sat);
+
+                        satTime[sat] += dt;
+
+                        // remove the satellites at t_next
+                        if(satTime[sat] >= stepSize - 1e-9)
+                        {
+                            satTime.erase(sat);
+                            satStep.erase(sat);
+                        }
+                    }
+                    else
+                    {
+                        satStep[sat] = newStep[n];
+                    }
                 }
 
-            } // End of 'for(satVectorMap::iterator...)'
+            }  // End of 'for(SatGroupMap::iterator...)'
 
-        }  // End of 'while(true)'
+        }  // End of 'while(...)'
 
         return y_next;
 
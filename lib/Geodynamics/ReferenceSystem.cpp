@@ -510,9 +510,17 @@ namespace gpstk
 
 
 
-    /// Transformation matrix from ICRS to ITRS.
-    Matrix<double> ReferenceSystem::C2TMatrix(const CommonTime& UTC)
+    /// Prepare the rotations of C2T = W * R(ERA) * Q at UTC.
+    void ReferenceSystem::prepareRotation(const CommonTime& UTC)
     {
+        if( isPrepared &&
+            UTC.getTimeSystem() == preparedUTC.getTimeSystem() &&
+            UTC == preparedUTC )
+        {
+            return;
+        }
+
+        isPrepared = false;
 
         // EOP Data
         EOPDataStore2::EOPData eop( getEOPData(UTC) );
@@ -532,32 +540,23 @@ namespace gpstk
         yp += cor_ocean(1);
         UT1mUTC += cor_ocean(2);
 
-        // Raw CIP X,Y coordinates
-        double X(0.0), Y(0.0);
-        iauXy06(JD_TO_MJD, mjd_tt.mjd, &X, &Y);
-
-        // The CIO locator s
-        double s = iauS06(JD_TO_MJD, mjd_tt.mjd, X, Y);
+        // Raw CIP X,Y coordinates and the CIO locator s
+        CIPData cip( getCIP(mjd_tt.mjd) );
 
         // Corrected CIP X,Y coordinates
-//        X += dX * AS_TO_RAD;
-//        Y += dY * AS_TO_RAD;
+//        cip.X += dX * AS_TO_RAD;
+//        cip.Y += dY * AS_TO_RAD;
 
         // GCRS-to-CIRS matrix
-        Matrix<double> Q(3,3,0.0);
-        iauC2ixys(X, Y, s, Q);
+        preparedQ.resize(3,3,0.0);
+        iauC2ixys(cip.X, cip.Y, cip.s, preparedQ);
 
         // UT1
         CommonTime UT1( UTC2UT1(UTC, UT1mUTC) );
         MJD mjd_ut1(UT1);
 
         // Earth rotation angle
-        double ERA = iauEra00(JD_TO_MJD, mjd_ut1.mjd);
-
-        // CIRS-to-TIRS matrix
-        Matrix<double> R(3,3,0.0);
-        R(0,0) = 1.0; R(1,1) = 1.0; R(2,2) = 1.0;
-        iauRz(ERA, R);
+        preparedERA = iauEra00(JD_TO_MJD, mjd_ut1.mjd);
 
         // The TIO locator s'
         double sp = iauSp00(JD_TO_MJD, mjd_tt.mjd);
@@ -566,10 +565,80 @@ namespace gpstk
         yp *= AS_TO_RAD;
 
         // TIRS-to-ITRS matrix
-        Matrix<double> W(3,3,0.0);
-        iauPom00(xp, yp, sp, W);
+        preparedW.resize(3,3,0.0);
+        iauPom00(xp, yp, sp, preparedW);
+
+        preparedUTC = UTC;
+        isPrepared = true;
+
+    }  // End of method 'ReferenceSystem::prepareRotation()'
+
+
+    /// Get CIP X, Y and CIO locator s at TT, as MJD.
+    ReferenceSystem::CIPData ReferenceSystem::getCIP(double mjd_tt)
+    {
+        CIPData cip;
+
+        if(nutationInterval <= 0.0)
+        {
+            iauXy06(JD_TO_MJD, mjd_tt, &cip.X, &cip.Y);
+            cip.s = iauS06(JD_TO_MJD, mjd_tt, cip.X, cip.Y);
+
+            return cip;
+        }
 
-        return W * R * Q;
+        // Node before mjd_tt, and position within its interval
+        double h( nutationInterval/DAY_TO_SEC );
+        long node( static_cast<long>( std::floor(mjd_tt/h) ) );
+        double u( mjd_tt/h - node );
+
+        // Lagrange weights of the nodes node-1, ..., node+2
+        double w[4];
+        w[0] = -u*(u - 1.0)*(u - 2.0)/6.0;
+        w[1] =  (u + 1.0)*(u - 1.0)*(u - 2.0)/2.0;
+        w[2] = -(u + 1.0)*u*(u - 2.0)/2.0;
+        w[3] =  (u + 1.0)*u*(u - 1.0)/6.0;
+
+        // An integration only visits a few nodes at a time
+        if(cipNodes.size() > 64) cipNodes.clear();
+
+        cip.X = 0.0; cip.Y = 0.0; cip.s = 0.0;
+
+        for(int k=0; k<4; ++k)
+        {
+            long n( node - 1 + k );
+
+            std::map<long, CIPData>::iterator it( cipNodes.find(n) );
+            if( it == cipNodes.end() )
+            {
+                CIPData nodeCIP;
+                iauXy06(JD_TO_MJD, n*h, &nodeCIP.X, &nodeCIP.Y);
+                nodeCIP.s = iauS06(JD_TO_MJD, n*h, nodeCIP.X, nodeCIP.Y);
+
+                it = cipNodes.insert( std::make_pair(n, nodeCIP) ).first;
+            }
+
+            cip.X += w[k]*it->second.X;
+            cip.Y += w[k]*it->second.Y;
+            cip.s += w[k]*it->second.s;
+        }
+
+        return cip;
+
+    }  // End of method 'ReferenceSystem::getCIP()'
+
+
+    /// Transformation matrix from ICRS to ITRS.
+    Matrix<double> ReferenceSystem::C2TMatrix(const CommonTime& UTC)
+    {
+        prepareRotation(UTC);
+
+        // CIRS-to-TIRS matrix
+        Matrix<double> R(3,3,0.0);
+        R(0,0) = 1.0; R(1,1) = 1.0; R(2,2) = 1.0;
+        iauRz(preparedERA, R);
+
+        return preparedW * R * preparedQ;
 
     }  // End of method 'ReferenceSystem::C2TMatrix()'
 
@@ -588,45 +657,11 @@ namespace gpstk
     /// for a given date
     Matrix<double> ReferenceSystem::dC2TMatrix(const CommonTime& UTC)
     {
-        // EOP Data
-        EOPDataStore2::EOPData eop( getEOPData(UTC) );
-        double xp = eop.xp;
-        double yp = eop.yp;
-        double UT1mUTC = eop.UT1mUTC;
-        double dX = eop.dX;
-        double dY = eop.dY;
-
-        // TT
-        CommonTime TT( UTC2TT(UTC) );
-        MJD mjd_tt(TT);
-
-        // Ocean Tide Corrections
-        Vector<double> cor_ocean = ortho_eop(TT)*1e-6;
-        xp += cor_ocean(0);
-        yp += cor_ocean(1);
-        UT1mUTC += cor_ocean(2);
-
-        // Raw CIP X,Y coordinates
-        double X(0.0), Y(0.0);
-        iauXy06(JD_TO_MJD, mjd_tt.mjd, &X, &Y);
-
-        // The CIO locator s
-        double s = iauS06(JD_TO_MJD, mjd_tt.mjd, X, Y);
-
-        // Corrected CIP X,Y coordinates
-//        X += dX * AS_TO_RAD;
-//        Y += dY * AS_TO_RAD;
-
-        // GCRS-to-CTRS matrix
-        Matrix<double> Q(3,3,0.0);
-        iauC2ixys(X, Y, s, Q);
+        prepareRotation(UTC);
 
-        // UT1
-        CommonTime UT1( UTC2UT1(UTC, UT1mUTC) );
-        MJD mjd_ut1(UT1);
+        double ERA( preparedERA );
 
-        // Earth rotation angle and its time dot
-        double ERA = iauEra00(JD_TO_MJD, mjd_ut1.mjd);
+        // Earth rotation angle time dot
         double dERA = TWO_PI*1.00273781191135448/DAY_TO_SEC;
 
         // CIRS-to-TIRS matrix time dot
@@ -637,15 +672,7 @@ namespace gpstk
         dR(1,1) = -std::sin(ERA);
         dR = dR * dERA;
 
-        xp *= AS_TO_RAD;
-        yp *= AS_TO_RAD;
-
-        // TIRS-to-ITRS matrix
-        double sp = iauSp00(JD_TO_MJD, mjd_tt.mjd);
-        Matrix<double> W(3,3,0.0);
-        iauPom00(xp, yp, sp, W);
-
-        return W * dR * Q;
+        return preparedW * dR * preparedQ;
 
     }  // End of method 'ReferenceSystem::dC2TMatrix()'
 
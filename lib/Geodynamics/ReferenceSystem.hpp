@@ -33,6 +33,7 @@
 //============================================================================
 
 #include <string>
+#include <map>
 #include "constants.hpp"
 #include "Vector.hpp"
 #include "Matrix.hpp"
@@ -84,7 +85,8 @@ namespace gpstk
 
         /// Default constructor.
         ReferenceSystem()
-            : pEopStore(NULL), pLeapSecStore(NULL), isPrepared(false)
+            : pEopStore(NULL), pLeapSecStore(NULL), isPrepared(false),
+              nutationInterval(0.0)
         {}
 
 
@@ -92,7 +94,7 @@ namespace gpstk
          */
         ReferenceSystem(EOPDataStore2& eopStore,
                         LeapSecStore& leapSecStore)
-            : isPrepared(false)
+            : isPrepared(false), nutationInterval(0.0)
         {
             pEopStore = &eopStore;
             pLeapSecStore = &leapSecStore;
@@ -101,7 +103,7 @@ namespace gpstk
 
         /// Set the EOP data store.
         ReferenceSystem& setEOPDataStore(EOPDataStore2& eopStore)
-        { pEopStore = &eopStore; return (*this); };
+        { pEopStore = &eopStore; clearCache(); return (*this); };
 
 
         /// Get the EOP data store.
@@ -111,7 +113,7 @@ namespace gpstk
 
         /// Set the leapsec data store.
         ReferenceSystem& setLeapSecStore(LeapSecStore& leapSecStore)
-        { pLeapSecStore = &leapSecStore; return (*this); };
+        { pLeapSecStore = &leapSecStore; clearCache(); return (*this); };
 
 
         /// Get the leapsec data store.
@@ -265,6 +267,30 @@ namespace gpstk
         Matrix<double> dT2CMatrix(const CommonTime& UTC);
 
 
+        /** Set the node interval of the precession-nutation, in seconds.
+         *
+         * The CIP coordinates X, Y and the CIO locator s change slowly,
+         * the shortest nutation terms having periods of days. With a
+         * positive interval they are evaluated at nodes spaced by it and
+         * interpolated with a cubic polynomial, instead of summing the
+         * IAU 2006/2000A series at every call; with 3600 s the error
+         * stays far below 1e-12 rad. The default, 0, evaluates the
+         * series at every call.
+         */
+        ReferenceSystem& setNutationInterval(double interval)
+        { nutationInterval = interval; clearCache(); return (*this); };
+
+
+        /// Get the node interval of the precession-nutation, in seconds.
+        double getNutationInterval() const
+        { return nutationInterval; };
+
+
+        /// Forget the cached rotation and precession-nutation values.
+        void clearCache()
+        { isPrepared = false; cipNodes.clear(); };
+
+
         /**Convert coordinate difference in XYZ to RTN.
          *
          * @param dxyz     Coordinate difference in XYZ
@@ -289,9 +315,46 @@ namespace gpstk
         /// Pointer to the leap second store
         LeapSecStore* pLeapSecStore;
 
+        /// CIP X, Y coordinates and CIO locator s
+        struct CIPData
+        {
+            double X;
+            double Y;
+            double s;
+        };
+
+
+        /** Prepare the rotations of C2T = W * R(ERA) * Q at UTC.
+         *
+         * The force models evaluated at one time of an integration step
+         * ask for the same matrix, so the last one is kept and only
+         * computed again for a different time.
+         */
+        void prepareRotation(const CommonTime& UTC);
+
+
+        /// Get CIP X, Y and CIO locator s at TT, as MJD.
+        CIPData getCIP(double mjd_tt);
+
+
         /// whether the transformation matrix is prepared
         bool isPrepared;
 
+        /// UTC of the prepared matrix
+        CommonTime preparedUTC;
+
+        /// GCRS-to-CIRS matrix, Earth rotation angle and TIRS-to-ITRS
+        /// matrix of the prepared time
+        Matrix<double> preparedQ;
+        double preparedERA;
+        Matrix<double> preparedW;
+
+        /// Node interval of the precession-nutation, in seconds
+        double nutationInterval;
+
+        /// CIP values at the nodes, by node number
+        std::map<long, CIPData> cipNodes;
+
     }; // End of class 'ReferenceSystem'
 
     // @}
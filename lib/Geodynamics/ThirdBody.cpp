@@ -103,8 +103,18 @@ namespace gpstk
         Vector<double> r_sat(3,0.0);
 
 
-        // Geocentric position and velocity of planet, unit: km, km/day
-        double rv_planet[6] = {0.0};
+        // Geocentric position and velocity of the planets taken into
+        // account, all computed at once, unit: km, km/day
+        SolarSystem::Planet usedTargets[10];
+        int numUsed(0);
+
+        for(int i=0; i<10; ++i)
+        {
+            if( bPlanets[i] ) usedTargets[numUsed++] = targets[i];
+        }
+
+        double rv_planets[10][6] = {{0.0}};
+        pSolSys->computeStates(jd_tt, usedTargets, numUsed, center, rv_planets);
 
         // Geocentric position of planet, unit: m
         Vector<double> position(3,0.0);
@@ -112,15 +122,14 @@ namespace gpstk
         // Geocentric position of planets, unit: m
         Vector<double> positions[10] = {0.0};
 
-        for(int i=0; i<10; ++i)
+        for(int i=0, j=0; i<10; ++i)
         {
             if( bPlanets[i] )
             {
-                pSolSys->computeState(jd_tt, targets[i], center, rv_planet);
-
-                position(0) = rv_planet[0]*1e3;
-                position(1) = rv_planet[1]*1e3;
-                position(2) = rv_planet[2]*1e3;
+                position(0) = rv_planets[j][0]*1e3;
+                position(1) = rv_planets[j][1]*1e3;
+                position(2) = rv_planets[j][2]*1e3;
+                ++j;
             }
 
             positions[i] = position;
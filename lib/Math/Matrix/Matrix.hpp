@@ -84,6 +84,18 @@ namespace gpstk
          : v(rows*cols), r(rows), c(cols), s(rows * cols)
       { assignFrom(vec); }
 
+         /// copy constructor
+      Matrix(const Matrix& mat)
+            : v(mat.v), r(mat.r), c(mat.c), s(mat.s)
+         {}
+
+#if __cplusplus >= 201103L
+         /// move constructor, takes over the storage of mat
+      Matrix(Matrix&& mat)
+            : v((size_t)0), r(0), c(0), s(0)
+         { swap(mat); }
+#endif
+
          /// constructor for a ConstMatrixBase object
       template <class BaseClass>
       Matrix(const ConstMatrixBase<T, BaseClass>& mat) 
@@ -199,6 +211,21 @@ namespace gpstk
          /// Copies the other matrix.
       inline Matrix& operator=(const Matrix& mat)
          { v = mat.v; r = mat.r; c = mat.c; s = mat.s; return *this; }
+#if __cplusplus >= 201103L
+         /// Move assignment, exchanges the storage with mat.
+      inline Matrix& operator=(Matrix&& mat)
+         { return swap(mat); }
+#endif
+         /// Exchanges the contents of two matrices without copying elements.
+      inline Matrix& swap(Matrix& mat)
+         {
+            v.swap(mat.v);
+            size_t t;
+            t = r; r = mat.r; mat.r = t;
+            t = c; c = mat.c; mat.c = t;
+            t = s; s = mat.s; mat.s = t;
+            return *this;
+         }
          /// Copies from any matrix.
       template <class BaseClass>
       inline Matrix& operator=(const ConstMatrixBase<T, BaseClass>& mat)
@@ -222,6 +249,11 @@ namespace gpstk
          s;  ///< the overall size
    };
 
+      /// Exchanges the contents of two matrices without copying elements.
+   template <class T>
+   inline void swap(Matrix<T>& a, Matrix<T>& b)
+   { a.swap(b); }
+
 /**
  * An assignable slice of a matrix.
  */
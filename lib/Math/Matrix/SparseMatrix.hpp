@@ -0,0 +1,196 @@
+#pragma ident "$Id$"
+
+
+
+/**
+ * @file SparseMatrix.hpp
+ * Matrix stored in compressed-sparse-row form
+ */
+
+#ifndef GPSTK_SPARSE_MATRIX_HPP
+#define GPSTK_SPARSE_MATRIX_HPP
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//============================================================================
+
+#include <vector>
+#include "Matrix.hpp"
+
+namespace gpstk
+{
+
+ /** @addtogroup VectorGroup */
+   //@{
+
+/**
+ * A matrix stored in compressed-sparse-row (CSR) form, i.e. only the
+ * non-zero elements are kept, row after row, together with their column
+ * indexes. Memory and the cost of products scale with the number of
+ * non-zeros instead of rows*cols.
+ *
+ * The matrix is built row by row:
+ *
+ * @code
+ * SparseMatrix<double> H(numUnknowns);
+ *
+ * H.addElement(0, 1.0);
+ * H.addElement(5, -1.0);
+ * H.endRow();                // first row done
+ *
+ * Vector<double> r( H * x ); // product with a Vector
+ * @endcode
+ *
+ * The elements of row i are value(k) with column colIndex(k), for
+ * k = rowBegin(i) ... rowEnd(i)-1.
+ */
+   template <class T>
+   class SparseMatrix
+   {
+   public:
+         /// default constructor
+      SparseMatrix()
+            : c(0), rowPtr(1, 0)
+      {}
+
+         /// constructor given the number of columns
+      explicit SparseMatrix(size_t cols)
+            : c(cols), rowPtr(1, 0)
+      {}
+
+         /// Removes all rows and sets the number of columns.
+      SparseMatrix& clear(size_t cols)
+      {
+         c = cols;
+         rowPtr.assign(1, 0);
+         colIdx.clear();
+         val.clear();
+         return *this;
+      }
+
+         /// Reserves memory for the given number of rows and non-zeros.
+      SparseMatrix& reserve(size_t rows, size_t nonZeros)
+      {
+         rowPtr.reserve(rows + 1);
+         colIdx.reserve(nonZeros);
+         val.reserve(nonZeros);
+         return *this;
+      }
+
+         /// Appends an element to the row being built.
+      SparseMatrix& addElement(size_t col, const T value)
+      {
+         if (col >= c)
+         {
+            MatrixException e("SparseMatrix column index out of range");
+            GPSTK_THROW(e);
+         }
+         colIdx.push_back(col);
+         val.push_back(value);
+         return *this;
+      }
+
+         /// Closes the row being built, an empty row is allowed.
+      SparseMatrix& endRow()
+      {
+         rowPtr.push_back(val.size());
+         return *this;
+      }
+
+         /// The number of (closed) rows in the matrix
+      size_t rows() const { return rowPtr.size() - 1; }
+         /// The number of columns in the matrix
+      size_t cols() const { return c; }
+         /// The number of stored elements
+      size_t nonZeros() const { return val.size(); }
+
+         /// Position of the first element of the given row
+      size_t rowBegin(size_t row) const { return rowPtr[row]; }
+         /// Position after the last element of the given row
+      size_t rowEnd(size_t row) const { return rowPtr[row + 1]; }
+         /// Column of the k'th stored element
+      size_t colIndex(size_t k) const { return colIdx[k]; }
+         /// Value of the k'th stored element
+      T value(size_t k) const { return val[k]; }
+
+         /// Element (row,col), zero if it is not stored.
+      T operator() (size_t row, size_t col) const
+      {
+         T sum(0);
+         for (size_t k = rowPtr[row]; k < rowPtr[row + 1]; k++)
+            if (colIdx[k] == col)
+               sum += val[k];
+         return sum;
+      }
+
+         /// Dot product of the given row with a vector
+      template <class BaseClass>
+      T rowDot(size_t row, const ConstVectorBase<T, BaseClass>& x) const
+      {
+         T sum(0);
+         for (size_t k = rowPtr[row]; k < rowPtr[row + 1]; k++)
+            sum += val[k] * x(colIdx[k]);
+         return sum;
+      }
+
+         /// Returns the matrix in dense form.
+      Matrix<T> toDense() const
+      {
+         Matrix<T> m(rows(), c, T(0));
+         for (size_t i = 0; i < rows(); i++)
+            for (size_t k = rowPtr[i]; k < rowPtr[i + 1]; k++)
+               m(i, colIdx[k]) += val[k];
+         return m;
+      }
+
+   private:
+         /// the number of columns
+      size_t c;
+         /// start of each row in colIdx and val, plus the end of the last row
+      std::vector<size_t> rowPtr;
+         /// column index of each element
+      std::vector<size_t> colIdx;
+         /// value of each element
+      std::vector<T> val;
+   };
+
+/**
+ * Returns the product of a SparseMatrix and a Vector.
+ */
+   template <class T, class BaseClass>
+   Vector<T> operator*(const SparseMatrix<T>& m,
+                       const ConstVectorBase<T, BaseClass>& v)
+   {
+      if (v.size() != m.cols())
+      {
+         MatrixException e("Incompatible dimensions for SparseMatrix * Vector");
+         GPSTK_THROW(e);
+      }
+
+      Vector<T> toReturn(m.rows());
+      for (size_t i = 0; i < m.rows(); i++)
+         toReturn[i] = m.rowDot(i, v);
+      return toReturn;
+   }
+
+   //@}
+
+}  // namespace
+
+#endif
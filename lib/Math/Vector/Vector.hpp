@@ -157,10 +157,28 @@ namespace gpstk
             s = num;
          }
 
+#if __cplusplus >= 201103L
+         /// Move constructor, takes over the storage of r.
+      Vector(Vector&& r) : v(r.v), s(r.s)
+         { r.v = NULL; r.s = 0; }
+
+         /// Move assignment, exchanges the storage with x.
+      Vector& operator=(Vector&& x)
+         { return swap(x); }
+#endif
+
          /// Destructor
       ~Vector()
          { if (v) delete [] v; }
 
+         /// Exchanges the contents of two vectors without copying elements.
+      Vector& swap(Vector& x)
+         {
+            T* tv = v; v = x.v; x.v = tv;
+            size_t ts = s; s = x.s; x.s = ts;
+            return *this;
+         }
+
          /// STL iterator begin
       iterator begin() { return v; }
          /// STL const iterator begin
@@ -346,6 +364,11 @@ namespace gpstk
    };
    // end class Vector<T>
 
+      /// Exchanges the contents of two vectors without copying elements.
+   template <class T>
+   inline void swap(Vector<T>& a, Vector<T>& b)
+   { a.swap(b); }
+
 /**
  * A slice of Vector<T> that can be modified.
  * @warning Remember that (VectorSlice = VectorSlice) will
@@ -0,0 +1,158 @@
+#pragma ident "$Id: AstroContext.cpp $"
+
+/**
+ * @file AstroContext.cpp
+ * This is a class to compute once per epoch the astronomical quantities
+ * (Sun and Moon positions, tidal arguments, Earth orientation) shared by
+ * the station-level correction models.
+ */
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+//============================================================================
+
+
+#include "AstroContext.hpp"
+#include "SunPosition.hpp"
+#include "MoonPosition.hpp"
+#include "OceanLoading.hpp"
+
+using namespace std;
+
+namespace gpstk
+{
+
+      /* Computes the quantities of an epoch, unless they are already those
+       * of this epoch, and returns a copy of them.
+       *
+       * @param epoch      Epoch of interest.
+       */
+    AstroContext AstroContext::update(const CommonTime& epoch)
+        throw(InvalidRequest)
+    {
+        AstroContext astro;
+
+        bool failed(false);
+        InvalidRequest error;
+
+            // The exception can't leave the critical section
+#ifdef _OPENMP
+        #pragma omp critical (AstroContext_update)
+#endif
+        {
+            try
+            {
+                compute(epoch);
+                astro = (*this);
+            }
+            catch(InvalidRequest& e)
+            {
+                error = e;
+                failed = true;
+            }
+        }
+
+        if( failed )
+        {
+            GPSTK_RETHROW(error);
+        }
+
+        return astro;
+
+    }  // End of method 'AstroContext::update()'
+
+
+      // Computes the quantities of an epoch, unless they are already those
+      // of this epoch.
+    void AstroContext::compute(const CommonTime& epoch)
+        throw(InvalidRequest)
+    {
+        if( isCurrent(epoch) ) return;
+
+        m_Valid = false;
+
+        try
+        {
+            SunPosition sunPosition;
+            m_SunPos = sunPosition.getPosition(epoch);
+
+            MoonPosition moonPosition;
+            m_MoonPos = moonPosition.getPosition(epoch);
+        }
+        catch(InvalidRequest& e)
+        {
+            GPSTK_RETHROW(e);
+        }
+
+        OceanLoading ocean;
+        m_OceanArgs = ocean.getArg(epoch);
+
+            // A missing EOP only matters to those asking for it
+        m_EOPValid = false;
+        if( pEOPStore != NULL )
+        {
+            CommonTime utc(epoch);
+            utc.setTimeSystem( TimeSystem::UTC );
+
+            try
+            {
+                m_EOPData = pEOPStore->getEOPData(utc);
+                m_EOPValid = true;
+            }
+            catch(Exception& e)
+            {
+                m_EOPValid = false;
+            }
+        }
+
+        m_Epoch = epoch;
+        m_Epoch.setTimeSystem( TimeSystem::Any );
+        m_Valid = true;
+
+    }  // End of method 'AstroContext::compute()'
+
+
+      // Returns whether the quantities are those of an epoch.
+    bool AstroContext::isCurrent(const CommonTime& epoch) const
+    {
+        return ( m_Valid && m_Epoch == epoch );
+
+    }  // End of method 'AstroContext::isCurrent()'
+
+
+      /* Returns the EOP of the epoch.
+       *
+       * @throw InvalidRequest if there is no EOPDataStore2, or it has no
+       *  data for the epoch.
+       */
+    const EOPDataStore2::EOPData& AstroContext::getEOPData() const
+        throw(InvalidRequest)
+    {
+        if( !m_EOPValid )
+        {
+            InvalidRequest e("AstroContext: no EOP data at this epoch.");
+            GPSTK_THROW(e);
+        }
+
+        return m_EOPData;
+
+    }  // End of method 'AstroContext::getEOPData()'
+
+
+}  // End of namespace gpstk
@@ -0,0 +1,208 @@
+#pragma ident "$Id: AstroContext.hpp $"
+
+/**
+ * @file AstroContext.hpp
+ * This is a class to compute once per epoch the astronomical quantities
+ * (Sun and Moon positions, tidal arguments, Earth orientation) shared by
+ * the station-level correction models.
+ */
+
+#ifndef GPSTK_ASTRO_CONTEXT_HPP
+#define GPSTK_ASTRO_CONTEXT_HPP
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+//============================================================================
+
+
+#include "CommonTime.hpp"
+#include "Triple.hpp"
+#include "Vector.hpp"
+#include "EOPDataStore2.hpp"
+
+
+namespace gpstk
+{
+
+      /** @addtogroup GPSsolutions */
+      //@{
+
+      /** This class computes, once per epoch, the astronomical quantities
+       *  that the station-level correction models need and that are the
+       *  same for all the stations:
+       *
+       * \li Sun and Moon positions (ECEF, meters), as SunPosition and
+       *     MoonPosition give them.
+       * \li The 11 astronomical arguments of the ocean loading model, as
+       *     OceanLoading::getArg() gives them.
+       * \li The Earth orientation parameters, if an EOPDataStore2 is set.
+       *
+       * ComputeTides (through CorrectObservables), ComputeSatPCenter and
+       * ComputeWindUp take an AstroContext with setAstroContext(); each of
+       * them calls update() with its epoch, which only computes the
+       * quantities the first time it is called for that epoch, and works
+       * on the copy it returns. One object shared by all those classes
+       * thus does the astronomy once per epoch, instead of once per
+       * station and class.
+       *
+       * @code
+       *   AstroContext astro(eopStore);
+       *
+       *   ComputeSatPCenter svPcenter;
+       *   svPcenter.setAstroContext(astro);
+       *
+       *   ComputeWindUp windup;
+       *   windup.setAstroContext(astro);
+       *
+       *   CorrectObservables corr;
+       *   corr.setAstroContext(astro);
+       * @endcode
+       *
+       * The quantities do not depend on the time system of the epoch; the
+       * EOP are looked up at the epoch taken as UTC, as PoleTides does.
+       *
+       * update() may be called from several threads at the same time,
+       * e.g. by the clones of a parallel ProcessingList: it computes and
+       * copies the quantities in a critical section, so each caller gets
+       * its own consistent copy. The other methods of a shared object must
+       * not be called while it may be updated.
+       */
+    class AstroContext
+    {
+    public:
+
+        /// Default constructor.
+        AstroContext()
+            : pEOPStore(NULL), m_Valid(false), m_OceanArgs(11, 0.0),
+              m_EOPValid(false)
+        {};
+
+
+        /** Common constructor.
+         *
+         * @param eopStore   EOPDataStore2 object.
+         */
+        AstroContext(EOPDataStore2& eopStore)
+            : pEOPStore(&eopStore), m_Valid(false), m_OceanArgs(11, 0.0),
+              m_EOPValid(false)
+        {};
+
+
+        /// Returns a pointer to the EOPDataStore2 object currently in use.
+        virtual EOPDataStore2* getEOPDataStore() const
+        { return pEOPStore; };
+
+
+        /// Sets the EOPDataStore2 object to be used.
+        virtual AstroContext& setEOPDataStore(EOPDataStore2& eopStore)
+        { pEOPStore = &eopStore; m_Valid = false; return (*this); };
+
+
+        /** Computes the quantities of an epoch, unless they are already
+         *  those of this epoch, and returns a copy of them.
+         *
+         * It is safe to call it from several threads at the same time.
+         *
+         * @param epoch      Epoch of interest.
+         *
+         * @throw InvalidRequest if the Sun or Moon position can't be
+         *  computed at this epoch.
+         */
+        virtual AstroContext update(const CommonTime& epoch)
+            throw(InvalidRequest);
+
+
+        /// Returns whether the quantities are those of an epoch.
+        bool isCurrent(const CommonTime& epoch) const;
+
+
+        /// Returns the epoch of the quantities.
+        const CommonTime& getEpoch() const
+        { return m_Epoch; };
+
+
+        /// Returns the Sun position (ECEF), in meters.
+        const Triple& getSunPosition() const
+        { return m_SunPos; };
+
+
+        /// Returns the Moon position (ECEF), in meters.
+        const Triple& getMoonPosition() const
+        { return m_MoonPos; };
+
+
+        /// Returns the 11 astronomical arguments of the ocean loading
+        /// model, in radians.
+        const Vector<double>& getOceanArguments() const
+        { return m_OceanArgs; };
+
+
+        /// Returns whether the EOP of the epoch are available.
+        bool hasEOP() const
+        { return m_EOPValid; };
+
+
+        /** Returns the EOP of the epoch.
+         *
+         * @throw InvalidRequest if there is no EOPDataStore2, or it has no
+         *  data for the epoch.
+         */
+        const EOPDataStore2::EOPData& getEOPData() const
+            throw(InvalidRequest);
+
+
+        /// Destructor.
+        virtual ~AstroContext() {};
+
+
+    private:
+
+        /// Computes the quantities of an epoch, unless they are already
+        /// those of this epoch. Not thread-safe.
+        void compute(const CommonTime& epoch)
+            throw(InvalidRequest);
+
+
+        /// Pointer to the EOPDataStore2 object
+        EOPDataStore2* pEOPStore;
+
+        /// Epoch of the quantities, in TimeSystem::Any
+        CommonTime m_Epoch;
+
+        /// Whether the quantities are those of m_Epoch
+        bool m_Valid;
+
+        /// Sun and Moon positions
+        Triple m_SunPos;
+        Triple m_MoonPos;
+
+        /// Astronomical arguments of the ocean loading model
+        Vector<double> m_OceanArgs;
+
+        /// Earth orientation parameters
+        EOPDataStore2::EOPData m_EOPData;
+        bool m_EOPValid;
+
+    }; // End of class 'AstroContext'
+
+      //@}
+
+}  // End of namespace gpstk
+
+#endif   // GPSTK_ASTRO_CONTEXT_HPP
@@ -163,6 +163,9 @@ namespace gpstk
 
             TypeID defaultObs;
 
+            // Topocentric frame of the station, for all the satellites
+            StationFrame staFrame( nominalPos );
+
             // Loop through all the satellites
             satTypeValueMap::iterator stv;
             for( stv = gData.begin(); stv != gData.end(); ++stv )
@@ -196,7 +199,7 @@ namespace gpstk
                     // Compute most of the parameters
                     cerange.ComputeAtTransmitTime( time,
                                                    obs,
-                                                   nominalPos,
+                                                   staFrame,
                                                    sat,
                                                    *(getEphStore()) );
                 }
@@ -209,7 +212,7 @@ namespace gpstk
                 }
 
                 // Let's test if satellite has enough elevation over horizon
-                if ( nominalPos.elevationGeodetic(cerange.svPosVel) < minElev )
+                if ( cerange.elevationGeodetic < minElev )
                 {
                     // Mark this satellite if it doesn't have enough elevation
                     satRejectedSet.insert( sat );
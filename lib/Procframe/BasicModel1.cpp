@@ -170,6 +170,9 @@ namespace gpstk
             // Type
             TypeID defaultObs;
 
+            // Topocentric frame of the station, for all the satellites
+            StationFrame staFrame( nominalPos );
+
             // Loop through all the satellites
             satTypeValueMap::iterator stv;
             for( stv = gData.begin(); stv != gData.end(); ++stv )
@@ -203,12 +206,12 @@ namespace gpstk
                     // Compute most of the parameters
                     cerange1.ComputeAtTransmitTime( time,
                                                     obs,
-                                                    nominalPos,
+                                                    staFrame,
                                                     sat,
                                                     *pSP3Store );
                     cerange2.ComputeAtTransmitTime( time,
                                                     obs,
-                                                    nominalPos,
+                                                    staFrame,
                                                     sat,
                                                     *pBCEStore );
                 }
@@ -221,7 +224,7 @@ namespace gpstk
                 }
 
                 // Let's test if satellite has enough elevation over horizon
-                if ( nominalPos.elevationGeodetic(cerange1.svPosVel) < minElev )
+                if ( cerange1.elevationGeodetic < minElev )
                 {
                     // Mark this satellite if it doesn't have enough elevation
                     satRejectedSet.insert( sat );
@@ -365,25 +368,36 @@ namespace gpstk
                 SourceID source( sdmIt->first );
                 string station( source.sourceName );
 
-                if(pMSCStore == NULL)
+                if(pStaRegistry != NULL)
                 {
-                    sourceRejectedSet.insert( source );
-                    continue;
-                }
-
-                MSCData mscData;
+                    const StationRegistry::StationInfo* pStaInfo(
+                                                pStaRegistry->find( source ) );
+                    if(pStaInfo == NULL)
+                    {
+                        sourceRejectedSet.insert( source );
+                        continue;
+                    }
 
-                try
-                {
-                    mscData = pMSCStore->findMSC(station,epoch);
+                    nominalPos = pStaInfo->nominalPos;
                 }
-                catch(...)
+                else
                 {
-                    sourceRejectedSet.insert( source );
-                    continue;
-                }
+                    if(pMSCStore == NULL)
+                    {
+                        sourceRejectedSet.insert( source );
+                        continue;
+                    }
 
-                nominalPos = mscData.coordinates;
+                    try
+                    {
+                        nominalPos = pMSCStore->findMSC(station,epoch).coordinates;
+                    }
+                    catch(...)
+                    {
+                        sourceRejectedSet.insert( source );
+                        continue;
+                    }
+                }
 
                 Process( gdmIt->first, sdmIt->second );
             }
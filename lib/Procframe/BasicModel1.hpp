@@ -38,6 +38,7 @@
 #include "EphemerisRange.hpp"
 #include "XvtStore.hpp"
 #include "MSCStore.hpp"
+#include "StationRegistry.hpp"
 
 
 namespace gpstk
@@ -107,7 +108,7 @@ namespace gpstk
       BasicModel1()
          : minElev(10.0),
            pSP3Store(NULL), pBCEStore(NULL),
-           pMSCStore(NULL),
+           pMSCStore(NULL), pStaRegistry(NULL),
            defaultObsOfGPS(TypeID::C1), useTGDOfGPS(false),
            defaultObsOfGAL(TypeID::C1), useTGDOfGAL(false),
            defaultObsOfBDS(TypeID::C2), useTGDOfBDS(false)
@@ -337,6 +338,20 @@ namespace gpstk
       { pMSCStore = &msc; return (*this); };
 
 
+         /// Returns a pointer to the StationRegistry object currently in use.
+      virtual StationRegistry *getStationRegistry(void) const
+      { return pStaRegistry; };
+
+
+         /** Sets StationRegistry object to be used; when set, the stations
+          *  are looked up in it instead of in the MSCStore.
+          *
+          * @param staRegistry     StationRegistry object.
+          */
+      virtual BasicModel1& setStationRegistry(StationRegistry& staRegistry)
+      { pStaRegistry = &staRegistry; return (*this); };
+
+
          /// Get satellite clock map.
       virtual satValueMap getSatClock() const
       { return satClock; };
@@ -346,6 +361,11 @@ namespace gpstk
       virtual std::string getClassName(void) const;
 
 
+         /// Returns a copy of this object, see ProcessingClass::clone().
+      virtual BasicModel1* clone(void) const
+      { return new BasicModel1(*this); };
+
+
          /// Destructor.
       virtual ~BasicModel1() {};
 
@@ -372,6 +392,9 @@ namespace gpstk
          /// Pointer to MSCStore object
       MSCStore* pMSCStore;
 
+         /// Pointer to StationRegistry object
+      StationRegistry* pStaRegistry;
+
 
          /// Default observable to be used
       TypeID defaultObsOfGPS;
@@ -83,6 +83,9 @@ namespace gpstk
 
             Matrix<double> c2tRaw, c2tDot;
 
+            // Topocentric frame of the station, for all the satellites
+            StationFrame sourceFrame( posSource );
+
             // Loop through all the satellites
             for( satTypeValueMap::iterator it = gData.begin();
                  it != gData.end();
@@ -159,8 +162,10 @@ namespace gpstk
                                  posSatECEF(1),
                                  posSatECEF(2) );
 
-                double elevationGeodetic( posSource.elevationGeodetic(posSat) );
-                double azimuthGeodetic( posSource.azimuthGeodetic(posSat) );
+                double elevationGeodetic(0.0), azimuthGeodetic(0.0);
+                sourceFrame.elevAzimGeodetic( posSat,
+                                              elevationGeodetic,
+                                              azimuthGeodetic );
 
                 if(elevationGeodetic < minElev)
                 {
@@ -34,6 +34,7 @@
 #include "ProcessingClass.hpp"
 #include "ReferenceSystem.hpp"
 #include "MSCStore.hpp"
+#include "StationFrame.hpp"
 
 
 namespace gpstk
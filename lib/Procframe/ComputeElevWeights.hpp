@@ -145,6 +145,11 @@ namespace gpstk
       virtual std::string getClassName(void) const;
 
 
+         /// Returns a copy of this object, see ProcessingClass::clone().
+      virtual ComputeElevWeights* clone(void) const
+      { return new ComputeElevWeights(*this); };
+
+
          /// Destructor
       virtual ~ComputeElevWeights() {};
 
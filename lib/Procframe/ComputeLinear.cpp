@@ -34,6 +34,20 @@
 namespace gpstk
 {
 
+   namespace
+   {
+         // A linear combination with resolved EpochDataTable type indexes:
+         // the result, and the index and coefficient of every term (-1 if
+         // the type is not in the table).
+      struct Comb
+      {
+         int result;
+         std::vector<int> index;
+         std::vector<double> coef;
+      };
+   }
+
+
       // Returns a string identifying this object.
    std::string ComputeLinear::getClassName() const
    { return "ComputeLinear"; }
@@ -145,4 +159,81 @@ namespace gpstk
     }  // End of method 'ComputeLinear::Process()'
 
 
+
+     /** Returns an EpochDataTable object, adding the new data generated
+      *  when calling this object.
+      *
+      * @param table    Data object holding the data.
+      */
+    EpochDataTable& ComputeLinear::Process(EpochDataTable& table)
+        throw(ProcessingException)
+    {
+        // Type indexes of the linear combinations are resolved once
+        std::vector<Comb> combOfGPS, combOfGAL, combOfBDS;
+
+        const LinearCombList* lists[3] =
+                { &linearListOfGPS, &linearListOfGAL, &linearListOfBDS };
+        std::vector<Comb>* combs[3] = { &combOfGPS, &combOfGAL, &combOfBDS };
+
+        for(int i = 0; i < 3; ++i)
+        {
+            for( LinearCombList::const_iterator pos = lists[i]->begin();
+                 pos != lists[i]->end();
+                 ++pos )
+            {
+                Comb comb;
+                comb.result = table.addType(pos->header);
+
+                for( typeValueMap::const_iterator iter = pos->body.begin();
+                     iter != pos->body.end();
+                     ++iter )
+                {
+                    comb.index.push_back( table.getTypeIndex(iter->first) );
+                    comb.coef.push_back( iter->second );
+                }
+
+                combs[i]->push_back(comb);
+            }
+        }
+
+        for(int src = 0; src < table.numSources(); ++src)
+        {
+            for(int sat = 0; sat < table.numSats(); ++sat)
+            {
+                if( !table.hasSat(src, sat) ) continue;
+
+                SatID::SatelliteSystem sys( table.getSat(sat).system );
+
+                const std::vector<Comb>* comb(NULL);
+                if(sys == SatID::systemGPS)          comb = &combOfGPS;
+                else if(sys == SatID::systemGalileo) comb = &combOfGAL;
+                else if(sys == SatID::systemBDS)     comb = &combOfBDS;
+                else continue;
+
+                const double* row( table.row(src, sat) );
+
+                for(size_t c = 0; c < comb->size(); ++c)
+                {
+                    const Comb& lc( (*comb)[c] );
+
+                    double result(0.0);
+                    for(size_t k = 0; k < lc.index.size(); ++k)
+                    {
+                        // Types missing in the table are zero
+                        if(lc.index[k] >= 0)
+                        {
+                            result += lc.coef[k] * row[lc.index[k]];
+                        }
+                    }
+
+                    table.setValue(src, sat, lc.result, result);
+                }
+            }
+        }
+
+        return table;
+
+    }  // End of method 'ComputeLinear::Process()'
+
+
 } // End of namespace gpstk
@@ -209,6 +209,15 @@ namespace gpstk
          throw(ProcessingException);
 
 
+         /** Returns an EpochDataTable object, adding the new data generated
+          *  when calling this object. The table is processed directly.
+          *
+          * @param table    Data object holding the data.
+          */
+      virtual EpochDataTable& Process(EpochDataTable& table)
+         throw(ProcessingException);
+
+
          /// Returns the list of linear combinations to be computed.
       virtual LinearCombList getLinearCombinations(
                         const SatID::SatelliteSystem& sys=SatID::systemGPS) const
@@ -313,6 +322,11 @@ namespace gpstk
       virtual std::string getClassName(void) const;
 
 
+         /// Returns a copy of this object, see ProcessingClass::clone().
+      virtual ComputeLinear* clone(void) const
+      { return new ComputeLinear(*this); };
+
+
          /// Destructor
       virtual ~ComputeLinear() {};
 
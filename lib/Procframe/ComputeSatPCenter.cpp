@@ -30,6 +30,10 @@
 
 #include "ComputeSatPCenter.hpp"
 
+#ifdef USE_OPENMP
+#include <omp.h>
+#endif
+
 using namespace std;
 
 namespace gpstk
@@ -54,9 +58,18 @@ namespace gpstk
         try
         {
 
-            // Compute Sun position at this epoch
-            SunPosition sunPosition;
-            Triple sunPos(sunPosition.getPosition(time));
+            // Compute Sun position at this epoch, unless the AstroContext
+            // shared by the stations already has it
+            Triple sunPos;
+            if(pAstro != NULL)
+            {
+                sunPos = pAstro->update(time).getSunPosition();
+            }
+            else
+            {
+                SunPosition sunPosition;
+                sunPos = sunPosition.getPosition(time);
+            }
 
             // Define a Triple that will hold satellite position, in ECEF
             Triple satPos(0.0, 0.0, 0.0);
@@ -65,6 +78,31 @@ namespace gpstk
 
             SatID sat;
 
+            // Satellites whose position is not already computed get it from
+            // the ephemeris, all of them at once
+            std::vector<SatID> ephSats;
+            std::vector<Xvt> ephXvts;
+            std::vector<bool> ephValid;
+            for(satTypeValueMap::iterator it = gData.begin();
+                it != gData.end();
+                ++it)
+            {
+                if( ( (*it).second.find(TypeID::satX) == (*it).second.end() ) ||
+                    ( (*it).second.find(TypeID::satY) == (*it).second.end() ) ||
+                    ( (*it).second.find(TypeID::satZ) == (*it).second.end() ) )
+                {
+                    ephSats.push_back( it->first );
+                }
+            }
+
+            if( pEphStore != NULL && !ephSats.empty() )
+            {
+                // For our purposes, position at receive time is fine enough
+                pEphStore->getXvts(ephSats, time, ephXvts, ephValid);
+            }
+
+            size_t ephIndex(0);
+
             // Loop through all the satellites
             satTypeValueMap::iterator it;
             for(satTypeValueMap::iterator it = gData.begin();
@@ -79,35 +117,20 @@ namespace gpstk
                     ( (*it).second.find(TypeID::satZ) == (*it).second.end() ) )
                 {
 
-                    if(pEphStore==NULL)
+                    // Position from the ephemeris, in the order of ephSats
+                    size_t k( ephIndex++ );
+
+                    if( pEphStore == NULL || !ephValid[k] )
                     {
-                        // If ephemeris is missing, then remove all satellites
+                        // If ephemeris or satellite is missing, then
+                        // schedule it for removal
                         satRejectedSet.insert( sat );
                         continue;
                     }
-                    else
-                    {
-                        // Try to get satellite position
-                        // if it is not already computed
-                        try
-                        {
-                            // For our purposes, position at receive time
-                            // is fine enough
-                            Xvt satPosVel(pEphStore->getXvt( sat, time ));
-
-                            // If everything is OK, then continue processing.
-                            satPos[0] = satPosVel.x.theArray[0];
-                            satPos[1] = satPosVel.x.theArray[1];
-                            satPos[2] = satPosVel.x.theArray[2];
-                        }
-                        catch(...)
-                        {
-                            // If satellite is missing, then schedule it
-                            // for removal
-                            satRejectedSet.insert( sat );
-                            continue;
-                        }
-                    }
+
+                    satPos[0] = ephXvts[k].x.theArray[0];
+                    satPos[1] = ephXvts[k].x.theArray[1];
+                    satPos[2] = ephXvts[k].x.theArray[2];
                 }
                 else
                 {
@@ -176,24 +199,36 @@ namespace gpstk
                 source = sdmIt->first;
                 station = source.sourceName;
 
-                if(pMSCStore == NULL)
+                if(pStaRegistry != NULL)
                 {
-                    sourceRejectedSet.insert( source );
-                    continue;
-                }
+                    const StationRegistry::StationInfo* pStaInfo(
+                                                pStaRegistry->find( source ) );
+                    if(pStaInfo == NULL)
+                    {
+                        sourceRejectedSet.insert( source );
+                        continue;
+                    }
 
-                MSCData mscData;
-                try
-                {
-                    mscData = pMSCStore->findMSC(station,epoch);
+                    nominalPos = pStaInfo->nominalPos;
                 }
-                catch(...)
+                else
                 {
-                    sourceRejectedSet.insert( source );
-                    continue;
-                }
+                    if(pMSCStore == NULL)
+                    {
+                        sourceRejectedSet.insert( source );
+                        continue;
+                    }
 
-                nominalPos = mscData.coordinates;
+                    try
+                    {
+                        nominalPos = pMSCStore->findMSC(station,epoch).coordinates;
+                    }
+                    catch(...)
+                    {
+                        sourceRejectedSet.insert( source );
+                        continue;
+                    }
+                }
 
                 Process( gdmIt->first, sdmIt->second );
             }
@@ -275,13 +310,8 @@ namespace gpstk
             // only works for GPS and GLONASS.
             if( satid.system == SatID::systemGPS )
             {
-                std::stringstream sat;
-                sat << "G";
-                if( satid.id < 10 ) sat << "0";
-                sat << satid.id;
-
-                // Get satellite antenna information out of AntexReader object
-                Antenna antenna( pAntexReader->getAntenna( sat.str(), time ) );
+                // Get satellite antenna information
+                const AntennaTable::Entry& antenna( getSatAntenna( satid, time ) );
 
                 double zen2( antenna.getZen2() );
 
@@ -294,10 +324,19 @@ namespace gpstk
                     // Get antenna eccentricity for frequency "G01" (L1), in
                     // satellite reference system.
                     // NOTE: It is NOT in ECEF, it is in UEN!!!
-                    Triple satAnt( antenna.getAntennaEccentricity( Antenna::G01) );
+                    Triple satAnt;
+                    if( !antenna.getEccentricity( Antenna::G01, satAnt ) )
+                    {
+                        return satPCcorr;
+                    }
 
                     // Now, get the phase center variation.
-                    Triple var( antenna.getAntennaPCVariation( Antenna::G01, elev) );
+                    double pcv( 0.0 );
+                    if( !antenna.getPCVariation( Antenna::G01, elev, pcv ) )
+                    {
+                        return satPCcorr;
+                    }
+                    Triple var( pcv, 0.0, 0.0 );
 
                     // We must substract them
                     satAnt = satAnt;
@@ -325,13 +364,8 @@ namespace gpstk
             // Check if this satellite belongs to GLONASS system
             else if(satid.system == SatID::systemGLONASS)
             {
-                std::stringstream sat;
-                sat << "R";
-                if( satid.id < 10 ) sat << "0";
-                sat << satid.id;
-
-                // Get satellite antenna information out of AntexReader object
-                Antenna antenna( pAntexReader->getAntenna( sat.str(), time ) );
+                // Get satellite antenna information
+                const AntennaTable::Entry& antenna( getSatAntenna( satid, time ) );
 
                 double zen2( antenna.getZen2() );
 
@@ -344,10 +378,19 @@ namespace gpstk
                     // Get antenna offset for frequency "R01" (GLONASS), in
                     // satellite reference system.
                     // NOTE: It is NOT in ECEF, it is in UEN!!!
-                    Triple satAnt( antenna.getAntennaEccentricity( Antenna::R01) );
+                    Triple satAnt;
+                    if( !antenna.getEccentricity( Antenna::R01, satAnt ) )
+                    {
+                        return satPCcorr;
+                    }
 
                     // Now, get the phase center variation.
-                    Triple var( antenna.getAntennaPCVariation( Antenna::R01, elev) );
+                    double pcv( 0.0 );
+                    if( !antenna.getPCVariation( Antenna::R01, elev, pcv ) )
+                    {
+                        return satPCcorr;
+                    }
+                    Triple var( pcv, 0.0, 0.0 );
 
                     // We must substract them
                     satAnt = satAnt;
@@ -374,13 +417,8 @@ namespace gpstk
             // Check if this satellite belongs to Galileo system
             else if( satid.system == SatID::systemGalileo )
             {
-                std::stringstream sat;
-                sat << "E";
-                if( satid.id < 10 ) sat << "0";
-                sat << satid.id;
-
-                // Get satellite antenna information out of AntexReader object
-                Antenna antenna( pAntexReader->getAntenna( sat.str(), time ) );
+                // Get satellite antenna information
+                const AntennaTable::Entry& antenna( getSatAntenna( satid, time ) );
 
                 double zen2( antenna.getZen2() );
 
@@ -393,10 +431,19 @@ namespace gpstk
                     // Get antenna offset for frequency "E01" (Galileo), in
                     // satellite reference system.
                     // NOTE: It is NOT in ECEF, it is in UEN!!!
-                    Triple satAnt( antenna.getAntennaEccentricity( Antenna::E01) );
+                    Triple satAnt;
+                    if( !antenna.getEccentricity( Antenna::E01, satAnt ) )
+                    {
+                        return satPCcorr;
+                    }
 
                     // Now, get the phase center variation.
-                    Triple var( antenna.getAntennaPCVariation( Antenna::E01, elev) );
+                    double pcv( 0.0 );
+                    if( !antenna.getPCVariation( Antenna::E01, elev, pcv ) )
+                    {
+                        return satPCcorr;
+                    }
+                    Triple var( pcv, 0.0, 0.0 );
 
                     // We must substract them
                     satAnt = satAnt - var;
@@ -423,15 +470,10 @@ namespace gpstk
             // Check if this satellite belongs to BeiDou system
             else if( satid.system == SatID::systemBDS )
             {
-                std::stringstream sat;
-                sat << "C";
-                if( satid.id < 10 ) sat << "0";
-                sat << satid.id;
-
                 if(satid.id > 30) return satPCcorr;
 
-                // Get satellite antenna information out of AntexReader object
-                Antenna antenna( pAntexReader->getAntenna( sat.str(), time ) );
+                // Get satellite antenna information
+                const AntennaTable::Entry& antenna( getSatAntenna( satid, time ) );
 
                 double zen2( antenna.getZen2() );
 
@@ -444,10 +486,19 @@ namespace gpstk
                     // Get antenna offset for frequency "C01" (BeiDou), in
                     // satellite reference system.
                     // NOTE: It is NOT in ECEF, it is in UEN!!!
-                    Triple satAnt( antenna.getAntennaEccentricity( Antenna::C01) );
+                    Triple satAnt;
+                    if( !antenna.getEccentricity( Antenna::C01, satAnt ) )
+                    {
+                        return satPCcorr;
+                    }
 
                     // Now, get the phase center variation.
-                    Triple var( antenna.getAntennaPCVariation( Antenna::C01, elev) );
+                    double pcv( 0.0 );
+                    if( !antenna.getPCVariation( Antenna::C01, elev, pcv ) )
+                    {
+                        return satPCcorr;
+                    }
+                    Triple var( pcv, 0.0, 0.0 );
 
                     // Change to ECEF
                     Triple satAntenna( satAnt[2]*ri + satAnt[1]*rj + satAnt[0]*rk );
@@ -471,13 +522,8 @@ namespace gpstk
             // Check if this satellite belongs to QZSS system
             else if( satid.system == SatID::systemQZSS )
             {
-                std::stringstream sat;
-                sat << "J";
-                if( satid.id < 10 ) sat << "0";
-                sat << satid.id;
-
-                // Get satellite antenna information out of AntexReader object
-                Antenna antenna( pAntexReader->getAntenna( sat.str(), time ) );
+                // Get satellite antenna information
+                const AntennaTable::Entry& antenna( getSatAntenna( satid, time ) );
 
                 double zen2( antenna.getZen2() );
 
@@ -490,10 +536,19 @@ namespace gpstk
                     // Get antenna offset for frequency "J01" (QZSS), in
                     // satellite reference system.
                     // NOTE: It is NOT in ECEF, it is in UEN!!!
-                    Triple satAnt( antenna.getAntennaEccentricity( Antenna::J01) );
+                    Triple satAnt;
+                    if( !antenna.getEccentricity( Antenna::J01, satAnt ) )
+                    {
+                        return satPCcorr;
+                    }
 
                     // Now, get the phase center variation.
-                    Triple var( antenna.getAntennaPCVariation( Antenna::J01, elev) );
+                    double pcv( 0.0 );
+                    if( !antenna.getPCVariation( Antenna::J01, elev, pcv ) )
+                    {
+                        return satPCcorr;
+                    }
+                    Triple var( pcv, 0.0, 0.0 );
 
                     // Change to ECEF
                     Triple satAntenna( satAnt[2]*ri + satAnt[1]*rj + satAnt[0]*rk );
@@ -528,4 +583,72 @@ namespace gpstk
     }  // End of method 'ComputeSatPCenter::getSatPCenter()'
 
 
+
+      /* Get satellite antenna information, out of 'satAntennas' or, the
+       * first time it is needed for a validity interval, out of the
+       * AntexReader object.
+       *
+       * @param satid     Satellite ID
+       * @param time      Epoch of interest
+       */
+    const AntennaTable::Entry& ComputeSatPCenter::getSatAntenna(
+                                                    const SatID& satid,
+                                                    const CommonTime& time )
+        throw(ObjectNotFound, InvalidRequest)
+    {
+        const AntennaTable::Entry* pEntry(
+                                    satAntennas.findSatellite(satid, time) );
+        if( pEntry != NULL )
+        {
+            return (*pEntry);
+        }
+
+        // Antenna serial number in Antex format, e.g. "G01"
+        std::stringstream sat;
+        switch( satid.system )
+        {
+            case SatID::systemGPS:     sat << "G"; break;
+            case SatID::systemGLONASS: sat << "R"; break;
+            case SatID::systemGalileo: sat << "E"; break;
+            case SatID::systemBDS:     sat << "C"; break;
+            case SatID::systemQZSS:    sat << "J"; break;
+            default:
+            {
+                InvalidRequest e("No Antex serial for this satellite.");
+                GPSTK_THROW(e);
+            }
+        }
+        if( satid.id < 10 ) sat << "0";
+        sat << satid.id;
+
+        Antenna antenna;
+
+        bool found(false);
+        ObjectNotFound notFound;
+
+#ifdef _OPENMP
+        #pragma omp critical (ComputeSatPCenter_antex)
+#endif
+        {
+            try
+            {
+                antenna = pAntexReader->getAntenna( sat.str(), time );
+                found = true;
+            }
+            catch(ObjectNotFound& e)
+            {
+                notFound = e;
+            }
+        }
+
+        if( !found )
+        {
+            GPSTK_THROW(notFound);
+        }
+
+        return satAntennas.addSatellite(satid, antenna);
+
+    }  // End of method 'ComputeSatPCenter::getSatAntenna()'
+
+
 }  // End of namespace gpstk
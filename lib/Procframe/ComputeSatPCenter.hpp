@@ -41,7 +41,10 @@
 #include "SunPosition.hpp"
 #include "XvtStore.hpp"
 #include "MSCStore.hpp"
+#include "StationRegistry.hpp"
+#include "AstroContext.hpp"
 #include "AntexReader.hpp"
+#include "AntennaTable.hpp"
 #include "StringUtils.hpp"
 #include "constants.hpp"
 
@@ -104,7 +107,8 @@ namespace gpstk
          /// Default constructor
       ComputeSatPCenter()
          : pEphStore(NULL), nominalPos(0.0, 0.0, 0.0),
-           pMSCStore(NULL), pAntexReader(NULL)
+           pMSCStore(NULL), pStaRegistry(NULL),
+           pAstro(NULL), pAntexReader(NULL)
       { };
 
 
@@ -121,7 +125,8 @@ namespace gpstk
       ComputeSatPCenter( XvtStore<SatID>& ephStore,
                          const Position& staPos )
          : pEphStore(&ephStore), nominalPos(staPos),
-           pAntexReader(NULL), pMSCStore(NULL)
+           pAntexReader(NULL), pMSCStore(NULL), pStaRegistry(NULL),
+           pAstro(NULL)
       { };
 
 
@@ -136,7 +141,8 @@ namespace gpstk
           */
       ComputeSatPCenter( const Position& stapos )
          : pEphStore(NULL), nominalPos(stapos),
-           pAntexReader(NULL), pMSCStore(NULL)
+           pAntexReader(NULL), pMSCStore(NULL), pStaRegistry(NULL),
+           pAstro(NULL)
       { };
 
 
@@ -154,7 +160,8 @@ namespace gpstk
                          const Position& staPos,
                          AntexReader& antexObj )
          : pEphStore(&ephStore), nominalPos(staPos),
-           pAntexReader(&antexObj), pMSCStore(NULL)
+           pAntexReader(&antexObj), pMSCStore(NULL), pStaRegistry(NULL),
+           pAstro(NULL)
       { };
 
 
@@ -170,7 +177,8 @@ namespace gpstk
       ComputeSatPCenter( const Position& staPos,
                          AntexReader& antexObj )
          : pEphStore(NULL), nominalPos(staPos),
-           pAntexReader(&antexObj), pMSCStore(NULL)
+           pAntexReader(&antexObj), pMSCStore(NULL), pStaRegistry(NULL),
+           pAstro(NULL)
       { };
 
 
@@ -253,6 +261,34 @@ namespace gpstk
       { pMSCStore = &mscStore; return (*this); };
 
 
+         /// Returns a pointer to the StationRegistry object currently in use.
+      virtual StationRegistry *getStationRegistry(void) const
+      { return pStaRegistry; };
+
+
+         /** Sets StationRegistry object to be used; when set, the stations
+          *  are looked up in it instead of in the MSCStore.
+          *
+          * @param staRegistry     StationRegistry object.
+          */
+      virtual ComputeSatPCenter& setStationRegistry(StationRegistry& staRegistry)
+      { pStaRegistry = &staRegistry; return (*this); };
+
+
+         /// Returns a pointer to the AstroContext object currently in use.
+      virtual AstroContext *getAstroContext(void) const
+      { return pAstro; };
+
+
+         /** Sets AstroContext object to be used; when set, the Sun position
+          *  of the epoch is taken from it instead of being computed here.
+          *
+          * @param astro     AstroContext object.
+          */
+      virtual ComputeSatPCenter& setAstroContext(AstroContext& astro)
+      { pAstro = &astro; return (*this); };
+
+
          /// Returns a pointer to the AntexReader object currently in use.
       virtual AntexReader *getAntexReader(void) const
       { return pAntexReader; };
@@ -264,13 +300,18 @@ namespace gpstk
           *                  antenna data.
           */
       virtual ComputeSatPCenter& setAntexReader(AntexReader& antexObj)
-      { pAntexReader = &antexObj; return (*this); };
+      { pAntexReader = &antexObj; satAntennas.clear(); return (*this); };
 
 
          /// Returns a string identifying this object.
       virtual std::string getClassName(void) const;
 
 
+         /// Returns a copy of this object, see ProcessingClass::clone().
+      virtual ComputeSatPCenter* clone(void) const
+      { return new ComputeSatPCenter(*this); };
+
+
          /// Destructor
       virtual ~ComputeSatPCenter() {};
 
@@ -287,9 +328,37 @@ namespace gpstk
          /// Pointer to MSCStore object
       MSCStore* pMSCStore;
 
+         /// Pointer to StationRegistry object
+      StationRegistry* pStaRegistry;
+
+         /// Pointer to AstroContext object
+      AstroContext* pAstro;
+
          /// Pointer to AntexReader object
       AntexReader* pAntexReader;
 
+         /// Satellite antennas already got out of the AntexReader object
+      AntennaTable satAntennas;
+
+
+         /** Get satellite antenna information, out of 'satAntennas' or, the
+          *  first time it is needed for a validity interval, out of the
+          *  AntexReader object.
+          *
+          * AntexReader reads the antennas from file the first time they are
+          * asked for, so look-ups are serialized when the copies of this
+          * object run in parallel (see ProcessingClass::clone()). Each copy
+          * has its own 'satAntennas'.
+          *
+          * @param satid     Satellite ID
+          * @param time      Epoch of interest
+          *
+          * @warning The reference is valid until the next call.
+          */
+      const AntennaTable::Entry& getSatAntenna( const SatID& satid,
+                                                const CommonTime& time )
+         throw(ObjectNotFound, InvalidRequest);
+
 
          /** Compute the value of satellite antenna phase correction, in meters
           * @param satid     Satellite ID
@@ -297,7 +366,9 @@ namespace gpstk
           * @param satpos    Satellite position, as a Triple
           * @param sunpos    Sun position, as a Triple
           *
-          * @return Satellite antenna phase correction, in meters.
+          * @return Satellite antenna phase correction, in meters. It is
+          * zero if the Antex data of the satellite have no offset or
+          * variation for the frequency needed.
           */
       virtual Vector<double> getSatPCenter( const SatID& satid,
                                             const CommonTime& time,
@@ -7,11 +7,21 @@ namespace gpstk
 
    Triple ComputeTides::correct(const CommonTime time)
    {
+      if( NULL != m_pAstro )
+      {
+         return correct( time, m_pAstro->update(time) );
+      }
+
       SolidTides solid;
       Triple solidCorr, oceanCorr, poleCorr;
       solidCorr = solid.getSolidTide( time, m_NominalPos );
 
-      if( NULL != m_pBLQReader )
+      if( NULL != m_pTideHarmonics )
+      {
+         OceanLoading ocean;
+         oceanCorr = ocean.getOceanLoading(*m_pTideHarmonics, time);
+      }
+      else if( NULL != m_pBLQReader )
       {
          OceanLoading ocean(*m_pBLQReader);
          oceanCorr = ocean.getOceanLoading(m_StationName, time);
@@ -26,4 +36,47 @@ namespace gpstk
       return solidCorr + oceanCorr + poleCorr;
    }
 
+
+   Triple ComputeTides::correct( const CommonTime& time,
+                                 const AstroContext& astro )
+   {
+      SolidTides solid;
+      Triple solidCorr, oceanCorr, poleCorr;
+      solidCorr = solid.getSolidTide( m_NominalPos,
+                                      astro.getSunPosition(),
+                                      astro.getMoonPosition() );
+
+      OceanLoading ocean;
+      if( NULL != m_pTideHarmonics )
+      {
+         oceanCorr = ocean.getOceanLoading( *m_pTideHarmonics,
+                                            astro.getOceanArguments() );
+      }
+      else if( NULL != m_pBLQReader )
+      {
+         oceanCorr = ocean.getOceanLoading(
+                              m_pBLQReader->getTideHarmonics(m_StationName),
+                              astro.getOceanArguments() );
+      }
+
+      if( NULL != m_pEOPDataStore )
+      {
+         const EOPDataStore2::EOPData* pEOP( astro.hasEOP() ?
+                                             &astro.getEOPData() : NULL );
+
+         if( pEOP != NULL && astro.getEOPDataStore() == m_pEOPDataStore )
+         {
+            PoleTides pole;
+            poleCorr = pole.getPoleTide(time, m_NominalPos, pEOP->xp, pEOP->yp);
+         }
+         else
+         {
+            PoleTides pole(*m_pEOPDataStore);
+            poleCorr = pole.getPoleTide(time, m_NominalPos);
+         }
+      }
+
+      return solidCorr + oceanCorr + poleCorr;
+   }
+
 }
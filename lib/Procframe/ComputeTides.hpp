@@ -12,6 +12,7 @@
 #include "SolidTides.hpp"
 #include "OceanLoading.hpp"
 #include "PoleTides.hpp"
+#include "AstroContext.hpp"
 
 
 namespace gpstk
@@ -22,18 +23,26 @@ namespace gpstk
     public:
         ComputeTides()
             : m_pBLQReader(NULL),m_pEOPDataStore(NULL),
-              m_NominalPos(0,0,0),m_StationName("")
+              m_NominalPos(0,0,0),m_StationName(""),m_pTideHarmonics(NULL),
+              m_pAstro(NULL)
         {}
 
 
         ComputeTides(BLQDataReader& blqReader, EOPDataStore2& eopDataStore)
-            : m_NominalPos(0,0,0),m_StationName("")
+            : m_NominalPos(0,0,0),m_StationName(""),m_pTideHarmonics(NULL),
+              m_pAstro(NULL)
         { m_pBLQReader = &blqReader; m_pEOPDataStore = &eopDataStore; }
 
 
         virtual Triple correct(const CommonTime time);
 
 
+        // the same, with the Sun, Moon, tidal arguments and EOP of the epoch
+        // taken from astro
+        virtual Triple correct( const CommonTime& time,
+                                const AstroContext& astro );
+
+
         virtual ComputeTides& setBLQReader( BLQDataReader& blqReader)
         { m_pBLQReader = &blqReader; return (*this); }
 
@@ -50,6 +59,18 @@ namespace gpstk
         { m_StationName = name; return (*this);}
 
 
+        // ocean tide harmonics of the station, used instead of looking
+        // the station name up in the blq data; NULL to look it up
+        virtual ComputeTides& setTideHarmonics(const Matrix<double>* pHarmonics)
+        { m_pTideHarmonics = pHarmonics; return (*this);}
+
+
+        // per-epoch Sun, Moon, tidal arguments and EOP shared with the
+        // other stations, instead of computing them for each station
+        virtual ComputeTides& setAstroContext(AstroContext& astro)
+        { m_pAstro = &astro; return (*this);}
+
+
         virtual ~ComputeTides() {}
 
 
@@ -66,6 +87,12 @@ namespace gpstk
 
         // station Name
         std::string m_StationName;
+
+        // station ocean tide harmonics
+        const Matrix<double>* m_pTideHarmonics;
+
+        // per-epoch astronomical quantities
+        AstroContext* m_pAstro;
     };
 
 }
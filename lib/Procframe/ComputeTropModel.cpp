@@ -173,25 +173,38 @@ namespace gpstk
                 SourceID source( sdmIt->first );
                 string station( source.sourceName );
 
-                if(pMSCStore == NULL)
-                {
-                    sourceRejectedSet.insert( source );
-                    continue;
-                }
+                Position nominalPos;
 
-                MSCData mscData;
-
-                try
+                if(pStaRegistry != NULL)
                 {
-                    mscData = pMSCStore->findMSC(station,epoch);
+                    const StationRegistry::StationInfo* pStaInfo(
+                                                pStaRegistry->find( source ) );
+                    if(pStaInfo == NULL)
+                    {
+                        sourceRejectedSet.insert( source );
+                        continue;
+                    }
+
+                    nominalPos = pStaInfo->nominalPos;
                 }
-                catch(...)
+                else
                 {
-                    sourceRejectedSet.insert( source );
-                    continue;
-                }
+                    if(pMSCStore == NULL)
+                    {
+                        sourceRejectedSet.insert( source );
+                        continue;
+                    }
 
-                Position nominalPos( mscData.coordinates );
+                    try
+                    {
+                        nominalPos = pMSCStore->findMSC(station,epoch).coordinates;
+                    }
+                    catch(...)
+                    {
+                        sourceRejectedSet.insert( source );
+                        continue;
+                    }
+                }
 
                 pTropModel->setAllParameters( epoch, nominalPos );
 
@@ -36,6 +36,7 @@
 #include "ProcessingClass.hpp"
 #include "TropModel.hpp"
 #include "MSCStore.hpp"
+#include "StationRegistry.hpp"
 
 
 namespace gpstk
@@ -100,7 +101,9 @@ namespace gpstk
     public:
 
          /// Default constructor.
-        ComputeTropModel() : pTropModel(NULL) {};
+        ComputeTropModel()
+            : pTropModel(NULL), pMSCStore(NULL), pStaRegistry(NULL)
+        {};
 
 
          /** Explicit constructor.
@@ -109,6 +112,7 @@ namespace gpstk
           *
           */
         ComputeTropModel(TropModel& tropoModel)
+            : pMSCStore(NULL), pStaRegistry(NULL)
         { pTropModel = &tropoModel; };
 
 
@@ -180,6 +184,20 @@ namespace gpstk
         { pMSCStore = &msc; return (*this); };
 
 
+         /// Returns a pointer to the StationRegistry object currently in use.
+        virtual StationRegistry *getStationRegistry(void) const
+        { return pStaRegistry; };
+
+
+         /** Sets StationRegistry object to be used; when set, the stations
+          *  are looked up in it instead of in the MSCStore.
+          *
+          * @param staRegistry     StationRegistry object.
+          */
+        virtual ComputeTropModel& setStationRegistry(StationRegistry& staRegistry)
+        { pStaRegistry = &staRegistry; return (*this); };
+
+
          /// Returns a string identifying this object.
         virtual std::string getClassName(void) const;
 
@@ -197,6 +215,9 @@ namespace gpstk
          /// Pointer to object contatining station nominal position
         MSCStore* pMSCStore;
 
+         /// Pointer to StationRegistry object
+        StationRegistry* pStaRegistry;
+
     }; // End of class 'ComputeTropModel'
 
       //@}
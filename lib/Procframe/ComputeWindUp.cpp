@@ -53,15 +53,49 @@ namespace gpstk
     {
         try
         {
-            // Compute Sun position at this epoch
-            SunPosition sunPosition;
-            Triple sunPos(sunPosition.getPosition(time));
+            // Compute Sun position at this epoch, unless the AstroContext
+            // shared by the stations already has it
+            Triple sunPos;
+            if(pAstro != NULL)
+            {
+                sunPos = pAstro->update(time).getSunPosition();
+            }
+            else
+            {
+                SunPosition sunPosition;
+                sunPos = sunPosition.getPosition(time);
+            }
 
             // Define a Triple that will hold satellite position, in ECEF
             Triple svPos(0.0, 0.0, 0.0);
 
             SatIDSet satRejectedSet;
 
+            // Satellites whose position is not already computed get it from
+            // the ephemeris, all of them at once
+            std::vector<SatID> ephSats;
+            std::vector<Xvt> ephXvts;
+            std::vector<bool> ephValid;
+            for ( satTypeValueMap::iterator it = gData.begin();
+                  it != gData.end();
+                  ++it )
+            {
+                if( ( (*it).second.find(TypeID::satX) == (*it).second.end() ) ||
+                    ( (*it).second.find(TypeID::satY) == (*it).second.end() ) ||
+                    ( (*it).second.find(TypeID::satZ) == (*it).second.end() ) )
+                {
+                    ephSats.push_back( it->first );
+                }
+            }
+
+            if( pEphStore != NULL && !ephSats.empty() )
+            {
+                // For our purposes, position at receive time is fine enough
+                pEphStore->getXvts(ephSats, time, ephXvts, ephValid);
+            }
+
+            size_t ephIndex(0);
+
             // Loop through all the satellites
             for ( satTypeValueMap::iterator it = gData.begin();
                   it != gData.end();
@@ -95,35 +129,20 @@ namespace gpstk
                     ( (*it).second.find(TypeID::satZ) == (*it).second.end() ) )
                 {
 
-                    if(pEphStore==NULL)
+                    // Position from the ephemeris, in the order of ephSats
+                    size_t k( ephIndex++ );
+
+                    if( pEphStore == NULL || !ephValid[k] )
                     {
-                        // If ephemeris is missing, then remove all satellites
+                        // If ephemeris or satellite is missing, then
+                        // schedule it for removal
                         satRejectedSet.insert( (*it).first );
                         continue;
                     }
-                    else
-                    {
-                        // Try to get satellite position
-                        // if it is not already computed
-                        try
-                        {
-                            // For our purposes, position at receive time
-                            // is fine enough
-                            Xvt svPosVel(pEphStore->getXvt( (*it).first, time ));
-
-                            // If everything is OK, then continue processing.
-                            svPos[0] = svPosVel.x.theArray[0];
-                            svPos[1] = svPosVel.x.theArray[1];
-                            svPos[2] = svPosVel.x.theArray[2];
-                        }
-                        catch(...)
-                        {
-                            // If satellite is missing, then schedule it
-                            // for removal
-                            satRejectedSet.insert( (*it).first );
-                            continue;
-                        }
-                    }
+
+                    svPos[0] = ephXvts[k].x.theArray[0];
+                    svPos[1] = ephXvts[k].x.theArray[1];
+                    svPos[2] = ephXvts[k].x.theArray[2];
                 }
                 else
                 {
@@ -186,24 +205,36 @@ namespace gpstk
                 source = sdmIt->first;
                 station = source.sourceName;
 
-                if(pMSCStore == NULL)
+                if(pStaRegistry != NULL)
                 {
-                    sourceRejectedSet.insert( source );
-                    continue;
-                }
+                    const StationRegistry::StationInfo* pStaInfo(
+                                                pStaRegistry->find( source ) );
+                    if(pStaInfo == NULL)
+                    {
+                        sourceRejectedSet.insert( source );
+                        continue;
+                    }
 
-                MSCData mscData;
-                try
-                {
-                    mscData = pMSCStore->findMSC(station,epoch);
+                    nominalPos = pStaInfo->nominalPos;
                 }
-                catch(...)
+                else
                 {
-                    sourceRejectedSet.insert( source );
-                    continue;
-                }
+                    if(pMSCStore == NULL)
+                    {
+                        sourceRejectedSet.insert( source );
+                        continue;
+                    }
 
-                nominalPos = mscData.coordinates;
+                    try
+                    {
+                        nominalPos = pMSCStore->findMSC(station,epoch).coordinates;
+                    }
+                    catch(...)
+                    {
+                        sourceRejectedSet.insert( source );
+                        continue;
+                    }
+                }
 
                 SatPhaseDataMap::iterator satPhaseDataIt = m_satPhaseDataMap.find(source);
 
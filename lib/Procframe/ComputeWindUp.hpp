@@ -37,6 +37,8 @@
 #include "SunPosition.hpp"
 #include "XvtStore.hpp"
 #include "MSCStore.hpp"
+#include "StationRegistry.hpp"
+#include "AstroContext.hpp"
 #include "SatDataReader.hpp"
 #include "AntexReader.hpp"
 #include "constants.hpp"
@@ -104,6 +106,7 @@ namespace gpstk
          /// Default constructor
       ComputeWindUp()
          : pEphStore(NULL), nominalPos(0.0, 0.0, 0.0), pMSCStore(NULL),
+           pStaRegistry(NULL), pAstro(NULL),
            satData("PRN_GPS"), fileData("PRN_GPS"), pAntexReader(NULL)
       { };
 
@@ -122,7 +125,8 @@ namespace gpstk
                      const Position& staPos,
                      std::string filename="PRN_GPS" )
          : pEphStore(&ephStore), nominalPos(staPos),
-           pMSCStore(NULL), satData(filename),
+           pMSCStore(NULL), pStaRegistry(NULL),
+           pAstro(NULL), satData(filename),
            fileData(filename), pAntexReader(NULL)
       { };
 
@@ -142,7 +146,8 @@ namespace gpstk
                      MSCStore& mscStore,
                      AntexReader& antexObj )
          : pEphStore(&ephStore), nominalPos(staPos),
-           pMSCStore(&mscStore), pAntexReader(&antexObj)
+           pMSCStore(&mscStore), pStaRegistry(NULL),
+           pAstro(NULL), pAntexReader(&antexObj)
       { };
 
 
@@ -158,7 +163,8 @@ namespace gpstk
       ComputeWindUp( const Position& staPos,
                      AntexReader& antexObj )
          : pEphStore(NULL), nominalPos(staPos),
-           pMSCStore(NULL), pAntexReader(&antexObj)
+           pMSCStore(NULL), pStaRegistry(NULL),
+           pAstro(NULL), pAntexReader(&antexObj)
       { };
 
 
@@ -265,6 +271,34 @@ namespace gpstk
       { pMSCStore = &msc; return (*this); };
 
 
+         /// Returns a pointer to the StationRegistry object currently in use.
+      virtual StationRegistry *getStationRegistry(void) const
+      { return pStaRegistry; };
+
+
+         /** Sets StationRegistry object to be used; when set, the stations
+          *  are looked up in it instead of in the MSCStore.
+          *
+          * @param staRegistry     StationRegistry object.
+          */
+      virtual ComputeWindUp& setStationRegistry(StationRegistry& staRegistry)
+      { pStaRegistry = &staRegistry; return (*this); };
+
+
+         /// Returns a pointer to the AstroContext object currently in use.
+      virtual AstroContext *getAstroContext(void) const
+      { return pAstro; };
+
+
+         /** Sets AstroContext object to be used; when set, the Sun position
+          *  of the epoch is taken from it instead of being computed here.
+          *
+          * @param astro     AstroContext object.
+          */
+      virtual ComputeWindUp& setAstroContext(AstroContext& astro)
+      { pAstro = &astro; return (*this); };
+
+
          /// Returns a string identifying this object.
       virtual std::string getClassName(void) const;
 
@@ -287,6 +321,12 @@ namespace gpstk
          /// Pointer to MSCStore object
       MSCStore* pMSCStore;
 
+         /// Pointer to StationRegistry object
+      StationRegistry* pStaRegistry;
+
+         /// Pointer to AstroContext object
+      AstroContext* pAstro;
+
 
          /// Object to read satellite data file (PRN_GPS)
       SatDataReader satData;
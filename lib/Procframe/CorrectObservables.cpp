@@ -547,24 +547,41 @@ namespace gpstk
                 monumentVector = sourceMonument[source];
                 antenna = sourceAntenna[source];
 
-                if(pMSCStore == NULL)
+                if(pStaRegistry != NULL)
                 {
-                    sourceRejectedSet.insert( source );
-                    continue;
-                }
+                    const StationRegistry::StationInfo* pStaInfo(
+                                                pStaRegistry->find( source ) );
+                    if(pStaInfo == NULL)
+                    {
+                        sourceRejectedSet.insert( source );
+                        continue;
+                    }
 
-                MSCData mscData;
-                try
-                {
-                    mscData = pMSCStore->findMSC(station,epoch);
+                    nominalPos = pStaInfo->nominalPos;
+
+                    tideCorr.setTideHarmonics( pStaInfo->hasBLQ ?
+                                               &pStaInfo->blq : NULL );
                 }
-                catch(...)
+                else
                 {
-                    sourceRejectedSet.insert( source );
-                    continue;
-                }
+                    tideCorr.setTideHarmonics( NULL );
 
-                nominalPos = mscData.coordinates;
+                    if(pMSCStore == NULL)
+                    {
+                        sourceRejectedSet.insert( source );
+                        continue;
+                    }
+
+                    try
+                    {
+                        nominalPos = pMSCStore->findMSC(station,epoch).coordinates;
+                    }
+                    catch(...)
+                    {
+                        sourceRejectedSet.insert( source );
+                        continue;
+                    }
+                }
 
                 tideCorr.setNominalPosition( nominalPos );
                 tideCorr.setStationName( station );
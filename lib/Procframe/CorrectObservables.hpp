@@ -38,6 +38,7 @@
 #include "ProcessingClass.hpp"
 #include "XvtStore.hpp"
 #include "MSCStore.hpp"
+#include "StationRegistry.hpp"
 #include "Antenna.hpp"
 #include "ComputeTides.hpp"
 #include "constants.hpp"
@@ -114,7 +115,7 @@ namespace gpstk
          /// Default constructor
         CorrectObservables()
             : pEphStore(NULL), nominalPos(0.0, 0.0, 0.0),
-              pMSCStore(NULL), useAzimuth(false),
+              pMSCStore(NULL), pStaRegistry(NULL), useAzimuth(false),
               L1PhaseCenter(0.0, 0.0, 0.0), L2PhaseCenter(0.0, 0.0, 0.0),
               L3PhaseCenter(0.0, 0.0, 0.0), L5PhaseCenter(0.0, 0.0, 0.0),
               L6PhaseCenter(0.0, 0.0, 0.0), L7PhaseCenter(0.0, 0.0, 0.0),
@@ -130,7 +131,7 @@ namespace gpstk
           */
         CorrectObservables(XvtStore<SatID>& ephStore)
             : pEphStore(&ephStore), nominalPos(0.0, 0.0, 0.0),
-              pMSCStore(NULL), useAzimuth(false),
+              pMSCStore(NULL), pStaRegistry(NULL), useAzimuth(false),
               L1PhaseCenter(0.0, 0.0, 0.0), L2PhaseCenter(0.0, 0.0, 0.0),
               L3PhaseCenter(0.0, 0.0, 0.0), L5PhaseCenter(0.0, 0.0, 0.0),
               L6PhaseCenter(0.0, 0.0, 0.0), L7PhaseCenter(0.0, 0.0, 0.0),
@@ -148,7 +149,7 @@ namespace gpstk
         CorrectObservables( XvtStore<SatID>& ephStore,
                             const Position& staPos )
             : pEphStore(&ephStore), nominalPos(staPos),
-              pMSCStore(NULL), useAzimuth(false),
+              pMSCStore(NULL), pStaRegistry(NULL), useAzimuth(false),
               L1PhaseCenter(0.0, 0.0, 0.0), L2PhaseCenter(0.0, 0.0, 0.0),
               L3PhaseCenter(0.0, 0.0, 0.0), L5PhaseCenter(0.0, 0.0, 0.0),
               L6PhaseCenter(0.0, 0.0, 0.0), L7PhaseCenter(0.0, 0.0, 0.0),
@@ -170,7 +171,7 @@ namespace gpstk
                             MSCStore& mscStore,
                             const Antenna& antennaObj )
             : pEphStore(&ephStore), nominalPos(staPos),
-              pMSCStore(&mscStore), antenna(antennaObj),
+              pMSCStore(&mscStore), pStaRegistry(NULL), antenna(antennaObj),
               useAzimuth(true),
               L1PhaseCenter(0.0, 0.0, 0.0), L2PhaseCenter(0.0, 0.0, 0.0),
               L3PhaseCenter(0.0, 0.0, 0.0), L5PhaseCenter(0.0, 0.0, 0.0),
@@ -193,7 +194,7 @@ namespace gpstk
                             MSCStore& mscStore,
                             const Triple& L1pc )
             : pEphStore(&ephStore), nominalPos(staPos),
-              pMSCStore(&mscStore), useAzimuth(false),
+              pMSCStore(&mscStore), pStaRegistry(NULL), useAzimuth(false),
               L1PhaseCenter(L1pc), L2PhaseCenter(0.0, 0.0, 0.0),
               L3PhaseCenter(0.0, 0.0, 0.0), L5PhaseCenter(0.0, 0.0, 0.0),
               L6PhaseCenter(0.0, 0.0, 0.0), L7PhaseCenter(0.0, 0.0, 0.0),
@@ -218,7 +219,7 @@ namespace gpstk
                             const Triple& L1pc,
                             const Triple& L2pc )
             : pEphStore(&ephStore), nominalPos(staPos),
-              pMSCStore(&mscStore), useAzimuth(false),
+              pMSCStore(&mscStore), pStaRegistry(NULL), useAzimuth(false),
               L1PhaseCenter(L1pc), L2PhaseCenter(L2pc),
               L3PhaseCenter(0.0, 0.0, 0.0), L5PhaseCenter(0.0, 0.0, 0.0),
               L6PhaseCenter(0.0, 0.0, 0.0), L7PhaseCenter(0.0, 0.0, 0.0),
@@ -246,7 +247,7 @@ namespace gpstk
                             const Triple& L2pc,
                             const Triple& extra )
             : pEphStore(&ephStore), nominalPos(staPos),
-              pMSCStore(&mscStore), useAzimuth(false),
+              pMSCStore(&mscStore), pStaRegistry(NULL), useAzimuth(false),
               L1PhaseCenter(L1pc), L2PhaseCenter(L2pc),
               L3PhaseCenter(0.0, 0.0, 0.0), L5PhaseCenter(0.0, 0.0, 0.0),
               L6PhaseCenter(0.0, 0.0, 0.0), L7PhaseCenter(0.0, 0.0, 0.0),
@@ -276,7 +277,7 @@ namespace gpstk
                             const Triple& monument,
                             const Triple& extra )
             : pEphStore(&ephStore), nominalPos(staPos),
-              pMSCStore(&mscStore), useAzimuth(false),
+              pMSCStore(&mscStore), pStaRegistry(NULL), useAzimuth(false),
               L1PhaseCenter(L1pc), L2PhaseCenter(L2pc),
               L3PhaseCenter(0.0, 0.0, 0.0), L5PhaseCenter(0.0, 0.0, 0.0),
               L6PhaseCenter(0.0, 0.0, 0.0), L7PhaseCenter(0.0, 0.0, 0.0),
@@ -320,7 +321,7 @@ namespace gpstk
                             const Triple& monument,
                             const Triple& extra )
             : pEphStore(&ephStore), nominalPos(staPos),
-              pMSCStore(&mscStore), useAzimuth(false),
+              pMSCStore(&mscStore), pStaRegistry(NULL), useAzimuth(false),
               L1PhaseCenter(L1pc), L2PhaseCenter(L2pc),
               L3PhaseCenter(L3pc), L5PhaseCenter(L5pc),
               L6PhaseCenter(L6pc), L7PhaseCenter(L7pc),
@@ -596,6 +597,20 @@ namespace gpstk
         { pMSCStore = &mscStore; return (*this); };
 
 
+         /// Returns a pointer to the StationRegistry object currently in use.
+        virtual StationRegistry *getStationRegistry(void) const
+        { return pStaRegistry; };
+
+
+         /** Sets StationRegistry object to be used; when set, the stations
+          *  are looked up in it instead of in the MSCStore.
+          *
+          * @param staRegistry     StationRegistry object.
+          */
+        virtual CorrectObservables& setStationRegistry(StationRegistry& staRegistry)
+        { pStaRegistry = &staRegistry; return (*this); };
+
+
          /// Returns a pointer to the sourceMonumentMap object currently
          /// in use.
         virtual std::map<SourceID,Triple> getMonumentMap(void) const
@@ -634,10 +649,24 @@ namespace gpstk
         { tideCorr = tides; return (*this); };
 
 
+         /** Sets the AstroContext object of the tide corrections, see
+          *  ComputeTides::setAstroContext(). Call it after setTideCorr().
+          *
+          * @param astro     AstroContext object.
+          */
+        virtual CorrectObservables& setAstroContext( AstroContext& astro )
+        { tideCorr.setAstroContext(astro); return (*this); };
+
+
          /// Returns a string identifying this object.
         virtual std::string getClassName(void) const;
 
 
+         /// Returns a copy of this object, see ProcessingClass::clone().
+        virtual CorrectObservables* clone(void) const
+        { return new CorrectObservables(*this); };
+
+
          /// Destructor
         virtual ~CorrectObservables() {};
 
@@ -653,6 +682,9 @@ namespace gpstk
          /// Pointer to MSCStore object.
         MSCStore* pMSCStore;
 
+         /// Pointer to StationRegistry object
+        StationRegistry* pStaRegistry;
+
         std::map<SourceID,Triple> sourceMonument;
 
         std::map<SourceID,Antenna> sourceAntenna;
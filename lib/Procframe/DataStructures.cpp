@@ -3565,7 +3565,19 @@ in matrix and number of types do not match") );
             f.header.epochFlag = rod.epochFlag;
             f.header.epoch = rod.time;
 
-            f.body = satTypeValueMapFromRinex3ObsData(roh, rod);
+            // The conversion of the observation types is worked out once
+            // per header
+            Rinex3ObsTypeMap* pTypeMap(
+                     dynamic_cast<Rinex3ObsTypeMap*>(strm.getHeaderCache()) );
+
+            if(pTypeMap == NULL)
+            {
+                pTypeMap = new Rinex3ObsTypeMap(roh);
+                strm.setHeaderCache(pTypeMap);
+            }
+
+            f.body.clear();
+            pTypeMap->fill(rod, f.body);
 
             return i;
         }
@@ -3773,13 +3785,14 @@ in matrix and number of types do not match") );
 
 
 
-      // Convenience function to fill a satTypeValueMap with data
-      // from Rinex3ObsData.
-      // @param roh Rinex3ObsHeader holding the data
-      // @param rod Rinex3ObsData holding the data.
-    satTypeValueMap satTypeValueMapFromRinex3ObsData(
-                         const Rinex3ObsHeader& roh, const Rinex3ObsData& rod )
+      /* Works out the conversion for the given header.
+       *
+       * @param roh     Rinex3ObsHeader of the data.
+       */
+    Rinex3ObsTypeMap& Rinex3ObsTypeMap::setHeader(const Rinex3ObsHeader& roh)
     {
+        columns.clear();
+
         // Valid Rinex Tracking Codes of GPS
         const string G1_validRTCs( ObsID::validRinexTrackingCodes['G']['1'] );
         const string G2_validRTCs( ObsID::validRinexTrackingCodes['G']['2'] );
@@ -3808,7 +3821,7 @@ in matrix and number of types do not match") );
         vector<RinexObsID> useObsTypesOfGalileo;
         vector<RinexObsID> useObsTypesOfBDS;
 
-        map< string,vector<RinexObsID> > mapObsTypes(roh.mapObsTypes);
+        const map< string,vector<RinexObsID> >& mapObsTypes(roh.mapObsTypes);
         map< string,vector<RinexObsID> >::const_iterator it_mot;
 
         // Loop of systems
@@ -4088,32 +4101,26 @@ in matrix and number of types do not match") );
 
 
 
-        // We need to declare a satTypeValueMap
-        satTypeValueMap theMap;
-
-        // map< RinexSatID, std::vector<RinexDatum> >
-        Rinex3ObsData::DataMap::const_iterator it;
+        // Systems to be converted, with the observation types to be used
+        const char sysChars[3] = { 'G', 'E', 'C' };
+        const SatID::SatelliteSystem systems[3] =
+            { SatID::systemGPS, SatID::systemGalileo, SatID::systemBDS };
+        const vector<RinexObsID>* useObsTypes[3] =
+            { &useObsTypesOfGPS, &useObsTypesOfGalileo, &useObsTypesOfBDS };
 
-        for(it=rod.obs.begin(); it != rod.obs.end(); ++it)
+        for(int k=0; k<3; k++)
         {
-            RinexSatID sat(it->first);
-
-            typeValueMap tvMap;
+            // Satellites of these systems are converted even if the
+            // header has no observation types for them
+            vector<Column>& cols( columns[systems[k]] );
 
-            vector<RinexObsID> roi_obs(mapObsTypes[sat.toString().substr(0,1)]);
+            it_mot = mapObsTypes.find( string(1, sysChars[k]) );
+            if(it_mot == mapObsTypes.end()) continue;
 
-            vector<RinexObsID> roi_use;
+            const vector<RinexObsID>& roi_obs(it_mot->second);
+            const vector<RinexObsID>& roi_use(*useObsTypes[k]);
 
-            if(sat.system == SatID::systemGPS)
-                roi_use = useObsTypesOfGPS;
-            else if(sat.system == SatID::systemGalileo)
-                roi_use = useObsTypesOfGalileo;
-            else if(sat.system == SatID::systemBDS)
-                roi_use = useObsTypesOfBDS;
-            else
-                continue;
-
-//           cout << sat << ' ';
+            RinexSatID sat(1, systems[k]);
 
             for(size_t i=0; i<roi_obs.size(); i++)
             {
@@ -4121,66 +4128,128 @@ in matrix and number of types do not match") );
                     continue;
 
                 TypeID type_3c( ConvertToTypeID(roi_obs[i],sat) );
-                TypeID type_2c( asString(type_3c).substr(0,2) );
-
-//               cout << type_2c << ' ';
 
-                int n = GetCarrierBand(roi_obs[i]);
-                double data = it->second[i].data;
-
-                if(data == 0.0) continue;
+                Column col;
+                col.index = i;
+                col.type = TypeID( asString(type_3c).substr(0,2) );
+                col.factor = 1.0;
+                col.hasLLI = false;
 
                 if(roi_obs[i].type == ObsID::otL)
                 {
-                    tvMap[type_2c] = data * getWavelength(sat,n);
+                    int n = GetCarrierBand(roi_obs[i]);
 
-                    double lli = it->second[i].lli;
-                    double ssi = it->second[i].ssi;
+                    col.factor = getWavelength(sat,n);
+
+                    col.hasLLI = true;
 
                     if(n == 1)
                     {
-                        tvMap[TypeID::LLI1] = lli; tvMap[TypeID::SSI1] = ssi;
+                        col.lli = TypeID::LLI1; col.ssi = TypeID::SSI1;
                     }
                     else if(n == 2)
                     {
-                        tvMap[TypeID::LLI2] = lli; tvMap[TypeID::SSI2] = ssi;
+                        col.lli = TypeID::LLI2; col.ssi = TypeID::SSI2;
                     }
                     else if(n == 3)
                     {
-                        tvMap[TypeID::LLI3] = lli; tvMap[TypeID::SSI3] = ssi;
+                        col.lli = TypeID::LLI3; col.ssi = TypeID::SSI3;
                     }
                     else if(n == 5)
                     {
-                        tvMap[TypeID::LLI5] = lli; tvMap[TypeID::SSI5] = ssi;
+                        col.lli = TypeID::LLI5; col.ssi = TypeID::SSI5;
                     }
                     else if(n == 6)
                     {
-                        tvMap[TypeID::LLI6] = lli; tvMap[TypeID::SSI6] = ssi;
+                        col.lli = TypeID::LLI6; col.ssi = TypeID::SSI6;
                     }
                     else if(n == 7)
                     {
-                        tvMap[TypeID::LLI7] = lli; tvMap[TypeID::SSI7] = ssi;
+                        col.lli = TypeID::LLI7; col.ssi = TypeID::SSI7;
                     }
                     else if(n == 8)
                     {
-                        tvMap[TypeID::LLI8] = lli; tvMap[TypeID::SSI8] = ssi;
+                        col.lli = TypeID::LLI8; col.ssi = TypeID::SSI8;
                     }
                     else if(n == 9)
                     {
-                        tvMap[TypeID::LLI9] = lli; tvMap[TypeID::SSI9] = ssi;
+                        col.lli = TypeID::LLI9; col.ssi = TypeID::SSI9;
+                    }
+                    else
+                    {
+                        col.hasLLI = false;
                     }
                 }
-                else
+
+                cols.push_back(col);
+            }
+        }
+
+        return (*this);
+
+    }  // End of method 'Rinex3ObsTypeMap::setHeader()'
+
+
+      /* Fills a satTypeValueMap with the data of one epoch.
+       *
+       * @param rod     Rinex3ObsData holding the data.
+       * @param theMap  satTypeValueMap to receive the data.
+       */
+    satTypeValueMap& Rinex3ObsTypeMap::fill( const Rinex3ObsData& rod,
+                                             satTypeValueMap& theMap ) const
+    {
+        // map< RinexSatID, std::vector<RinexDatum> >
+        Rinex3ObsData::DataMap::const_iterator it;
+
+        for(it=rod.obs.begin(); it != rod.obs.end(); ++it)
+        {
+            std::map< SatID::SatelliteSystem,
+                      std::vector<Column> >::const_iterator itCols(
+                                          columns.find(it->first.system) );
+
+            if(itCols == columns.end()) continue;
+
+            const vector<Column>& cols(itCols->second);
+            const vector<RinexDatum>& obs(it->second);
+
+            typeValueMap& tvMap( theMap[it->first] );
+
+            for(size_t i=0; i<cols.size(); i++)
+            {
+                const Column& col(cols[i]);
+
+                if(col.index >= obs.size()) break;
+
+                double data = obs[col.index].data;
+
+                if(data == 0.0) continue;
+
+                tvMap[col.type] = data * col.factor;
+
+                if(col.hasLLI)
                 {
-                    tvMap[type_2c] = data;
+                    tvMap[col.lli] = obs[col.index].lli;
+                    tvMap[col.ssi] = obs[col.index].ssi;
                 }
             }
 
-//           cout << endl;
+        }   // End loop over all the satellite
+
+        return theMap;
 
-            theMap[sat] = tvMap;
+    }  // End of method 'Rinex3ObsTypeMap::fill()'
 
-        }   // End loop over all the satellite
+
+      // Convenience function to fill a satTypeValueMap with data
+      // from Rinex3ObsData.
+      // @param roh Rinex3ObsHeader holding the data
+      // @param rod Rinex3ObsData holding the data.
+    satTypeValueMap satTypeValueMapFromRinex3ObsData(
+                         const Rinex3ObsHeader& roh, const Rinex3ObsData& rod )
+    {
+        satTypeValueMap theMap;
+
+        Rinex3ObsTypeMap(roh).fill(rod, theMap);
 
         return theMap;
     }
@@ -1660,6 +1660,70 @@ namespace gpstk
    SourceID::SourceType SatIDsystem2SourceIDtype(const SatID& sid);
 
 
+      /** This class holds how the observations of a Rinex3ObsHeader are
+       *  converted to the TypeID's of a satTypeValueMap.
+       *
+       * The tracking code used for every band, the TypeID of every column
+       * and the factor (wavelength) applied to it only depend on the
+       * header, so they are worked out once and kept with the stream
+       * (see Rinex3ObsStream::setHeaderCache()), and each epoch is then
+       * converted without any string handling.
+       */
+   class Rinex3ObsTypeMap : public Rinex3ObsStream::HeaderCache
+   {
+   public:
+
+         /// Default constructor, nothing is converted.
+      Rinex3ObsTypeMap() {};
+
+
+         /** Common constructor.
+          *
+          * @param roh     Rinex3ObsHeader of the data.
+          */
+      explicit Rinex3ObsTypeMap(const Rinex3ObsHeader& roh)
+      { setHeader(roh); };
+
+
+         /** Works out the conversion for the given header.
+          *
+          * @param roh     Rinex3ObsHeader of the data.
+          */
+      Rinex3ObsTypeMap& setHeader(const Rinex3ObsHeader& roh);
+
+
+         /** Fills a satTypeValueMap with the data of one epoch.
+          *
+          * @param rod     Rinex3ObsData holding the data.
+          * @param theMap  satTypeValueMap to receive the data.
+          */
+      satTypeValueMap& fill( const Rinex3ObsData& rod,
+                             satTypeValueMap& theMap ) const;
+
+
+         /// Destructor.
+      virtual ~Rinex3ObsTypeMap() {};
+
+
+   private:
+
+         /// Conversion of one column of the observations
+      struct Column
+      {
+         size_t index;        ///< Index in the observations of the satellite
+         TypeID type;         ///< TypeID of the value
+         double factor;       ///< Factor applied to the value
+         bool hasLLI;         ///< Whether the LLI and SSI are stored
+         TypeID lli;          ///< TypeID of the LLI
+         TypeID ssi;          ///< TypeID of the SSI
+      };
+
+         /// Columns to be converted, per satellite system
+      std::map< SatID::SatelliteSystem, std::vector<Column> > columns;
+
+   };  // End of class 'Rinex3ObsTypeMap'
+
+
       /// Convenience function to fill a satTypeValueMap with data
       /// from Rinex3ObsData.
       /// @param roh Rinex3ObsHeader holding the data
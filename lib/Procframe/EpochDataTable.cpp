@@ -0,0 +1,437 @@
+#pragma ident "$Id: EpochDataTable.cpp $"
+
+/**
+ * @file EpochDataTable.cpp
+ * Dense (station x satellite x type) table holding the GNSS data of one
+ * epoch, an alternative to the nested maps of 'gnssDataMap'.
+ */
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+//============================================================================
+
+
+#include <algorithm>
+#include "EpochDataTable.hpp"
+
+using namespace std;
+
+namespace gpstk
+{
+
+      // Adds a SourceID, if new, and returns its index.
+    int EpochDataTable::addSource(const SourceID& source)
+    {
+        std::map<SourceID, int>::const_iterator it( m_SourceIndex.find(source) );
+        if( it != m_SourceIndex.end() ) return it->second;
+
+        reshape(m_NumSources + 1, m_NumSats, m_NumTypes);
+
+        m_SourceIndex[source] = m_NumSources - 1;
+        m_Sources.push_back(source);
+        m_SourceEpochs.push_back(m_Epoch);
+
+        return (m_NumSources - 1);
+
+    }  // End of method 'EpochDataTable::addSource()'
+
+
+      // Adds a SatID, if new, and returns its index.
+    int EpochDataTable::addSat(const SatID& sat)
+    {
+        std::map<SatID, int>::const_iterator it( m_SatIndex.find(sat) );
+        if( it != m_SatIndex.end() ) return it->second;
+
+        reshape(m_NumSources, m_NumSats + 1, m_NumTypes);
+
+        m_SatIndex[sat] = m_NumSats - 1;
+        m_Sats.push_back(sat);
+
+        return (m_NumSats - 1);
+
+    }  // End of method 'EpochDataTable::addSat()'
+
+
+      // Adds a TypeID, if new, and returns its index.
+    int EpochDataTable::addType(const TypeID& type)
+    {
+        std::map<TypeID, int>::const_iterator it( m_TypeIndex.find(type) );
+        if( it != m_TypeIndex.end() ) return it->second;
+
+        reshape(m_NumSources, m_NumSats, m_NumTypes + 1);
+
+        m_TypeIndex[type] = m_NumTypes - 1;
+        m_Types.push_back(type);
+
+        return (m_NumTypes - 1);
+
+    }  // End of method 'EpochDataTable::addType()'
+
+
+      // Returns the index of a SourceID, or -1 if it is not indexed.
+    int EpochDataTable::getSourceIndex(const SourceID& source) const
+    {
+        std::map<SourceID, int>::const_iterator it( m_SourceIndex.find(source) );
+        return (it != m_SourceIndex.end()) ? it->second : -1;
+    }
+
+
+      // Returns the index of a SatID, or -1 if it is not indexed.
+    int EpochDataTable::getSatIndex(const SatID& sat) const
+    {
+        std::map<SatID, int>::const_iterator it( m_SatIndex.find(sat) );
+        return (it != m_SatIndex.end()) ? it->second : -1;
+    }
+
+
+      // Returns the index of a TypeID, or -1 if it is not indexed.
+    int EpochDataTable::getTypeIndex(const TypeID& type) const
+    {
+        std::map<TypeID, int>::const_iterator it( m_TypeIndex.find(type) );
+        return (it != m_TypeIndex.end()) ? it->second : -1;
+    }
+
+
+      // Returns the given value.
+    double EpochDataTable::getValue(int src, int sat, int type) const
+        throw(ValueNotFound)
+    {
+        size_t k( offset(src, sat, type) );
+
+        if( !m_Valid[k] )
+        {
+            ValueNotFound e("EpochDataTable: value not found.");
+            GPSTK_THROW(e);
+        }
+
+        return m_Values[k];
+
+    }  // End of method 'EpochDataTable::getValue()'
+
+
+      // Removes all the data of the satellite for the given source.
+    void EpochDataTable::removeSat(int src, int sat)
+    {
+        size_t k( offset(src, sat, 0) );
+
+        std::fill( m_Values.begin() + k, m_Values.begin() + k + m_NumTypes, 0.0 );
+        std::fill( m_Valid.begin() + k, m_Valid.begin() + k + m_NumTypes, 0 );
+
+        m_RowValid[src*m_NumSats + sat] = 0;
+
+    }  // End of method 'EpochDataTable::removeSat()'
+
+
+      // Removes all the data of the given source.
+    void EpochDataTable::removeSource(int src)
+    {
+        for(int sat = 0; sat < m_NumSats; ++sat)
+        {
+            removeSat(src, sat);
+        }
+
+        m_SourceValid[src] = 0;
+
+    }  // End of method 'EpochDataTable::removeSource()'
+
+
+      // Removes all the data and indexes.
+    void EpochDataTable::clear()
+    {
+        m_NumSources = m_NumSats = m_NumTypes = 0;
+
+        m_SourceIndex.clear();
+        m_SatIndex.clear();
+        m_TypeIndex.clear();
+
+        m_Sources.clear();
+        m_SourceEpochs.clear();
+        m_Sats.clear();
+        m_Types.clear();
+
+        m_Values.clear();
+        m_Valid.clear();
+        m_RowValid.clear();
+        m_SourceValid.clear();
+
+    }  // End of method 'EpochDataTable::clear()'
+
+
+      // Reorganizes the arrays for new numbers of indexes.
+    void EpochDataTable::reshape(int numSources, int numSats, int numTypes)
+    {
+        size_t size( static_cast<size_t>(numSources)*numSats*numTypes );
+
+        std::vector<double> values(size, 0.0);
+        std::vector<unsigned char> valid(size, 0);
+        std::vector<unsigned char> rowValid(numSources*numSats, 0);
+
+        // Indexes are only appended, so the old ones keep their meaning
+        for(int src = 0; src < m_NumSources; ++src)
+        {
+            for(int sat = 0; sat < m_NumSats; ++sat)
+            {
+                size_t k( offset(src, sat, 0) );
+                size_t n( (static_cast<size_t>(src)*numSats + sat)*numTypes );
+
+                std::copy( m_Values.begin() + k,
+                           m_Values.begin() + k + m_NumTypes,
+                           values.begin() + n );
+                std::copy( m_Valid.begin() + k,
+                           m_Valid.begin() + k + m_NumTypes,
+                           valid.begin() + n );
+
+                rowValid[src*numSats + sat] = m_RowValid[src*m_NumSats + sat];
+            }
+        }
+
+        m_Values.swap(values);
+        m_Valid.swap(valid);
+        m_RowValid.swap(rowValid);
+        m_SourceValid.resize(numSources, 0);
+
+        m_NumSources = numSources;
+        m_NumSats = numSats;
+        m_NumTypes = numTypes;
+
+    }  // End of method 'EpochDataTable::reshape()'
+
+
+      // Adds the indexes of the data, without numbering them.
+    void EpochDataTable::addIndexes(const sourceDataMap& sdMap)
+    {
+        for( sourceDataMap::const_iterator sdmIt = sdMap.begin();
+             sdmIt != sdMap.end();
+             ++sdmIt )
+        {
+            m_SourceIndex.insert( std::make_pair(sdmIt->first, 0) );
+
+            for( satTypeValueMap::const_iterator stvmIt = sdmIt->second.begin();
+                 stvmIt != sdmIt->second.end();
+                 ++stvmIt )
+            {
+                m_SatIndex.insert( std::make_pair(stvmIt->first, 0) );
+
+                for( typeValueMap::const_iterator tvmIt = stvmIt->second.begin();
+                     tvmIt != stvmIt->second.end();
+                     ++tvmIt )
+                {
+                    m_TypeIndex.insert( std::make_pair(tvmIt->first, 0) );
+                }
+            }
+        }
+
+    }  // End of method 'EpochDataTable::addIndexes()'
+
+
+      // Numbers the indexes in their map order and allocates the arrays.
+    void EpochDataTable::numberIndexes()
+    {
+        for( std::map<SourceID, int>::iterator it = m_SourceIndex.begin();
+             it != m_SourceIndex.end();
+             ++it )
+        {
+            it->second = m_Sources.size();
+            m_Sources.push_back(it->first);
+            m_SourceEpochs.push_back(m_Epoch);
+        }
+
+        for( std::map<SatID, int>::iterator it = m_SatIndex.begin();
+             it != m_SatIndex.end();
+             ++it )
+        {
+            it->second = m_Sats.size();
+            m_Sats.push_back(it->first);
+        }
+
+        for( std::map<TypeID, int>::iterator it = m_TypeIndex.begin();
+             it != m_TypeIndex.end();
+             ++it )
+        {
+            it->second = m_Types.size();
+            m_Types.push_back(it->first);
+        }
+
+        reshape(m_Sources.size(), m_Sats.size(), m_Types.size());
+
+    }  // End of method 'EpochDataTable::numberIndexes()'
+
+
+      // Sets the values of the data, the indexes must exist.
+    void EpochDataTable::setValues( const CommonTime& epoch,
+                                    const sourceDataMap& sdMap )
+    {
+        for( sourceDataMap::const_iterator sdmIt = sdMap.begin();
+             sdmIt != sdMap.end();
+             ++sdmIt )
+        {
+            int src( m_SourceIndex[sdmIt->first] );
+
+            m_SourceValid[src] = 1;
+            m_SourceEpochs[src] = epoch;
+
+            for( satTypeValueMap::const_iterator stvmIt = sdmIt->second.begin();
+                 stvmIt != sdmIt->second.end();
+                 ++stvmIt )
+            {
+                int sat( m_SatIndex[stvmIt->first] );
+
+                m_RowValid[src*m_NumSats + sat] = 1;
+
+                for( typeValueMap::const_iterator tvmIt = stvmIt->second.begin();
+                     tvmIt != stvmIt->second.end();
+                     ++tvmIt )
+                {
+                    size_t k( offset(src, sat, m_TypeIndex[tvmIt->first]) );
+                    m_Values[k] = tvmIt->second;
+                    m_Valid[k] = 1;
+                }
+            }
+        }
+
+    }  // End of method 'EpochDataTable::setValues()'
+
+
+      // Copies the values of one source to a satTypeValueMap.
+    void EpochDataTable::getValues(int src, satTypeValueMap& stvMap) const
+    {
+        for(int sat = 0; sat < m_NumSats; ++sat)
+        {
+            if( !m_RowValid[src*m_NumSats + sat] ) continue;
+
+            // Indexes mostly follow the map order, so hint at the end
+            typeValueMap& tvMap( stvMap.insert( stvMap.end(),
+                          std::make_pair(m_Sats[sat], typeValueMap()) )->second );
+
+            size_t k( offset(src, sat, 0) );
+            for(int type = 0; type < m_NumTypes; ++type, ++k)
+            {
+                if( m_Valid[k] )
+                {
+                    tvMap.insert( tvMap.end(),
+                                  std::make_pair(m_Types[type], m_Values[k]) );
+                }
+            }
+        }
+
+    }  // End of method 'EpochDataTable::getValues()'
+
+
+      /* Replaces the content with the first epoch of a gnssDataMap, i.e.
+       * all the data within its tolerance of the first epoch.
+       *
+       * @param gData     Data object holding the data.
+       */
+    EpochDataTable& EpochDataTable::fromDataMap(const gnssDataMap& gData)
+    {
+        clear();
+
+        if( gData.empty() ) return (*this);
+
+        m_Epoch = gData.begin()->first;
+
+        gnssDataMap::const_iterator endPos(
+                        gData.upper_bound(m_Epoch + gData.getTolerance()) );
+
+        // First the indexes, so that the arrays are allocated only once
+        for( gnssDataMap::const_iterator it = gData.begin();
+             it != endPos;
+             ++it )
+        {
+            addIndexes(it->second);
+        }
+
+        numberIndexes();
+
+        for( gnssDataMap::const_iterator it = gData.begin();
+             it != endPos;
+             ++it )
+        {
+            setValues(it->first, it->second);
+        }
+
+        return (*this);
+
+    }  // End of method 'EpochDataTable::fromDataMap()'
+
+
+      /* Replaces the content with the data of one epoch.
+       *
+       * @param epoch     Epoch of the data.
+       * @param sdMap     Data of all the sources at this epoch.
+       */
+    EpochDataTable& EpochDataTable::fromSourceDataMap( const CommonTime& epoch,
+                                                       const sourceDataMap& sdMap )
+    {
+        clear();
+
+        m_Epoch = epoch;
+
+        addIndexes(sdMap);
+        numberIndexes();
+        setValues(epoch, sdMap);
+
+        return (*this);
+
+    }  // End of method 'EpochDataTable::fromSourceDataMap()'
+
+
+      /* Replaces the content of a gnssDataMap with the data of this table,
+       * one element per source.
+       *
+       * @param gData     Data object to receive the data.
+       */
+    void EpochDataTable::toDataMap(gnssDataMap& gData) const
+    {
+        gData.clear();
+
+        for(int src = 0; src < m_NumSources; ++src)
+        {
+            if( !m_SourceValid[src] ) continue;
+
+            gnssDataMap::iterator it( gData.insert(
+                    std::make_pair(m_SourceEpochs[src], sourceDataMap()) ) );
+
+            getValues( src, it->second[m_Sources[src]] );
+        }
+
+    }  // End of method 'EpochDataTable::toDataMap()'
+
+
+      /* Replaces the content of a sourceDataMap with the data of this table.
+       *
+       * @param sdMap     Data object to receive the data.
+       */
+    void EpochDataTable::toSourceDataMap(sourceDataMap& sdMap) const
+    {
+        sdMap.clear();
+
+        for(int src = 0; src < m_NumSources; ++src)
+        {
+            if( !m_SourceValid[src] ) continue;
+
+            // Indexes mostly follow the map order, so hint at the end
+            getValues( src, sdMap.insert( sdMap.end(),
+                   std::make_pair(m_Sources[src], satTypeValueMap()) )->second );
+        }
+
+    }  // End of method 'EpochDataTable::toSourceDataMap()'
+
+
+}  // End of namespace gpstk
@@ -0,0 +1,341 @@
+#pragma ident "$Id: EpochDataTable.hpp $"
+
+/**
+ * @file EpochDataTable.hpp
+ * Dense (station x satellite x type) table holding the GNSS data of one
+ * epoch, an alternative to the nested maps of 'gnssDataMap'.
+ */
+
+#ifndef GPSTK_EPOCH_DATA_TABLE_HPP
+#define GPSTK_EPOCH_DATA_TABLE_HPP
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+//============================================================================
+
+
+#include <map>
+#include <vector>
+#include "DataStructures.hpp"
+
+
+namespace gpstk
+{
+
+      /** @addtogroup DataStructures */
+      //@{
+
+      /** This class holds the GNSS data of one epoch in dense arrays,
+       *  indexed by (source, satellite, type).
+       *
+       * SourceID's, SatID's and TypeID's are mapped to small integer
+       * indexes (0, 1, 2, ... in order of insertion). All the values of one
+       * (source, satellite) pair are contiguous in memory, so that a
+       * processor resolves the indexes of its TypeID's once per epoch and
+       * then works on plain arrays, without tree look-ups or one heap node
+       * per value as in 'gnssDataMap'.
+       *
+       * As in the maps, a value may be present or not; missing values read
+       * as zero. Adding a new SourceID, SatID or TypeID to a table already
+       * holding data reorganizes the arrays, so it is better to add all the
+       * indexes first (as 'fromDataMap()' does).
+       *
+       * Adapters to and from 'gnssDataMap' allow porting the processors
+       * incrementally:
+       *
+       * @code
+       *   gnssDataMap gData;
+       *   ...
+       *
+       *   EpochDataTable table(gData);
+       *
+       *   int prefit( table.addType(TypeID::prefitC) );
+       *   int pc( table.getTypeIndex(TypeID::PC) );
+       *   int rho( table.getTypeIndex(TypeID::rho) );
+       *
+       *   for(int src = 0; src < table.numSources(); ++src)
+       *   {
+       *      for(int sat = 0; sat < table.numSats(); ++sat)
+       *      {
+       *         if( !table.hasSat(src, sat) ) continue;
+       *
+       *         double* row( table.row(src, sat) );
+       *         table.setValue(src, sat, prefit, row[pc] - row[rho]);
+       *      }
+       *   }
+       *
+       *   table.toDataMap(gData);
+       * @endcode
+       *
+       * @sa DataStructures.hpp.
+       */
+    class EpochDataTable
+    {
+    public:
+
+        /// Default constructor.
+        EpochDataTable()
+            : m_NumSources(0), m_NumSats(0), m_NumTypes(0)
+        {};
+
+
+        /** Constructor from the first epoch of a gnssDataMap.
+         *
+         * @param gData     Data object holding the data.
+         */
+        explicit EpochDataTable(const gnssDataMap& gData)
+            : m_NumSources(0), m_NumSats(0), m_NumTypes(0)
+        { fromDataMap(gData); };
+
+
+        /// Returns the epoch of the data.
+        const CommonTime& getEpoch() const
+        { return m_Epoch; };
+
+
+        /// Sets the epoch of the data.
+        EpochDataTable& setEpoch(const CommonTime& epoch)
+        { m_Epoch = epoch; return (*this); };
+
+
+        /// Returns the number of SourceID indexes.
+        int numSources() const
+        { return m_NumSources; };
+
+
+        /// Returns the number of SatID indexes.
+        int numSats() const
+        { return m_NumSats; };
+
+
+        /// Returns the number of TypeID indexes.
+        int numTypes() const
+        { return m_NumTypes; };
+
+
+        /// Adds a SourceID, if new, and returns its index.
+        int addSource(const SourceID& source);
+
+
+        /// Adds a SatID, if new, and returns its index.
+        int addSat(const SatID& sat);
+
+
+        /// Adds a TypeID, if new, and returns its index.
+        int addType(const TypeID& type);
+
+
+        /// Returns the index of a SourceID, or -1 if it is not indexed.
+        int getSourceIndex(const SourceID& source) const;
+
+
+        /// Returns the index of a SatID, or -1 if it is not indexed.
+        int getSatIndex(const SatID& sat) const;
+
+
+        /// Returns the index of a TypeID, or -1 if it is not indexed.
+        int getTypeIndex(const TypeID& type) const;
+
+
+        /// Returns the SourceID of the given index.
+        const SourceID& getSource(int src) const
+        { return m_Sources[src]; };
+
+
+        /// Returns the SatID of the given index.
+        const SatID& getSat(int sat) const
+        { return m_Sats[sat]; };
+
+
+        /// Returns the TypeID of the given index.
+        const TypeID& getType(int type) const
+        { return m_Types[type]; };
+
+
+        /// Returns whether the given source holds data.
+        bool hasSource(int src) const
+        { return m_SourceValid[src] != 0; };
+
+
+        /// Returns whether the given source holds data of the satellite.
+        bool hasSat(int src, int sat) const
+        { return m_RowValid[src*m_NumSats + sat] != 0; };
+
+
+        /// Returns whether the given value is present.
+        bool hasValue(int src, int sat, int type) const
+        { return m_Valid[offset(src, sat, type)] != 0; };
+
+
+        /** Returns the given value.
+         *
+         * @throw ValueNotFound if the value is not present.
+         */
+        double getValue(int src, int sat, int type) const
+            throw(ValueNotFound);
+
+
+        /// Sets the given value, marking it (and its satellite and source)
+        /// as present.
+        void setValue(int src, int sat, int type, double value)
+        {
+            size_t k( offset(src, sat, type) );
+            m_Values[k] = value;
+            m_Valid[k] = 1;
+            m_RowValid[src*m_NumSats + sat] = 1;
+            m_SourceValid[src] = 1;
+        };
+
+
+        /** Returns the values of one (source, satellite) pair, indexed by
+         *  the type indexes. Missing values are zero, and writing to them
+         *  does not make them present; use 'setValue()' for that.
+         */
+        double* row(int src, int sat)
+        { return &m_Values[offset(src, sat, 0)]; };
+
+
+        /// Returns the values of one (source, satellite) pair.
+        const double* row(int src, int sat) const
+        { return &m_Values[offset(src, sat, 0)]; };
+
+
+        /// Removes one value.
+        void removeValue(int src, int sat, int type)
+        {
+            size_t k( offset(src, sat, type) );
+            m_Values[k] = 0.0;
+            m_Valid[k] = 0;
+        };
+
+
+        /// Removes all the data of the satellite for the given source.
+        void removeSat(int src, int sat);
+
+
+        /// Removes all the data of the given source.
+        void removeSource(int src);
+
+
+        /// Removes all the data and indexes.
+        void clear();
+
+
+        /** Replaces the content with the first epoch of a gnssDataMap,
+         *  i.e. all the data within its tolerance of the first epoch.
+         *
+         * @param gData     Data object holding the data.
+         */
+        EpochDataTable& fromDataMap(const gnssDataMap& gData);
+
+
+        /** Replaces the content with the data of one epoch.
+         *
+         * @param epoch     Epoch of the data.
+         * @param sdMap     Data of all the sources at this epoch.
+         */
+        EpochDataTable& fromSourceDataMap( const CommonTime& epoch,
+                                           const sourceDataMap& sdMap );
+
+
+        /** Replaces the content of a gnssDataMap with the data of this
+         *  table, one element per source (as 'addGnssRinex()' does).
+         *
+         * @param gData     Data object to receive the data.
+         */
+        void toDataMap(gnssDataMap& gData) const;
+
+
+        /** Replaces the content of a sourceDataMap with the data of this
+         *  table.
+         *
+         * @param sdMap     Data object to receive the data.
+         */
+        void toSourceDataMap(sourceDataMap& sdMap) const;
+
+
+        /// Destructor.
+        virtual ~EpochDataTable() {};
+
+
+    private:
+
+        /// Position of a value in the arrays
+        size_t offset(int src, int sat, int type) const
+        { return (static_cast<size_t>(src)*m_NumSats + sat)*m_NumTypes + type; };
+
+
+        /// Reorganizes the arrays for new numbers of indexes.
+        void reshape(int numSources, int numSats, int numTypes);
+
+
+        /// Adds the indexes of the data, without numbering them.
+        void addIndexes(const sourceDataMap& sdMap);
+
+
+        /// Numbers the indexes in their map order and allocates the arrays.
+        void numberIndexes();
+
+
+        /// Sets the values of the data, the indexes must exist.
+        void setValues(const CommonTime& epoch, const sourceDataMap& sdMap);
+
+
+        /// Copies the values of one source to a satTypeValueMap.
+        void getValues(int src, satTypeValueMap& stvMap) const;
+
+
+        /// Epoch of the data
+        CommonTime m_Epoch;
+
+        /// Number of indexes
+        int m_NumSources;
+        int m_NumSats;
+        int m_NumTypes;
+
+        /// Indexes
+        std::map<SourceID, int> m_SourceIndex;
+        std::map<SatID, int> m_SatIndex;
+        std::map<TypeID, int> m_TypeIndex;
+
+        /// Index -> object
+        std::vector<SourceID> m_Sources;
+        std::vector<CommonTime> m_SourceEpochs;
+        std::vector<SatID> m_Sats;
+        std::vector<TypeID> m_Types;
+
+        /// Values, per (source, satellite, type)
+        std::vector<double> m_Values;
+
+        /// Whether each value is present
+        std::vector<unsigned char> m_Valid;
+
+        /// Whether each (source, satellite) pair is present
+        std::vector<unsigned char> m_RowValid;
+
+        /// Whether each source is present
+        std::vector<unsigned char> m_SourceValid;
+
+    }; // End of class 'EpochDataTable'
+
+      //@}
+
+}  // End of namespace gpstk
+
+#endif   // GPSTK_EPOCH_DATA_TABLE_HPP
@@ -150,6 +150,9 @@ namespace gpstk
         // Set up index for Variables now
         setUpEquationIndex( tempOldUnknowns );
 
+        // Fill the sparse geometry matrix, prefits and weights
+        prepareGeometryAndWeights();
+
         // Set this object as "prepared"
         m_IsPrepared = true;
 
@@ -283,6 +286,67 @@ namespace gpstk
 
 
 
+    /* Return the geometry matrix of the current equations, in
+     * compressed-sparse-row form.
+     *
+     *  \warning You must call method Prepare() first, otherwise this
+     *  method will throw an InvalidEquationSystemEx exception.
+     */
+    const SparseMatrix<double>& EquationSystemEx::getCurrentGeometryMatrix() const
+        throw(InvalidEquationSystemEx)
+    {
+        // If the object as not ready, throw an exception
+        if (!m_IsPrepared)
+        {
+            GPSTK_THROW(InvalidEquationSystemEx("EquationSystemEx is not prepared"));
+        }
+
+        return m_CurrentGeometry;
+
+    }  // End of method 'EquationSystemEx::getCurrentGeometryMatrix()'
+
+
+
+    /* Return the prefit residuals of the current equations.
+     *
+     *  \warning You must call method Prepare() first, otherwise this
+     *  method will throw an InvalidEquationSystemEx exception.
+     */
+    const Vector<double>& EquationSystemEx::getCurrentPrefitsVector() const
+        throw(InvalidEquationSystemEx)
+    {
+        // If the object as not ready, throw an exception
+        if (!m_IsPrepared)
+        {
+            GPSTK_THROW(InvalidEquationSystemEx("EquationSystemEx is not prepared"));
+        }
+
+        return m_CurrentPrefits;
+
+    }  // End of method 'EquationSystemEx::getCurrentPrefitsVector()'
+
+
+
+    /* Return the weights of the current equations.
+     *
+     *  \warning You must call method Prepare() first, otherwise this
+     *  method will throw an InvalidEquationSystemEx exception.
+     */
+    const Vector<double>& EquationSystemEx::getCurrentWeightsVector() const
+        throw(InvalidEquationSystemEx)
+    {
+        // If the object as not ready, throw an exception
+        if (!m_IsPrepared)
+        {
+            GPSTK_THROW(InvalidEquationSystemEx("EquationSystemEx is not prepared"));
+        }
+
+        return m_CurrentWeights;
+
+    }  // End of method 'EquationSystemEx::getCurrentWeightsVector()'
+
+
+
     /// Setup Equation Index.
     void EquationSystemEx::setUpEquationIndex( VariableSet& oldVariableSet )
     {
@@ -333,6 +397,75 @@ namespace gpstk
 
 
 
+    // Prepare geometry matrix, prefits and weights of current equations
+    void EquationSystemEx::prepareGeometryAndWeights()
+    {
+        int numEquations( m_CurrentEquationsList.size() );
+
+        m_CurrentGeometry.clear( m_CurrentUnknowns.size() );
+        m_CurrentPrefits.resize( numEquations, 0.0 );
+        m_CurrentWeights.resize( numEquations, 0.0 );
+
+        int row(0);
+
+        for( EquationList::iterator equIter = m_CurrentEquationsList.begin();
+             equIter != m_CurrentEquationsList.end();
+             ++equIter )
+        {
+            // Get the type value data from the header of the equation
+            typeValueMap& tData( equIter->header.typeValueData );
+
+            // Get the independent type of this equation
+            TypeID indepType( equIter->header.indTerm.getType() );
+
+            // Weight
+            double weight( equIter->header.constWeight );
+
+            if( indepType == TypeID::prefitC )
+            {
+                typeValueMap::const_iterator it( tData.find(TypeID::weightC) );
+                if( it != tData.end() ) weight *= it->second;
+            }
+            else if( indepType == TypeID::prefitL )
+            {
+                typeValueMap::const_iterator it( tData.find(TypeID::weightL) );
+                if( it != tData.end() ) weight *= it->second;
+            }
+
+            m_CurrentPrefits(row) = tData(indepType);
+            m_CurrentWeights(row) = weight;
+
+            // Now, let's visit all Variables and the corresponding
+            // coefficients in the equation description
+            for( VarCoeffMap::const_iterator vcmIter = equIter->body.begin();
+                 vcmIter != equIter->body.end();
+                 ++vcmIter )
+            {
+                const Variable& var( vcmIter->first );
+                const Coefficient& coef( vcmIter->second );
+
+                double tempCoef( coef.defaultCoefficient );
+
+                // If the coefficient is not forced, look for it in the data,
+                // otherwise use the default coefficient
+                if( !coef.forceDefault )
+                {
+                    typeValueMap::const_iterator it( tData.find(var.getType()) );
+                    if( it != tData.end() ) tempCoef = it->second;
+                }
+
+                m_CurrentGeometry.addElement( var.getNowIndex(), tempCoef );
+            }
+
+            m_CurrentGeometry.endRow();
+
+            row++;
+        }
+
+    }  // End of method 'EquationSystemEx::prepareGeometryAndWeights()'
+
+
+
     // Get current sources (SourceID's) and satellites (SatID's)
     void EquationSystemEx::prepareCurrentSourceSat( gnssDataMap& gdsMap )
     {
@@ -56,6 +56,7 @@
 
 #include "Equation.hpp"
 #include "StateStore.hpp"
+#include "SparseMatrix.hpp"
 
 
 namespace gpstk
@@ -283,10 +284,43 @@ namespace gpstk
 
 
         /// Get the list of current equations.
-        virtual EquationList getCurrentEquationsList() const
+        virtual const EquationList& getCurrentEquationsList() const
         { return m_CurrentEquationsList; };
 
 
+        /** Return the geometry matrix of the current equations, in
+         *  compressed-sparse-row form. Row 'i' corresponds to the i'th
+         *  equation of the current equation list, and the columns are
+         *  the 'now' indexes of the current unknowns.
+         *
+         * \warning You must call method Prepare() first, otherwise this
+         * method will throw an InvalidEquationSystemEx exception.
+         */
+        virtual const SparseMatrix<double>& getCurrentGeometryMatrix() const
+            throw(InvalidEquationSystemEx);
+
+
+        /** Return the prefit residuals (independent terms) of the
+         *  current equations.
+         *
+         * \warning You must call method Prepare() first, otherwise this
+         * method will throw an InvalidEquationSystemEx exception.
+         */
+        virtual const Vector<double>& getCurrentPrefitsVector() const
+            throw(InvalidEquationSystemEx);
+
+
+        /** Return the weights of the current equations, i.e. the constant
+         *  weight of each equation times the 'weightC'/'weightL' value of
+         *  the data, when available.
+         *
+         * \warning You must call method Prepare() first, otherwise this
+         * method will throw an InvalidEquationSystemEx exception.
+         */
+        virtual const Vector<double>& getCurrentWeightsVector() const
+            throw(InvalidEquationSystemEx);
+
+
         /// Setup Equation Index.
         void setUpEquationIndex(VariableSet& oldVariableSet);
 
@@ -325,6 +359,15 @@ namespace gpstk
         /// Set containing satellites being currently processed
         SatIDSet m_CurrentSatSet;
 
+        /// Geometry matrix of the current equations
+        SparseMatrix<double> m_CurrentGeometry;
+
+        /// Prefit residuals of the current equations
+        Vector<double> m_CurrentPrefits;
+
+        /// Weights of the current equations
+        Vector<double> m_CurrentWeights;
+
         /// Pointer to object of StateStore
         StateStore* m_pStateStore;
 
@@ -337,6 +380,9 @@ namespace gpstk
         /// Prepare set of current unknowns and list of current equations
         void prepareUnknownsAndEquations( gnssDataMap& gdsMap );
 
+        /// Prepare geometry matrix, prefits and weights of current equations
+        void prepareGeometryAndWeights();
+
     }; // End of class 'EquationSystemEx'
 
     //@}
@@ -194,25 +194,37 @@ namespace gpstk
                 SourceID source( sdmIt->first );
                 string station( source.sourceName );
 
-                if(pMSCStore == NULL)
+                if(pStaRegistry != NULL)
                 {
-                    sourceRejectedSet.insert( source );
-                    continue;
-                }
-
-                MSCData mscData;
-                try
-                {
-                    mscData = pMSCStore->findMSC(station,epoch);
+                    const StationRegistry::StationInfo* pStaInfo(
+                                                pStaRegistry->find( source ) );
+                    if(pStaInfo == NULL)
+                    {
+                        sourceRejectedSet.insert( source );
+                        continue;
+                    }
+
+                    nominalPos = pStaInfo->nominalPos;
                 }
-                catch(...)
+                else
                 {
-                    sourceRejectedSet.insert( source );
-                    continue;
+                    if(pMSCStore == NULL)
+                    {
+                        sourceRejectedSet.insert( source );
+                        continue;
+                    }
+
+                    try
+                    {
+                        nominalPos = pMSCStore->findMSC(station,epoch).coordinates;
+                    }
+                    catch(...)
+                    {
+                        sourceRejectedSet.insert( source );
+                        continue;
+                    }
                 }
 
-                nominalPos = mscData.coordinates;
-
                 Process( gdmIt->first, sdmIt->second );
             }
         }
@@ -36,6 +36,7 @@
 #include "ProcessingClass.hpp"
 #include "Position.hpp"
 #include "MSCStore.hpp"
+#include "StationRegistry.hpp"
 
 
 namespace gpstk
@@ -108,7 +109,7 @@ namespace gpstk
 
          /// Default constructor.
         GravitationalDelay()
-            : nominalPos(0.0, 0.0, 0.0), pMSCStore(NULL)
+            : nominalPos(0.0, 0.0, 0.0), pMSCStore(NULL), pStaRegistry(NULL)
         {};
 
 
@@ -117,7 +118,7 @@ namespace gpstk
           * @param stapos    Nominal position of receiver station.
           */
         GravitationalDelay(const Position& staPos)
-            : nominalPos(staPos), pMSCStore(NULL)
+            : nominalPos(staPos), pMSCStore(NULL), pStaRegistry(NULL)
         {};
 
 
@@ -185,10 +186,29 @@ namespace gpstk
         { pMSCStore = &mscStore; return (*this); };
 
 
+         /// Returns a pointer to the StationRegistry object currently in use.
+        virtual StationRegistry *getStationRegistry(void) const
+        { return pStaRegistry; };
+
+
+         /** Sets StationRegistry object to be used; when set, the stations
+          *  are looked up in it instead of in the MSCStore.
+          *
+          * @param staRegistry     StationRegistry object.
+          */
+        virtual GravitationalDelay& setStationRegistry(StationRegistry& staRegistry)
+        { pStaRegistry = &staRegistry; return (*this); };
+
+
          /// Returns a string identifying this object.
         virtual std::string getClassName(void) const;
 
 
+         /// Returns a copy of this object, see ProcessingClass::clone().
+        virtual GravitationalDelay* clone(void) const
+        { return new GravitationalDelay(*this); };
+
+
          /// Destructor
         virtual ~GravitationalDelay() {};
 
@@ -201,6 +221,9 @@ namespace gpstk
         /// Pointer to MSCStore object
         MSCStore* pMSCStore;
 
+        /// Pointer to StationRegistry object
+        StationRegistry* pStaRegistry;
+
     }; // End of class 'GravitationalDelay'
 
       //@}
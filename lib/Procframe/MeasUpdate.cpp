@@ -42,6 +42,8 @@
 
 #include "MeasUpdate.hpp"
 #include "Counter.hpp"
+#include <algorithm>
+#include <cmath>
 
 #ifdef USE_OPENMP
 #include <omp.h>
@@ -145,6 +147,14 @@ namespace gpstk
 
         int times(0);
 
+        // Whether 'xhat' and 'P' hold the buffers of the state store
+        bool stateTaken(false);
+
+        // State and covariance before the update, given back to the
+        // state store if the update fails after taking its buffers
+        Vector<double> xhat0;
+        Matrix<double> P0;
+
         try
         {
 
@@ -167,12 +177,14 @@ namespace gpstk
                 VariableSet currentUnknowns( equSystem.getCurrentUnknowns() );
 
                 // Get the list with equations to be processed
-                EquationList equList( equSystem.getCurrentEquationsList() );
+                const EquationList& equList( equSystem.getCurrentEquationsList() );
 
-                int numEquations( equList.size() );
+                // Sparse geometry matrix, prefits and weights
+                const SparseMatrix<double>& H( equSystem.getCurrentGeometryMatrix() );
+                const Vector<double>& prefitResiduals( equSystem.getCurrentPrefitsVector() );
+                const Vector<double>& weights( equSystem.getCurrentWeightsVector() );
 
-                Vector<double> prefitResiduals( numEquations, 0.0 );
-                Matrix<double> hMatrix( numEquations, numUnknowns, 0.0 );
+                int numEquations( equList.size() );
 
 //                cout << "numEquations = " << numEquations << ' '
 //                     << "numUnknowns = " << numUnknowns << endl;
@@ -183,259 +195,134 @@ namespace gpstk
 
                 times++;
 
-                xhat = m_pStateStore->getStateVector( currentUnknowns );
-                P = m_pStateStore->getCovarMatrix( currentUnknowns );
-
-//                cout << setprecision(3);
-//
-//                int iii(0);
-//                for(VariableSet::iterator it = currentUnknowns.begin();
-//                    it != currentUnknowns.end();
-//                    ++it)
-//                {
-//                    cout << StringUtils::asString(*it)
-//                         << setw(10) << xhat(iii)
-//                         << setw(20) << P(iii,iii)
-//                         << endl;
-//
-//                    iii++;
-//                }
-
-
-                // Visit each Equation in "equList"
-                int row(0);
-
-                for( EquationList::const_iterator itEqu = equList.begin();
-                     itEqu != equList.end();
-                     ++itEqu )
+                // If the unknowns keep their place since the last update,
+                // take the stored state over without copying it,
+                // otherwise extract it for the current unknowns.
+                if( m_pStateStore->hasSameLayout( currentUnknowns ) )
                 {
-                    // Get the type value data from the header of the equation
-                    typeValueMap tData( (*itEqu).header.typeValueData );
-
-                    // Get the independent type of this equation
-                    TypeID indepType( (*itEqu).header.indTerm.getType() );
+                    m_pStateStore->swapStateVector( xhat );
+                    m_pStateStore->swapCovarMatrix( P );
+                    stateTaken = true;
 
-                    // Now, Let's get current prefit
-                    double tempPrefit( tData(indepType) );
-
-                    // Weight
-                    double weight( (*itEqu).header.constWeight );
-
-                    // number of Variables in current Equation
-                    int numVar( (*itEqu).body.size() );
+                    xhat0 = xhat;
+                    P0 = P;
+                }
+                else
+                {
+                    xhat = m_pStateStore->getStateVector( currentUnknowns );
+                    P = m_pStateStore->getCovarMatrix( currentUnknowns );
+                }
 
-                    // holding current Equation Variable indexes in Unknowns
-                    Vector<int> index(numVar);
 
-                    // holding current Equation Variable coefficients
-                    Vector<double> G(numVar);
+                if( m_BatchUpdate )
+                {
+                    // Process consecutive equations of the same source
+                    // together, limited to 'm_MaxBlockSize' equations
+                    EquationList::const_iterator itEqu( equList.begin() );
 
-                    // resize the Matrix and Vector, just reset all element to zero
-                    M.resize( M.size(), 0.0 );
-                    K.resize( K.size(), 0.0 );
+                    int firstRow(0);
+                    while( firstRow < numEquations )
+                    {
+                        const SourceID& source( itEqu->header.equationSource );
 
+                        int lastRow( firstRow + 1 );
+                        ++itEqu;
 
-                    // First, fill weight matrix
-                    if( indepType == TypeID::prefitC )
-                    {
-                        if( tData.find(TypeID::weightC) != tData.end() )
+                        while( lastRow < numEquations &&
+                               lastRow - firstRow < m_MaxBlockSize &&
+                               itEqu->header.equationSource == source )
                         {
-                            weight = weight * tData(TypeID::weightC);
+                            lastRow++;
+                            ++itEqu;
                         }
-                    }
-                    else if( indepType == TypeID::prefitL )
-                    {
-                        if( tData.find(TypeID::weightL) != tData.end() )
-                        {
-                            weight = weight * tData(TypeID::weightL);
-                        }
-                    }
-
 
-                    // Second, fill geometry matrix: Look for equation coefficients
-                    // Now, let's visit all Variables and the corresponding
-                    // coefficients in the equation description
-                    int i(0);
+                        blockUpdate( H, prefitResiduals, weights,
+                                     firstRow, lastRow );
 
-//                    cout << indepType << ": " << setw(15) << tempPrefit << "  "
-//                         << "number" << ": " << setw(5) << numVar << "  "
-//                         << "weight" << ": "<< setw(10) << weight << endl;
+                        firstRow = lastRow;
+                    }
 
-                    for( VarCoeffMap::const_iterator vcmIter = (*itEqu).body.begin();
-                         vcmIter != (*itEqu).body.end();
-                         ++vcmIter )
+                }
+                else
+                {
+                    for( int row = 0; row < numEquations; row++ )
                     {
-                        // We will work with a copy of current Variable
-                        Variable var( (*vcmIter).first );
+                        // first and last+1 position of the row coefficients
+                        const size_t kBegin( H.rowBegin(row) );
+                        const size_t kEnd( H.rowEnd(row) );
 
-                        // Coefficient Struct
-                        Coefficient coef( (*vcmIter).second);
+                        // resize the Matrix and Vector, just reset all element to zero
+                        M.resize( M.size(), 0.0 );
+                        K.resize( K.size(), 0.0 );
 
-                        // Coefficient values
-                        double tempCoef(0.0);
+                        // Temp measurement
+                        double z( prefitResiduals(row) );
 
-                        // Check if '(*itCol)' unknown variable enforces a specific
-                        // coefficient, according the coefficient information from
-                        // the equation
-                        if( coef.forceDefault )
-                        {
-                            // Use default coefficient
-                            tempCoef = coef.defaultCoefficient;
-                        }
-                        else
-                        {
-                            // Look the coefficient in 'tdata'
+                        // Inverse weight
+                        double inv_W(1.0/weights(row));
 
-                            // Get type of current varUnknown
-                            TypeID type( var.getType() );
 
-                            // Check if this type has an entry in current GDS type set
-                            if( tData.find(type) != tData.end() )
-                            {
-                                // If type was found, insert value into hMatrix
-                                tempCoef = tData(type);
-                            }
-                            else
+                        // M = P * transpose(G)
+                        for(int i=0; i<numUnknowns; i++)
+                        {
+                            for(size_t k=kBegin; k<kEnd; k++)
                             {
-                                // If value for current type is not in gdsMap, then
-                                // insert default coefficient for this variable
-                                tempCoef = coef.defaultCoefficient;
+                                M(i) = M(i) + P(i,H.colIndex(k)) * H.value(k);
                             }
+                        }
 
-                        }  // End of 'if( coef.forceDefault )'
-
-//                        cout << StringUtils::asString(var)
-//                             << setw(10) << tempCoef << endl;
-
-                        hMatrix( row, var.getNowIndex() ) = tempCoef;
-                        index(i) = var.getNowIndex();
-                        G(i) = tempCoef;
-
-                        i++;
-
-                    }  // End of 'for( VarCoeffMap::const_iterator vcmIter = ...'
-
-
-                    // Now, Let's create the indexes for current float unknowns
-
-                    // Temp measurement
-                    double z(tempPrefit);
-
-//                    cout << "Z:" << setw(20) << z << endl;
-//                    cout << "G:";
-//                    for(int i=0; i<numVar; ++i)
-//                    {
-//                        cout << setw(10) << G(i);
-//                    }
-//                    cout << endl;
-
-
-                    // Inverse weight
-                    double inv_W(1.0/weight);
-
-
-                    // M = P * transpose(G)
-                    for(int i=0; i<numUnknowns; i++)
-                    {
-                        for(int j=0; j<numVar; j++)
+                        // dotGM = G * P * transpose(G)
+                        double dotGM(0.0);
+                        for(size_t k=kBegin; k<kEnd; k++)
                         {
-                            M(i) = M(i) + P(i,index(j)) * G(j);
+                            dotGM = dotGM + H.value(k)*M(H.colIndex(k));
                         }
-                    }
 
-                    // dotGM = G * P * transpose(G)
-                    double dotGM(0.0);
-                    for(int i=0; i<numVar; i++)
-                    {
-                        dotGM = dotGM + G(i)*M(index(i));
-                    }
-
-//                    cout << "dotGM:" << setw(20) << dotGM << endl;
+                        // Compute the Kalman gain
+                        double beta(inv_W + dotGM);
 
-                    // Compute the Kalman gain
-                    double beta(inv_W + dotGM);
+                        K = M/beta;
 
-                    K = M/beta;
+                        double dotGX( H.rowDot(row, xhat) );
 
-//                    cout << "beta:" << setw(20) << beta << endl;
+                        // State update
+                        xhat = xhat + K*( z - dotGX );
 
-//                    cout << "K:" << endl;
-//                    for(int i=0; i<numUnknowns; ++i)
-//                    {
-//                        if(K(i) != 0)
-//                        cout << setw(10) << K(i) << endl;
-//                    }
 
-                    double dotGX(0.0);
-                    for(int i=0; i<numVar; i++)
-                    {
-                        dotGX = dotGX + G(i)*xhat(index(i));
-                    }
-
-//                    cout << "dotGX:" << setw(20) << dotGX << endl;
-
-                    // State update
-                    xhat = xhat + K*( z - dotGX );
-
-//                    cout << "xhat:" << endl;
-//                    for(int i=0; i<numUnknowns; ++i)
-//                    {
-//                        if(xhat(i) != 0)
-//                        cout << setw(10) << xhat(i) << endl;
-//                    }
-
-
-                    // Covariance update
-                    // old version:
-                    // P = P - outer(K,M);
-                    // Considering that the P and KM matrix are symmetric,
-                    // thus the computation can be accelerated by operating
-                    // the upper triangular matrix.
+                        // Covariance update
+                        // old version:
+                        // P = P - outer(K,M);
+                        // Considering that the P and KM matrix are symmetric,
+                        // thus the computation can be accelerated by operating
+                        // the upper triangular matrix.
 #ifdef _OPENMP
    #pragma omp parallel for
 #endif
-                    for(int i=0;i<numUnknowns;i++)
-                    {
-                        // The diagonal element
-                        P(i,i) = P(i,i) -  K(i)*M(i);
-
-                        // The upper/lower triangular element
-                        for(int j=(i+1);j<numUnknowns;j++)
+                        for(int i=0;i<numUnknowns;i++)
                         {
-                            P(j,i) = P(i,j) = P(i,j) - K(i)*M(j);
-                        }
+                            // The diagonal element
+                            P(i,i) = P(i,i) -  K(i)*M(i);
 
-                    }  // End of 'for(int i = 0; ...)'
+                            // The upper/lower triangular element
+                            for(int j=(i+1);j<numUnknowns;j++)
+                            {
+                                P(j,i) = P(i,j) = P(i,j) - K(i)*M(j);
+                            }
 
-                    // insert current 'prefit' into 'prefitResiduals'
-                    prefitResiduals(row) = tempPrefit;
+                        }  // End of 'for(int i = 0; ...)'
 
-                    // Increment row number
-                    row++;
+                    }  // End of 'for( int row = 0; ...'
 
-                }  // End of 'for( EquationList::const_iterator itEqu = ...'
+                }  // End of 'if( m_BatchUpdate )'
 
                 // Compute the postfit residuals Vector
-                postfitResiduals = prefitResiduals - (hMatrix* xhat);
+                postfitResiduals = prefitResiduals - (H * xhat);
 
 //                for(int i=0; i<numEquations; ++i)
 //                {
 //                    cout << setw(10) << postfitResiduals(i) << endl;
 //                }
 
-//                cout << "hMatrix:" << endl;
-//                for(int i=0; i<numEquations; ++i)
-//                {
-//                    for(int j=0; j<numUnknowns; ++j)
-//                    {
-//                        if(hMatrix(i,j) != 0)
-//                            cout << setw(5) << i
-//                                 << setw(5) << j
-//                                 << setw(10) << hMatrix(i,j);
-//                    }
-//                    cout << endl;
-//                }
-//
 //                cout << "xhat:" << endl;
 //                for(int i=0; i<numUnknowns; ++i)
 //                {
@@ -453,19 +340,38 @@ namespace gpstk
             //
             //////////// //////////// //////////// ////////////
 
-            m_pStateStore->setStateVector( xhat );
-            m_pStateStore->setCovarMatrix( P );
+            m_pStateStore->swapStateVector( xhat );
+            m_pStateStore->swapCovarMatrix( P );
+            stateTaken = false;
             m_pStateStore->setVariableSet( equSystem.getCurrentUnknowns() );
 
         }
         catch(Exception& u)
         {
+            // Give the state before the update back, so that the store
+            // is left as when the state is copied out of it
+            if( stateTaken )
+            {
+                m_pStateStore->swapStateVector( xhat0 );
+                m_pStateStore->swapCovarMatrix( P0 );
+            }
+
             // Throw an exception if something unexpected happens
             ProcessingException e( getClassName() + ":" + u.what() );
             std::cout << "exception: " << e.what() << std::endl;
 
             GPSTK_THROW(e);
         }
+        catch(...)
+        {
+            if( stateTaken )
+            {
+                m_pStateStore->swapStateVector( xhat0 );
+                m_pStateStore->swapCovarMatrix( P0 );
+            }
+
+            throw;
+        }
 
         double clk2( Counter::now() );
 
@@ -476,41 +382,215 @@ namespace gpstk
     }  // End of method 'MeasUpdate::Process()'
 
 
-    /// Postfit filter.
-    bool MeasUpdate::postfitFilter(gnssDataMap& gdsMap)
+    /* Measurement update of equations [firstRow, lastRow) as one block.
+     *
+     * With H the block rows of the geometry matrix and R the diagonal
+     * matrix of inverse weights, the update is computed as:
+     *
+     *    S = H*P*transpose(H) + R = L*transpose(L)
+     *    U = P*transpose(H)*inverse(transpose(L))
+     *    x = x + U*inverse(L)*(z - H*x)
+     *    P = P - U*transpose(U)
+     *
+     * which equals the result of processing the rows one by one.
+     */
+    void MeasUpdate::blockUpdate( const SparseMatrix<double>& H,
+                                  const Vector<double>& prefit,
+                                  const Vector<double>& weight,
+                                  int firstRow,
+                                  int lastRow )
+        throw(InvalidSolver)
     {
-        // get equation list
-        EquationList equList = equSystem.getCurrentEquationsList();
+        const int n( xhat.size() );
+        const int m( lastRow - firstRow );
 
-        double sigma = 0.0;
-        bool isValid = true;
+        if( n == 0 || m <= 0 ) return;
 
-        int i = 0;
-        for( EquationList::iterator itEqu = equList.begin();
-             itEqu != equList.end();
-             ++itEqu )
+        // U = P * transpose(H), n x m stored column by column. Only the
+        // columns of P related to the non-zeros of H are visited.
+        std::vector<double> U( n*m, 0.0 );
+
+        for(int k=0; k<m; k++)
         {
-            TypeID residualType( (*itEqu).header.indTerm.getType() );
-            typeValueMap tvm( (*itEqu).header.typeValueData );
+            int row( firstRow + k );
+            double* uk( &U[0] + k*n );
 
-            double weight( (*itEqu).header.constWeight );
+            for(size_t p=H.rowBegin(row); p<H.rowEnd(row); p++)
+            {
+                const double g( H.value(p) );
+                const double* pc( &P(0,H.colIndex(p)) );
+
+                for(int i=0; i<n; i++)
+                {
+                    uk[i] += pc[i] * g;
+                }
+            }
+        }
+
+        // S = H * P * transpose(H) + R (lower part), and the
+        // innovations v = z - H * x
+        std::vector<double> S( m*m, 0.0 );
+        std::vector<double> v( m, 0.0 );
+
+        for(int k=0; k<m; k++)
+        {
+            int row( firstRow + k );
 
-            if( residualType == TypeID::prefitC )
+            v[k] = prefit(row) - H.rowDot(row, xhat);
+
+            for(int l=0; l<=k; l++)
             {
-                weight = weight * tvm(TypeID::weightC);
+                const double* ul( &U[0] + l*n );
+
+                double s(0.0);
+                for(size_t p=H.rowBegin(row); p<H.rowEnd(row); p++)
+                {
+                    s += H.value(p) * ul[H.colIndex(p)];
+                }
+
+                S[k + l*m] = s;
             }
-            else if( residualType == TypeID::prefitL )
+
+            S[k + k*m] += 1.0/weight(row);
+        }
+
+        // Cholesky decomposition S = L * transpose(L), in place
+        for(int j=0; j<m; j++)
+        {
+            double d( S[j + j*m] );
+            for(int l=0; l<j; l++)
             {
-                weight = weight * tvm(TypeID::weightL);
+                d -= S[j + l*m] * S[j + l*m];
             }
 
-            sigma += std::pow( postfitResiduals(i), 2 ) * weight;
+            if( d <= 0.0 )
+            {
+                InvalidSolver e("Innovation covariance is not positive definite");
+                GPSTK_THROW(e);
+            }
 
-            i++;
+            d = std::sqrt(d);
+            S[j + j*m] = d;
+
+            for(int i=j+1; i<m; i++)
+            {
+                double s( S[i + j*m] );
+                for(int l=0; l<j; l++)
+                {
+                    s -= S[i + l*m] * S[j + l*m];
+                }
+                S[i + j*m] = s/d;
+            }
+        }
+
+        // U = U * inverse(transpose(L)), and v = inverse(L) * v
+        for(int k=0; k<m; k++)
+        {
+            double* uk( &U[0] + k*n );
+
+            for(int l=0; l<k; l++)
+            {
+                const double lkl( S[k + l*m] );
+                const double* ul( &U[0] + l*n );
+
+                for(int i=0; i<n; i++)
+                {
+                    uk[i] -= lkl * ul[i];
+                }
+
+                v[k] -= lkl * v[l];
+            }
+
+            const double inv_L( 1.0/S[k + k*m] );
+
+            for(int i=0; i<n; i++)
+            {
+                uk[i] *= inv_L;
+            }
+
+            v[k] *= inv_L;
+        }
+
+        // State update
+        for(int k=0; k<m; k++)
+        {
+            const double* uk( &U[0] + k*n );
+
+            for(int i=0; i<n; i++)
+            {
+                xhat(i) += uk[i] * v[k];
+            }
         }
 
+        // Covariance update, P = P - U * transpose(U). Only the upper
+        // triangular part is computed, tile by tile, to keep the working
+        // set of P and U in cache; the lower part is mirrored afterwards.
+        const int tile(64);
+
+#ifdef _OPENMP
+   #pragma omp parallel for schedule(dynamic)
+#endif
+        for(int jb=0; jb<n; jb+=tile)
+        {
+            const int je( std::min(jb+tile, n) );
+
+            for(int ib=0; ib<je; ib+=tile)
+            {
+                for(int k=0; k<m; k++)
+                {
+                    const double* uk( &U[0] + k*n );
+
+                    for(int j=jb; j<je; j++)
+                    {
+                        const double ujk( uk[j] );
+                        if( ujk == 0.0 ) continue;
+
+                        double* pj( &P(0,j) );
+                        const int ie( std::min(ib+tile, j+1) );
+
+                        for(int i=ib; i<ie; i++)
+                        {
+                            pj[i] -= uk[i] * ujk;
+                        }
+                    }
+                }
+            }
+        }
+
+#ifdef _OPENMP
+   #pragma omp parallel for
+#endif
+        for(int j=0; j<n; j++)
+        {
+            for(int i=j+1; i<n; i++)
+            {
+                P(i,j) = P(j,i);
+            }
+        }
+
+    }  // End of method 'MeasUpdate::blockUpdate()'
+
+
+    /// Postfit filter.
+    bool MeasUpdate::postfitFilter(gnssDataMap& gdsMap)
+    {
+        // get equation list
+        const EquationList& equList( equSystem.getCurrentEquationsList() );
+
+        // get equation weights
+        const Vector<double>& weights( equSystem.getCurrentWeightsVector() );
+
+        double sigma = 0.0;
+        bool isValid = true;
+
         int n =  equList.size();
         int t =  equSystem.getCurrentNumVariables();
+
+        for( int i = 0; i < n; i++ )
+        {
+            sigma += std::pow( postfitResiduals(i), 2 ) * weights(i);
+        }
+
         sigma = std::sqrt( sigma/(n-t) );
 
 //        cout << "sigma: " << sigma << endl;
@@ -518,8 +598,8 @@ namespace gpstk
         SourceID sourceRemoved;
         SatID satRemoved;
 
-        i = 0;
-        for( EquationList::iterator itEqu = equList.begin();
+        int i = 0;
+        for( EquationList::const_iterator itEqu = equList.begin();
              itEqu != equList.end();
              ++itEqu )
         {
@@ -527,17 +607,7 @@ namespace gpstk
             SatID sat( (*itEqu).header.equationSat );
             TypeID residualType( (*itEqu).header.indTerm.getType() );
 
-            double weight( (*itEqu).header.constWeight );
-            typeValueMap& tvm( (*itEqu).header.typeValueData );
-
-            if( residualType == TypeID::prefitC )
-            {
-                weight = weight * tvm(TypeID::weightC);
-            }
-            else if( residualType == TypeID::prefitL )
-            {
-                weight = weight * tvm(TypeID::weightL);
-            }
+            double weight( weights(i) );
 
             double v( std::sqrt(weight) * std::fabs(postfitResiduals(i)) );
 
@@ -37,6 +37,7 @@
 //                  'getCurrentSources()' and 'getCurrentSats()'.
 //                  shjzhang.
 //  2015/07/16      A new solver for fast time and measurement update
+//  2026/10/15      Add the batched (block-sequential) measurement update.
 //============================================================================
 
 
@@ -170,7 +171,9 @@ namespace gpstk
     public:
 
         /// Default constructor.
-        MeasUpdate() {};
+        MeasUpdate()
+            : m_BatchUpdate(false), m_MaxBlockSize(64)
+        {};
 
         /** Explicit constructor.
          *
@@ -178,6 +181,7 @@ namespace gpstk
          *                            be solved.
          */
         MeasUpdate( const EquationSystemEx& equationSys )
+            : m_BatchUpdate(false), m_MaxBlockSize(64)
         { equSystem = equationSys; };
 
 
@@ -245,6 +249,9 @@ namespace gpstk
          *  the previously defined equation system.
          *
          * @param gdsMap    Data object holding the data.
+         *
+         * @throw ProcessingException if the update fails. The state store
+         *  then keeps the state and covariance it had before the call.
          */
         virtual gnssDataMap& Process( gnssDataMap& gdsMap )
             throw(ProcessingException);
@@ -259,6 +266,34 @@ namespace gpstk
         }
 
 
+        /** Set the batched measurement update mode.
+         *
+         * When enabled, the equations of one epoch are not processed one
+         * by one, but in blocks of consecutive equations belonging to the
+         * same SourceID (at most 'maxBlockSize' equations each). Every
+         * block is applied as one matrix update, so the covariance matrix
+         * is visited once per block instead of once per observation.
+         *
+         * The result is mathematically identical to the sequential
+         * update, differences are only due to round-off.
+         *
+         * @param batch         whether or not to use the batched update.
+         * @param maxBlockSize  maximum number of equations in one block.
+         */
+        virtual MeasUpdate& setBatchUpdate( bool batch,
+                                            int maxBlockSize = 64 )
+        {
+            m_BatchUpdate = batch;
+            m_MaxBlockSize = (maxBlockSize > 0) ? maxBlockSize : 1;
+            return (*this);
+        };
+
+
+        /// Get whether the batched measurement update is used.
+        virtual bool getBatchUpdate() const
+        { return m_BatchUpdate; };
+
+
         /// Postfit filter.
         virtual bool postfitFilter(gnssDataMap& gdsMap);
 
@@ -285,6 +320,28 @@ namespace gpstk
         /// State Store
         StateStore*  m_pStateStore;
 
+        /// Whether or not the batched measurement update is used
+        bool m_BatchUpdate;
+
+        /// Maximum number of equations processed in one block
+        int m_MaxBlockSize;
+
+
+        /** Measurement update of equations [firstRow, lastRow) as one block.
+         *
+         * @param H         sparse geometry matrix of all equations.
+         * @param prefit    prefit residuals of all equations.
+         * @param weight    weights of all equations.
+         * @param firstRow  first equation of the block.
+         * @param lastRow   one past the last equation of the block.
+         */
+        virtual void blockUpdate( const SparseMatrix<double>& H,
+                                  const Vector<double>& prefit,
+                                  const Vector<double>& weight,
+                                  int firstRow,
+                                  int lastRow )
+            throw(InvalidSolver);
+
     }; // End of class 'MeasUpdate'
 
     //@}
@@ -41,8 +41,18 @@
  */
 
 #include "NetworkObsStreams.hpp"
+#include <vector>
+#include <sstream>
+#include <sys/stat.h>
+#include <cstdlib>
+#include <climits>
+#include <iomanip>
 #include "Rinex3ObsHeader.hpp"
 
+#ifdef USE_OPENMP
+#include <omp.h>
+#endif
+
 using namespace std;
 
 namespace gpstk
@@ -54,19 +64,54 @@ namespace gpstk
          // object to hold the data
       ObsData oData;
       oData.obsFile = obsFile;
+      oData.pObsStream = (Rinex3ObsStream*)0;
+      oData.pSynchro = (Synchronize*)0;
+      oData.pArchive = (ObsEpochArchive*)0;
 
       try
       {
+            // The archive of the file is valid while its size and time
+            // don't change
+         std::string stamp;
+         if( !epochCache.empty() )
+         {
+            struct stat fileStat;
+            if( stat(obsFile.c_str(), &fileStat) != 0 ) return false;
+
+            std::ostringstream ss;
+            ss << static_cast<long long>(fileStat.st_size) << " "
+               << static_cast<long long>(fileStat.st_mtime);
+            stamp = ss.str();
+
+            oData.pArchive = new ObsEpochArchive();
+
+            std::string archiveName( archiveFileName(obsFile, stamp) );
+            if( oData.pArchive->open(archiveName, stamp) &&
+                oData.pArchive->getNumEpochs() > 0 )
+            {
+                  // Replay the archive, the RINEX file isn't opened
+               oData.pSynchro = new Synchronize();
+
+               oData.obsSource.type = oData.pArchive->getSource().type;
+               oData.obsSource.sourceName =
+                                    oData.pArchive->getSource().sourceName;
+
+               allStreamData.push_back(oData);
+
+               mapSourceStream[oData.obsSource] = oData.pObsStream;
+               mapSourceSynchro[oData.obsSource] = oData.pSynchro;
+               mapSourceArchive[oData.obsSource] = oData.pArchive;
+
+               referenceSource = oData.obsSource;
+
+               return true;
+            }
+         }
+
             // allocate memory
          oData.pObsStream = new Rinex3ObsStream();
          oData.pSynchro = new Synchronize();
-         if(!oData.pObsStream || !oData.pSynchro)
-         {
-            if(oData.pObsStream) delete oData.pObsStream;
-            if(oData.pSynchro) delete oData.pSynchro;
 
-            return false;
-         }
             // Open the file
          oData.pObsStream->exceptions(std::ios::failbit);
          oData.pObsStream->open(oData.obsFile, std::ios::in);
@@ -76,16 +121,36 @@ namespace gpstk
          (*oData.pObsStream) >> obsHeader;
 
 
+            // Work out the conversion of the observation types now, the
+            // streams may be read later by several threads
+         oData.pObsStream->setHeaderCache( new Rinex3ObsTypeMap(obsHeader) );
+
          oData.obsSource.type = SatIDsystem2SourceIDtype(obsHeader.fileSysSat);
          oData.obsSource.sourceName = obsHeader.markerName;
 
          oData.pSynchro->setReferenceSource(*oData.pObsStream);
 
+            // Record the epochs as they are read. Not being able to
+            // write the archive only disables the cache of this file
+         if(oData.pArchive)
+         {
+            try
+            {
+               oData.pArchive->create(archiveFileName(obsFile, stamp), stamp);
+            }
+            catch(...)
+            {
+               delete oData.pArchive;
+               oData.pArchive = (ObsEpochArchive*)0;
+            }
+         }
+
             // Now, we should store the data for the receiver
          allStreamData.push_back(oData);
 
          mapSourceStream[oData.obsSource] = oData.pObsStream;
          mapSourceSynchro[oData.obsSource] = oData.pSynchro;
+         mapSourceArchive[oData.obsSource] = oData.pArchive;
 
          referenceSource = oData.obsSource;
 
@@ -100,6 +165,12 @@ namespace gpstk
          delete oData.pObsStream;
          oData.pObsStream = (Rinex3ObsStream*)0;
 
+         delete oData.pSynchro;
+         oData.pSynchro = (Synchronize*)0;
+
+         delete oData.pArchive;
+         oData.pArchive = (ObsEpochArchive*)0;
+
          return false;
       }
 
@@ -111,6 +182,12 @@ namespace gpstk
    bool NetworkObsStreams::readEpochData(gnssDataMap& gdsMap)
       throw(SynchronizeException)
    {
+         // Archives are only read through the buffers
+      if( prefetchEpochs > 0 || !epochCache.empty() )
+      {
+         return readBufferedEpochData(gdsMap);
+      }
+
       // First, We clear the data map
       gdsMap.clear();
 
@@ -165,10 +242,257 @@ namespace gpstk
 
    }  // End of method 'NetworkObsStreams::readEpochData()'
 
+
+      // Get epoch data of the network out of the epoch buffers
+   bool NetworkObsStreams::readBufferedEpochData(gnssDataMap& gdsMap)
+      throw(SynchronizeException)
+   {
+      gdsMap.clear();
+
+      std::map<SourceID, Rinex3ObsStream*>::iterator it;
+
+         // Refill all the buffers at once when one of them runs dry
+      for( it = mapSourceStream.begin();
+           it != mapSourceStream.end();
+           ++it )
+      {
+         EpochBuffer& buffer( mapSourceBuffer[it->first] );
+         if( buffer.epochs.empty() && !buffer.end )
+         {
+            fillBuffers();
+            break;
+         }
+      }
+
+      EpochBuffer& refBuffer( mapSourceBuffer[referenceSource] );
+
+      if( refBuffer.epochs.empty() )
+      {
+         if(refBuffer.failed)
+         {
+            SynchronizeException e( "Unable to read reference data: "
+                                    + refBuffer.error );
+            GPSTK_THROW(e);
+         }
+
+         return false;
+      }
+
+      gnssRinex gRef( refBuffer.epochs.front() );
+      refBuffer.epochs.pop_front();
+
+      gdsMap.addGnssRinex(gRef);
+
+      const CommonTime& time( gRef.header.epoch );
+
+      for( it = mapSourceStream.begin();
+           it != mapSourceStream.end();
+           ++it )
+      {
+         if( it->first == referenceSource) continue;
+
+         EpochBuffer& buffer( mapSourceBuffer[it->first] );
+
+         double tolerance( mapSourceSynchro[it->first]->getTolerance() );
+
+            // Same rules as 'Synchronize': older epochs out of tolerance
+            // are dropped, newer ones are kept for the coming epochs
+         bool found(false);
+         while(true)
+         {
+            if( buffer.epochs.empty() )
+            {
+               if(buffer.end) break;
+
+               fillBuffer( it->second, mapSourceArchive[it->first], buffer );
+               continue;
+            }
+
+            const gnssRinex& gRin( buffer.epochs.front() );
+
+            if( gRin.header.epoch < time &&
+                std::abs( gRin.header.epoch - time ) > tolerance )
+            {
+               buffer.epochs.pop_front();
+               continue;
+            }
+
+            if( std::abs( gRin.header.epoch - time ) <= tolerance )
+            {
+               gdsMap.addGnssRinex(gRin);
+               buffer.epochs.pop_front();
+               found = true;
+            }
+
+            break;
+         }
+
+         if( !found && synchronizeException )
+         {
+            std::stringstream ss;
+            ss << "Exception when try to synchronize at epoch: "
+               << gRef.header.epoch << std::endl;
+
+            SynchronizeException e(ss.str());
+
+            GPSTK_THROW(e);
+         }
+
+      }  // End of 'for(std::map<SourceID, Rinex3ObsStream*>::iterator it;
+
+      return true;
+
+   }  // End of method 'NetworkObsStreams::readBufferedEpochData()'
+
+
+      // Fill the epoch buffers of all the files, in parallel
+   void NetworkObsStreams::fillBuffers()
+   {
+      std::vector<Rinex3ObsStream*> streams;
+      std::vector<ObsEpochArchive*> archives;
+      std::vector<EpochBuffer*> buffers;
+
+      std::map<SourceID, Rinex3ObsStream*>::iterator it;
+      for( it = mapSourceStream.begin();
+           it != mapSourceStream.end();
+           ++it )
+      {
+         EpochBuffer& buffer( mapSourceBuffer[it->first] );
+
+         if( !buffer.end && buffer.epochs.size() < bufferSize() )
+         {
+            streams.push_back(it->second);
+            archives.push_back( mapSourceArchive[it->first] );
+            buffers.push_back(&buffer);
+         }
+      }
+
+      int numStreams( streams.size() );
+
+         // Every thread reads its own streams; 'fillBuffer()' doesn't throw
+#ifdef _OPENMP
+   #pragma omp parallel for schedule(dynamic)
+#endif
+      for(int i = 0; i < numStreams; ++i)
+      {
+         fillBuffer( streams[i], archives[i], *buffers[i] );
+      }
+
+   }  // End of method 'NetworkObsStreams::fillBuffers()'
+
+
+      // Read epochs from a file, or its archive, until its buffer is full
+   void NetworkObsStreams::fillBuffer( Rinex3ObsStream* pObsStream,
+                                       ObsEpochArchive* pArchive,
+                                       EpochBuffer& buffer )
+   {
+      while( !buffer.end && buffer.epochs.size() < bufferSize() )
+      {
+         try
+         {
+            gnssRinex gRin;
+
+            if( pObsStream == NULL )
+            {
+               if( pArchive->read(gRin) )
+               {
+                  buffer.epochs.push_back(gRin);
+               }
+               else
+               {
+                  buffer.end = true;
+               }
+            }
+            else if( (*pObsStream) >> gRin )
+            {
+               buffer.epochs.push_back(gRin);
+
+               if(pArchive) pArchive->write(gRin);
+            }
+            else
+            {
+               buffer.end = true;
+
+                  // Only a file read to the end gives a complete archive
+               if(pArchive) pArchive->close();
+            }
+         }
+         catch(Exception& e)
+         {
+            buffer.end = true;
+            buffer.failed = true;
+            buffer.error = e.what();
+         }
+         catch(std::exception& e)
+         {
+            buffer.end = true;
+            buffer.failed = true;
+            buffer.error = e.what();
+         }
+         catch(...)
+         {
+            buffer.end = true;
+            buffer.failed = true;
+            buffer.error = "unknown exception";
+         }
+      }
+
+   }  // End of method 'NetworkObsStreams::fillBuffer()'
+
+      // Name of the archive of an observation file: the name of the file
+      // in the cache directory, plus a hash of its full path and stamp,
+      // plus ".epochs"
+   std::string NetworkObsStreams::archiveFileName(
+                                          const std::string& obsFile,
+                                          const std::string& stamp ) const
+   {
+      std::string::size_type pos( obsFile.find_last_of("/\\") );
+      std::string name( (pos == std::string::npos) ? obsFile
+                                                   : obsFile.substr(pos + 1) );
+
+         // Files of the same name in different directories, or different
+         // versions of a file, get different archives
+      std::string path( obsFile );
+
+#ifndef _WIN32
+      char fullPath[PATH_MAX];
+      if( realpath(obsFile.c_str(), fullPath) != NULL )
+      {
+         path = fullPath;
+      }
+#else
+      char fullPath[_MAX_PATH];
+      if( _fullpath(fullPath, obsFile.c_str(), _MAX_PATH) != NULL )
+      {
+         path = fullPath;
+      }
+#endif
+
+      path += "\n" + stamp;
+
+         // 64-bit FNV-1a hash
+      unsigned long long hash( 14695981039346656037ULL );
+      for(std::string::size_type i = 0; i < path.size(); ++i)
+      {
+         hash ^= static_cast<unsigned char>(path[i]);
+         hash *= 1099511628211ULL;
+      }
+
+      std::ostringstream ss;
+      ss << epochCache << "/" << name << "."
+         << std::hex << std::setfill('0') << std::setw(16) << hash
+         << ".epochs";
+
+      return ss.str();
+
+   }  // End of method 'NetworkObsStreams::archiveFileName()'
+
       // do some clean operation
    void NetworkObsStreams::cleanUp()
    {
       mapSourceStream.clear();
+      mapSourceBuffer.clear();
+      mapSourceArchive.clear();
 
       std::list<ObsData>::iterator it;
       for( it = allStreamData.begin();
@@ -187,6 +511,12 @@ namespace gpstk
             delete it->pSynchro;
             it->pSynchro = (Synchronize*)0;
          }
+
+         if(it->pArchive)
+         {
+            delete it->pArchive;
+            it->pArchive = (ObsEpochArchive*)0;
+         }
       }
 
       allStreamData.clear();
@@ -47,9 +47,11 @@
 #include <string>
 #include <list>
 #include <map>
+#include <deque>
 #include "Rinex3ObsStream.hpp"
 #include "DataStructures.hpp"
 #include "Synchronize.hpp"
+#include "ObsEpochArchive.hpp"
 
 namespace gpstk
 {
@@ -95,12 +97,27 @@ namespace gpstk
        * to be synchronized. When 'NetworkObsStreams::setSynchronizeException(true)'
        * is used, it'll throw a 'SynchronizeException' when faied to synchronize data.
        * Then, you must handle it appropriately.
+       *
+       * By default the files are read one after another when the data of
+       * an epoch are requested. With 'setPrefetchEpochs(n)', every file is
+       * read up to 'n' epochs ahead into a buffer of its own, and the
+       * buffers of all the files are filled at the same time by OpenMP
+       * threads; 'readEpochData()' then takes the epoch data out of the
+       * buffers. This mode must be set before reading the first epoch.
+       *
+       * With 'setEpochCache(directory)', the epochs read from every file
+       * are also written to a binary archive in that directory (see
+       * 'ObsEpochArchive'), named after the file, its full path and its
+       * size and time. When the same file is added again later, and it
+       * wasn't modified, its epochs are read from the archive instead of
+       * parsing the RINEX file. The cache must be set before adding the
+       * files, and the epochs are then always read through the buffers.
        */
    class NetworkObsStreams
    {
    public:
          /// Default constructor
-      NetworkObsStreams() : synchronizeException(false)
+      NetworkObsStreams() : synchronizeException(false), prefetchEpochs(0)
       {}
 
          /// Default destructor
@@ -122,6 +139,31 @@ namespace gpstk
       void setSynchronizeException(const bool& synException = true)
       { synchronizeException = synException; }
 
+         /** Sets the number of epochs read ahead for every file.
+          *
+          * @param epochs     Number of epochs, 0 (default) to read the
+          *                   files only when the epoch data are requested.
+          */
+      void setPrefetchEpochs(int epochs)
+      { prefetchEpochs = (epochs > 0) ? epochs : 0; }
+
+         /// Returns the number of epochs read ahead for every file.
+      int getPrefetchEpochs() const
+      { return prefetchEpochs; }
+
+         /** Sets the directory of the archives caching the epochs of the
+          *  files, to be set before adding the files.
+          *
+          * @param directory  Directory of the archives, empty (default)
+          *                   not to cache the epochs.
+          */
+      void setEpochCache(const std::string& directory)
+      { epochCache = directory; }
+
+         /// Returns the directory of the archives caching the epochs.
+      std::string getEpochCache() const
+      { return epochCache; }
+
          /// Get epoch data of the network
          /// @gdsMap  Object hold epoch observation data of the network
          /// @return  Is there more epoch data for the network
@@ -131,6 +173,9 @@ namespace gpstk
          /// Get the SourceID of the rinex observation file
       SourceID sourceIDOfRinexObsFile(std::string obsFile);
 
+         /** Returns the stream of a source, NULL if its epochs are read
+          *  from the epoch cache.
+          */
       Rinex3ObsStream* getRinexObsStream(const SourceID& source)
       { return mapSourceStream[source]; }
 
@@ -145,6 +190,9 @@ namespace gpstk
 
          Synchronize* pSynchro;
          Rinex3ObsStream* pObsStream;
+
+            /// Archive written or read, NULL if the epochs aren't cached
+         ObsEpochArchive* pArchive;
       };
 
          /// Object to hold all the data of the network
@@ -156,16 +204,63 @@ namespace gpstk
          /// Map to easy access the synchronize object
       std::map<SourceID, Synchronize*> mapSourceSynchro;
 
+         /// Map to easy access the epoch archives
+      std::map<SourceID, ObsEpochArchive*> mapSourceArchive;
+
          /// Reference Sourcee
       SourceID referenceSource;
 
          /// Flag indicate will throw 'SynchronizeException'
       bool synchronizeException;
 
+         /// Struct to hold the epochs read ahead from a observation file
+      struct EpochBuffer
+      {
+         EpochBuffer() : end(false), failed(false) {}
+
+         std::deque<gnssRinex> epochs;
+
+            /// No more epochs can be read from the file
+         bool end;
+
+            /// Reading stopped because of an error
+         bool failed;
+         std::string error;
+      };
+
+         /// Map to easy access the epoch buffers by 'SourceID'
+      std::map<SourceID, EpochBuffer> mapSourceBuffer;
+
+         /// Number of epochs read ahead for every file, 0 to disable
+      int prefetchEpochs;
+
+         /// Directory of the epoch archives, empty to disable
+      std::string epochCache;
+
    private:
          // Do some clean operation
       virtual void cleanUp();
 
+         // Get epoch data of the network out of the epoch buffers
+      bool readBufferedEpochData(gnssDataMap& gdsMap)
+         throw(SynchronizeException);
+
+         // Fill the epoch buffers of all the files, in parallel
+      void fillBuffers();
+
+         // Read epochs from a file, or its archive, until its buffer is full
+      void fillBuffer( Rinex3ObsStream* pObsStream,
+                       ObsEpochArchive* pArchive,
+                       EpochBuffer& buffer );
+
+         // Number of epochs the buffers are filled up to
+      size_t bufferSize() const
+      { return (prefetchEpochs > 0) ? prefetchEpochs : 1; }
+
+         // Name of the archive of an observation file
+      std::string archiveFileName( const std::string& obsFile,
+                                   const std::string& stamp ) const;
+
    }; // End of class 'NetworkObsStreams'
 
       //@}
@@ -0,0 +1,720 @@
+#pragma ident "$Id: ObsEpochArchive.cpp $"
+
+/**
+ * @file ObsEpochArchive.cpp
+ * Binary archive of the observation epochs (gnssRinex objects) of one
+ * station, to replay them without parsing the RINEX file again.
+ */
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+//============================================================================
+
+
+#include <cstring>
+#include <cstdio>
+
+#ifndef _WIN32
+#include <unistd.h>
+#else
+#include <process.h>
+#endif
+
+#include "ObsEpochArchive.hpp"
+
+using namespace std;
+
+namespace gpstk
+{
+
+    namespace
+    {
+        const char archiveMagic[8] = { 'O','B','S','E','P','O','C','H' };
+        const unsigned int byteOrderMark = 0x01020304;
+        const unsigned int archiveVersion = 1;
+
+        /// Sizes of the satellite and type tables, limited by the keys
+        const size_t maxTableSize = 0x10000;
+
+        /// Longest string of the trailer
+        const unsigned int maxStringSize = 0x100000;
+
+
+        /// Header at the start of the archive (32 bytes)
+        struct FileHead
+        {
+            char magic[8];
+            unsigned int byteOrder;
+            unsigned int version;
+            long long trailerOffset;
+            long long numEpochs;
+        };
+
+
+        /// Head of every epoch record (32 bytes)
+        struct RecordHead
+        {
+            int day;
+            int msod;
+            double fsod;
+            int timeSystem;
+            short epochFlag;
+            short unused;
+            unsigned int numValues;
+            unsigned int unused2;
+        };
+
+
+        /// Entry of the epoch index of the trailer (32 bytes)
+        struct IndexRecord
+        {
+            int day;
+            int msod;
+            double fsod;
+            int timeSystem;
+            int unused;
+            long long offset;
+        };
+
+
+        template <class T>
+        void writeValue(std::ostream& os, const T& value)
+        {
+            os.write( reinterpret_cast<const char*>(&value), sizeof(T) );
+        }
+
+
+        template <class T>
+        bool readValue(std::istream& is, T& value)
+        {
+            is.read( reinterpret_cast<char*>(&value), sizeof(T) );
+            return is.good();
+        }
+
+
+        /// Bytes needed to pad 'size' to a multiple of 8
+        size_t padding(size_t size)
+        {
+            return (8 - size % 8) % 8;
+        }
+
+
+        /// Strings are stored as their size and characters, padded to 8
+        void writeString(std::ostream& os, const std::string& s)
+        {
+            const char zeros[8] = { 0 };
+
+            writeValue( os, static_cast<unsigned int>(s.size()) );
+            writeValue( os, static_cast<unsigned int>(0) );
+            os.write( s.data(), s.size() );
+            os.write( zeros, padding(s.size()) );
+        }
+
+
+        bool readString(std::istream& is, std::string& s)
+        {
+            unsigned int size, unused;
+            if( !readValue(is, size) || !readValue(is, unused) ||
+                size > maxStringSize )
+            {
+                return false;
+            }
+
+            std::vector<char> buf( size + padding(size) + 1 );
+            is.read( &buf[0], size + padding(size) );
+            if( !is.good() ) return false;
+
+            s.assign( &buf[0], size );
+
+            return true;
+        }
+
+    }  // End of anonymous namespace
+
+
+        // Opens an archive for reading.
+    bool ObsEpochArchive::open( const std::string& fileName,
+                                const std::string& stamp )
+    {
+        close();
+
+        m_File.open( fileName.c_str(), std::ios::in | std::ios::binary );
+        if( !m_File.is_open() )
+        {
+            m_File.clear();
+            return false;
+        }
+
+        FileHead head;
+        if( !readValue(m_File, head)                              ||
+            std::memcmp(head.magic, archiveMagic, 8) != 0         ||
+            head.byteOrder != byteOrderMark                       ||
+            head.version != archiveVersion                        ||
+            head.trailerOffset < static_cast<long long>(sizeof(head)) )
+        {
+            m_File.close();
+            m_File.clear();
+            return false;
+        }
+
+        m_File.seekg( head.trailerOffset );
+
+        if( !readTrailer(stamp) ||
+            m_Index.size() != static_cast<size_t>(head.numEpochs) )
+        {
+            m_File.close();
+            m_File.clear();
+            m_Index.clear();
+            return false;
+        }
+
+        m_FileName = fileName;
+        m_Mode = readMode;
+
+            // The records follow the header
+        m_File.seekg( sizeof(head) );
+        m_Next = 0;
+
+        return true;
+
+    }  // End of method 'ObsEpochArchive::open()'
+
+
+        // Creates an archive for writing, replacing any previous file.
+    void ObsEpochArchive::create( const std::string& fileName,
+                                  const std::string& stamp )
+        throw(FFStreamError)
+    {
+        close();
+
+            // The process ID keeps concurrent runs apart
+#ifndef _WIN32
+        long pid( getpid() );
+#else
+        long pid( _getpid() );
+#endif
+        m_TempName = fileName + ".tmp" + StringUtils::asString(pid);
+
+        m_File.open( m_TempName.c_str(),
+                     std::ios::out | std::ios::binary | std::ios::trunc );
+        if( !m_File.is_open() )
+        {
+            m_File.clear();
+            FFStreamError e("Unable to create the archive " + fileName);
+            GPSTK_THROW(e);
+        }
+
+        m_FileName = fileName;
+        m_Stamp = stamp;
+        m_Header = sourceEpochRinexHeader();
+        m_HasHeader = false;
+        m_Sats.clear();
+        m_Types.clear();
+        m_SatIndex.clear();
+        m_TypeIndex.clear();
+        m_Index.clear();
+
+            // The trailer offset stays 0 until the archive is completed
+        FileHead head;
+        std::memcpy(head.magic, archiveMagic, 8);
+        head.byteOrder = byteOrderMark;
+        head.version = archiveVersion;
+        head.trailerOffset = 0;
+        head.numEpochs = 0;
+
+        writeValue(m_File, head);
+        m_Size = sizeof(head);
+
+        m_Mode = writeMode;
+
+        if( !m_File.good() )
+        {
+            m_Mode = closedMode;
+            m_File.close();
+            m_File.clear();
+            std::remove( m_TempName.c_str() );
+            FFStreamError e("Unable to write the archive " + fileName);
+            GPSTK_THROW(e);
+        }
+
+    }  // End of method 'ObsEpochArchive::create()'
+
+
+        // Reads the next epoch.
+    bool ObsEpochArchive::read(gnssRinex& gRin)
+        throw(FFStreamError)
+    {
+        if( m_Mode != readMode || m_Next >= m_Index.size() )
+        {
+            return false;
+        }
+
+        RecordHead head;
+        bool ok( readValue(m_File, head) );
+
+        size_t n( ok ? head.numValues : 0 );
+
+        if(ok && n > 0)
+        {
+            m_Keys.resize( n + 1 );
+            m_Values.resize( n );
+
+            m_File.read( reinterpret_cast<char*>(&m_Keys[0]),
+                         n * sizeof(unsigned int) + padding(4 * n) );
+            m_File.read( reinterpret_cast<char*>(&m_Values[0]),
+                         n * sizeof(double) );
+            ok = m_File.good();
+        }
+
+        if(!ok)
+        {
+            FFStreamError e("Unable to read the archive " + m_FileName);
+            GPSTK_THROW(e);
+        }
+
+        gRin.header = m_Header;
+        gRin.header.epoch.setInternal( head.day,
+                                       head.msod,
+                                       head.fsod,
+                                       TimeSystem(head.timeSystem) );
+        gRin.header.epochFlag = head.epochFlag;
+
+            // The keys are sorted as the maps are, so every value goes
+            // to the end of its map
+        gRin.body.clear();
+
+        satTypeValueMap::iterator itSat( gRin.body.end() );
+        unsigned int lastSat( maxTableSize );
+
+        for(size_t i = 0; i < n; ++i)
+        {
+            unsigned int sat( m_Keys[i] >> 16 );
+            unsigned int type( m_Keys[i] & 0xffff );
+
+            if( sat >= m_Sats.size() || type >= m_Types.size() )
+            {
+                FFStreamError e("Invalid record in the archive " + m_FileName);
+                GPSTK_THROW(e);
+            }
+
+            if( sat != lastSat )
+            {
+                itSat = gRin.body.insert( gRin.body.end(),
+                            std::make_pair(m_Sats[sat], typeValueMap()) );
+                lastSat = sat;
+            }
+
+            itSat->second.insert( itSat->second.end(),
+                                  std::make_pair(m_Types[type], m_Values[i]) );
+        }
+
+        ++m_Next;
+
+        return true;
+
+    }  // End of method 'ObsEpochArchive::read()'
+
+
+        // Appends an epoch.
+    void ObsEpochArchive::write(const gnssRinex& gRin)
+        throw(FFStreamError)
+    {
+        if( m_Mode != writeMode )
+        {
+            FFStreamError e("The archive is not open for writing");
+            GPSTK_THROW(e);
+        }
+
+        if( !m_HasHeader )
+        {
+            m_Header = gRin.header;
+            m_HasHeader = true;
+        }
+
+        m_Keys.clear();
+        m_Values.clear();
+
+        for( satTypeValueMap::const_iterator itSat = gRin.body.begin();
+             itSat != gRin.body.end();
+             ++itSat )
+        {
+            std::map<SatID, unsigned int>::iterator itIndex(
+                                            m_SatIndex.find(itSat->first) );
+            if( itIndex == m_SatIndex.end() )
+            {
+                if( m_Sats.size() >= maxTableSize )
+                {
+                    FFStreamError e("Too many satellites for the archive");
+                    GPSTK_THROW(e);
+                }
+
+                itIndex = m_SatIndex.insert(
+                    std::make_pair(itSat->first, m_Sats.size()) ).first;
+                m_Sats.push_back(itSat->first);
+            }
+
+            unsigned int sat( itIndex->second );
+
+            for( typeValueMap::const_iterator itType = itSat->second.begin();
+                 itType != itSat->second.end();
+                 ++itType )
+            {
+                std::map<TypeID, unsigned int>::iterator itTypeIndex(
+                                        m_TypeIndex.find(itType->first) );
+                if( itTypeIndex == m_TypeIndex.end() )
+                {
+                    if( m_Types.size() >= maxTableSize )
+                    {
+                        FFStreamError e("Too many types for the archive");
+                        GPSTK_THROW(e);
+                    }
+
+                    itTypeIndex = m_TypeIndex.insert(
+                        std::make_pair(itType->first, m_Types.size()) ).first;
+                    m_Types.push_back(itType->first);
+                }
+
+                m_Keys.push_back( (sat << 16) | itTypeIndex->second );
+                m_Values.push_back( itType->second );
+            }
+        }
+
+        size_t n( m_Keys.size() );
+
+        RecordHead head;
+        long day, msod;
+        TimeSystem ts;
+        gRin.header.epoch.getInternal(day, msod, head.fsod, ts);
+        head.day = day;
+        head.msod = msod;
+        head.timeSystem = ts.getTimeSystem();
+        head.epochFlag = gRin.header.epochFlag;
+        head.unused = 0;
+        head.numValues = n;
+        head.unused2 = 0;
+
+        IndexEntry entry;
+        entry.epoch = gRin.header.epoch;
+        entry.offset = m_Size;
+
+        writeValue(m_File, head);
+
+        if(n > 0)
+        {
+            m_Keys.resize( n + padding(4 * n) / 4, 0 );
+
+            m_File.write( reinterpret_cast<const char*>(&m_Keys[0]),
+                          m_Keys.size() * sizeof(unsigned int) );
+            m_File.write( reinterpret_cast<const char*>(&m_Values[0]),
+                          n * sizeof(double) );
+        }
+
+        if( !m_File.good() )
+        {
+            FFStreamError e("Unable to write the archive " + m_FileName);
+            GPSTK_THROW(e);
+        }
+
+        m_Size += sizeof(head) + m_Keys.size() * sizeof(unsigned int)
+                               + n * sizeof(double);
+        m_Index.push_back(entry);
+
+    }  // End of method 'ObsEpochArchive::write()'
+
+
+        // Positions the archive being read at the first epoch not before
+        // the given one.
+    bool ObsEpochArchive::seek(const CommonTime& epoch)
+    {
+        if( m_Mode != readMode ) return false;
+
+        size_t first(0), last( m_Index.size() );
+        while(first < last)
+        {
+            size_t middle( first + (last - first) / 2 );
+
+            if( m_Index[middle].epoch < epoch )
+            {
+                first = middle + 1;
+            }
+            else
+            {
+                last = middle;
+            }
+        }
+
+        m_Next = first;
+        if( m_Next >= m_Index.size() ) return false;
+
+        m_File.clear();
+        m_File.seekg( m_Index[m_Next].offset );
+
+        return m_File.good();
+
+    }  // End of method 'ObsEpochArchive::seek()'
+
+
+        // Closes the archive.
+    void ObsEpochArchive::close()
+        throw(FFStreamError)
+    {
+        if( m_Mode == closedMode ) return;
+
+        bool writing( m_Mode == writeMode );
+
+        m_Mode = closedMode;
+
+            // 'writeTrailer()' closes the file itself if it fails
+        if(writing)
+        {
+            try
+            {
+                writeTrailer();
+            }
+            catch(FFStreamError& e)
+            {
+                std::remove( m_TempName.c_str() );
+                GPSTK_RETHROW(e);
+            }
+        }
+
+        m_File.close();
+        m_File.clear();
+
+            // The complete archive replaces any previous one at once
+        if( writing &&
+            std::rename( m_TempName.c_str(), m_FileName.c_str() ) != 0 )
+        {
+            std::remove( m_TempName.c_str() );
+            FFStreamError e("Unable to write the archive " + m_FileName);
+            GPSTK_THROW(e);
+        }
+
+    }  // End of method 'ObsEpochArchive::close()'
+
+
+        // Destructor. An archive being written is not completed.
+    ObsEpochArchive::~ObsEpochArchive()
+    {
+        if( m_Mode == writeMode )
+        {
+            m_File.close();
+            std::remove( m_TempName.c_str() );
+        }
+
+    }  // End of method 'ObsEpochArchive::~ObsEpochArchive()'
+
+
+        // Reads the trailer, returns false if it is not valid.
+    bool ObsEpochArchive::readTrailer(const std::string& stamp)
+    {
+        m_Sats.clear();
+        m_Types.clear();
+        m_SatIndex.clear();
+        m_TypeIndex.clear();
+        m_Index.clear();
+
+        unsigned int num, unused;
+
+            // Satellites
+        if( !readValue(m_File, num) || !readValue(m_File, unused) ||
+            num > maxTableSize )
+        {
+            return false;
+        }
+
+        for(unsigned int i = 0; i < num; ++i)
+        {
+            int id, system;
+            if( !readValue(m_File, id) || !readValue(m_File, system) )
+            {
+                return false;
+            }
+
+            m_Sats.push_back(
+                    SatID(id, static_cast<SatID::SatelliteSystem>(system)) );
+        }
+
+            // Types, by their names: the values of the types created at run
+            // time depend on the order they were created in
+        if( !readValue(m_File, num) || !readValue(m_File, unused) ||
+            num > maxTableSize )
+        {
+            return false;
+        }
+
+        for(unsigned int i = 0; i < num; ++i)
+        {
+            int type;
+            std::string name;
+            if( !readValue(m_File, type) || !readValue(m_File, unused) ||
+                !readString(m_File, name) )
+            {
+                return false;
+            }
+
+            // Not through asString(): it would register a value unknown
+            // here with an empty name
+            TypeID typeID( static_cast<TypeID::ValueType>(type) );
+            std::map<TypeID::ValueType, std::string>::const_iterator itName(
+                                         TypeID::tStrings.find(typeID.type) );
+            if( itName == TypeID::tStrings.end() || itName->second != name )
+            {
+                typeID = TypeID(name);
+            }
+
+            m_Types.push_back(typeID);
+        }
+
+            // Stamp of the data
+        if( !readString(m_File, m_Stamp) ||
+            ( !stamp.empty() && stamp != m_Stamp ) )
+        {
+            return false;
+        }
+
+            // Header data
+        int hasHeader, sourceType;
+        m_Header = sourceEpochRinexHeader();
+        if( !readValue(m_File, hasHeader)                     ||
+            !readValue(m_File, sourceType)                    ||
+            !readString(m_File, m_Header.source.sourceName)   ||
+            !readString(m_File, m_Header.source.sourceNumber) ||
+            !readString(m_File, m_Header.antennaType)         ||
+            !readValue(m_File, m_Header.antennaPosition[0])   ||
+            !readValue(m_File, m_Header.antennaPosition[1])   ||
+            !readValue(m_File, m_Header.antennaPosition[2]) )
+        {
+            return false;
+        }
+
+        m_HasHeader = (hasHeader != 0);
+        m_Header.source.type = static_cast<SourceID::SourceType>(sourceType);
+        m_Header.epochFlag = 0;
+
+            // Epoch index
+        long long numEpochs;
+        if( !readValue(m_File, numEpochs) || numEpochs < 0 )
+        {
+            return false;
+        }
+
+        m_Index.reserve( numEpochs );
+        for(long long i = 0; i < numEpochs; ++i)
+        {
+            IndexRecord record;
+            if( !readValue(m_File, record) ) return false;
+
+            IndexEntry entry;
+            entry.epoch.setInternal( record.day,
+                                     record.msod,
+                                     record.fsod,
+                                     TimeSystem(record.timeSystem) );
+            entry.offset = record.offset;
+
+            m_Index.push_back(entry);
+        }
+
+        return true;
+
+    }  // End of method 'ObsEpochArchive::readTrailer()'
+
+
+        // Writes the trailer and updates the header.
+    void ObsEpochArchive::writeTrailer()
+    {
+        long long trailerOffset( m_Size );
+
+            // Satellites
+        writeValue( m_File, static_cast<unsigned int>(m_Sats.size()) );
+        writeValue( m_File, static_cast<unsigned int>(0) );
+
+        for(size_t i = 0; i < m_Sats.size(); ++i)
+        {
+            writeValue( m_File, m_Sats[i].id );
+            writeValue( m_File, static_cast<int>(m_Sats[i].system) );
+        }
+
+            // Types
+        writeValue( m_File, static_cast<unsigned int>(m_Types.size()) );
+        writeValue( m_File, static_cast<unsigned int>(0) );
+
+        for(size_t i = 0; i < m_Types.size(); ++i)
+        {
+            writeValue( m_File, static_cast<int>(m_Types[i].type) );
+            writeValue( m_File, static_cast<unsigned int>(0) );
+            writeString( m_File, StringUtils::asString(m_Types[i]) );
+        }
+
+            // Stamp of the data
+        writeString(m_File, m_Stamp);
+
+            // Header data
+        writeValue( m_File, static_cast<int>(m_HasHeader) );
+        writeValue( m_File, static_cast<int>(m_Header.source.type) );
+        writeString( m_File, m_Header.source.sourceName );
+        writeString( m_File, m_Header.source.sourceNumber );
+        writeString( m_File, m_Header.antennaType );
+        writeValue( m_File, m_Header.antennaPosition[0] );
+        writeValue( m_File, m_Header.antennaPosition[1] );
+        writeValue( m_File, m_Header.antennaPosition[2] );
+
+            // Epoch index
+        writeValue( m_File, static_cast<long long>(m_Index.size()) );
+
+        for(size_t i = 0; i < m_Index.size(); ++i)
+        {
+            IndexRecord record;
+            long day, msod;
+            TimeSystem ts;
+            m_Index[i].epoch.getInternal(day, msod, record.fsod, ts);
+            record.day = day;
+            record.msod = msod;
+            record.timeSystem = ts.getTimeSystem();
+            record.unused = 0;
+            record.offset = m_Index[i].offset;
+
+            writeValue(m_File, record);
+        }
+
+            // Last, the header: the archive is complete from now on
+        FileHead head;
+        std::memcpy(head.magic, archiveMagic, 8);
+        head.byteOrder = byteOrderMark;
+        head.version = archiveVersion;
+        head.trailerOffset = trailerOffset;
+        head.numEpochs = m_Index.size();
+
+        m_File.flush();
+        m_File.seekp(0);
+        writeValue(m_File, head);
+        m_File.flush();
+
+        if( !m_File.good() )
+        {
+            m_File.close();
+            m_File.clear();
+            FFStreamError e("Unable to write the archive " + m_FileName);
+            GPSTK_THROW(e);
+        }
+
+    }  // End of method 'ObsEpochArchive::writeTrailer()'
+
+
+}  // End of namespace gpstk
@@ -0,0 +1,295 @@
+#pragma ident "$Id: ObsEpochArchive.hpp $"
+
+/**
+ * @file ObsEpochArchive.hpp
+ * Binary archive of the observation epochs (gnssRinex objects) of one
+ * station, to replay them without parsing the RINEX file again.
+ */
+
+#ifndef GPSTK_OBS_EPOCH_ARCHIVE_HPP
+#define GPSTK_OBS_EPOCH_ARCHIVE_HPP
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+//============================================================================
+
+
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+#include "DataStructures.hpp"
+#include "FFStreamError.hpp"
+
+
+namespace gpstk
+{
+
+      /** @addtogroup DataStructures */
+      //@{
+
+      /** This class writes and reads a binary archive of the observation
+       *  epochs of one station, as 'gnssRinex' objects.
+       *
+       * Reading the archive gives the same 'gnssRinex' objects that were
+       * written, without the cost of parsing the RINEX text again, e.g.
+       * when the same observation files are processed many times with
+       * different settings.
+       *
+       * The layout of the file is fixed and naturally aligned, so that it
+       * may also be memory-mapped:
+       *
+       * - Header (32 bytes): "OBSEPOCH", byte order mark, format version,
+       *   offset of the trailer and number of epochs. The trailer offset
+       *   is only written by 'close()', an archive that was not closed is
+       *   incomplete and can't be opened.
+       * - One record per epoch: the epoch (day, msod, fsod, time system),
+       *   the epoch flag and the number of values (32 bytes), then the
+       *   keys of the values (satellite index << 16 | type index, 4 bytes
+       *   each, padded to 8 bytes) and then the values (8 bytes each).
+       * - Trailer: the SatID and TypeID tables of the indexes, the header
+       *   data common to all the epochs (source, antenna), a stamp of the
+       *   data the archive was made from, and the epoch index (epoch and
+       *   file offset of every record).
+       *
+       * Numbers are stored in the byte order of the machine; archives are
+       * a local cache, not an exchange format.
+       *
+       * A typical way to use this class follows:
+       *
+       * @code
+       *   ObsEpochArchive archive;
+       *
+       *   if( !archive.open("ebre0300.epochs") )
+       *   {
+       *      Rinex3ObsStream rin("ebre0300.02o");
+       *      archive.create("ebre0300.epochs");
+       *
+       *      gnssRinex gRin;
+       *      while( rin >> gRin )
+       *      {
+       *         archive.write(gRin);
+       *      }
+       *      archive.close();
+       *
+       *      archive.open("ebre0300.epochs");
+       *   }
+       *
+       *   gnssRinex gRin;
+       *   while( archive.read(gRin) )
+       *   {
+       *      // processing code here
+       *   }
+       * @endcode
+       *
+       * @sa NetworkObsStreams::setEpochCache().
+       */
+    class ObsEpochArchive
+    {
+    public:
+
+        /// Default constructor.
+        ObsEpochArchive()
+            : m_Mode(closedMode), m_HasHeader(false), m_Next(0), m_Size(0)
+        {};
+
+
+        /** Opens an archive for reading.
+         *
+         * @param fileName  Name of the archive.
+         * @param stamp     If not empty, the archive is only opened if it
+         *                  was created with the same stamp.
+         *
+         * @return Whether the archive could be opened: false if it doesn't
+         *         exist, is not a complete archive, was created on another
+         *         kind of machine or with another stamp.
+         */
+        bool open( const std::string& fileName,
+                   const std::string& stamp = "" );
+
+
+        /** Creates an archive for writing, replacing any previous file.
+         *
+         * The epochs are written to a temporary file in the same
+         * directory, which only replaces the archive when it is completed
+         * by 'close()'. So an archive being written by another process is
+         * never read half-written.
+         *
+         * @param fileName  Name of the archive.
+         * @param stamp     Stamp of the data (e.g. size and time of the
+         *                  RINEX file), checked by 'open()'.
+         *
+         * @throw FFStreamError if the file can't be created.
+         */
+        void create( const std::string& fileName,
+                     const std::string& stamp = "" )
+            throw(FFStreamError);
+
+
+        /** Reads the next epoch.
+         *
+         * @param gRin      Object to receive the data.
+         *
+         * @return Whether an epoch was read, false at the end.
+         * @throw FFStreamError if the archive can't be read.
+         */
+        bool read(gnssRinex& gRin)
+            throw(FFStreamError);
+
+
+        /** Appends an epoch.
+         *
+         * The source and antenna data of the header are those of the first
+         * epoch written.
+         *
+         * @param gRin      Data of the epoch.
+         *
+         * @throw FFStreamError if the archive can't be written.
+         */
+        void write(const gnssRinex& gRin)
+            throw(FFStreamError);
+
+
+        /** Positions the archive being read at the first epoch not before
+         *  the given one.
+         *
+         * @return Whether there is such an epoch.
+         */
+        bool seek(const CommonTime& epoch);
+
+
+        /** Closes the archive. An archive being written is completed, i.e.
+         *  the trailer is written and the temporary file is renamed to the
+         *  name of the archive.
+         *
+         * @throw FFStreamError if the archive can't be written.
+         */
+        void close()
+            throw(FFStreamError);
+
+
+        /// Returns whether the archive is open for reading.
+        bool isReading() const
+        { return m_Mode == readMode; };
+
+
+        /// Returns whether the archive is open for writing.
+        bool isWriting() const
+        { return m_Mode == writeMode; };
+
+
+        /// Returns the number of epochs of the archive.
+        size_t getNumEpochs() const
+        { return m_Index.size(); };
+
+
+        /// Returns the epoch of the given record.
+        const CommonTime& getEpoch(size_t i) const
+        { return m_Index[i].epoch; };
+
+
+        /// Returns the source of the data.
+        const SourceID& getSource() const
+        { return m_Header.source; };
+
+
+        /// Returns the name of the archive.
+        const std::string& getFileName() const
+        { return m_FileName; };
+
+
+        /** Destructor. An archive being written is not completed: its
+         *  temporary file is removed, and any previous archive is kept.
+         */
+        virtual ~ObsEpochArchive();
+
+
+    private:
+
+        /// Copies are not allowed.
+        ObsEpochArchive(const ObsEpochArchive&);
+        ObsEpochArchive& operator=(const ObsEpochArchive&);
+
+
+        /// Reads the trailer, returns false if it is not valid.
+        bool readTrailer(const std::string& stamp);
+
+
+        /// Writes the trailer and updates the header.
+        void writeTrailer();
+
+
+        /// State of the archive
+        enum Mode
+        {
+            closedMode,
+            readMode,
+            writeMode
+        };
+
+        Mode m_Mode;
+
+        /// Name of the archive
+        std::string m_FileName;
+
+        /// Name of the temporary file of the archive being written
+        std::string m_TempName;
+
+        /// The archive file
+        std::fstream m_File;
+
+        /// Stamp of the data
+        std::string m_Stamp;
+
+        /// Header data common to all the epochs
+        sourceEpochRinexHeader m_Header;
+        bool m_HasHeader;
+
+        /// Indexes of the satellites and types
+        std::vector<SatID> m_Sats;
+        std::vector<TypeID> m_Types;
+        std::map<SatID, unsigned int> m_SatIndex;
+        std::map<TypeID, unsigned int> m_TypeIndex;
+
+        /// Epoch index
+        struct IndexEntry
+        {
+            CommonTime epoch;
+            long long offset;
+        };
+
+        std::vector<IndexEntry> m_Index;
+
+        /// Next record to read
+        size_t m_Next;
+
+        /// Size of the archive being written
+        long long m_Size;
+
+        /// Keys and values of the current record
+        std::vector<unsigned int> m_Keys;
+        std::vector<double> m_Values;
+
+    }; // End of class 'ObsEpochArchive'
+
+      //@}
+
+}  // End of namespace gpstk
+
+#endif   // GPSTK_OBS_EPOCH_ARCHIVE_HPP
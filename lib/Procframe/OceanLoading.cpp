@@ -56,18 +56,51 @@ namespace gpstk
       throw(InvalidRequest)
    {
 
-      const int NUM_COMPONENTS = 3;
-      const int NUM_HARMONICS = 11;
+         // Get harmonics data from file
+      return getOceanLoading( (*pBLQStore).getTideHarmonics(name), t );
 
-      Matrix<double> harmonics(6,11,0.0);
+   }  // End of method 'OceanLoading::getOceanLoading()'
 
-         // Get harmonics data from file
-      harmonics = (*pBLQStore).getTideHarmonics(name);
 
-      Vector<double> arguments(11,0.0);
+      /* Returns the effect of ocean tides loading (meters) of the given
+       * tide harmonics at the given epoch, in the Up-East-North (UEN)
+       * reference frame.
+       *
+       * @param harmonics  Tide harmonics of the station, as returned by
+       *                   BLQDataReader::getTideHarmonics().
+       * @param time       Epoch to look up
+       *
+       * @return a Triple with the ocean tidas loading effect, in meters
+       * and in the UEN reference frame.
+       */
+   Triple OceanLoading::getOceanLoading( const Matrix<double>& harmonics,
+                                         const CommonTime& t )
+   {
 
          // Compute arguments
-      arguments = getArg(t);
+      return getOceanLoading( harmonics, getArg(t) );
+
+   }  // End of method 'OceanLoading::getOceanLoading()'
+
+
+      /* Returns the effect of ocean tides loading (meters) of the given
+       * tide harmonics, for the given astronomical arguments, in the
+       * Up-East-North (UEN) reference frame.
+       *
+       * @param harmonics  Tide harmonics of the station, as returned by
+       *                   BLQDataReader::getTideHarmonics().
+       * @param arguments  Astronomical arguments of the epoch, as returned
+       *                   by getArg().
+       *
+       * @return a Triple with the ocean tidas loading effect, in meters
+       * and in the UEN reference frame.
+       */
+   Triple OceanLoading::getOceanLoading( const Matrix<double>& harmonics,
+                                         const Vector<double>& arguments )
+   {
+
+      const int NUM_COMPONENTS = 3;
+      const int NUM_HARMONICS = 11;
 
       Triple oLoading;
 
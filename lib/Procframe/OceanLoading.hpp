@@ -128,15 +128,35 @@ namespace gpstk
          throw(InvalidRequest);
 
 
-         /// Destructor
-      virtual ~OceanLoading() {};
-
-
-   private:
+         /** Returns the effect of ocean tides loading (meters) of the given
+          *  tide harmonics at the given epoch, in the Up-East-North (UEN)
+          *  reference frame. No BLQDataReader is needed.
+          *
+          * @param harmonics  Tide harmonics of the station, as returned by
+          *                   BLQDataReader::getTideHarmonics().
+          * @param time       Epoch to look up
+          *
+          * @return a Triple with the ocean tidas loading effect, in meters
+          * and in the UEN reference frame.
+          */
+      Triple getOceanLoading( const Matrix<double>& harmonics,
+                              const CommonTime& t );
 
 
-         /// Object to read BLQ ocean tides harmonics data file
-      BLQDataReader *pBLQStore;
+         /** Returns the effect of ocean tides loading (meters) of the given
+          *  tide harmonics, for the given astronomical arguments, in the
+          *  Up-East-North (UEN) reference frame.
+          *
+          * @param harmonics  Tide harmonics of the station, as returned by
+          *                   BLQDataReader::getTideHarmonics().
+          * @param arguments  Astronomical arguments of the epoch, as
+          *                   returned by getArg().
+          *
+          * @return a Triple with the ocean tidas loading effect, in meters
+          * and in the UEN reference frame.
+          */
+      Triple getOceanLoading( const Matrix<double>& harmonics,
+                              const Vector<double>& arguments );
 
 
          /** Compute the value of the corresponding astronomical arguments,
@@ -150,6 +170,17 @@ namespace gpstk
       virtual Vector<double> getArg(const CommonTime& time);
 
 
+         /// Destructor
+      virtual ~OceanLoading() {};
+
+
+   private:
+
+
+         /// Object to read BLQ ocean tides harmonics data file
+      BLQDataReader *pBLQStore;
+
+
    }; // End of class 'OceanLoading'
 
       //@}
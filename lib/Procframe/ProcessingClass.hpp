@@ -34,6 +34,7 @@
 
 #include "StringUtils.hpp"
 #include "DataStructures.hpp"
+#include "EpochDataTable.hpp"
 
 
 namespace gpstk
@@ -104,11 +105,47 @@ namespace gpstk
       virtual gnssDataMap& Process(gnssDataMap& gData) = 0;
 
 
+         /** Processes an EpochDataTable object.
+          *
+          * By default the table is converted to a gnssDataMap, processed
+          * by 'Process(gnssDataMap&)' and converted back. Classes ported
+          * to EpochDataTable override this method to work on the table
+          * directly.
+          *
+          * @param table    Data object holding the data.
+          */
+      virtual EpochDataTable& Process(EpochDataTable& table)
+      {
+         gnssDataMap gData;
+         table.toDataMap(gData);
+         Process(gData);
+         table.fromDataMap(gData);
+         return table;
+      };
+
+
          /// Abstract method. It returns a string identifying the class the
          /// object belongs to.
       virtual std::string getClassName(void) const = 0;
 
 
+         /** Returns a new copy of this object, or NULL if the object can
+          *  not be copied.
+          *
+          * The copies are used by a parallel 'ProcessingList' to process
+          * different SourceID's of a gnssDataMap at the same time, one copy
+          * per thread. Therefore, a class should only return a copy when
+          * processing one SourceID does not depend on the SourceID's
+          * processed before, and when the copies do not share objects that
+          * are modified during processing. By default NULL is returned,
+          * and the object is then applied serially.
+          *
+          * The caller owns the returned object.
+          */
+      virtual ProcessingClass* clone(void) const
+      { return NULL; };
+
+
          /// Destructor
       virtual ~ProcessingClass() {};
 
@@ -135,6 +172,12 @@ namespace gpstk
    { procClass.Process(gData); return gData; }
 
 
+      /// Input operator from EpochDataTable to ProcessingClass.
+   inline EpochDataTable& operator>>( EpochDataTable& table,
+                                      ProcessingClass& procClass )
+   { procClass.Process(table); return table; }
+
+
    //@}
 
 }  // End of namespace gpstk
@@ -30,6 +30,10 @@
 
 #include "ProcessingList.hpp"
 
+#ifdef USE_OPENMP
+#include <omp.h>
+#endif
+
 
 namespace gpstk
 {
@@ -40,6 +44,66 @@ namespace gpstk
 
 
 
+      // Assignment operator. Copies of the elements are not shared.
+   ProcessingList& ProcessingList::operator=(const ProcessingList& right)
+   {
+
+      if( this != &right )
+      {
+         resetCopies();
+         proclist = right.proclist;
+         m_Parallel = right.m_Parallel;
+      }
+
+      return (*this);
+
+   }  // End of 'ProcessingList::operator=()'
+
+
+
+      // Deletes the per-thread copies of the elements.
+   void ProcessingList::resetCopies()
+   {
+
+      for( size_t t = 0; t < m_Copies.size(); ++t )
+      {
+         for( size_t i = 0; i < m_Copies[t].size(); ++i )
+         {
+            delete m_Copies[t][i];
+         }
+      }
+
+      m_Copies.clear();
+
+   }  // End of method 'ProcessingList::resetCopies()'
+
+
+
+      // Makes the per-thread copies of the elements, if not made yet.
+   void ProcessingList::makeCopies(int numThreads)
+   {
+
+      if( m_Copies.size() == static_cast<size_t>(numThreads) )
+      {
+         return;
+      }
+
+      resetCopies();
+
+      m_Copies.resize( numThreads );
+      for( int t = 0; t < numThreads; ++t )
+      {
+         std::list<ProcessingClass*>::const_iterator pos;
+         for (pos = proclist.begin(); pos != proclist.end(); ++pos)
+         {
+            m_Copies[t].push_back( (*pos)->clone() );
+         }
+      }
+
+   }  // End of method 'ProcessingList::makeCopies()'
+
+
+
       /* Processing method. It returns a gnssSatTypeValue object.
        *
        * @param gData    Data object holding the data.
@@ -114,6 +178,11 @@ namespace gpstk
       try
       {
 
+         if( m_Parallel )
+         {
+            return processParallel(gData);
+         }
+
          std::list<ProcessingClass*>::const_iterator pos;
          for (pos = proclist.begin(); pos != proclist.end(); ++pos)
          {
@@ -135,4 +204,153 @@ namespace gpstk
    }  // End of method 'ProcessingList::Process()'
 
 
+
+      /* Processes gData in parallel. Runs of consecutive elements that can
+       * be copied are applied to one SourceID of one epoch at a time, each
+       * thread using its own copies; the other elements are applied to the
+       * whole gData in the calling thread.
+       *
+       * @param gData    Data object holding the data.
+       */
+   gnssDataMap& ProcessingList::processParallel(gnssDataMap& gData)
+   {
+
+      int numThreads(1);
+#ifdef _OPENMP
+      numThreads = omp_get_max_threads();
+#endif
+
+      makeCopies(numThreads);
+
+      std::vector<ProcessingClass*> procVec( proclist.begin(),
+                                             proclist.end() );
+
+      const int numProc( procVec.size() );
+
+      int first(0);
+      while( first < numProc )
+      {
+            // Elements that can not be copied are applied serially
+         if( m_Copies[0][first] == NULL )
+         {
+            procVec[first]->Process(gData);
+            ++first;
+            continue;
+         }
+
+         int last(first + 1);
+         while( last < numProc && m_Copies[0][last] != NULL )
+         {
+            ++last;
+         }
+
+            // Split gData into (epoch, SourceID) items
+         std::vector<gnssDataMap::iterator> epochVec;
+         std::vector<sourceDataMap::iterator> sourceVec;
+         for( gnssDataMap::iterator gdmIt = gData.begin();
+              gdmIt != gData.end();
+              ++gdmIt )
+         {
+            for( sourceDataMap::iterator sdmIt = gdmIt->second.begin();
+                 sdmIt != gdmIt->second.end();
+                 ++sdmIt )
+            {
+               epochVec.push_back( gdmIt );
+               sourceVec.push_back( sdmIt );
+            }
+         }
+
+         const int numItems( sourceVec.size() );
+
+         std::vector<char> rejected( numItems, 0 );
+         bool failed(false);
+         std::string failure;
+
+#ifdef _OPENMP
+         #pragma omp parallel for schedule(dynamic)
+#endif
+         for( int k = 0; k < numItems; ++k )
+         {
+            int thread(0);
+#ifdef _OPENMP
+            thread = omp_get_thread_num();
+#endif
+
+               // A gnssDataMap holding this SourceID only. The data is
+               // swapped in and out, so nothing is copied.
+            gnssDataMap single;
+            gnssDataMap::iterator it( single.insert(
+                     std::make_pair(epochVec[k]->first, sourceDataMap()) ) );
+            it->second[sourceVec[k]->first].swap( sourceVec[k]->second );
+
+            try
+            {
+               for( int i = first; i < last; ++i )
+               {
+                  m_Copies[thread][i]->Process(single);
+               }
+            }
+            catch(Exception& u)
+            {
+#ifdef _OPENMP
+               #pragma omp critical (ProcessingList_failure)
+#endif
+               {
+                  failed = true;
+                  failure = u.what();
+               }
+            }
+            catch(...)
+            {
+#ifdef _OPENMP
+               #pragma omp critical (ProcessingList_failure)
+#endif
+               {
+                  failed = true;
+                  failure = "unknown exception";
+               }
+            }
+
+               // Get the data back, if the SourceID was not rejected
+            rejected[k] = 1;
+            if( !single.empty() )
+            {
+               sourceDataMap& sdm( single.begin()->second );
+               sourceDataMap::iterator sdmIt( sdm.find(sourceVec[k]->first) );
+               if( sdmIt != sdm.end() )
+               {
+                  sourceVec[k]->second.swap( sdmIt->second );
+                  rejected[k] = 0;
+               }
+            }
+
+         }  // End of 'for( int k = 0; k < numItems; ++k )'
+
+         if( failed )
+         {
+            ProcessingException e( getClassName() + ":" + failure );
+            GPSTK_THROW(e);
+         }
+
+            // Rejected SourceID's are removed as the elements themselves do
+         SourceIDSet sourceRejectedSet;
+         for( int k = 0; k < numItems; ++k )
+         {
+            if( rejected[k] )
+            {
+               sourceRejectedSet.insert( sourceVec[k]->first );
+            }
+         }
+
+         gData.removeSourceID( sourceRejectedSet );
+
+         first = last;
+
+      }  // End of 'while( first < numProc )'
+
+      return gData;
+
+   }  // End of method 'ProcessingList::processParallel()'
+
+
 }  // End of namespace gpstk
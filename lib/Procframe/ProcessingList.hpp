@@ -32,6 +32,7 @@
 
 
 #include <list>
+#include <vector>
 #include "ProcessingClass.hpp"
 
 
@@ -77,6 +78,20 @@ namespace gpstk
        *   }
        * @endcode
        *
+       * When processing a gnssDataMap with many SourceID's, the list may
+       * be run in parallel (OpenMP) with 'setParallel(true)'. Then every
+       * thread gets its own copy of the list elements (see
+       * ProcessingClass::clone()), and consecutive elements that can be
+       * copied are applied to each SourceID in turn, with the SourceID's
+       * shared among the threads. Elements that can not be copied are
+       * applied serially to the whole gnssDataMap, as usual.
+       *
+       * \warning In parallel mode the copies are made the first time they
+       * are needed, so the settings of the list elements must be done
+       * before, or 'resetCopies()' must be called afterwards. Results kept
+       * inside the elements (e.g. BasicModel1::getSatClock()) are found in
+       * the copies, not in the original objects.
+       *
        */
    class ProcessingList : public ProcessingClass
    {
@@ -85,9 +100,20 @@ namespace gpstk
 
          /// Default constructor.
       ProcessingList()
+         : m_Parallel(false)
+      { };
+
+
+         /// Copy constructor. Copies of the elements are not shared.
+      ProcessingList(const ProcessingList& right)
+         : proclist(right.proclist), m_Parallel(right.m_Parallel)
       { };
 
 
+         /// Assignment operator. Copies of the elements are not shared.
+      ProcessingList& operator=(const ProcessingList& right);
+
+
          /** Processing method. It returns a gnssSatTypeValue object.
           *
           * @param gData    Data object holding the data.
@@ -124,7 +150,7 @@ namespace gpstk
           * @param pClass     Processing object to be added.
           */
       virtual void push_front(ProcessingClass& pClass)
-      { proclist.push_front( (&pClass) ); return; };
+      { proclist.push_front( (&pClass) ); resetCopies(); return; };
 
 
          /** Inserts a new element at the end.
@@ -132,17 +158,17 @@ namespace gpstk
           * @param pClass     Processing object to be added.
           */
       virtual void push_back(ProcessingClass& pClass)
-      { proclist.push_back( (&pClass) ); return; };
+      { proclist.push_back( (&pClass) ); resetCopies(); return; };
 
 
          /// Removes the first element. It does NOT return it.
       virtual void pop_front(void)
-      { proclist.pop_front(); return; };
+      { proclist.pop_front(); resetCopies(); return; };
 
 
          /// Removes the last element. It does NOT return it.
       virtual void pop_back(void)
-      { proclist.pop_back(); return; };
+      { proclist.pop_back(); resetCopies(); return; };
 
 
          /// Returns TRUE if the ProcessingList size is zero (0).
@@ -157,7 +183,27 @@ namespace gpstk
 
          /// Removes all the elements from the ProcessingList.
       virtual void clear(void)
-      { return (proclist.clear()); };
+      { proclist.clear(); resetCopies(); return; };
+
+
+         /** Sets whether gnssDataMap objects are processed in parallel,
+          *  distributing the SourceID's among threads.
+          *
+          * @param parallel   Whether or not to process in parallel.
+          */
+      virtual ProcessingList& setParallel(bool parallel)
+      { m_Parallel = parallel; return (*this); };
+
+
+         /// Returns whether gnssDataMap objects are processed in parallel.
+      virtual bool getParallel(void) const
+      { return m_Parallel; };
+
+
+         /** Deletes the per-thread copies of the elements, so they are made
+          *  again from the current elements when needed.
+          */
+      virtual void resetCopies(void);
 
 
          /// Returns a string identifying this object.
@@ -165,15 +211,30 @@ namespace gpstk
 
 
          /// Destructor
-      virtual ~ProcessingList() {};
+      virtual ~ProcessingList()
+      { resetCopies(); };
 
 
    private:
 
 
+         /// Processes gData in parallel, see 'setParallel()'.
+      gnssDataMap& processParallel(gnssDataMap& gData);
+
+
+         /// Makes the per-thread copies of the elements, if not made yet.
+      void makeCopies(int numThreads);
+
+
          /// stl::vector holding pointers to ProcessingClass objects.
       std::list<ProcessingClass*> proclist;
 
+         /// Whether gnssDataMap objects are processed in parallel
+      bool m_Parallel;
+
+         /// Copies of the elements, per thread. NULL if it can't be copied
+      std::vector< std::vector<ProcessingClass*> > m_Copies;
+
 
    }; // End of class 'ProcessingList'
 
@@ -295,6 +295,11 @@ namespace gpstk
       virtual std::string getClassName(void) const;
 
 
+         /// Returns a copy of this object, see ProcessingClass::clone().
+      virtual RequireObservables* clone(void) const
+      { return new RequireObservables(*this); };
+
+
          /// Destructor
       virtual ~RequireObservables() {};
 
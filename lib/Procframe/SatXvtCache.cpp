@@ -0,0 +1,341 @@
+#pragma ident "$Id: SatXvtCache.cpp $"
+
+/**
+ * @file SatXvtCache.cpp
+ * This is a class to cache the satellite position, velocity and clock of
+ * the current epoch, to be shared by all the stations.
+ */
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+//============================================================================
+
+
+#include "SatXvtCache.hpp"
+
+using namespace std;
+
+namespace gpstk
+{
+
+      // Number of nodes of each cached satellite
+    static const int numNodes(4);
+
+
+      // Returns a string identifying this object.
+    std::string SatXvtCache::getClassName() const
+    { return "SatXvtCache"; }
+
+
+      /* Sets the interval around each epoch covered by the cache.
+       *
+       * @param before     Seconds before the epoch, 0.3 by default.
+       * @param after      Seconds after the epoch, 0.0 by default.
+       */
+    SatXvtCache& SatXvtCache::setInterval(double before, double after)
+    {
+        if( before + after <= 0.0 )
+        {
+            InvalidRequest e("SatXvtCache: the interval must not be empty.");
+            GPSTK_THROW(e);
+        }
+
+        m_Before = before;
+        m_After = after;
+
+        clear();
+
+        return (*this);
+
+    }  // End of method 'SatXvtCache::setInterval()'
+
+
+      /* Fills the cache for the given epoch and satellites, replacing the
+       * previous content.
+       *
+       * @param epoch      Epoch of the observations.
+       * @param satSet     Satellites to be cached.
+       */
+    SatXvtCache& SatXvtCache::prepare( const CommonTime& epoch,
+                                       const SatIDSet& satSet )
+    {
+        clear();
+
+        addEpoch(epoch, satSet);
+
+        return (*this);
+
+    }  // End of method 'SatXvtCache::prepare()'
+
+
+      // Fills the cache for the given epoch, keeping the other epochs.
+    void SatXvtCache::addEpoch( const CommonTime& epoch,
+                                const SatIDSet& satSet )
+    {
+        if(pXvtStore == NULL) return;
+
+        SatXvtNodeMap& nodeMap( m_Cache[epoch] );
+
+        double h( (m_Before + m_After)/(numNodes - 1) );
+
+        for( SatIDSet::const_iterator it = satSet.begin();
+             it != satSet.end();
+             ++it )
+        {
+            std::vector<Xvt> nodes(numNodes);
+
+            try
+            {
+                for(int k = 0; k < numNodes; ++k)
+                {
+                    nodes[k] = pXvtStore->getXvt( *it,
+                                                  epoch - m_Before + k*h );
+                }
+            }
+            catch(...)
+            {
+                // Not cached, 'getXvt()' will ask the store
+                continue;
+            }
+
+            nodeMap[*it] = nodes;
+        }
+
+    }  // End of method 'SatXvtCache::addEpoch()'
+
+
+      /* Returns the position, velocity and clock offset of the given
+       * satellite, out of the cache if possible.
+       *
+       * @param sat        Satellite.
+       * @param t          Time of interest.
+       */
+    Xvt SatXvtCache::getXvt(const SatID& sat, const CommonTime& t) const
+    {
+        if(pXvtStore == NULL)
+        {
+            InvalidRequest e("SatXvtCache: no XvtStore has been set.");
+            GPSTK_THROW(e);
+        }
+
+        if( m_Cache.empty() )
+        {
+            return pXvtStore->getXvt(sat, t);
+        }
+
+        // Times of another time system can't be compared with the cache
+        TimeSystem ts( m_Cache.begin()->first.getTimeSystem() );
+        if( t.getTimeSystem() != ts &&
+            t.getTimeSystem() != TimeSystem::Any &&
+            ts != TimeSystem::Any )
+        {
+            return pXvtStore->getXvt(sat, t);
+        }
+
+        // First epoch with t <= epoch + after
+        EpochSatXvtMap::const_iterator epochIt(
+                                        m_Cache.lower_bound(t - m_After) );
+
+        if( epochIt == m_Cache.end() )
+        {
+            return pXvtStore->getXvt(sat, t);
+        }
+
+        double h( (m_Before + m_After)/(numNodes - 1) );
+        double s( (t - (epochIt->first - m_Before))/h );
+
+        if( s < 0.0 )
+        {
+            return pXvtStore->getXvt(sat, t);
+        }
+
+        SatXvtNodeMap::const_iterator satIt( epochIt->second.find(sat) );
+        if( satIt == epochIt->second.end() )
+        {
+            return pXvtStore->getXvt(sat, t);
+        }
+
+        const std::vector<Xvt>& nodes( satIt->second );
+
+        // Lagrange weights of the 4 equally spaced nodes
+        double w[numNodes];
+        w[0] = -(s - 1.0)*(s - 2.0)*(s - 3.0)/6.0;
+        w[1] =  s*(s - 2.0)*(s - 3.0)/2.0;
+        w[2] = -s*(s - 1.0)*(s - 3.0)/2.0;
+        w[3] =  s*(s - 1.0)*(s - 2.0)/6.0;
+
+        Xvt xvt;
+        xvt.frame = nodes[0].frame;
+
+        for(int k = 0; k < numNodes; ++k)
+        {
+            for(int i = 0; i < 3; ++i)
+            {
+                xvt.x[i] += w[k]*nodes[k].x[i];
+                xvt.v[i] += w[k]*nodes[k].v[i];
+            }
+            xvt.clkbias  += w[k]*nodes[k].clkbias;
+            xvt.clkdrift += w[k]*nodes[k].clkdrift;
+            xvt.relcorr  += w[k]*nodes[k].relcorr;
+        }
+
+        return xvt;
+
+    }  // End of method 'SatXvtCache::getXvt()'
+
+
+      // Dumps the cached epochs and the underlying store.
+    void SatXvtCache::dump(std::ostream& s, short detail) const
+    {
+        s << "Dump of SatXvtCache:" << endl;
+
+        for( EpochSatXvtMap::const_iterator it = m_Cache.begin();
+             it != m_Cache.end();
+             ++it )
+        {
+            s << " epoch " << it->first
+              << ", " << it->second.size() << " satellites" << endl;
+        }
+
+        if(pXvtStore != NULL)
+        {
+            pXvtStore->dump(s, detail);
+        }
+
+    }  // End of method 'SatXvtCache::dump()'
+
+
+      // Removes the cached epochs outside [tmin, tmax].
+    void SatXvtCache::edit( const CommonTime& tmin, const CommonTime& tmax )
+    {
+        m_Cache.erase( m_Cache.begin(), m_Cache.lower_bound(tmin) );
+        m_Cache.erase( m_Cache.upper_bound(tmax), m_Cache.end() );
+
+    }  // End of method 'SatXvtCache::edit()'
+
+
+      // Returns the time system of the underlying store.
+    TimeSystem SatXvtCache::getTimeSystem(void) const
+    {
+        if(pXvtStore == NULL) return TimeSystem::Unknown;
+
+        return pXvtStore->getTimeSystem();
+    }
+
+
+      // Returns the initial time of the underlying store.
+    CommonTime SatXvtCache::getInitialTime(void) const
+    {
+        if(pXvtStore == NULL)
+        {
+            InvalidRequest e("SatXvtCache: no XvtStore has been set.");
+            GPSTK_THROW(e);
+        }
+
+        return pXvtStore->getInitialTime();
+    }
+
+
+      // Returns the final time of the underlying store.
+    CommonTime SatXvtCache::getFinalTime(void) const
+    {
+        if(pXvtStore == NULL)
+        {
+            InvalidRequest e("SatXvtCache: no XvtStore has been set.");
+            GPSTK_THROW(e);
+        }
+
+        return pXvtStore->getFinalTime();
+    }
+
+
+      // Returns whether the underlying store has velocity data.
+    bool SatXvtCache::hasVelocity(void) const
+    {
+        return (pXvtStore != NULL) && pXvtStore->hasVelocity();
+    }
+
+
+      // Returns whether the satellite is present in the underlying store.
+    bool SatXvtCache::isPresent(const SatID& sat) const
+    {
+        return (pXvtStore != NULL) && pXvtStore->isPresent(sat);
+    }
+
+
+      /* Fills the cache for the epoch and satellites of gData.
+       *
+       * @param gData     Data object holding the data.
+       */
+    gnssSatTypeValue& SatXvtCache::Process(gnssSatTypeValue& gData)
+        throw(ProcessingException)
+    {
+        prepare( gData.header.epoch, gData.body.getSatID() );
+
+        return gData;
+
+    }  // End of method 'SatXvtCache::Process()'
+
+
+      /* Fills the cache for the epoch and satellites of gData.
+       *
+       * @param gData     Data object holding the data.
+       */
+    gnssRinex& SatXvtCache::Process(gnssRinex& gData)
+        throw(ProcessingException)
+    {
+        prepare( gData.header.epoch, gData.body.getSatID() );
+
+        return gData;
+
+    }  // End of method 'SatXvtCache::Process()'
+
+
+      /* Fills the cache for all the epochs and satellites of gData.
+       *
+       * @param gData     Data object holding the data.
+       */
+    gnssDataMap& SatXvtCache::Process(gnssDataMap& gData)
+        throw(ProcessingException)
+    {
+        clear();
+
+        for( gnssDataMap::iterator gdmIt = gData.begin();
+             gdmIt != gData.end();
+             ++gdmIt )
+        {
+            SatIDSet satSet;
+
+            for( sourceDataMap::iterator sdmIt = gdmIt->second.begin();
+                 sdmIt != gdmIt->second.end();
+                 ++sdmIt )
+            {
+                SatIDSet sats( sdmIt->second.getSatID() );
+                satSet.insert( sats.begin(), sats.end() );
+            }
+
+            addEpoch( gdmIt->first, satSet );
+        }
+
+        return gData;
+
+    }  // End of method 'SatXvtCache::Process()'
+
+
+}  // End of namespace gpstk
@@ -0,0 +1,243 @@
+#pragma ident "$Id: SatXvtCache.hpp $"
+
+/**
+ * @file SatXvtCache.hpp
+ * This is a class to cache the satellite position, velocity and clock of
+ * the current epoch, to be shared by all the stations.
+ */
+
+#ifndef GPSTK_SAT_XVT_CACHE_HPP
+#define GPSTK_SAT_XVT_CACHE_HPP
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+//============================================================================
+
+
+#include <map>
+#include <vector>
+#include "XvtStore.hpp"
+#include "ProcessingClass.hpp"
+
+
+namespace gpstk
+{
+
+      /** @addtogroup GPSsolutions */
+      //@{
+
+      /** This class caches the satellite position, velocity and clock of
+       *  the current epoch, so that all the stations of a network share
+       *  them instead of interpolating the ephemeris again and again.
+       *
+       * For every satellite of the epoch, the underlying XvtStore is
+       * evaluated once at 4 equally spaced times of an interval around the
+       * epoch ([epoch - 0.3 s, epoch] by default, which holds the transmit
+       * times of all the GNSS signals). Afterwards, 'getXvt()' evaluates the
+       * cubic polynomial through these values. Requests for other times, or
+       * for satellites that are not cached, are passed to the underlying
+       * store.
+       *
+       * As a SatXvtCache is an XvtStore itself, it may be given to any class
+       * taking an XvtStore<SatID> (BasicModel1, ComputeSatPCenter,
+       * ComputeWindUp, CorrectObservables, ...) instead of the ephemeris
+       * store. It is filled when processing the GNSS data structures, so it
+       * must be the first element of the processing chain:
+       *
+       * @code
+       *   SP3EphemerisStore sp3Store;
+       *   ...
+       *
+       *   SatXvtCache sp3Cache(sp3Store);
+       *
+       *   BasicModel1 basicModel;
+       *   basicModel.setSP3Store(sp3Cache);
+       *
+       *   ComputeWindUp windup;
+       *   windup.setEphStore(sp3Cache);
+       *
+       *   while( obsStreams.readEpochData(gData) )
+       *   {
+       *      gData >> sp3Cache >> basicModel >> windup;
+       *   }
+       * @endcode
+       *
+       * The cache is only changed by the 'Process()' and 'prepare()'
+       * methods; 'getXvt()' may be called from several threads at the same
+       * time.
+       */
+    class SatXvtCache : public XvtStore<SatID>, public ProcessingClass
+    {
+    public:
+
+        /// Default constructor.
+        SatXvtCache()
+            : pXvtStore(NULL), m_Before(0.3), m_After(0.0)
+        {};
+
+
+        /** Common constructor.
+         *
+         * @param xvtStore   XvtStore<SatID> object to be cached.
+         */
+        SatXvtCache(XvtStore<SatID>& xvtStore)
+            : pXvtStore(&xvtStore), m_Before(0.3), m_After(0.0)
+        {};
+
+
+        /// Returns a pointer to the XvtStore<SatID> object being cached.
+        virtual XvtStore<SatID>* getXvtStore() const
+        { return pXvtStore; };
+
+
+        /** Sets the XvtStore<SatID> object to be cached.
+         *
+         * @param xvtStore   XvtStore<SatID> object to be cached.
+         */
+        virtual SatXvtCache& setXvtStore(XvtStore<SatID>& xvtStore)
+        { pXvtStore = &xvtStore; clear(); return (*this); };
+
+
+        /** Sets the interval around each epoch covered by the cache.
+         *
+         * @param before     Seconds before the epoch, 0.3 by default.
+         * @param after      Seconds after the epoch, 0.0 by default.
+         */
+        virtual SatXvtCache& setInterval(double before, double after);
+
+
+        /** Fills the cache for the given epoch and satellites, replacing
+         *  the previous content.
+         *
+         * @param epoch      Epoch of the observations.
+         * @param satSet     Satellites to be cached.
+         */
+        virtual SatXvtCache& prepare( const CommonTime& epoch,
+                                      const SatIDSet& satSet );
+
+
+        /** Returns the position, velocity and clock offset of the given
+         *  satellite, out of the cache if possible.
+         *
+         * @param sat        Satellite.
+         * @param t          Time of interest.
+         */
+        virtual Xvt getXvt(const SatID& sat, const CommonTime& t) const;
+
+
+        /// Dumps the cached epochs and the underlying store.
+        virtual void dump(std::ostream& s = std::cout, short detail = 0) const;
+
+
+        /// Removes the cached epochs outside [tmin, tmax]. The underlying
+        /// store is not changed.
+        virtual void edit( const CommonTime& tmin,
+                           const CommonTime& tmax = CommonTime::END_OF_TIME );
+
+
+        /// Removes all the cached values. The underlying store is not
+        /// changed.
+        virtual void clear(void)
+        { m_Cache.clear(); };
+
+
+        /// Returns the time system of the underlying store.
+        virtual TimeSystem getTimeSystem(void) const;
+
+
+        /// Returns the initial time of the underlying store.
+        virtual CommonTime getInitialTime(void) const;
+
+
+        /// Returns the final time of the underlying store.
+        virtual CommonTime getFinalTime(void) const;
+
+
+        /// Returns whether the underlying store has velocity data.
+        virtual bool hasVelocity(void) const;
+
+
+        /// Returns whether the satellite is present in the underlying store.
+        virtual bool isPresent(const SatID& sat) const;
+
+
+        /** Fills the cache for the epoch and satellites of gData.
+         *
+         * @param gData     Data object holding the data.
+         */
+        virtual gnssSatTypeValue& Process(gnssSatTypeValue& gData)
+            throw(ProcessingException);
+
+
+        /** Fills the cache for the epoch and satellites of gData.
+         *
+         * @param gData     Data object holding the data.
+         */
+        virtual gnssRinex& Process(gnssRinex& gData)
+            throw(ProcessingException);
+
+
+        /** Fills the cache for all the epochs and satellites of gData.
+         *
+         * @param gData     Data object holding the data.
+         */
+        virtual gnssDataMap& Process(gnssDataMap& gData)
+            throw(ProcessingException);
+
+
+        /// Returns a string identifying this object.
+        virtual std::string getClassName(void) const;
+
+
+        /// Destructor
+        virtual ~SatXvtCache() {};
+
+
+    private:
+
+        /// Values at the 4 nodes of one satellite
+        typedef std::map<SatID, std::vector<Xvt> > SatXvtNodeMap;
+
+        /// Cached values, per epoch
+        typedef std::map<CommonTime, SatXvtNodeMap> EpochSatXvtMap;
+
+
+        /// Fills the cache for the given epoch, keeping the other epochs.
+        void addEpoch(const CommonTime& epoch, const SatIDSet& satSet);
+
+
+        /// Pointer to the XvtStore<SatID> object being cached
+        XvtStore<SatID>* pXvtStore;
+
+        /// Seconds before each epoch covered by the cache
+        double m_Before;
+
+        /// Seconds after each epoch covered by the cache
+        double m_After;
+
+        /// Cached values
+        EpochSatXvtMap m_Cache;
+
+    }; // End of class 'SatXvtCache'
+
+      //@}
+
+}  // End of namespace gpstk
+
+#endif   // GPSTK_SAT_XVT_CACHE_HPP
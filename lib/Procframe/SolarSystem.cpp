@@ -195,9 +195,13 @@ try {
 
    // EphemerisNumber != -1 means the header is complete
    EphemerisNumber = int(constants["DENUM"]);
+   cacheConstants();
 
    // clear the data arrays
    store.clear();
+   records.clear();
+   coeffOffset = -1;
+   clearCache();
 }
 catch(Exception& e) { GPSTK_RETHROW(e); }
 catch(exception& e) { Exception E("std except: "+string(e.what())); GPSTK_THROW(E); }
@@ -596,10 +600,15 @@ try {
    int iret;
 
    readBinaryHeader(filename);
-   iret = readBinaryData(false);    // false: don't store data in map
+   iret = readBinaryData(false);    // false: keep the data in records, not in map
+
+   // the data records are all in memory now
+   istrm.clear();
+   istrm.close();
+
    if(iret == 0) {
       // EphemerisNumber == -1 means the header has not been read
-      // EphemerisNumber ==  0 means the fileposMap has not been read (binary)
+      // EphemerisNumber ==  0 means the data records have not been read (binary)
       // EphemerisNumber == constants["DENUM"] means object has been initialized
       //                       (binary file), or header read (ASCII file)
       EphemerisNumber = int(constants["DENUM"]);
@@ -664,11 +673,11 @@ try {
 
    // special cases of Earth OR Moon, but not both:
    if((target == Earth && center != Moon) || (center == Earth && target != Moon)) {
-      Eratio = 1.0/(1.0 + constants["EMRAT"]);
+      Eratio = 1.0/(1.0 + constEMRAT);
       computeState(tt, MOON, PVMOON);
    }
    if((target == Moon && center != Earth) || (center == Moon && target != Earth)) {
-      Mratio = constants["EMRAT"]/(1.0 + constants["EMRAT"]);
+      Mratio = constEMRAT/(1.0 + constEMRAT);
       computeState(tt, EMBARY, PVEMBARY);
    }
 
@@ -693,8 +702,40 @@ try {
    for(i=0; i<6; i++) PV[i] = PVTARGET[i] - PVCENTER[i];
    
    if(!kilometers) {
-      double AU = constants["AU"];
-      for(i=0; i<6; i++) PV[i] /= AU;
+      for(i=0; i<6; i++) PV[i] /= constAU;
+   }
+
+   return 0;
+}
+catch(Exception& e) { GPSTK_RETHROW(e); }
+catch(exception& e) { Exception E("std except: "+string(e.what())); GPSTK_THROW(E); }
+catch(...) { Exception e("Unknown exception"); GPSTK_THROW(e); }
+}
+
+//------------------------------------------------------------------------------------
+// return 0 ok, or the same values as computeState()
+int SolarSystem::computeStates(double tt,
+                               const SolarSystem::Planet targets[],
+                               int ntarget,
+                               SolarSystem::Planet center,
+                               double PV[][6],
+                               bool kilometers) throw(Exception)
+{
+try {
+   int iret,i,j;
+
+   // initialize
+   for(i=0; i<ntarget; i++)
+      for(j=0; j<6; j++) PV[i][j] = 0.0;
+
+   // get the right record once; computeState() then finds it current, and
+   // takes the states of the center, the Moon and the E-M barycenter from the cache
+   iret = seekToJD(tt);
+   if(iret) return iret;
+
+   for(i=0; i<ntarget; i++) {
+      iret = computeState(tt, targets[i], center, PV[i], kilometers);
+      if(iret) return iret;
    }
 
    return 0;
@@ -874,13 +915,17 @@ try {
    if(denum == constants["DENUM"]) {
 
       // EphemerisNumber == -1 means the header has not been read
-      // EphemerisNumber ==  0 means the fileposMap has not been read (binary)
+      // EphemerisNumber ==  0 means the data records have not been read (binary)
       // EphemerisNumber == constants["DENUM"] means object has been initialized
       //                       (binary file), or header read (ASCII file)
       EphemerisNumber = 0;
+      cacheConstants();
 
       // clear the data arrays
       store.clear();
+      records.clear();
+      coeffOffset = -1;
+      clearCache();
    }
    else {
       LOG(WARNING) << "DENUM (" << denum << ") does not equal the array value ("
@@ -901,26 +946,23 @@ try {
    // has the header been read?
    if(EphemerisNumber == -1) return -4;
 
-   // read the data, optionally storing it all; fill the file position map
+   // read the data, storing it all either in store or in records
    int iret=-1,nrec=1;
    double prev=0.0;
    vector<double> data_vector;
+   records.clear();
+   coeffOffset = -1;
+   clearCache();
    while(!istrm.eof() && istrm.good()) {
-      long filepos = istrm.tellg();
       iret = readBinaryRecord(data_vector);
       if(iret == -2) { iret = 0; break; }       // EOF
       if(iret) break;
 
-      // if saving all in store, add it here
+      // if saving all in store, add it here; else keep it for computeState()
       if(save)
          store[data_vector[0]] = data_vector;
-
-      // put the first record in coefficients array
-      if(nrec == 1)
-         coefficients = data_vector;
-
-      // build the positions map
-      fileposMap[data_vector[0]] = filepos;
+      else
+         records.insert(records.end(), data_vector.begin(), data_vector.end());
 
       if(nrec > 1 && data_vector[0] != prev) {
          ostringstream oss;
@@ -939,6 +981,10 @@ try {
 
    istrm.clear();
 
+   // the first record is the current one
+   if(!records.empty())
+      coeffOffset = 0;
+
    return iret;
 }
 catch(Exception& e) { GPSTK_RETHROW(e); }
@@ -976,6 +1022,17 @@ catch(exception& e) { Exception E("std except: "+string(e.what())); GPSTK_THROW(
 catch(...) { Exception e("Unknown exception"); GPSTK_THROW(e); }
 }
 
+//------------------------------------------------------------------------------------
+// private
+void SolarSystem::cacheConstants(void) throw()
+{
+   map<string,double>::const_iterator it;
+   it = constants.find("AU");
+   constAU = (it == constants.end() ? 0.0 : it->second);
+   it = constants.find("EMRAT");
+   constEMRAT = (it == constants.end() ? 0.0 : it->second);
+}
+
 //------------------------------------------------------------------------------------
 // private
 // return 0 ok, or
@@ -987,27 +1044,28 @@ catch(...) { Exception e("Unknown exception"); GPSTK_THROW(e); }
 int SolarSystem::seekToJD(double JD) throw(Exception)
 {
 try {
-   if(!istrm) return -3;
-   if(istrm.eof() || !istrm.good()) return -3;
-   if(EphemerisNumber != int(constants["DENUM"])) return -4;
-
-   if(coefficients[0] <= JD && JD <= coefficients[1]) return 0;
+   if(records.empty() || coeffOffset < 0) return -3;
+   if(EphemerisNumber <= 0) return -4;
 
-   map<double,long>::const_iterator it; // key >= input
-   it = fileposMap.lower_bound(JD); // it points to first element with JD <= time
+   if(records[coeffOffset] <= JD && JD <= records[coeffOffset+1]) return 0;
 
-   if(it == fileposMap.begin() && JD < it->first)
+   if(JD < records[0])
       return -1;                    // failure: JD is before the first record
 
-   if(it == fileposMap.end()        // if beyond the found record, go to previous;
-         || JD < it->first) it--;   // but beware the "lower_bound found the =" case
+   // the records are contiguous, and normally each covers 'interval' days;
+   // find the last record that begins at or before JD
+   long nrec = records.size()/Ncoeff;
+   long k(0);
+   if(interval > 0.0) {
+      double d = (JD - records[0])/interval;
+      k = (d < double(nrec) ? long(d) : nrec-1);
+   }
+   while(k > 0 && JD < records[k*Ncoeff]) k--;
+   while(k < nrec-1 && JD >= records[(k+1)*Ncoeff]) k++;
 
-   istrm.seekg(it->second,ios_base::beg);         // get the record
-   int iret = readBinaryRecord(coefficients);
-   if(iret == -2) iret = -3;        // this means EOF during data read
-   if(iret) return iret;            // reading failed
+   coeffOffset = k*Ncoeff;
 
-   if(JD > coefficients[1])
+   if(JD > records[coeffOffset+1])
       return -2;                    // failure: JD is after the last record, or
                                     // JD is in a gap between records
    return 0;
@@ -1029,6 +1087,18 @@ try {
    for(i=0; i<6; i++) PV[i]=0.0;
    if(which == NONE) return;
 
+   // states already computed at this time
+   if(tt != cacheJD) {
+      clearCache();
+      cacheJD = tt;
+   }
+   if(stateCached[which]) {
+      for(i=0; i<6; i++) PV[i] = stateCache[which][i];
+      return;
+   }
+
+   const double *coefficients = &records[coeffOffset];
+
    double T,Tbeg,Tspan,Tspan0;
    Tbeg = coefficients[0];
    Tspan0 = Tspan = coefficients[1] - coefficients[0];
@@ -1051,20 +1121,26 @@ try {
    T = 2.0*(tt-Tbeg)/Tspan - 1.0;
 
    // interpolate
+   const long MAXN=64;
    long N=c_ncoeff[which];
-   vector<double> C(N,0.0);     // Chebyshev
-   vector<double> U(N,0.0);     // derivative of Chebyshev
-   for(i=0; i<ncomp; i++) {     // loop over components
+   if(N < 2 || N > MAXN) {
+      Exception e("Invalid number of Chebyshev coefficients "+asString(N));
+      GPSTK_THROW(e);
+   }
+   double C[MAXN];              // Chebyshev
+   double U[MAXN];              // derivative of Chebyshev
 
-      // seed the Chebyshev recursions
-      C[0] = 1; C[1] = T; //C[2] = 2*T*T-1;
-      U[0] = 0; U[1] = 1; //U[2] = 4*T;
+   // seed the Chebyshev recursions
+   C[0] = 1; C[1] = T; //C[2] = 2*T*T-1;
+   U[0] = 0; U[1] = 1; //U[2] = 4*T;
 
-      // generate the Chebyshevs
-      for(j=2; j<N; j++) {
-         C[j] = 2*T*C[j-1] - C[j-2];
-         U[j] = 2*T*U[j-1] + 2*C[j-1] - U[j-2];
-      }
+   // generate the Chebyshevs, the same for all components
+   for(j=2; j<N; j++) {
+      C[j] = 2*T*C[j-1] - C[j-2];
+      U[j] = 2*T*U[j-1] + 2*C[j-1] - U[j-2];
+   }
+
+   for(i=0; i<ncomp; i++) {     // loop over components
 
       // compute P and V
       // done above PV[i] = PV[i+3] = 0.0;
@@ -1076,6 +1152,9 @@ try {
       // convert velocity to 'per day'
       PV[i+ncomp] *= 2*double(c_nsets[which])/Tspan0;
    }
+
+   for(i=0; i<6; i++) stateCache[which][i] = PV[i];
+   stateCached[which] = true;
 }
 catch(Exception& e) { GPSTK_RETHROW(e); }
 catch(exception& e) { Exception E("std except: "+string(e.what())); GPSTK_THROW(E); }
@@ -89,6 +89,11 @@ namespace gpstk {
 /// instantiates a SolarSystem object, calls initializeWithBinaryFile(file) once,
 /// passing it the name of the binary file, then calling computeState() any number
 /// of times, passing it the time and Planet of interest.
+/// initializeWithBinaryFile() keeps all the data records of the file in memory,
+/// so that computeState() finds the record of a time without reading the file;
+/// the states of the bodies computed at the last time are kept as well, so that
+/// the several force models evaluated at the same time compute them only once.
+/// computeStates() returns the states of several bodies at once.
 class SolarSystem{
 public:
    /// These are indexes used by the caller of computeState().
@@ -114,7 +119,10 @@ public:
 
    /// Constructor. Set EphemerisNumber to -1 to indicate that nothing has been
    /// read yet.
-   SolarSystem(void) throw() : EphemerisNumber(-1) {};
+   SolarSystem(void) throw()
+      : EphemerisNumber(-1), constAU(0.0), constEMRAT(0.0),
+        coeffOffset(-1), cacheJD(-1.0)
+   { clearCache(); }
 
    /// Read the header from a JPL ASCII planetary ephemeris file. Note that this
    /// routine clears the 'store' map and defines the 'constants' hash. It also
@@ -231,6 +239,29 @@ public:
                     bool kilometers = true)
    throw(gpstk::Exception);
 
+   /// Compute position and velocity of several 'target' bodies, relative to the
+   /// same 'center' body, at the given time. This is the same as calling
+   /// computeState() for each target, but the data record is found, and the
+   /// states of the center, the Earth-Moon barycenter and the Moon are computed,
+   /// only once.
+   /// @param tt      Time (Julian Date) of interest.
+   /// @param targets Array of the bodies for which position and velocity are to
+   ///                   be computed.
+   /// @param ntarget Number of bodies in targets.
+   /// @param center  Body relative to which the results apply, see computeState().
+   /// @param PV      Array of ntarget double arrays of length 6; PV[i] contains the
+   ///                   result of targets[i], see computeState().
+   /// @param km      boolean: if true (default), units are km, km/day; else AU,
+   ///                   AU/day.
+   /// @return 0 success, or the same values as computeState().
+   int computeStates(double tt,
+                     const Planet targets[],
+                     int ntarget,
+                     Planet center,
+                     double PV[][6],
+                     bool kilometers = true)
+   throw(gpstk::Exception);
+
    /// Return the value of 1 AU (Astronomical Unit) in km. If the file header has not
    /// been read, return -1.0.
    /// @return the value of 1 AU in km;
@@ -304,6 +335,13 @@ private:
    ///        -3 input stream is not open or not valid
    int readBinaryRecord(std::vector<double>& data_vector) throw(gpstk::Exception);
 
+   /// Cache the constants used by computeState() after the header has been read.
+   void cacheConstants(void) throw();
+
+   /// Forget the states computed at the last time.
+   void clearCache(void) throw()
+   { for(int i=0; i<13; i++) stateCached[i] = false; cacheJD = -1.0; }
+
    /// These are indexes used in the actual computation, and correspond to indexes
    /// in the ephemeris file; for example computation for the SUN is done using
    /// c_offset[SUN], c_ncoeff[SUN] and c_nsets[SUN].
@@ -339,6 +377,7 @@ private:
 
    /// Compute position and velocity of given body at given time, using the current
    /// coefficient array. NB caller MUST call seekToJD(time) BEFORE calling this.
+   /// The states computed at the last time are returned from the cache.
    /// On successful return, PV[0-2] contains the three position components, in km,
    /// and PV[3-5] the velocity components in km/day (for regular bodies), relative
    /// to the solar system barycenter, except for the moon, which is relative to
@@ -373,6 +412,8 @@ private:
    int c_offset[13];     ///< starting index in the coefficients array for each planet
    int c_ncoeff[13];     ///< number of coefficients per component for each planet
    int c_nsets[13];      ///< number of sets of coefficients for each planet
+   double constAU;       ///< constants["AU"], km
+   double constEMRAT;    ///< constants["EMRAT"], Earth-Moon mass ratio
 
    /// Hash of labels and values of constants read from the header.
    /// This is taken directly from the JPL documentation:
@@ -408,14 +449,24 @@ private:
    /// for the purpose of reading/writing files, NOT for ephemeris computation.
    std::map<double, std::vector<double> > store;
 
-   /// Hash of start times (JD) and file positions. This object is filled by
-   /// readBinaryData(), which is called by initializeWithBinaryFile(), and is
-   /// used by seekToJD() to read records in random order.
-   std::map<double, long> fileposMap;
-
-   /// One complete data record (Ncoeff doubles) consisting of times and coefficients.
-   /// seekToJD() stores the current record here, and computeState() makes use of it.
-   std::vector<double> coefficients;
+   /// All the data records (Ncoeff doubles each, consisting of times and
+   /// coefficients), in time order. This object is filled by readBinaryData(),
+   /// which is called by initializeWithBinaryFile(), and is used by seekToJD()
+   /// to find the record of a time without reading the file.
+   std::vector<double> records;
+
+   /// Index in records of the current data record (Ncoeff doubles consisting of
+   /// times and coefficients), -1 if none. seekToJD() sets it, and computeState()
+   /// makes use of the record. An index rather than a pointer, so that copies of
+   /// this object use their own records.
+   long coeffOffset;
+
+   /// Time (Julian Date) of the states in stateCache, -1 if none
+   double cacheJD;
+   /// States computed at cacheJD, by computeID
+   double stateCache[13][6];
+   /// stateCache[i] is valid
+   bool stateCached[13];
 
 }; // end class SolarSystem
 
@@ -61,9 +61,6 @@ namespace gpstk
       throw(InvalidRequest)
    {
 
-         // We will store here the results
-      Triple res;
-
          // Objects to compute Sun and Moon positions
       SunPosition  sunPosition;
       MoonPosition moonPosition;
@@ -76,77 +73,100 @@ namespace gpstk
          Triple sunPos(sunPosition.getPosition(t));
          Triple moonPos(moonPosition.getPosition(t));
 
+         return getSolidTide(p, sunPos, moonPos);
+
+      } // End of try block
+      catch(InvalidRequest& ir)
+      {
+         GPSTK_RETHROW(ir);
+      }
+
+   } // End SolidTides::getSolidTide
+
+
+      /* Returns the effect of solid Earth tides (meters) at the given
+       * position, for the given Sun and Moon positions, in the
+       * Up-East-North (UEN) reference frame.
+       *
+       * @param[in] p       Position of interest
+       * @param[in] sunPos  Sun position (ECEF), in meters
+       * @param[in] moonPos Moon position (ECEF), in meters
+       *
+       * @return a Triple with the solid tidal effect, in meters and in
+       * the UEN reference frame.
+       */
+   Triple SolidTides::getSolidTide(const Position& p,
+                                   const Triple& sunPos,
+                                   const Triple& moonPos) const
+   {
 
-            // Compute the factors for the Sun
-         double rpRs( p.X()*sunPos.theArray[0] + 
-                      p.Y()*sunPos.theArray[1] + 
-                      p.Z()*sunPos.theArray[2]);
+         // We will store here the results
+      Triple res;
 
-         double Rs2(sunPos.theArray[0]*sunPos.theArray[0] +
-                    sunPos.theArray[1]*sunPos.theArray[1] +
-                    sunPos.theArray[2]*sunPos.theArray[2]);
+         // Compute the factors for the Sun
+      double rpRs( p.X()*sunPos.theArray[0] + 
+                   p.Y()*sunPos.theArray[1] + 
+                   p.Z()*sunPos.theArray[2]);
 
-         double rp2( p.X()*p.X() + p.Y()*p.Y() + p.Z()*p.Z() );
+      double Rs2(sunPos.theArray[0]*sunPos.theArray[0] +
+                 sunPos.theArray[1]*sunPos.theArray[1] +
+                 sunPos.theArray[2]*sunPos.theArray[2]);
 
-         double xy2p( p.X()*p.X() + p.Y()*p.Y() );
-         double sqxy2p( std::sqrt(xy2p) );
+      double rp2( p.X()*p.X() + p.Y()*p.Y() + p.Z()*p.Z() );
 
-         double sqRs2(std::sqrt(Rs2));
+      double xy2p( p.X()*p.X() + p.Y()*p.Y() );
+      double sqxy2p( std::sqrt(xy2p) );
 
-         double fac_s( 3.0*MU_SUN*rp2/(sqRs2*sqRs2*sqRs2*sqRs2*sqRs2) );
+      double sqRs2(std::sqrt(Rs2));
 
-         double g1sun( fac_s*(rpRs*rpRs/2.0 - rp2*Rs2/6.0) );
+      double fac_s( 3.0*MU_SUN*rp2/(sqRs2*sqRs2*sqRs2*sqRs2*sqRs2) );
 
-         double g2sun( fac_s * rpRs * (sunPos.theArray[1]*p.X() -
-                       sunPos.theArray[0]*p.Y()) * std::sqrt(rp2)/sqxy2p );
+      double g1sun( fac_s*(rpRs*rpRs/2.0 - rp2*Rs2/6.0) );
 
-         double g3sun( fac_s * rpRs * ( sqxy2p* sunPos.theArray[2] -
-                       p.Z()/sqxy2p * (p.X()*sunPos.theArray[0] +
-                       p.Y()*sunPos.theArray[1]) ) );
+      double g2sun( fac_s * rpRs * (sunPos.theArray[1]*p.X() -
+                    sunPos.theArray[0]*p.Y()) * std::sqrt(rp2)/sqxy2p );
 
+      double g3sun( fac_s * rpRs * ( sqxy2p* sunPos.theArray[2] -
+                    p.Z()/sqxy2p * (p.X()*sunPos.theArray[0] +
+                    p.Y()*sunPos.theArray[1]) ) );
 
-            // Compute the factors for the Moon
-         double rpRm( p.X()*moonPos.theArray[0] + 
-                      p.Y()*moonPos.theArray[1] + 
-                      p.Z()*moonPos.theArray[2]);
 
-         double Rm2(moonPos.theArray[0]*moonPos.theArray[0] +
-                    moonPos.theArray[1]*moonPos.theArray[1] +
-                    moonPos.theArray[2]*moonPos.theArray[2]);
+         // Compute the factors for the Moon
+      double rpRm( p.X()*moonPos.theArray[0] + 
+                   p.Y()*moonPos.theArray[1] + 
+                   p.Z()*moonPos.theArray[2]);
 
-         double sqRm2(std::sqrt(Rm2));
+      double Rm2(moonPos.theArray[0]*moonPos.theArray[0] +
+                 moonPos.theArray[1]*moonPos.theArray[1] +
+                 moonPos.theArray[2]*moonPos.theArray[2]);
 
-         double fac_m( 3.0*MU_MOON*rp2/(sqRm2*sqRm2*sqRm2*sqRm2*sqRm2) );
+      double sqRm2(std::sqrt(Rm2));
 
-         double g1moon( fac_m*(rpRm*rpRm/2.0 - rp2*Rm2/6.0) );
+      double fac_m( 3.0*MU_MOON*rp2/(sqRm2*sqRm2*sqRm2*sqRm2*sqRm2) );
 
-         double g2moon( fac_m * rpRm * (moonPos.theArray[1]*p.X() -
-                        moonPos.theArray[0]*p.Y()) * std::sqrt(rp2)/sqxy2p );
+      double g1moon( fac_m*(rpRm*rpRm/2.0 - rp2*Rm2/6.0) );
 
-         double g3moon( fac_m * rpRm * ( sqxy2p* moonPos.theArray[2] -
-                        p.Z()/sqxy2p * (p.X()*moonPos.theArray[0] +
-                        p.Y()*moonPos.theArray[1]) ) );
+      double g2moon( fac_m * rpRm * (moonPos.theArray[1]*p.X() -
+                     moonPos.theArray[0]*p.Y()) * std::sqrt(rp2)/sqxy2p );
 
-            // Effects due to the Sun
-         double delta_sun1(H_LOVE*g1sun);
-         double delta_sun2(L_LOVE*g2sun);
-         double delta_sun3(L_LOVE*g3sun);
+      double g3moon( fac_m * rpRm * ( sqxy2p* moonPos.theArray[2] -
+                     p.Z()/sqxy2p * (p.X()*moonPos.theArray[0] +
+                     p.Y()*moonPos.theArray[1]) ) );
 
-            // Effects due to the Moon
-         double delta_moon1(H_LOVE*g1moon);
-         double delta_moon2(L_LOVE*g2moon);
-         double delta_moon3(L_LOVE*g3moon);
+         // Effects due to the Sun
+      double delta_sun1(H_LOVE*g1sun);
+      double delta_sun2(L_LOVE*g2sun);
+      double delta_sun3(L_LOVE*g3sun);
 
-            // Combined effect
-         res.theArray[0] = delta_sun1 + delta_moon1;
-         res.theArray[1] = delta_sun2 + delta_moon2;
-         res.theArray[2] = delta_sun3 + delta_moon3;
+         // Effects due to the Moon
+      double delta_moon1(H_LOVE*g1moon);
+      double delta_moon2(L_LOVE*g2moon);
+      double delta_moon3(L_LOVE*g3moon);
 
-      } // End of try block
-      catch(InvalidRequest& ir)
-      {
-         GPSTK_RETHROW(ir);
-      }
+         // Combined effect
+      res.theArray[0] = delta_sun1 + delta_moon1;
+      res.theArray[1] = delta_sun2 + delta_moon2;
+      res.theArray[2] = delta_sun3 + delta_moon3;
 
       return res;
 
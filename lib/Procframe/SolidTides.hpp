@@ -89,6 +89,22 @@ namespace gpstk
             throw(InvalidRequest);
 
 
+         /** Returns the effect of solid Earth tides (meters) at the given
+          * position, for the given Sun and Moon positions, in the
+          * Up-East-North (UEN) reference frame.
+          *
+          * @param[in] p       Position of interest
+          * @param[in] sunPos  Sun position (ECEF), in meters
+          * @param[in] moonPos Moon position (ECEF), in meters
+          *
+          * @return a Triple with the solid tidal effect, in meters and in
+          * the UEN reference frame.
+          */
+         Triple getSolidTide(const Position& p,
+                             const Triple& sunPos,
+                             const Triple& moonPos) const;
+
+
    private:
 
          /// Love numbers
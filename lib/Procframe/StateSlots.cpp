@@ -0,0 +1,370 @@
+#pragma ident "$Id: StateSlots.cpp $"
+
+/**
+ * @file StateSlots.cpp
+ * This is a class to keep the state vector and covariance matrix of a
+ * network filter in persistent slots, so that stations and satellites may
+ * come and go without repacking them.
+ */
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+//============================================================================
+
+
+#include "StateSlots.hpp"
+#include <algorithm>
+
+using namespace std;
+
+namespace gpstk
+{
+
+      // Returns the first slot of the block of a station, or -1 if it has
+      // none.
+    int StateSlots::getSlot(const SourceID& source) const
+    {
+        std::map<SourceID, Block>::const_iterator it(
+                                            m_SourceBlocks.find(source) );
+
+        return ( it != m_SourceBlocks.end() ) ? it->second.first : -1;
+
+    }  // End of method 'StateSlots::getSlot()'
+
+
+      // Returns the first slot of the block of a satellite, or -1 if it
+      // has none.
+    int StateSlots::getSlot(const SatID& sat) const
+    {
+        std::map<SatID, Block>::const_iterator it( m_SatBlocks.find(sat) );
+
+        return ( it != m_SatBlocks.end() ) ? it->second.first : -1;
+
+    }  // End of method 'StateSlots::getSlot()'
+
+
+      /* Adds a block of parameters for a station, whose state and
+       * covariance are zero; a station already added keeps its block.
+       *
+       * @param source     Station.
+       * @param size       Number of parameters of the block.
+       *
+       * @return the first slot of the block.
+       */
+    int StateSlots::addSource(const SourceID& source, int size)
+    {
+        int first( getSlot(source) );
+        if( first >= 0 ) return first;
+
+        first = allocate(size);
+
+        m_SourceBlocks[source] = Block(first, size);
+
+        return first;
+
+    }  // End of method 'StateSlots::addSource()'
+
+
+      /* Adds a block of parameters for a satellite, whose state and
+       * covariance are zero; a satellite already added keeps its block.
+       *
+       * @param sat        Satellite.
+       * @param size       Number of parameters of the block.
+       *
+       * @return the first slot of the block.
+       */
+    int StateSlots::addSat(const SatID& sat, int size)
+    {
+        int first( getSlot(sat) );
+        if( first >= 0 ) return first;
+
+        first = allocate(size);
+
+        m_SatBlocks[sat] = Block(first, size);
+
+        return first;
+
+    }  // End of method 'StateSlots::addSat()'
+
+
+      // Removes the block of a station, if it has one.
+    void StateSlots::removeSource(const SourceID& source)
+    {
+        std::map<SourceID, Block>::iterator it( m_SourceBlocks.find(source) );
+        if( it == m_SourceBlocks.end() ) return;
+
+        release(it->second);
+
+        m_SourceBlocks.erase(it);
+
+    }  // End of method 'StateSlots::removeSource()'
+
+
+      // Removes the block of a satellite, if it has one.
+    void StateSlots::removeSat(const SatID& sat)
+    {
+        std::map<SatID, Block>::iterator it( m_SatBlocks.find(sat) );
+        if( it == m_SatBlocks.end() ) return;
+
+        release(it->second);
+
+        m_SatBlocks.erase(it);
+
+    }  // End of method 'StateSlots::removeSat()'
+
+
+      /* Removes the blocks of the stations and satellites not in the sets,
+       * and compacts the blocks if more than half of the slots are then
+       * free.
+       *
+       * @param sourceSet  Stations to keep.
+       * @param satSet     Satellites to keep.
+       */
+    void StateSlots::keepOnly( const SourceIDSet& sourceSet,
+                               const SatIDSet& satSet )
+    {
+        std::map<SourceID, Block>::iterator itSource( m_SourceBlocks.begin() );
+        while( itSource != m_SourceBlocks.end() )
+        {
+            if( sourceSet.find(itSource->first) == sourceSet.end() )
+            {
+                release(itSource->second);
+                m_SourceBlocks.erase(itSource++);
+            }
+            else
+            {
+                ++itSource;
+            }
+        }
+
+        std::map<SatID, Block>::iterator itSat( m_SatBlocks.begin() );
+        while( itSat != m_SatBlocks.end() )
+        {
+            if( satSet.find(itSat->first) == satSet.end() )
+            {
+                release(itSat->second);
+                m_SatBlocks.erase(itSat++);
+            }
+            else
+            {
+                ++itSat;
+            }
+        }
+
+        if( 2*getNumLive() < size() )
+        {
+            compact();
+        }
+
+    }  // End of method 'StateSlots::keepOnly()'
+
+
+      /* Moves the blocks to the front, sources first and then satellites,
+       * in their order, leaving spare slots for a quarter of them at the
+       * end.
+       */
+    void StateSlots::compact()
+    {
+        int numLive( getNumLive() );
+
+        relayout( numLive + numLive/4 );
+
+    }  // End of method 'StateSlots::compact()'
+
+
+      // Returns the slots of the blocks, in increasing order.
+    std::vector<int> StateSlots::getLiveSlots() const
+    {
+        std::vector<int> slots;
+        slots.reserve( getNumLive() );
+
+        for( std::map<SourceID, Block>::const_iterator it =
+                                                    m_SourceBlocks.begin();
+             it != m_SourceBlocks.end();
+             ++it )
+        {
+            for(int k=0; k<it->second.size; ++k)
+            {
+                slots.push_back( it->second.first + k );
+            }
+        }
+
+        for( std::map<SatID, Block>::const_iterator it = m_SatBlocks.begin();
+             it != m_SatBlocks.end();
+             ++it )
+        {
+            for(int k=0; k<it->second.size; ++k)
+            {
+                slots.push_back( it->second.first + k );
+            }
+        }
+
+        std::sort( slots.begin(), slots.end() );
+
+        return slots;
+
+    }  // End of method 'StateSlots::getLiveSlots()'
+
+
+      // Removes all the blocks.
+    void StateSlots::clear()
+    {
+        m_SourceBlocks.clear();
+        m_SatBlocks.clear();
+        m_FreeBlocks.clear();
+
+        m_Used = 0;
+        m_NumFree = 0;
+
+        m_State.resize(0);
+        m_Covar.resize(0, 0);
+
+    }  // End of method 'StateSlots::clear()'
+
+
+      // Takes a free block of 'size' slots, growing if needed. Its state
+      // and covariance are zero.
+    int StateSlots::allocate(int size)
+    {
+            // A tombstoned block of the same size
+        std::map<int, std::vector<int> >::iterator it( m_FreeBlocks.find(size) );
+        if( it != m_FreeBlocks.end() && !it->second.empty() )
+        {
+            int first( it->second.back() );
+            it->second.pop_back();
+
+            m_NumFree -= size;
+
+            return first;
+        }
+
+            // Spare slots at the end, after growing with spare slots for a
+            // quarter of the blocks if there are not enough
+        if( m_Used + size > this->size() )
+        {
+            int numLive( getNumLive() + size );
+
+            relayout( numLive + numLive/4 );
+        }
+
+        int first( m_Used );
+
+        m_Used += size;
+
+        return first;
+
+    }  // End of method 'StateSlots::allocate()'
+
+
+      // Tombstones a block and puts it in the free list.
+    void StateSlots::release(const Block& block)
+    {
+        const int n( size() );
+
+        for(int k=block.first; k<block.first+block.size; ++k)
+        {
+            m_State(k) = 0.0;
+
+            for(int i=0; i<n; ++i)
+            {
+                m_Covar(i,k) = 0.0;
+                m_Covar(k,i) = 0.0;
+            }
+        }
+
+        m_FreeBlocks[block.size].push_back(block.first);
+
+        m_NumFree += block.size;
+
+    }  // End of method 'StateSlots::release()'
+
+
+      // Lays the blocks out again, with 'capacity' slots: sources first and
+      // then satellites, in their order, with no free blocks.
+    void StateSlots::relayout(int capacity)
+    {
+            // Old first slots and new first slots of the blocks
+        std::vector<int> oldSlot;
+        std::vector<int> newSlot;
+        std::vector<int> blockSize;
+
+        int used(0);
+
+        for( std::map<SourceID, Block>::iterator it = m_SourceBlocks.begin();
+             it != m_SourceBlocks.end();
+             ++it )
+        {
+            oldSlot.push_back(it->second.first);
+            newSlot.push_back(used);
+            blockSize.push_back(it->second.size);
+
+            it->second.first = used;
+            used += it->second.size;
+        }
+
+        for( std::map<SatID, Block>::iterator it = m_SatBlocks.begin();
+             it != m_SatBlocks.end();
+             ++it )
+        {
+            oldSlot.push_back(it->second.first);
+            newSlot.push_back(used);
+            blockSize.push_back(it->second.size);
+
+            it->second.first = used;
+            used += it->second.size;
+        }
+
+        if( capacity < used ) capacity = used;
+
+            // Old index of each new slot, -1 for the spare ones
+        std::vector<int> oldIndex(capacity, -1);
+        for(size_t b=0; b<oldSlot.size(); ++b)
+        {
+            for(int k=0; k<blockSize[b]; ++k)
+            {
+                oldIndex[ newSlot[b]+k ] = oldSlot[b] + k;
+            }
+        }
+
+        Vector<double> state(capacity, 0.0);
+        Matrix<double> covar(capacity, capacity, 0.0);
+
+        for(int j=0; j<used; ++j)
+        {
+            const int oldJ( oldIndex[j] );
+
+            state(j) = m_State(oldJ);
+
+            for(int i=0; i<used; ++i)
+            {
+                covar(i,j) = m_Covar( oldIndex[i], oldJ );
+            }
+        }
+
+        m_State.swap(state);
+        m_Covar.swap(covar);
+
+        m_FreeBlocks.clear();
+        m_NumFree = 0;
+        m_Used = used;
+
+    }  // End of method 'StateSlots::relayout()'
+
+
+}  // End of namespace gpstk
@@ -0,0 +1,248 @@
+#pragma ident "$Id: StateSlots.hpp $"
+
+/**
+ * @file StateSlots.hpp
+ * This is a class to keep the state vector and covariance matrix of a
+ * network filter in persistent slots, so that stations and satellites may
+ * come and go without repacking them.
+ */
+
+#ifndef GPSTK_STATE_SLOTS_HPP
+#define GPSTK_STATE_SLOTS_HPP
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+//============================================================================
+
+
+#include <map>
+#include <vector>
+#include "DataStructures.hpp"
+#include "Vector.hpp"
+#include "Matrix.hpp"
+
+
+namespace gpstk
+{
+
+      /** @addtogroup GPSsolutions */
+      //@{
+
+      /** This class keeps the state vector and covariance matrix of a
+       *  network filter, whose parameters are blocks of a station (e.g.
+       *  clock and troposphere) or of a satellite (e.g. orbit and clock),
+       *  in persistent slots.
+       *
+       * A station or satellite added takes a block of consecutive slots,
+       * which it keeps until it is removed: the parameters of the others do
+       * not move. A block removed is tombstoned (its state and its rows
+       * and columns of the covariance are set to zero) and put in a free
+       * list, from which the next block of the same size is taken. So a
+       * satellite rising or setting costs O(n), instead of the O(n^2)
+       * reallocation and copy of repacking the covariance matrix.
+       *
+       * The state and the covariance are size() long, tombstones and
+       * spare slots included. As their rows and columns are zero, the
+       * filter equations may run over all of them and leave them at zero;
+       * only the process noise must not be added to them. The O(n^2) loops
+       * had better run over getLiveSlots() only, though. When more than
+       * half of the slots are free, the blocks are compacted (sources
+       * first, then satellites, as the filters usually lay them out), which
+       * is the only O(n^2) operation besides growing.
+       *
+       * @code
+       *   StateSlots slots;
+       *
+       *   while( ... )
+       *   {
+       *      slots.keepOnly( gData.getSourceIDSet(), gData.getSatIDSet() );
+       *
+       *      for( each source in gData )
+       *      {
+       *         if( slots.getSlot(source) < 0 )
+       *         {
+       *            int id( slots.addSource(source, 2) );
+       *            slots.getCovarMatrix()(id,id) = 1e4;
+       *            ...
+       *         }
+       *      }
+       *
+       *      Vector<double>& state( slots.getStateVector() );
+       *      Matrix<double>& covar( slots.getCovarMatrix() );
+       *      std::vector<int> live( slots.getLiveSlots() );
+       *      ...
+       *   }
+       * @endcode
+       *
+       * @warning Adding a block or compacting may reallocate the state and
+       * the covariance, and move the blocks: get them, and the slots, again
+       * afterwards.
+       */
+    class StateSlots
+    {
+    public:
+
+        /// Default constructor.
+        StateSlots()
+            : m_Used(0), m_NumFree(0)
+        {};
+
+
+        /// Returns the first slot of the block of a station, or -1 if it
+        /// has none.
+        int getSlot(const SourceID& source) const;
+
+
+        /// Returns the first slot of the block of a satellite, or -1 if it
+        /// has none.
+        int getSlot(const SatID& sat) const;
+
+
+        /** Adds a block of parameters for a station, whose state and
+         *  covariance are zero; a station already added keeps its block.
+         *
+         * @param source     Station.
+         * @param size       Number of parameters of the block.
+         *
+         * @return the first slot of the block.
+         */
+        virtual int addSource(const SourceID& source, int size);
+
+
+        /** Adds a block of parameters for a satellite, whose state and
+         *  covariance are zero; a satellite already added keeps its block.
+         *
+         * @param sat        Satellite.
+         * @param size       Number of parameters of the block.
+         *
+         * @return the first slot of the block.
+         */
+        virtual int addSat(const SatID& sat, int size);
+
+
+        /// Removes the block of a station, if it has one.
+        virtual void removeSource(const SourceID& source);
+
+
+        /// Removes the block of a satellite, if it has one.
+        virtual void removeSat(const SatID& sat);
+
+
+        /** Removes the blocks of the stations and satellites not in the
+         *  sets, and compacts the blocks if more than half of the slots are
+         *  then free.
+         *
+         * @param sourceSet  Stations to keep.
+         * @param satSet     Satellites to keep.
+         */
+        virtual void keepOnly( const SourceIDSet& sourceSet,
+                               const SatIDSet& satSet );
+
+
+        /** Moves the blocks to the front, sources first and then
+         *  satellites, in their order, leaving spare slots for a quarter
+         *  of them at the end.
+         */
+        virtual void compact();
+
+
+        /// Returns the number of slots, i.e. the size of the state vector
+        /// and covariance matrix.
+        int size() const
+        { return m_State.size(); };
+
+
+        /// Returns the number of slots of the blocks.
+        int getNumLive() const
+        { return m_Used - m_NumFree; };
+
+
+        /// Returns the slots of the blocks, in increasing order.
+        std::vector<int> getLiveSlots() const;
+
+
+        /// Returns the state vector, size() long.
+        Vector<double>& getStateVector()
+        { return m_State; };
+
+
+        /// Returns the covariance matrix, size() x size().
+        Matrix<double>& getCovarMatrix()
+        { return m_Covar; };
+
+
+        /// Removes all the blocks.
+        virtual void clear();
+
+
+        /// Destructor.
+        virtual ~StateSlots() {};
+
+
+    private:
+
+        /// Block of consecutive slots
+        struct Block
+        {
+            Block() : first(-1), size(0) {};
+            Block(int f, int s) : first(f), size(s) {};
+
+            int first;
+            int size;
+        };
+
+        /// Blocks of the stations
+        std::map<SourceID, Block> m_SourceBlocks;
+
+        /// Blocks of the satellites
+        std::map<SatID, Block> m_SatBlocks;
+
+        /// First slots of the free blocks, by block size
+        std::map<int, std::vector<int> > m_FreeBlocks;
+
+        /// Slots used so far, free blocks included; the slots from
+        /// m_Used to size() are spare
+        int m_Used;
+
+        /// Slots of the free blocks
+        int m_NumFree;
+
+        /// State vector
+        Vector<double> m_State;
+
+        /// Covariance matrix
+        Matrix<double> m_Covar;
+
+
+        /// Takes a free block of 'size' slots, growing if needed.
+        int allocate(int size);
+
+        /// Tombstones a block and puts it in the free list.
+        void release(const Block& block);
+
+        /// Lays the blocks out again, with 'capacity' slots.
+        void relayout(int capacity);
+
+    }; // End of class 'StateSlots'
+
+      //@}
+
+}  // End of namespace gpstk
+
+#endif   // GPSTK_STATE_SLOTS_HPP
@@ -393,52 +393,67 @@ namespace gpstk
     Matrix<double> StateStore::getCovarMatrix( const VariableSet& subVariableSet )
     {
         int size = subVariableSet.size();
-        Matrix<double> subCovarMatrix(size,size);
+        Matrix<double> subCovarMatrix(size,size,0.0);
 
-        VariableSet tempSet(subVariableSet);
+        // previous index of each variable, in 'now' index order
+        std::vector<int> preIndex(size,-1);
 
-        for( VariableSet::const_iterator varIter1 = subVariableSet.begin();
-             varIter1 != subVariableSet.end();
-             ++varIter1 )
+        for( VariableSet::const_iterator varIter = subVariableSet.begin();
+             varIter != subVariableSet.end();
+             ++varIter )
         {
-            // diagonal elements
-            int preIndex1 = varIter1->getPreIndex();
-            int nowIndex1 = varIter1->getNowIndex();
+            int preIndex1 = varIter->getPreIndex();
+            int nowIndex1 = varIter->getNowIndex();
+
+            preIndex[nowIndex1] = preIndex1;
 
+            // diagonal elements of new variables
             if( -1 == preIndex1 )
             {
-                subCovarMatrix( nowIndex1, nowIndex1 ) = varIter1->getInitialVariance();
+                subCovarMatrix( nowIndex1, nowIndex1 ) = varIter->getInitialVariance();
             }
-            else
+        }
+
+        // elements between old variables, the others remain zero
+        for( int j=0; j<size; j++ )
+        {
+            if( -1 == preIndex[j] ) continue;
+
+            for( int i=0; i<size; i++ )
             {
-                subCovarMatrix( nowIndex1, nowIndex1 ) = m_CovarMatrix( preIndex1, preIndex1 );
+                if( -1 == preIndex[i] ) continue;
+
+                subCovarMatrix( i, j ) = m_CovarMatrix( preIndex[i], preIndex[j] );
             }
+        }
 
-            // remove from tempSet
-            tempSet.erase( (*varIter1) );
+        return subCovarMatrix;
+    }
 
-            // non-diagonal elements
-            for( VariableSet::const_iterator varIter2 = tempSet.begin();
-                 varIter2 != tempSet.end();
-                 ++varIter2 )
-            {
-                int preIndex2 = varIter2->getPreIndex();
-                int nowIndex2 = varIter2->getNowIndex();
 
-                if( -1 == preIndex1 ||
-                    -1 == preIndex2 )
-                {
-                    subCovarMatrix( nowIndex1, nowIndex2 ) =
-                        subCovarMatrix( nowIndex2, nowIndex1 ) = 0.0;
-                    continue;
-                }
+    /* Check if the given variable set is laid out as the stored state.
+     *
+     * @param subVariableSet the variable set to check
+     */
+    bool StateStore::hasSameLayout( const VariableSet& subVariableSet ) const
+    {
+        if( subVariableSet.size() != m_StateVec.size() ||
+            subVariableSet.size() != m_CovarMatrix.rows() )
+        {
+            return false;
+        }
 
-                subCovarMatrix( nowIndex1, nowIndex2 ) =
-                    subCovarMatrix( nowIndex2, nowIndex1 ) = m_CovarMatrix( preIndex1, preIndex2 );
+        for( VariableSet::const_iterator varIter = subVariableSet.begin();
+             varIter != subVariableSet.end();
+             ++varIter )
+        {
+            if( varIter->getNowIndex() != varIter->getPreIndex() )
+            {
+                return false;
             }
         }
 
-        return subCovarMatrix;
+        return true;
     }
 
 
@@ -649,27 +664,43 @@ namespace gpstk
             workEpoch.setTimeSystem(TimeSystem::Unknown);
 
             for( sourceDataMap::iterator sdmIter = gdsIter->second.begin();
-                 sdmIter != gdsIter->second.end();
-                 ++sdmIter )
+                 sdmIter != gdsIter->second.end(); )
             {
-                try
-                {
-                    MSCData data = m_pMSCStore->findMSC( sdmIter->first.sourceName, workEpoch );
-                    Position nominalPos = data.coordinates;
+                bool found(false);
 
-                    if( sdmIter->first.sourceName == m_MasterName )
+                if( m_pStaRegistry != NULL )
+                {
+                    found = ( m_pStaRegistry->find( sdmIter->first ) != NULL );
+                }
+                else
+                {
+                    try
                     {
-                        m_MasterSource = SourceID( sdmIter->first );
+                        m_pMSCStore->findMSC( sdmIter->first.sourceName, workEpoch );
+                        found = true;
+                    }
+                    catch( InvalidRequest& exec )
+                    {
+                        found = false;
                     }
                 }
-                catch( InvalidRequest& exec )
+
+                if( !found )
                 {
                     cerr << "The station " << sdmIter->first.sourceName
                          << " isn't included in MSC file." << endl;
 
                     // remove the sourceData
-                    gdsIter->second.erase( sdmIter );
+                    gdsIter->second.erase( sdmIter++ );
+                    continue;
                 }
+
+                if( sdmIter->first.sourceName == m_MasterName )
+                {
+                    m_MasterSource = SourceID( sdmIter->first );
+                }
+
+                ++sdmIter;
             }
         }
 
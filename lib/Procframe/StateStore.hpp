@@ -47,6 +47,7 @@
 #include "DataStructures.hpp"
 #include "Variable.hpp"
 #include "MSCStore.hpp"
+#include "StationRegistry.hpp"
 #include "Rinex3EphemerisStore2.hpp"
 
 namespace gpstk
@@ -60,6 +61,7 @@ namespace gpstk
 
         /// Constructor
         StateStore()
+            : m_pMSCStore(NULL), m_pStaRegistry(NULL), m_pEphStore(NULL)
         {};
 
         /// Convenience output method
@@ -211,8 +213,8 @@ namespace gpstk
         { m_VariableSet = variableSet; return (*this);}
 
 
-        /// Get the Covariance Matrix
-        virtual Matrix<double> getCovarMatrix()
+        /// Get the Covariance Matrix, without copying it
+        virtual const Matrix<double>& getCovarMatrix() const
         { return m_CovarMatrix;}
 
 
@@ -221,6 +223,14 @@ namespace gpstk
         { m_CovarMatrix = covarMatrix; return (*this);}
 
 
+        /** Exchange the Covariance Matrix with the given one, without
+         *  copying any element. The previous matrix is returned in
+         *  'covarMatrix', so its memory can be reused by the caller.
+         */
+        virtual StateStore& swapCovarMatrix(Matrix<double>& covarMatrix)
+        { m_CovarMatrix.swap(covarMatrix); return (*this);}
+
+
 
         /** get Covariance Matrix from subVariableSet
          *
@@ -260,14 +270,36 @@ namespace gpstk
         { m_StateVec = stateVector; return (*this);}
 
 
-        /** get State Vector
+        /** Exchange the State Vector with the given one, without copying
+         *  any element.
+         *
+         * @param stateVector  state Vector to be stored, holding the
+         *                     previous one on return.
+         *
+         * @return this object
+         */
+        virtual StateStore& swapStateVector(Vector<double>& stateVector)
+        { m_StateVec.swap(stateVector); return (*this);}
+
+
+        /** get State Vector, without copying it
          *
          * @return the state vector.
          */
-        virtual Vector<double> getStateVector()
+        virtual const Vector<double>& getStateVector() const
         { return m_StateVec;}
 
 
+        /** Check if the given variable set is laid out as the stored state,
+         *  i.e. it has the same size and every variable keeps its index
+         *  ('now' index equal to 'previous' index). In that case the stored
+         *  state vector and covariance matrix can be used as they are.
+         *
+         * @param subVariableSet  the variable set to check
+         */
+        virtual bool hasSameLayout(const VariableSet& subVariableSet) const;
+
+
         /** get State Vector from sub VariableSet
          *
          * @param subVariableSet  the sub variable set
@@ -329,6 +361,16 @@ namespace gpstk
         { m_pMSCStore=&mscStore; return (*this); }
 
 
+        /** set station registry, used instead of the MSC data store
+         *
+         * @param staRegistry  station registry.
+         *
+         * @return this object.
+         */
+        virtual StateStore& setStationRegistry( StationRegistry& staRegistry )
+        { m_pStaRegistry=&staRegistry; return (*this); }
+
+
         /** set master name
          *
          * @param masterName  master station name
@@ -426,6 +468,9 @@ namespace gpstk
         // MSC data
         MSCStore* m_pMSCStore;
 
+        // station registry
+        StationRegistry* m_pStaRegistry;
+
         // BCE data
         XvtStore<SatID>* m_pEphStore;
 
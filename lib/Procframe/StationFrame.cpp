@@ -0,0 +1,210 @@
+#pragma ident "$Id: StationFrame.cpp $"
+
+/**
+ * @file StationFrame.cpp
+ * This is a class to hold the topocentric frame of a station, and to
+ * compute the geodetic elevation and azimuth of satellites from it.
+ */
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+//============================================================================
+
+
+#include <cmath>
+#include "StationFrame.hpp"
+#include "constants.hpp"
+
+using namespace std;
+
+namespace gpstk
+{
+
+      // Number of targets of each block of the batch computation
+    static const int blockSize(64);
+
+
+      // Default constructor, for a station at the center of the Earth.
+    StationFrame::StationFrame()
+        : position(0.0, 0.0, 0.0),
+          latitude(0.0), longitude(0.0), height(0.0)
+    {
+        for(int i=0; i<3; ++i)
+            for(int j=0; j<3; ++j)
+                rotENU[i][j] = (i == j) ? 1.0 : 0.0;
+
+    }  // End of constructor 'StationFrame::StationFrame()'
+
+
+      /* Sets the position of the station, and computes its frame.
+       *
+       * @param staPos     Position of the station.
+       */
+    StationFrame& StationFrame::setPosition(const Position& staPos)
+    {
+        position = staPos;
+        position.transformTo(Position::Cartesian);
+
+        latitude = position.getGeodeticLatitude();
+        longitude = position.getLongitude();
+        height = position.getHeight();
+
+        double lat( latitude*DEG_TO_RAD );
+        double lon( longitude*DEG_TO_RAD );
+
+            // East
+        rotENU[0][0] = -::sin(lon);
+        rotENU[0][1] =  ::cos(lon);
+        rotENU[0][2] =  0.0;
+
+            // North
+        rotENU[1][0] = -::sin(lat)*::cos(lon);
+        rotENU[1][1] = -::sin(lat)*::sin(lon);
+        rotENU[1][2] =  ::cos(lat);
+
+            // Up
+        rotENU[2][0] =  ::cos(lat)*::cos(lon);
+        rotENU[2][1] =  ::cos(lat)*::sin(lon);
+        rotENU[2][2] =  ::sin(lat);
+
+        return (*this);
+
+    }  // End of method 'StationFrame::setPosition()'
+
+
+      /* Returns the East, North, Up components of an ECEF vector.
+       *
+       * @param ecef       Vector in ECEF.
+       * @param enu        Vector in East, North, Up.
+       */
+    void StationFrame::toENU(const Triple& ecef, double enu[3]) const
+    {
+        for(int i=0; i<3; ++i)
+        {
+            enu[i] = rotENU[i][0]*ecef[0]
+                   + rotENU[i][1]*ecef[1]
+                   + rotENU[i][2]*ecef[2];
+        }
+
+    }  // End of method 'StationFrame::toENU()'
+
+
+      /* Computes the geodetic elevation and azimuth of a target, as seen
+       * from the station.
+       *
+       * @param target     ECEF position of the target, in meters.
+       * @param elev       Elevation, in degrees.
+       * @param azim       Azimuth, in degrees, in [0,360).
+       */
+    void StationFrame::elevAzimGeodetic( const Triple& target,
+                                         double& elev,
+                                         double& azim ) const
+        throw(GeometryException)
+    {
+        double xyz[3] = { target[0], target[1], target[2] };
+
+        elevAzimGeodetic(1, xyz, &elev, &azim);
+
+    }  // End of method 'StationFrame::elevAzimGeodetic()'
+
+
+      /* Computes the geodetic elevation and azimuth of n targets in one
+       * pass.
+       *
+       * @param n          Number of targets.
+       * @param xyz        ECEF positions of the targets, in meters, as
+       *                   x0,y0,z0,x1,y1,z1,...
+       * @param elev       n elevations, in degrees.
+       * @param azim       n azimuths, in degrees, in [0,360).
+       */
+    void StationFrame::elevAzimGeodetic( int n,
+                                         const double* xyz,
+                                         double* elev,
+                                         double* azim ) const
+        throw(GeometryException)
+    {
+        const double rx( position[0] );
+        const double ry( position[1] );
+        const double rz( position[2] );
+
+        const double ex( rotENU[0][0] ), ey( rotENU[0][1] ), ez( rotENU[0][2] );
+        const double nx( rotENU[1][0] ), ny( rotENU[1][1] ), nz( rotENU[1][2] );
+        const double ux( rotENU[2][0] ), uy( rotENU[2][1] ), uz( rotENU[2][2] );
+
+        double localE[blockSize];
+        double localN[blockSize];
+        double localU[blockSize];
+        double range[blockSize];
+
+        for(int first=0; first<n; first+=blockSize)
+        {
+            const int count( (n-first < blockSize) ? n-first : blockSize );
+            const double* p( xyz + 3*first );
+
+                // The slant vectors in East, North, Up, without branches
+            double minRange( 1.0 );
+            for(int i=0; i<count; ++i)
+            {
+                double dx( p[3*i+0] - rx );
+                double dy( p[3*i+1] - ry );
+                double dz( p[3*i+2] - rz );
+
+                double r( std::sqrt(dx*dx + dy*dy + dz*dz) );
+
+                localE[i] = dx*ex + dy*ey + dz*ez;
+                localN[i] = dx*nx + dy*ny + dz*nz;
+                localU[i] = dx*ux + dy*uy + dz*uz;
+                range[i] = r;
+
+                minRange = (r < minRange) ? r : minRange;
+            }
+
+                // If the positions are within .1 millimeter
+            if( minRange <= 1e-4 )
+            {
+                GeometryException ge("Positions are within .1 millimeter");
+                GPSTK_THROW(ge);
+            }
+
+            for(int i=0; i<count; ++i)
+            {
+                double cosUp( localU[i]/range[i] );
+
+                elev[first+i] = 90.0 - std::acos(cosUp)*RAD_TO_DEG;
+
+                double cosN( localN[i]/range[i] );
+                double cosE( localE[i]/range[i] );
+
+                    // If elevation is very close to 90 degrees, azimuth = 0.0
+                if( std::fabs(cosN) + std::fabs(cosE) < 1.0e-16 )
+                {
+                    azim[first+i] = 0.0;
+                    continue;
+                }
+
+                double alpha( std::atan2(cosE, cosN)*RAD_TO_DEG );
+
+                azim[first+i] = (alpha < 0.0) ? alpha + 360.0 : alpha;
+            }
+        }
+
+    }  // End of method 'StationFrame::elevAzimGeodetic()'
+
+
+}  // End of namespace gpstk
@@ -0,0 +1,202 @@
+#pragma ident "$Id: StationFrame.hpp $"
+
+/**
+ * @file StationFrame.hpp
+ * This is a class to hold the topocentric frame of a station, and to
+ * compute the geodetic elevation and azimuth of satellites from it.
+ */
+
+#ifndef GPSTK_STATION_FRAME_HPP
+#define GPSTK_STATION_FRAME_HPP
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+//============================================================================
+
+
+#include "Position.hpp"
+#include "Triple.hpp"
+
+
+namespace gpstk
+{
+
+      /** @addtogroup GPSsolutions */
+      //@{
+
+      /** This class holds the topocentric frame of a station: its geodetic
+       *  latitude, longitude and height, and the rotation from ECEF to the
+       *  local East, North, Up frame, whose Up axis is the normal to the
+       *  ellipsoid.
+       *
+       * Position::elevationGeodetic() and Position::azimuthGeodetic() copy
+       * both positions and do the iterative geodetic conversion of the
+       * station for every satellite. A StationFrame does the conversion
+       * once, so that the elevation and azimuth of a satellite only take
+       * three dot products, a square root, an acos and an atan2. They are
+       * the same as those of Position, to rounding.
+       *
+       * @code
+       *   StationFrame frame(nominalPos);
+       *
+       *   double elev, azim;
+       *   frame.elevAzimGeodetic(satPos, elev, azim);
+       *
+       *      // or, for n satellites, with their positions in xyz[3*n]
+       *   frame.elevAzimGeodetic(n, xyz, elevs, azims);
+       * @endcode
+       */
+    class StationFrame
+    {
+    public:
+
+        /// Default constructor, for a station at the center of the Earth.
+        StationFrame();
+
+
+        /** Common constructor.
+         *
+         * @param staPos     Position of the station.
+         */
+        StationFrame(const Position& staPos)
+        { setPosition(staPos); };
+
+
+        /** Sets the position of the station, and computes its frame.
+         *
+         * @param staPos     Position of the station.
+         */
+        virtual StationFrame& setPosition(const Position& staPos);
+
+
+        /// Returns the position of the station, in Cartesian coordinates.
+        const Position& getPosition() const
+        { return position; };
+
+
+        /// Returns the geodetic latitude of the station, in degrees.
+        double getGeodeticLatitude() const
+        { return latitude; };
+
+
+        /// Returns the longitude of the station, in degrees.
+        double getLongitude() const
+        { return longitude; };
+
+
+        /// Returns the height of the station above the ellipsoid, in meters.
+        double getHeight() const
+        { return height; };
+
+
+        /// Returns the East unit vector of the station, in ECEF.
+        const double* getEast() const
+        { return rotENU[0]; };
+
+
+        /// Returns the North unit vector of the station, in ECEF.
+        const double* getNorth() const
+        { return rotENU[1]; };
+
+
+        /// Returns the Up unit vector of the station (the normal to the
+        /// ellipsoid), in ECEF.
+        const double* getUp() const
+        { return rotENU[2]; };
+
+
+        /** Returns the East, North, Up components of an ECEF vector.
+         *
+         * @param ecef       Vector in ECEF.
+         * @param enu        Vector in East, North, Up.
+         */
+        void toENU(const Triple& ecef, double enu[3]) const;
+
+
+        /** Computes the geodetic elevation and azimuth of a target, as seen
+         *  from the station.
+         *
+         * @param target     ECEF position of the target, in meters.
+         * @param elev       Elevation, in degrees.
+         * @param azim       Azimuth, in degrees, in [0,360).
+         *
+         * @throw GeometryException if the target is within 0.1 mm of the
+         *  station.
+         */
+        void elevAzimGeodetic( const Triple& target,
+                               double& elev,
+                               double& azim ) const
+            throw(GeometryException);
+
+
+        /** Computes the geodetic elevation and azimuth of n targets in one
+         *  pass.
+         *
+         * @param n          Number of targets.
+         * @param xyz        ECEF positions of the targets, in meters, as
+         *                   x0,y0,z0,x1,y1,z1,...
+         * @param elev       n elevations, in degrees.
+         * @param azim       n azimuths, in degrees, in [0,360).
+         *
+         * @throw GeometryException if a target is within 0.1 mm of the
+         *  station.
+         */
+        void elevAzimGeodetic( int n,
+                               const double* xyz,
+                               double* elev,
+                               double* azim ) const
+            throw(GeometryException);
+
+
+        /// Returns the geodetic elevation of a target, in degrees.
+        double elevationGeodetic(const Triple& target) const
+            throw(GeometryException)
+        { double e, a; elevAzimGeodetic(target, e, a); return e; };
+
+
+        /// Returns the geodetic azimuth of a target, in degrees.
+        double azimuthGeodetic(const Triple& target) const
+            throw(GeometryException)
+        { double e, a; elevAzimGeodetic(target, e, a); return a; };
+
+
+        /// Destructor.
+        virtual ~StationFrame() {};
+
+
+    private:
+
+        /// Position of the station, in Cartesian coordinates
+        Position position;
+
+        /// Geodetic latitude, longitude (degrees) and height (meters)
+        double latitude;
+        double longitude;
+        double height;
+
+        /// Rotation from ECEF to East, North, Up
+        double rotENU[3][3];
+
+    }; // End of class 'StationFrame'
+
+      //@}
+
+}  // End of namespace gpstk
+
+#endif   // GPSTK_STATION_FRAME_HPP
@@ -0,0 +1,161 @@
+#pragma ident "$Id: StationRegistry.cpp $"
+
+/**
+ * @file StationRegistry.cpp
+ * This is a class to resolve the metadata of the stations of a network
+ * once, and to give each station a dense integer handle.
+ */
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+//============================================================================
+
+
+#include "StationRegistry.hpp"
+
+using namespace std;
+
+namespace gpstk
+{
+
+      /* Adds a station, looking it up in the MSC store (and the BLQ
+       * reader) now. Adding a station again returns its handle.
+       *
+       * @param source     Station.
+       * @param epoch      Epoch of the MSC record of interest.
+       *
+       * @return the handle of the station.
+       */
+    int StationRegistry::addStation( const SourceID& source,
+                                     const CommonTime& epoch )
+        throw(InvalidRequest)
+    {
+        std::map<SourceID, int>::const_iterator it( m_Handles.find(source) );
+        if( it != m_Handles.end() ) return it->second;
+
+        if( pMSCStore == NULL )
+        {
+            InvalidRequest e("StationRegistry: no MSC store.");
+            GPSTK_THROW(e);
+        }
+
+        StationInfo info;
+
+        try
+        {
+            const MSCData& mscData( pMSCStore->findMSC( source.sourceName,
+                                                        epoch ) );
+
+            info.nominalPos = mscData.coordinates;
+            info.antType = mscData.antType;
+            info.antOffset = mscData.antOffset;
+        }
+        catch(InvalidRequest& e)
+        {
+            GPSTK_RETHROW(e);
+        }
+
+        info.source = source;
+        info.frame.setPosition(info.nominalPos);
+
+        if( pBLQReader != NULL && pBLQReader->isValid(source.sourceName) )
+        {
+            info.blq = pBLQReader->getTideHarmonics(source.sourceName);
+            info.hasBLQ = true;
+        }
+
+        info.handle = m_Stations.size();
+
+        m_Stations.push_back(info);
+        m_Handles[source] = info.handle;
+
+        return info.handle;
+
+    }  // End of method 'StationRegistry::addStation()'
+
+
+      /* Adds several stations; those missing from the MSC store are
+       * skipped.
+       *
+       * @param sourceSet  Stations.
+       * @param epoch      Epoch of the MSC records of interest.
+       *
+       * @return the number of stations of sourceSet in the registry.
+       */
+    int StationRegistry::addStations( const SourceIDSet& sourceSet,
+                                      const CommonTime& epoch )
+    {
+        int count(0);
+
+        for( SourceIDSet::const_iterator it = sourceSet.begin();
+             it != sourceSet.end();
+             ++it )
+        {
+            try
+            {
+                addStation(*it, epoch);
+                ++count;
+            }
+            catch(InvalidRequest& e)
+            {
+                continue;
+            }
+        }
+
+        return count;
+
+    }  // End of method 'StationRegistry::addStations()'
+
+
+      /* Adds all the stations of gData, at its first epoch; those missing
+       * from the MSC store are skipped.
+       *
+       * @return the number of stations of gData in the registry.
+       */
+    int StationRegistry::addStations(const gnssDataMap& gData)
+    {
+        if( gData.empty() ) return 0;
+
+        return addStations( gData.getSourceIDSet(), gData.begin()->first );
+
+    }  // End of method 'StationRegistry::addStations()'
+
+
+      // Returns the handle of a station, or -1 if it is not registered.
+    int StationRegistry::getHandle(const SourceID& source) const
+    {
+        std::map<SourceID, int>::const_iterator it( m_Handles.find(source) );
+
+        return ( it != m_Handles.end() ) ? it->second : -1;
+
+    }  // End of method 'StationRegistry::getHandle()'
+
+
+      // Returns the metadata of a station, or NULL if it is not registered.
+    const StationRegistry::StationInfo*
+    StationRegistry::find(const SourceID& source) const
+    {
+        std::map<SourceID, int>::const_iterator it( m_Handles.find(source) );
+
+        return ( it != m_Handles.end() ) ? &m_Stations[it->second] : NULL;
+
+    }  // End of method 'StationRegistry::find()'
+
+
+}  // End of namespace gpstk
@@ -0,0 +1,233 @@
+#pragma ident "$Id: StationRegistry.hpp $"
+
+/**
+ * @file StationRegistry.hpp
+ * This is a class to resolve the metadata of the stations of a network
+ * once, and to give each station a dense integer handle.
+ */
+
+#ifndef GPSTK_STATION_REGISTRY_HPP
+#define GPSTK_STATION_REGISTRY_HPP
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+//============================================================================
+
+
+#include <map>
+#include <deque>
+#include <string>
+#include "DataStructures.hpp"
+#include "MSCStore.hpp"
+#include "BLQDataReader.hpp"
+#include "Position.hpp"
+#include "StationFrame.hpp"
+#include "Matrix.hpp"
+
+
+namespace gpstk
+{
+
+      /** @addtogroup GPSsolutions */
+      //@{
+
+      /** This class resolves the metadata of the stations of a network once,
+       *  at setup, instead of looking them up by name for every station at
+       *  every epoch.
+       *
+       * Each station (SourceID) added gets a dense integer handle, 0, 1,
+       * 2, ..., in the order the stations are added. Its StationInfo holds
+       * the nominal position from the MSC store, its topocentric frame
+       * (StationFrame), the antenna of the MSC record and, if a BLQ reader
+       * was given, the ocean loading harmonics.
+       *
+       * The processing classes taking a StationRegistry (BasicModel1,
+       * ComputeTropModel, ComputeSatPCenter, ComputeWindUp,
+       * CorrectObservables, GravitationalDelay, StateStore) use it instead
+       * of their MSCStore; the stations that are not registered are removed
+       * from the data, as those that are not in the MSC store are.
+       *
+       * @code
+       *   MSCStore mscStore;
+       *   mscStore.loadFile(mscFile);
+       *
+       *   StationRegistry staRegistry(mscStore);
+       *   staRegistry.setBLQReader(blqReader);
+       *   staRegistry.addStations(sourceSet, initialEpoch);
+       *
+       *   BasicModel1 basicModel;
+       *   basicModel.setStationRegistry(staRegistry);
+       * @endcode
+       *
+       * Once the stations are added, the registry is only read; it may be
+       * used from several threads at the same time.
+       *
+       * The StationInfo of a station stays at the same address until
+       * clear() is called: the pointers and references returned by find()
+       * and getStation() remain valid when more stations are added.
+       */
+    class StationRegistry
+    {
+    public:
+
+        /// Metadata of a station
+        struct StationInfo
+        {
+            /// Default constructor
+            StationInfo()
+                : handle(-1), hasBLQ(false), blq(6,11,0.0)
+            {};
+
+            int handle;             ///< index of the station in the registry
+            SourceID source;        ///< station
+            Position nominalPos;    ///< nominal position (ECEF), meters
+            StationFrame frame;     ///< topocentric frame of nominalPos
+
+            std::string antType;    ///< antenna type of the MSC record
+            Triple antOffset;       ///< antenna offset of the MSC record
+
+            bool hasBLQ;            ///< the BLQ reader has the station
+            Matrix<double> blq;     ///< ocean tide harmonics (6 x 11), see
+                                    ///< BLQDataReader::getTideHarmonics()
+        };
+
+
+        /// Default constructor.
+        StationRegistry()
+            : pMSCStore(NULL), pBLQReader(NULL)
+        {};
+
+
+        /** Common constructor.
+         *
+         * @param mscStore   MSCStore holding the station coordinates.
+         */
+        StationRegistry(MSCStore& mscStore)
+            : pMSCStore(&mscStore), pBLQReader(NULL)
+        {};
+
+
+        /// Returns a pointer to the MSCStore object currently in use.
+        virtual MSCStore* getMSCStore() const
+        { return pMSCStore; };
+
+
+        /// Sets the MSCStore object holding the station coordinates.
+        virtual StationRegistry& setMSCStore(MSCStore& mscStore)
+        { pMSCStore = &mscStore; return (*this); };
+
+
+        /// Returns a pointer to the BLQDataReader object currently in use.
+        virtual BLQDataReader* getBLQReader() const
+        { return pBLQReader; };
+
+
+        /// Sets the BLQDataReader object holding the ocean loading
+        /// harmonics; it is optional.
+        virtual StationRegistry& setBLQReader(BLQDataReader& blqReader)
+        { pBLQReader = &blqReader; return (*this); };
+
+
+        /** Adds a station, looking it up in the MSC store (and the BLQ
+         *  reader) now. Adding a station again returns its handle.
+         *
+         * @param source     Station.
+         * @param epoch      Epoch of the MSC record of interest.
+         *
+         * @return the handle of the station.
+         *
+         * @throw InvalidRequest if there is no MSC store, or the station is
+         *  not in it.
+         */
+        virtual int addStation( const SourceID& source,
+                                const CommonTime& epoch )
+            throw(InvalidRequest);
+
+
+        /** Adds several stations; those missing from the MSC store are
+         *  skipped.
+         *
+         * @param sourceSet  Stations.
+         * @param epoch      Epoch of the MSC records of interest.
+         *
+         * @return the number of stations of sourceSet in the registry.
+         */
+        virtual int addStations( const SourceIDSet& sourceSet,
+                                 const CommonTime& epoch );
+
+
+        /** Adds all the stations of gData, at its first epoch; those
+         *  missing from the MSC store are skipped.
+         *
+         * @return the number of stations of gData in the registry.
+         */
+        virtual int addStations(const gnssDataMap& gData);
+
+
+        /// Returns the handle of a station, or -1 if it is not registered.
+        virtual int getHandle(const SourceID& source) const;
+
+
+        /// Returns the metadata of a station, or NULL if it is not
+        /// registered. The pointer is valid until clear() is called.
+        virtual const StationInfo* find(const SourceID& source) const;
+
+
+        /// Returns the metadata of the station of a handle. The reference
+        /// is valid until clear() is called.
+        const StationInfo& getStation(int handle) const
+        { return m_Stations[handle]; };
+
+
+        /// Returns the number of stations in the registry.
+        int size() const
+        { return m_Stations.size(); };
+
+
+        /// Removes all the stations.
+        virtual void clear()
+        { m_Stations.clear(); m_Handles.clear(); };
+
+
+        /// Destructor.
+        virtual ~StationRegistry() {};
+
+
+    private:
+
+        /// Pointer to the MSCStore object
+        MSCStore* pMSCStore;
+
+        /// Pointer to the BLQDataReader object
+        BLQDataReader* pBLQReader;
+
+        /// Metadata of the stations, by handle. A deque, so that adding a
+        /// station doesn't move the others
+        std::deque<StationInfo> m_Stations;
+
+        /// Handles of the stations
+        std::map<SourceID, int> m_Handles;
+
+    }; // End of class 'StationRegistry'
+
+      //@}
+
+}  // End of namespace gpstk
+
+#endif   // GPSTK_STATION_REGISTRY_HPP
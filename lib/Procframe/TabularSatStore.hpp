@@ -128,6 +128,24 @@ namespace gpstk
       virtual DataRecord getValue(const SatID& sat, const CommonTime& ttag)
          const throw(InvalidRequest) = 0;
 
+      /// Called when edit() or clear() have modified the data tables, so that
+      /// derived classes may drop anything they derived from them.
+      virtual void tablesModified() throw() {}
+
+      /// Return true if an interval of 2*nhalf points would pass the data gap
+      /// and interval checks of getTableInterval().
+      /// @param[in] step time between the two points around the time of interest
+      /// @param[in] span time between the first and last points of the interval
+      /// @param[in] dt time of interest from the first point of the interval
+      bool acceptInterval(double step, double span, double dt) const throw()
+      {
+         if(checkDataGap && step > gapInterval) return false;
+         if(checkInterval && ( std::abs(span)    > maxInterval ||
+                               std::abs(dt)      > maxInterval ||
+                               std::abs(dt-span) > maxInterval ) ) return false;
+         return true;
+      }
+
       /// Locate the given time in the DataTable for the given satellite.
       /// Return two const iterators it1 and it2 (it1 < it2) giving the range of
       /// 2*nhalf points, nhalf on each side of the given time.
@@ -568,6 +586,8 @@ namespace gpstk
             if(jt != dtab.begin() && --jt != dtab.begin())
                dtab.erase(dtab.begin(),jt);
          }
+
+         tablesModified();
       }
 
       // remaining functions are not virtual
@@ -578,6 +598,8 @@ namespace gpstk
          for(satit=tables.begin(); satit!=tables.end(); ++satit)
             satit->second.clear();
          tables.clear();
+
+         tablesModified();
       }
 
       /// Return true if the given SatID is present in the store
@@ -42,6 +42,8 @@
 
 #include "TimeUpdate.hpp"
 #include "Counter.hpp"
+#include <algorithm>
+#include <map>
 
 #ifdef USE_OPENMP
 #include <omp.h>
@@ -127,9 +129,58 @@ namespace gpstk
 
 
 
+    namespace
+    {
+        // Key used to find related variables: TypeID, plus SourceID and
+        // SatID when the reference variable is source/satellite-indexed.
+        struct RelVarKey
+        {
+            TypeID type;
+            SourceID source;
+            SatID sat;
+
+            bool operator<(const RelVarKey& right) const
+            {
+                if( type != right.type ) return ( type < right.type );
+                if( source != right.source ) return ( source < right.source );
+                return ( sat < right.sat );
+            }
+        };
+
+        // Indexes of the unknowns sharing a key, in VariableSet order.
+        // 'next' points to the first one not yet assigned to a group.
+        struct RelVarBucket
+        {
+            std::vector<int> index;
+            size_t next;
+
+            RelVarBucket() : next(0) {}
+        };
+
+        typedef std::map<RelVarKey, RelVarBucket> RelVarIndex;
+
+        // Group of related variables sharing one stochastic model
+        struct VarGroup
+        {
+            std::vector<int> now;
+            Matrix<double> phi;
+            Matrix<double> q;
+        };
+
+    }  // End of unnamed namespace
+
+
     /* Return a reference to a gnssDataMap object after solving
      *  the previously defined equation system.
      *
+     * The unknowns are first split into groups of related variables,
+     * each group having its own Phi and Q. As Phi is block diagonal,
+     * the propagated covariance is computed block-wise:
+     *
+     *    Pminus(a,b) = Phi_a * P(a,b) * transpose(Phi_b) + Q_a*delta(a,b)
+     *
+     * without scanning the VariableSet for every variable.
+     *
      * @param gData    Data object holding the data.
      */
     gnssDataMap& TimeUpdate::Process( gnssDataMap& gdsMap )
@@ -141,11 +192,11 @@ namespace gpstk
 
         try
         {
-            // state vector from stateStore
-            Vector<double> stateVec( m_pStateStore->getStateVector() );
+            // state vector from stateStore, no copy
+            const Vector<double>& stateVec( m_pStateStore->getStateVector() );
 
-            // covariance matrix from stateStore
-            Matrix<double> covarMatrix( m_pStateStore->getCovarMatrix() );
+            // covariance matrix from stateStore, no copy
+            const Matrix<double>& covarMatrix( m_pStateStore->getCovarMatrix() );
 
             // Prepare the equation system with current data
             equSystem.Prepare( gdsMap );
@@ -153,46 +204,58 @@ namespace gpstk
             // current unknowns
             VariableSet currentUnknowns( equSystem.getCurrentUnknowns() );
 
-//            for(VariableSet::iterator it = currentUnknowns.begin();
-//                it != currentUnknowns.end();
-//                ++it)
-//            {
-//                cout << StringUtils::asString(*it) << endl;
-//            }
-
             // the number of unknowns being processed
             int numUnknowns( currentUnknowns.size() );
 
 //            cout << "numUnknowns = " << numUnknowns << endl;
 
-            // holding relative Variable in order
-            std::vector<Variable> relVarVec;
+            // unknowns in 'now' index order, and their previous indexes
+            std::vector<const Variable*> varVec( numUnknowns );
+            std::vector<int> preIndex( numUnknowns, -1 );
 
-            // holding the ready index for Phi * P
-            std::vector<int> readyIndexVec;
+            for( VariableSet::const_iterator it = currentUnknowns.begin();
+                 it != currentUnknowns.end();
+                 ++it )
+            {
+                varVec[ (*it).getNowIndex() ] = &(*it);
+                preIndex[ (*it).getNowIndex() ] = (*it).getPreIndex();
+            }
 
-            // copy current unknowns
-            VariableSet tempUnknowns( currentUnknowns );
 
-            // P1 Matrix for holding Phi * P
-            Matrix<double> P1( numUnknowns, numUnknowns, 0.0 );
+            //// group the related variables
 
-            // resize the xhatminus vector
-            xhatminus.resize( numUnknowns, 0.0 );
+            // one index per combination of source/satellite indexing
+            RelVarIndex relVarIndex[4];
+            bool indexReady[4] = { false, false, false, false };
 
-            // resize the Pminus Matrix
-            Pminus.resize( numUnknowns, numUnknowns, 0.0 );
-
-            // get variable iterator
-            VariableSet::iterator varIter = tempUnknowns.begin();
+            std::vector<bool> grouped( numUnknowns, false );
+            std::vector<VarGroup> groups;
 
-            while( varIter != tempUnknowns.end() )
+            for( int n=0; n<numUnknowns; n++ )
             {
-                // clear vector container for relative variable
-                relVarVec.clear();
+                if( grouped[n] ) continue;
+
+                const Variable& var( *varVec[n] );
+
+                bool bySource( var.getSourceIndexed() );
+                bool bySat( var.getSatIndexed() );
+                int mode( (bySource ? 1 : 0) + (bySat ? 2 : 0) );
+
+                // build the index for this kind of variable, if needed
+                if( !indexReady[mode] )
+                {
+                    for( int i=0; i<numUnknowns; i++ )
+                    {
+                        RelVarKey key;
+                        key.type = varVec[i]->getType();
+                        if( bySource ) key.source = varVec[i]->getSource();
+                        if( bySat ) key.sat = varVec[i]->getSatellite();
+
+                        relVarIndex[mode][key].index.push_back(i);
+                    }
 
-                // copy current variable
-                Variable var( *varIter );
+                    indexReady[mode] = true;
+                }
 
                 // get relative TypeID in order
                 vector<TypeID> relTypeIDVec( var.getModel()->getRelTypeIDVec() );
@@ -200,245 +263,224 @@ namespace gpstk
                 // the size of relative TypeID vector
                 int relSize = relTypeIDVec.size();
 
-                // get all relative variable and insert to container 'relVarVec'
-                for( VariableSet::iterator it = tempUnknowns.begin();
-                     it != tempUnknowns.end();
-                     ++it )
+                // position in 'relTypeIDVec' of each related variable found
+                std::vector<int> relPos;
+                std::vector<int> relNow;
+
+                RelVarKey key;
+                if( bySource ) key.source = var.getSource();
+                if( bySat ) key.sat = var.getSatellite();
+
+                for( int i=0; i<relSize; i++ )
                 {
+                    key.type = relTypeIDVec[i];
 
-                    // if current variable is satellite-indexed,
-                    // we need to guarantee the satellite consistentency
-                    if( var.getSatIndexed() )
-                    {
-                        if( var.getSatellite() != (*it).getSatellite() )
-                        {
-                            continue;
-                        }
-                    }
+                    RelVarIndex::iterator it( relVarIndex[mode].find(key) );
+                    if( it == relVarIndex[mode].end() ) continue;
 
-                    // if current variable is source-indexed,
-                    // we need to guarantee the source consistentency
-                    if( var.getSourceIndexed() )
+                    // take the first variable of this kind not yet grouped
+                    RelVarBucket& bucket( it->second );
+                    while( bucket.next < bucket.index.size() &&
+                           grouped[ bucket.index[bucket.next] ] )
                     {
-                        if( var.getSource() != (*it).getSource() )
-                        {
-                            continue;
-                        }
+                        bucket.next++;
                     }
 
-                    // judge whether TypeID is included in relative TypeID vector
-                    // or not, if it exists, add variable to 'relVarVec'
-                    if( relTypeIDVec.end() != std::find( relTypeIDVec.begin(),
-                                                         relTypeIDVec.end(),
-                                                         (*it).getType()  ) )
-                    {
-                        Variable relVar( *it );
-                        relVarVec.push_back( relVar );
-                    }
+                    if( bucket.next == bucket.index.size() ) continue;
 
-                    // judge the size of relative variable vector and relative
-                    // TypeID vector, if it equals, indicate all of variables
-                    // are found, break the inner for loop for saving time.
-                    if( relVarVec.size() == relTypeIDVec.size() ) break;
+                    relPos.push_back(i);
+                    relNow.push_back( bucket.index[bucket.next] );
+                    grouped[ bucket.index[bucket.next] ] = true;
+                }
 
-                } // End of ' for( VariableSet::iterator it = ... ) '
+                if( relNow.empty() )
+                {
+                    InvalidSolver e( "No stochastic model found for variable "
+                                     + StringUtils::asString(var) );
+                    GPSTK_THROW(e);
+                }
 
+                // relative variables, in VariableSet order
+                std::vector<int> sortedNow( relNow );
+                std::sort( sortedNow.begin(), sortedNow.end() );
+
+                std::vector<Variable> relVarVec;
+                for( size_t i=0; i<sortedNow.size(); i++ )
+                {
+                    relVarVec.push_back( *varVec[ sortedNow[i] ] );
+                }
 
                 // prepare stochastic model for current variable and relative
                 // variables
                 var.getModel()->Prepare( relVarVec, gdsMap );
 
-                // get phi matrix
-                Matrix<double> phiMatrix = var.getModel()->getPhi();
+                // get phi and q matrix
+                phiMatrix = var.getModel()->getPhi();
+                qMatrix = var.getModel()->getQ();
 
-                // get q matrix
-                Matrix<double> qMatrix = var.getModel()->getQ();
+                // keep the rows/columns of the variables found
+                int size( relNow.size() );
 
-//                cout << StringUtils::asString(var) << endl;
-//
-//                cout << "PHI: " << endl;
-//                for(int i=0; i<phiMatrix.rows(); ++i)
-//                {
-//                    for(int j=0; j<phiMatrix.cols(); ++j)
-//                    {
-//                        cout << setw(15) << phiMatrix(i,j);
-//                    }
-//                    cout << endl;
-//                }
-//
-//                cout << "Q: " << endl;
-//                for(int i=0; i<qMatrix.rows(); ++i)
-//                {
-//                    for(int j=0; j<qMatrix.cols(); ++j)
-//                    {
-//                        cout << setw(15) << qMatrix(i,j);
-//                    }
-//                    cout << endl;
-//                }
-//
-                //// update xhatminus routine
+                VarGroup group;
+                group.now = relNow;
+                group.phi.resize( size, size, 0.0 );
+                group.q.resize( size, size, 0.0 );
 
-                // holding the value for relative variable
-                // in 'relTypeIDVec' order.
-                Vector<double> valVec( relSize, 0.0 );
+                for( int i=0; i<size; i++ )
+                {
+                    for( int j=0; j<size; j++ )
+                    {
+                        group.phi(i,j) = phiMatrix( relPos[i], relPos[j] );
+                        group.q(i,j) = qMatrix( relPos[i], relPos[j] );
+                    }
+                }
 
-                // holding the pre index for relative variable
-                // in 'relTypeIDVec' order
-                Vector<int> indexPreVec( relSize, -1 );
+                groups.push_back( group );
 
-                // holding the now index for relative variable
-                // in 'relTypeIDVec' order.
-                Vector<int> indexNowVec( relSize, -1 );
+            } // End of ' for( int n=0; n<numUnknowns; n++ ) '
 
-                for( std::vector<Variable>::iterator it = relVarVec.begin();
-                     it != relVarVec.end();
-                     ++it )
-                {
-                    TypeID type( (*it).getType() );
 
-                    int preIndex = (*it).getPreIndex();
-                    int nowIndex = (*it).getNowIndex();
+            int numGroups( groups.size() );
+
+            //// update xhatminus routine
 
-                    // add to ready index vector for Phi * P
-                    readyIndexVec.push_back( nowIndex );
+            xhatminus.resize( numUnknowns, 0.0 );
 
-                    for( int i=0; i<relSize; i++ )
+            for( int g=0; g<numGroups; g++ )
+            {
+                const VarGroup& group( groups[g] );
+                int size( group.now.size() );
+
+                for( int i=0; i<size; i++ )
+                {
+                    double xVal(0.0);
+
+                    // new variables, i.e. preIndex == -1, have value 0.0
+                    for( int j=0; j<size; j++ )
                     {
-                        if( relTypeIDVec[i] == type )
+                        int pre( preIndex[ group.now[j] ] );
+                        if( -1 != pre )
                         {
-                            indexPreVec(i) = preIndex;
-                            indexNowVec(i) = nowIndex;
-
-                            // if variable is new, i.e. preIndex == -1,
-                            // the value will be set to 0.0;
-                            // if variable is old, i.e. preIndex != -1,
-                            // the value will be extracted from 'stateVec'.
-                            if( -1 != preIndex )
-                            {
-                                valVec(i) = stateVec(preIndex);
-                            }
-                            else
-                            {
-                                valVec(i) = 0.0;
-                            }
-
-                            break;
+                            xVal += group.phi(i,j) * stateVec(pre);
                         }
                     }
 
-                } // End of ' for( std::vector<Variable>::iterator it = ... ) '
-
+                    xhatminus( group.now[i] ) = xVal;
+                }
+            }
 
-//                cout << "X0: " << endl;
-//                for(int i=0; i<relSize; i++) cout << setw(15) << valVec(i);
-//                cout << endl;
 
-                for( int i=0; i<relSize; i++ )
-                {
-                    double xVal = 0.0;
+            //// update Pminus routine
 
-                    for( int j=0; j<relSize; j++ )
-                    { xVal += phiMatrix(i,j) * valVec(j); }
-
-                    xhatminus( indexNowVec(i) ) = xVal ;
-//                    cout << setw(5) << xVal;
-                }
-//                cout << endl;
+            // P1 Matrix for holding Phi * P
+            Matrix<double> P1( numUnknowns, numUnknowns, 0.0 );
 
+            Pminus.resize( numUnknowns, numUnknowns, 0.0 );
 
-                //// update Pminus routine
+            // P1 = Phi * P, group by group of rows. As P is symmetric, the
+            // row of a variable is read as a column of 'covarMatrix'.
+            // A new variable has covariance 0.0 with any other variable,
+            // and its initial variance on the diagonal.
+#ifdef _OPENMP
+   #pragma omp parallel for schedule(dynamic)
+#endif
+            for( int g=0; g<numGroups; g++ )
+            {
+                const VarGroup& group( groups[g] );
+                int size( group.now.size() );
 
-                // update Phi * P
-                for( VariableSet::iterator it = currentUnknowns.begin();
-                     it != currentUnknowns.end();
-                     ++it )
+                for( int k=0; k<size; k++ )
                 {
-                    for( int i=0; i<relSize; i++ )
+                    int nowK( group.now[k] );
+                    int preK( preIndex[nowK] );
+
+                    for( int i=0; i<size; i++ )
                     {
-                        double pVal = 0.0;
+                        double phi( group.phi(i,k) );
+                        if( 0.0 == phi ) continue;
 
-                        for( int j=0; j<relSize; j++)
+                        int nowI( group.now[i] );
+
+                        if( -1 == preK )
                         {
-                            double covar = 0.0;
+                            P1( nowI, nowK ) += phi * varVec[nowK]->getInitialVariance();
+                            continue;
+                        }
 
-                            // if two variables are not new, we get covariance
-                            // from 'covarMatrix'
-                            if( -1 != (*it).getPreIndex() &&
-                                -1 != indexPreVec(j) )
-                            {
-                                covar = covarMatrix( indexPreVec(j),
-                                                     (*it).getPreIndex() );
-                            }
-                            else
+                        const double* pK( covarMatrix.begin()
+                                          + preK*covarMatrix.rows() );
+
+                        for( int j=0; j<numUnknowns; j++ )
+                        {
+                            int preJ( preIndex[j] );
+                            if( -1 != preJ )
                             {
-                                // if now index equals, it shows two variable
-                                // the same and covariance set to initialVariance,
-                                // otherwise, it will be 0.0.
-                                if( (*it).getNowIndex() == indexNowVec(j) )
-                                {
-                                    covar = (*it).getInitialVariance();
-                                }
+                                P1( nowI, j ) += phi * pK[preJ];
                             }
-
-                            pVal += phiMatrix(i,j) * covar;
                         }
-
-                        P1( indexNowVec(i), (*it).getNowIndex() ) = pVal;
                     }
                 }
+            }
 
+            // Pminus = P1 * transpose(Phi), group by group of columns
+#ifdef _OPENMP
+   #pragma omp parallel for schedule(dynamic)
+#endif
+            for( int g=0; g<numGroups; g++ )
+            {
+                const VarGroup& group( groups[g] );
+                int size( group.now.size() );
 
-                /// for P * transpose(Phi)
-                int readyIndexSize = readyIndexVec.size();
-                for( int i=0; i<readyIndexSize; i++ )
+                for( int l=0; l<size; l++ )
                 {
-                    int readyIndex = readyIndexVec[i];
+                    double* pL( &Pminus(0,group.now[l]) );
 
-                    for( int j=0; j<relSize; j++ )
+                    for( int m=0; m<size; m++ )
                     {
-                        double pVal = 0.0;
+                        double phi( group.phi(l,m) );
+                        if( 0.0 == phi ) continue;
 
-                        for( int k=0; k<relSize; k++)
+                        const double* p1M( &P1(0,group.now[m]) );
+
+                        for( int i=0; i<numUnknowns; i++ )
                         {
-                            int relIndex = indexNowVec(k);
-                            pVal += P1( readyIndex, relIndex) * phiMatrix(j,k);
+                            pL[i] += p1M[i] * phi;
                         }
-
-                        Pminus( readyIndex, indexNowVec(j) ) =
-                                Pminus( indexNowVec(j), readyIndex ) = pVal;
                     }
                 }
+            }
 
-
-                // add q matrix to Pminus
-                for( int i=0; i<relSize; i++ )
+            // keep Pminus exactly symmetric
+            for( int j=0; j<numUnknowns; j++ )
+            {
+                for( int i=j+1; i<numUnknowns; i++ )
                 {
-                    for( int j=i; j<relSize; j++ )
-                    {
-                        Pminus( indexNowVec(i), indexNowVec(j) )
-                                += qMatrix( i, j );
-                        Pminus( indexNowVec(j), indexNowVec(i) )
-                                += qMatrix( i, j);
-                    }
+                    Pminus(i,j) = Pminus(j,i);
                 }
+            }
 
+            // add q matrix to Pminus (the diagonal receiving it twice,
+            // as it always did)
+            for( int g=0; g<numGroups; g++ )
+            {
+                const VarGroup& group( groups[g] );
+                int size( group.now.size() );
 
-                // remove relative variables in tempUnknowns
-                for( std::vector<Variable>::iterator it = relVarVec.begin();
-                     it != relVarVec.end();
-                     ++it )
+                for( int i=0; i<size; i++ )
                 {
-                    tempUnknowns.erase( *it );
+                    for( int j=i; j<size; j++ )
+                    {
+                        Pminus( group.now[i], group.now[j] ) += group.q(i,j);
+                        Pminus( group.now[j], group.now[i] ) += group.q(i,j);
+                    }
                 }
+            }
 
-                // reset varIter
-                varIter = tempUnknowns.begin();
-
-            } // End of ' while( tempUnknowns.end() != varIter ) '
-
+            // hand the new state over to the store; the previous state is
+            // kept in 'xhatminus' and 'Pminus' to reuse their memory
             m_pStateStore->setVariableSet( currentUnknowns );
-            m_pStateStore->setStateVector( xhatminus );
-            m_pStateStore->setCovarMatrix( Pminus );
+            m_pStateStore->swapStateVector( xhatminus );
+            m_pStateStore->swapCovarMatrix( Pminus );
 
         }
         catch(Exception& u)
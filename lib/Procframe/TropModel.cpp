@@ -49,6 +49,16 @@
 #include "MJD.hpp"
 #include "StringUtils.hpp"
 
+#include <fstream>
+#include <map>
+#include <cstring>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+
 using namespace std;
 using namespace gpstk::StringUtils;
 
@@ -2968,6 +2978,7 @@ namespace gpstk
       // @param time Time.
    ViennaTropModel::ViennaTropModel( const Position& RX,
                                      const CommonTime& time )
+      : mappedGrid(NULL)
    {
       setReceiverLatitude(RX.getGeodeticLatitude( ));
       setReceiverLongitude(RX.getLongitude());
@@ -2981,6 +2992,10 @@ namespace gpstk
    void ViennaTropModel::loadFile(std::string file)
        throw(FileMissingException)
    {
+       // a binary grid is mapped, not read
+       if( mapBinaryFile(file) ) return;
+
+       mappedGrid = NULL;
        gpt2DataVec.clear();
 
        double vec[44] = {0.0};
@@ -3044,6 +3059,143 @@ namespace gpstk
    }  // end ViennaTropModel::loadFile()
 
 
+      // Binary GPT2 grid files: a header of 32 bytes (magic, number of cells,
+      // number of values per cell, byte order mark, padding) followed by the
+      // cells, as GPT2Data in native byte order; the header size keeps the
+      // cells aligned when the file is mapped.
+   static const char gpt2BinaryMagic[8] = { 'G','P','T','2','G','R','I','D' };
+   static const unsigned int gpt2ByteOrder( 0x01020304 );
+   static const size_t gpt2HeaderSize( 32 );
+
+      // Binary GPT2 grids mapped in memory, by file name
+   static std::map<std::string, const ViennaTropModel::GPT2Data*> gpt2MappedGrids;
+
+
+      // Map a binary GPT2 grid file in memory; return false if the file
+      // is not a binary grid.
+   bool ViennaTropModel::mapBinaryFile(const std::string& file)
+       throw(FileMissingException)
+   {
+       std::map<std::string, const GPT2Data*>::const_iterator it(
+                                               gpt2MappedGrids.find(file) );
+       if( it != gpt2MappedGrids.end() )
+       {
+           mappedGrid = it->second;
+           gpt2DataVec.clear();
+           return true;
+       }
+
+       std::ifstream inpf(file.c_str(), std::ios::in | std::ios::binary);
+
+       if(!inpf)
+       {
+           FileMissingException fme("Could not open GPT2 file " + file);
+           GPSTK_THROW(fme);
+       }
+
+       char header[gpt2HeaderSize];
+       inpf.read(header, gpt2HeaderSize);
+
+       if( !inpf || std::memcmp(header, gpt2BinaryMagic, 8) != 0 ) return false;
+
+       int numCells(0), numValues(0);
+       unsigned int byteOrder(0);
+       std::memcpy(&numCells, header+8, sizeof(int));
+       std::memcpy(&numValues, header+12, sizeof(int));
+       std::memcpy(&byteOrder, header+16, sizeof(unsigned int));
+
+       size_t size( gpt2HeaderSize + numGridCells*sizeof(GPT2Data) );
+       inpf.seekg(0, std::ios::end);
+
+       if( numCells != numGridCells ||
+           numValues != int(sizeof(GPT2Data)/sizeof(double)) ||
+           byteOrder != gpt2ByteOrder ||
+           size_t(inpf.tellg()) != size )
+       {
+           FileMissingException fme("GPT2 file " + file +
+                           " is corrupted or not a binary grid of this platform");
+           GPSTK_THROW(fme);
+       }
+
+#ifndef _WIN32
+       inpf.close();
+
+       int fd( open(file.c_str(), O_RDONLY) );
+       void* addr( (fd < 0) ? MAP_FAILED
+                            : mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0) );
+       if(fd >= 0) close(fd);
+
+       if(addr == MAP_FAILED)
+       {
+           FileMissingException fme("Could not map GPT2 file " + file);
+           GPSTK_THROW(fme);
+       }
+
+       mappedGrid = reinterpret_cast<const GPT2Data*>(
+                             static_cast<const char*>(addr) + gpt2HeaderSize );
+       gpt2MappedGrids[file] = mappedGrid;
+       gpt2DataVec.clear();
+#else
+       // no mapping here: read all the cells at once
+       mappedGrid = NULL;
+       gpt2DataVec.resize(numGridCells);
+       inpf.seekg(gpt2HeaderSize, std::ios::beg);
+       inpf.read( reinterpret_cast<char*>(&gpt2DataVec[0]),
+                  numGridCells*sizeof(GPT2Data) );
+       inpf.close();
+#endif
+
+       return true;
+
+   }  // end ViennaTropModel::mapBinaryFile()
+
+
+      // Write the GPT2 grid loaded to a binary file.
+      // @param file Binary GPT2 grid file.
+   void ViennaTropModel::writeBinaryFile(std::string file) const
+       throw(FileMissingException)
+   {
+       if( mappedGrid == NULL && int(gpt2DataVec.size()) != numGridCells )
+       {
+           FileMissingException fme("No GPT2 grid loaded to write to " + file);
+           GPSTK_THROW(fme);
+       }
+
+       std::ofstream outf(file.c_str(), std::ios::out | std::ios::binary);
+
+       if(!outf)
+       {
+           FileMissingException fme("Could not open GPT2 file " + file);
+           GPSTK_THROW(fme);
+       }
+
+       char header[gpt2HeaderSize];
+       std::memset(header, 0, gpt2HeaderSize);
+
+       int numCells( numGridCells );
+       int numValues( sizeof(GPT2Data)/sizeof(double) );
+       std::memcpy(header, gpt2BinaryMagic, 8);
+       std::memcpy(header+8, &numCells, sizeof(int));
+       std::memcpy(header+12, &numValues, sizeof(int));
+       std::memcpy(header+16, &gpt2ByteOrder, sizeof(unsigned int));
+
+       const GPT2Data* cells( (mappedGrid != NULL) ? mappedGrid
+                                                   : &gpt2DataVec[0] );
+
+       outf.write(header, gpt2HeaderSize);
+       outf.write( reinterpret_cast<const char*>(cells),
+                   numGridCells*sizeof(GPT2Data) );
+       outf.close();
+
+       if(!outf)
+       {
+           FileMissingException fme("Error writing GPT2 file " + file);
+           GPSTK_THROW(fme);
+       }
+
+   }  // end ViennaTropModel::writeBinaryFile()
+
+
    //mean gravity in m/s**2
    static const double meanGravity( 9.80665 );
 
@@ -3447,7 +3599,7 @@ namespace gpstk
                                   date before computing weather " );
       }
 
-      if( gpt2DataVec.empty() )
+      if( gpt2DataVec.empty() && mappedGrid == NULL )
       {
          valid = false;
          throw InvalidTropModel( "ViennaTropModel must have GPT2 grid data \
@@ -3507,7 +3659,7 @@ namespace gpstk
 
           int ix = indx[0] - 1;  //-1 to use in c
 
-          GPT2Data data( gpt2DataVec[ix] );
+          const GPT2Data& data( gridCell(ix) );
 
           // transforming ellipsoidal height to orthometric height
           double hgt = ViennaHeight - data.undu;
@@ -3602,8 +3754,6 @@ namespace gpstk
 
           int l = 0;
 
-          GPT2Data data;
-
           double undul[4] = {0.0};
           double Ql[4] = {0.0};
           double dTl[4] = {0.0};
@@ -3621,7 +3771,7 @@ namespace gpstk
               //Hortho = -N + Hell
               int ix = indx[l];
 
-              data = gpt2DataVec[ix];
+              const GPT2Data& data( gridCell(ix) );
 
               undul[l] = data.undu;
               double hgt = ViennaHeight - data.undu;
@@ -1566,6 +1566,11 @@ namespace gpstk
        *   trop = viennaTM.correction(elevation);
        * @endcode
        *
+       * Parsing the ASCII GPT2 grid takes a while, so the grid may be
+       * converted once to a binary file with writeBinaryFile(); loadFile()
+       * recognizes such a file and maps it in memory instead of reading
+       * it, so that only the cells around the receivers are actually read.
+       *
        */
    class ViennaTropModel : public TropModel
    {
@@ -1589,6 +1594,7 @@ namespace gpstk
 
          /// Default constructor
       ViennaTropModel(void)
+         : mappedGrid(NULL)
       {
           validLat=false;
           validLon=false;
@@ -1613,6 +1619,7 @@ namespace gpstk
                        const double& lon,
                        const double& ht,
                        const double& mjd )
+         : mappedGrid(NULL)
       {
           setReceiverLatitude(lat);
           setReceiverLongitude(lon);
@@ -1630,13 +1637,26 @@ namespace gpstk
                        const CommonTime& time );
 
 
-         /// Load GPT2 grid file.
+         /// Load GPT2 grid file, either the ASCII grid or a binary grid
+         /// written by writeBinaryFile(). A binary grid is mapped in memory
+         /// rather than read; the mapping is shared by all the models using
+         /// the same file, and is kept until the program ends.
          ///
          /// @param file GPT2 grid file.
       void loadFile(std::string file)
          throw(FileMissingException);
 
 
+         /// Write the GPT2 grid loaded to a binary file, to be loaded by
+         /// loadFile() much faster than the ASCII grid. The file is meant for
+         /// the platform writing it (native byte order), which loadFile()
+         /// checks.
+         ///
+         /// @param file Binary GPT2 grid file.
+      void writeBinaryFile(std::string file) const
+         throw(FileMissingException);
+
+
          /// Compute and return the full tropospheric delay. The receiver
          /// latitude, longitude, height and modified julian date must has
          /// been set before using the appropriate constructor or the provided
@@ -1802,8 +1822,23 @@ namespace gpstk
 
    private:
 
+         /// Number of cells of the 1 degree GPT2 grid
+      static const int numGridCells = 64800;
+
+         /// Return cell i of the grid, from gpt2DataVec or mappedGrid
+      const GPT2Data& gridCell(int i) const
+      { return (mappedGrid != NULL) ? mappedGrid[i] : gpt2DataVec[i]; }
+
+         /// Map a binary GPT2 grid file in memory; return false if the file
+         /// is not a binary grid.
+      bool mapBinaryFile(const std::string& file)
+         throw(FileMissingException);
+
       std::vector<GPT2Data> gpt2DataVec;
 
+         /// Cells of a binary grid mapped in memory, or NULL
+      const GPT2Data* mappedGrid;
+
       double ViennaMJD;
       double ViennaLat;
       double ViennaLon;
@@ -45,6 +45,8 @@
 
 #include "SatArcMarker.hpp"
 
+#include "SatXvtCache.hpp"
+
 #include "BasicModel1.hpp"
 
 #include "GravitationalDelay.hpp"
@@ -731,10 +733,15 @@ int main(int argc, char* argv[])
     prefitPCWithoutClock.addLinear(SatID::systemGPS, linearComb.pcPrefitWithoutClock);
 
 
+    // Satellite positions and clocks of the epoch, shared by all stations
+    SatXvtCache sp3Cache(sp3Store);
+    SatXvtCache bceCache(bceStore);
+
+
     // BasicModel
     BasicModel1 basicModel;
-    basicModel.setSP3Store(sp3Store);
-    basicModel.setBCEStore(bceStore);
+    basicModel.setSP3Store(sp3Cache);
+    basicModel.setBCEStore(bceCache);
     basicModel.setMSCStore(mscStore);
     basicModel.setMinElev(12.5);
     basicModel.setDefaultObs(SatID::systemGPS, TypeID::PC);
@@ -751,7 +758,7 @@ int main(int argc, char* argv[])
 
     // ComputeSatPCenter
     ComputeSatPCenter satPCenter;
-    satPCenter.setEphStore(sp3Store);
+    satPCenter.setEphStore(sp3Cache);
     satPCenter.setMSCStore(mscStore);
     satPCenter.setAntexReader(antexReader);
 
@@ -764,7 +771,7 @@ int main(int argc, char* argv[])
 
     // CorrectObservables
     CorrectObservables correctObs;
-    correctObs.setEphStore(sp3Store);
+    correctObs.setEphStore(sp3Cache);
     correctObs.setMSCStore(mscStore);
     correctObs.setTideCorr(staTides);
     correctObs.setMonumentMap(sourceMonumentMap);
@@ -838,6 +845,24 @@ int main(int argc, char* argv[])
     // Measurement Update
     MeasUpdate measUpdate;
     measUpdate.setStateStore( stateStore );
+    measUpdate.setBatchUpdate( true );
+
+
+    // preprocessing, the stations are processed in parallel
+    pList.push_back(requireObs);
+    pList.push_back(cc2noncc);
+    pList.push_back(linearPC);
+    pList.push_back(sp3Cache);
+    pList.push_back(bceCache);
+    pList.push_back(basicModel);
+    pList.push_back(elevWeights);
+    pList.push_back(gravDelay);
+    pList.push_back(satPCenter);
+    pList.push_back(correctObs);
+    pList.push_back(computeTM);
+    pList.push_back(linearPC);
+    pList.push_back(prefitPCWithoutClock);
+    pList.setParallel(true);
 
 
     // keep only necessary types
@@ -887,17 +912,7 @@ int main(int argc, char* argv[])
         try
         {
             // preprocessing
-            gData >> requireObs
-                  >> cc2noncc
-                  >> linearPC
-                  >> basicModel
-                  >> elevWeights
-                  >> gravDelay
-                  >> satPCenter
-                  >> correctObs
-                  >> computeTM
-                  >> linearPC
-                  >> prefitPCWithoutClock;
+            gData >> pList;
 //                  >> prefitPCWithSatClock
 //                  >> computeStaClock
 //                  >> prefitPCWithStaClock;
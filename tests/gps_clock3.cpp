@@ -82,6 +82,8 @@
 
 #include "MeasUpdate.hpp"
 
+#include "StateSlots.hpp"
+
 #include "Epoch.hpp"
 
 #include "Counter.hpp"
@@ -810,8 +812,8 @@ int main(int argc, char* argv[])
 
     Matrix<double> noise;
 
-    Vector<double> state;
-    Matrix<double> covar;
+    // state and covariance, in persistent slots
+    StateSlots stateSlots;
 
     TypeIDSet keepTypes;
     keepTypes.insert(TypeID::prefitCWithStaClock);
@@ -824,8 +826,6 @@ int main(int argc, char* argv[])
     CommonTime gps;
     double dt(30.0);
 
-    bool first(true);
-
     // process epoch by epoch
     while( obsStreams.readEpochData(gData) )
     {
@@ -861,150 +861,98 @@ int main(int argc, char* argv[])
             sourceSet = gData.getSourceIDSet();
             satSet = gData.getSatIDSet();
 
-            // number of source, sat and unknown
+            // number of source and sat
             int numSource( sourceSet.size() );
             int numSat( satSet.size() );
-            int numUnknown( numSource*2 + numSat*1 );
 
             if(numSource == 0 || numSat == 0) continue;
 
             int id(0);
 
-            // if it is first time, initialize the filter
-            if(first)
-            {
-                state.resize(numUnknown,0.0);
-                covar.resize(numUnknown,numUnknown,0.0);
-
-                id = 0;
-
-                // initialize source-related parameters
-                for(SourceIDSet::iterator itSource = sourceSet.begin();
-                    itSource != sourceSet.end();
-                    ++itSource)
-                {
-                    source = *itSource;
-
-                    // initialize the clock of this source
-                    state(id+0) = 0.0;
-
-                    // initialize the tropo of this source
-                    state(id+1) = 0.0;
-
-                    // initialize the covariance of clock
-                    covar(id+0,id+0) = 1e2 * 1e2;
+            // remove the sources and sats no longer in the data; the
+            // others keep their slots, and the new ones take free slots
+            stateSlots.keepOnly(sourceSet, satSet);
 
-                    // initialize the covariance of tropo
-                    covar(id+1,id+1) = 0.5 * 0.5;
-
-                    // set the index of this source
-                    sourceIndex[source] = id;
+            // initialize the parameters of the new sources
+            for(SourceIDSet::iterator itSource = sourceSet.begin();
+                itSource != sourceSet.end();
+                ++itSource)
+            {
+                source = *itSource;
 
-                    id = id + 2;
-                }
+                if(stateSlots.getSlot(source) >= 0) continue;
 
-                // initialize sat-related parameters
-                for(SatIDSet::iterator itSat = satSet.begin();
-                    itSat != satSet.end();
-                    ++itSat)
-                {
-                    sat = *itSat;
+                id = stateSlots.addSource(source, 2);
 
-                    clock = satClock[sat];
+                Vector<double>& state0( stateSlots.getStateVector() );
+                Matrix<double>& covar0( stateSlots.getCovarMatrix() );
 
-                    // initialize the clock of this sat
-                    // be aware that the estimated one IS the true one
-                    state(id) = clock;
+                // initialize the clock of this source
+                state0(id+0) = 0.0;
 
-                    // initialize the covariance of clock
-                    covar(id,id) = 1e2 * 1e2;
+                // initialize the tropo of this source
+                state0(id+1) = 0.0;
 
-                    // set the index of this sat
-                    satIndex[sat] = id;
+                // initialize the covariance of clock
+                covar0(id+0,id+0) = 1e2 * 1e2;
 
-                    id = id + 1;
-                }
-
-                // finished
-                first = false;
+                // initialize the covariance of tropo
+                covar0(id+1,id+1) = 0.5 * 0.5;
             }
 
-            if(state.size() != numUnknown)
+            // initialize the parameters of the new sats
+            for(SatIDSet::iterator itSat = satSet.begin();
+                itSat != satSet.end();
+                ++itSat)
             {
-                Vector<double> state2(numUnknown,0.0);
-                Matrix<double> covar2(numUnknown,numUnknown,0.0);
-                map<SourceID,int> sourceIndex2;
-                map<SatID,int> satIndex2;
-
-                int id2(0);
-
-                for(SourceIDSet::iterator itSource = sourceSet.begin();
-                    itSource != sourceSet.end();
-                    ++itSource)
-                {
-                    source = *itSource;
-                    sourceIndex2[source] = id2;
-
-                    if(sourceIndex.find(source) != sourceIndex.end())
-                    {
-                        id = sourceIndex[source];
+                sat = *itSat;
 
-                        state2(id2+0) = state(id+0);
-                        state2(id2+1) = state(id+1);
+                if(stateSlots.getSlot(sat) >= 0) continue;
 
-                        for(int i=0; i<2; ++i)
-                        {
-                            for(int j=0; j<2; ++j)
-                            {
-                                covar2(id2+i,id2+j) = covar(id+i,id+j);
-                            }
-                        }
+                id = stateSlots.addSat(sat, 1);
 
-                        id2 = id2 + 2;
-                    }
-                    else
-                    {
-                        state2(id2+0) = 0.0;
-                        state2(id2+1) = 0.0;
+                Vector<double>& state0( stateSlots.getStateVector() );
+                Matrix<double>& covar0( stateSlots.getCovarMatrix() );
 
-                        covar2(id2+0,id2+0) = 1e2 * 1e2;
-                        covar2(id2+1,id2+1) = 0.5 * 0.5;
+                clock = satClock[sat];
 
-                        id2 = id2 + 2;
-                    }
-                }
+                // initialize the clock of this sat
+                // be aware that the estimated one IS the true one
+                state0(id) = clock;
 
-                for(SatIDSet::iterator itSat = satSet.begin();
-                    itSat != satSet.end();
-                    ++itSat)
-                {
-                    sat = *itSat;
-                    satIndex2[sat] = id2;
-
-                    if(satIndex.find(sat) != satIndex.end())
-                    {
-                        id = satIndex[sat];
+                // initialize the covariance of clock
+                covar0(id,id) = 1e2 * 1e2;
+            }
 
-                        state2(id2) = state(id);
-                        covar2(id2,id2) = covar(id,id);
+            // the index of each source and sat, as adding may have moved
+            // the slots
+            sourceIndex.clear();
+            for(SourceIDSet::iterator itSource = sourceSet.begin();
+                itSource != sourceSet.end();
+                ++itSource)
+            {
+                sourceIndex[*itSource] = stateSlots.getSlot(*itSource);
+            }
 
-                        id2 = id2 + 1;
-                    }
-                    else
-                    {
-                        state2(id2) = satClock[sat];
+            satIndex.clear();
+            for(SatIDSet::iterator itSat = satSet.begin();
+                itSat != satSet.end();
+                ++itSat)
+            {
+                satIndex[*itSat] = stateSlots.getSlot(*itSat);
+            }
 
-                        covar2(id2,id2) = 1e2 * 1e2;
+            // state and covariance, including the free slots, whose
+            // rows and columns are zero
+            Vector<double>& state( stateSlots.getStateVector() );
+            Matrix<double>& covar( stateSlots.getCovarMatrix() );
 
-                        id2 = id2 + 1;
-                    }
-                }
+            int numUnknown( stateSlots.size() );
 
-                state = state2;
-                covar = covar2;
-                sourceIndex = sourceIndex2;
-                satIndex = satIndex2;
-            }
+            // slots of the parameters: the loops over the covariance
+            // skip the free ones
+            vector<int> live( stateSlots.getLiveSlots() );
+            int numLive( live.size() );
 
 //            cout << "after initialization" << endl;
 //            for(int i=0; i<numUnknown; i=i+1)
@@ -1030,9 +978,11 @@ int main(int argc, char* argv[])
             }
 
             double com(0.0);
-            for(int i=numSource*2; i<numUnknown; i=i+1)
+            for(SatIDSet::iterator itSat = satSet.begin();
+                itSat != satSet.end();
+                ++itSat)
             {
-                com += state(i);
+                com += state( satIndex[*itSat] );
             }
 
             // omc
@@ -1043,17 +993,23 @@ int main(int argc, char* argv[])
 
             // h
             Vector<double> h(numUnknown,0.0);
-            for(int i=numSource*2; i<numUnknown; i=i+1)
+            for(SatIDSet::iterator itSat = satSet.begin();
+                itSat != satSet.end();
+                ++itSat)
             {
-                h(i) = 1.0;
+                h( satIndex[*itSat] ) = 1.0;
             }
 
             // p * h'
             Vector<double> pht(numUnknown,0.0);
-            for(int i=0; i<numUnknown; ++i)
+            for(int a=0; a<numLive; ++a)
             {
-                for(int j=0; j<numUnknown; ++j)
+                int i( live[a] );
+
+                for(int b=0; b<numLive; ++b)
                 {
+                    int j( live[b] );
+
                     if(h(j) != 0.0) pht(i) += covar(i,j) * h(j);
                 }
             }
@@ -1074,12 +1030,16 @@ int main(int argc, char* argv[])
             state = state + gamma*omc;
 
             // covariance update
-            for(int i=0; i<numUnknown; ++i)
+            for(int a=0; a<numLive; ++a)
             {
+                int i( live[a] );
+
                 covar(i,i) = covar(i,i) - gamma(i)*pht(i);
 
-                for(int j=i+1; j<numUnknown; ++j)
+                for(int b=a+1; b<numLive; ++b)
                 {
+                    int j( live[b] );
+
                     covar(i,j) = covar(j,i) = covar(i,j) - gamma(i)*pht(j);
                 }
             }
@@ -1149,10 +1109,14 @@ int main(int argc, char* argv[])
                         // p * h'
                         Vector<double> pht(numUnknown,0.0);
 
-                        for(int i=0; i<numUnknown; ++i)
+                        for(int a=0; a<numLive; ++a)
                         {
-                            for(int j=0; j<numUnknown; ++j)
+                            int i( live[a] );
+
+                            for(int b=0; b<numLive; ++b)
                             {
+                                int j( live[b] );
+
                                 if(h(j) != 0.0) pht(i) += covar(i,j) * h(j);
                             }
                         }
@@ -1174,12 +1138,16 @@ int main(int argc, char* argv[])
                         state = state + gamma*omc;
 
                         // covariance update
-                        for(int i=0; i<numUnknown; ++i)
+                        for(int a=0; a<numLive; ++a)
                         {
+                            int i( live[a] );
+
                             covar(i,i) = covar(i,i) - gamma(i)*pht(i);
 
-                            for(int j=i+1; j<numUnknown; ++j)
+                            for(int b=a+1; b<numLive; ++b)
                             {
+                                int j( live[b] );
+
                                 covar(i,j) = covar(j,i) = covar(i,j) - gamma(i)*pht(j);
                             }
                         }
@@ -1196,8 +1164,8 @@ int main(int argc, char* argv[])
 
 //            break;
             cout << "after meas update" << endl;
-            for(int i=numSource*2; i<numSource*2+1; i=i+1)
             {
+                int i( satIndex[*satSet.begin()] );
                 cout << setprecision(3) << setw(15) << state(i)/C_MPS*1e9
                      << setprecision(6) << setw(15) << covar(i,i)
                      << endl;
@@ -1295,8 +1263,8 @@ int main(int argc, char* argv[])
             }
 
             cout << "after time update" << endl;
-            for(int i=numSource*2; i<numSource*2+1; i=i+1)
             {
+                int i( satIndex[*satSet.begin()] );
                 cout << setprecision(3) << setw(15) << state(i)/C_MPS*1e9
                      << setprecision(6) << setw(15) << covar(i,i)
                      << endl;
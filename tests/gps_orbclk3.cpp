@@ -68,6 +68,8 @@
 
 #include "Counter.hpp"
 
+#include "StateSlots.hpp"
+
 
 using namespace std;
 using namespace gpstk;
@@ -977,8 +979,8 @@ int main(int argc, char* argv[])
     map<SourceID,int> sourceIndex;
     map<SatID,int> satIndex;
 
-    Vector<double> state;
-    Matrix<double> covar;
+    // state and covariance, in persistent slots
+    StateSlots stateSlots;
 
     Matrix<double> phi, phit;
     Matrix<double> noise;
@@ -1063,234 +1065,160 @@ int main(int argc, char* argv[])
             sourceSet = gData.getSourceIDSet();
             satSet = gData.getSatIDSet();
 
-            // number of source, sat and unknown
+            // number of source and sat
             // for source, estimate clock and tropo, 2 for each source
             // for sat, estimate orbit, srpc and clock, 12 for each sat
             int numSource( sourceSet.size() );
             int numSat( satSet.size() );
-            int numUnknown( numSource*2 + numSat*12 );
 
             if(numSource == 0 || numSat == 0) continue;
 
             int id(0);
 
-            // if it is first time, initialize the filter
-            if(first)
-            {
-                state.resize(numUnknown,0.0);
-                covar.resize(numUnknown,numUnknown,0.0);
-
-                id = 0;
+            // remove the sources and sats no longer in the data; the
+            // others keep their slots, and the new ones take free slots
+            stateSlots.keepOnly(sourceSet, satSet);
 
-                // initialize source-related parameters
-                for(SourceIDSet::iterator itSource = sourceSet.begin();
-                    itSource != sourceSet.end();
-                    ++itSource)
-                {
-                    source = *itSource;
+            // initialize the parameters of the new sources
+            for(SourceIDSet::iterator itSource = sourceSet.begin();
+                itSource != sourceSet.end();
+                ++itSource)
+            {
+                source = *itSource;
 
-                    // initialize the clock of this source
-                    // be aware that the estimated one IS NOT the true one
-                    state(id+0) = 0.0;
+                if(stateSlots.getSlot(source) >= 0) continue;
 
-                    // initialize the tropo of this source
-                    state(id+1) = 0.0;
+                id = stateSlots.addSource(source, 2);
 
-                    // initialize the covariance of clock
-                    covar(id+0,id+0) = 1e+2 * 1e+2;
+                Vector<double>& state0( stateSlots.getStateVector() );
+                Matrix<double>& covar0( stateSlots.getCovarMatrix() );
 
-                    // initialize the covariance of tropo
-                    covar(id+1,id+1) = 5e-1 * 5e-1;
+                // initialize the clock of this source
+                // be aware that the estimated one IS NOT the true one
+                state0(id+0) = 0.0;
 
-                    // setup the index of this source
-                    sourceIndex[source] = id;
+                // initialize the tropo of this source
+                state0(id+1) = 0.0;
 
-                    id = id + 2;
-                }
+                // initialize the covariance of clock
+                covar0(id+0,id+0) = 1e+2 * 1e+2;
 
-                // initialize sat-related parameters
-                for(SatIDSet::iterator itSat = satSet.begin();
-                    itSat != satSet.end();
-                    ++itSat)
-                {
-                    sat = *itSat;
+                // initialize the covariance of tropo
+                covar0(id+1,id+1) = 5e-1 * 5e-1;
+            }
 
-                    orbit = satOrbit[sat];
-                    srpc = satSRPC[sat];
-                    clock = satClock[sat];
+            // initialize the parameters of the new sats
+            for(SatIDSet::iterator itSat = satSet.begin();
+                itSat != satSet.end();
+                ++itSat)
+            {
+                sat = *itSat;
 
-                    // initialize the pos and its covariance of this sat
-                    for(int i=0; i<3; ++i)
-                    {
-                        state(id+i) = orbit(i);
-                        covar(id+i,id+i) = 1e+0 * 1e+0;
-                    }
+                if(stateSlots.getSlot(sat) >= 0) continue;
 
-                    // initialize the vel and its covariance of this sat
-                    for(int i=3; i<6; ++i)
+                // the first time, from the initial orbit and srpc, and then
+                // with empirical info
+                Vector<double> orbitInit(6,0.0), srpcInit(5,0.0);
+                if(first)
+                {
+                    for(int i=0; i<6; ++i) orbitInit(i) = satOrbit[sat](i);
+                    srpcInit = satSRPC[sat];
+                }
+                else
+                {
+                    try
                     {
-                        state(id+i) = orbit(i);
-                        covar(id+i,id+i) = 1e-2 * 1e-2;
+                        rsat_t = sp3Store.getXvt(sat,gps).x.toVector();
+                        vsat_t = sp3Store.getXvt(sat,gps).v.toVector();
                     }
-
-                    // initialize the srpc and its covariance of this sat
-                    for(int i=6; i<11; ++i)
+                    catch(...)
                     {
-                        state(id+i) = srpc(i-6);
+                        cerr << "new sat initialize error." << endl;
+                        return 1;
                     }
 
-                    covar(id+ 6,id+ 6) = 1e+0 * 1e+0;
-                    covar(id+ 7,id+ 7) = 1e-1 * 1e-1;
-                    covar(id+ 8,id+ 8) = 1e-1 * 1e-1;
-                    covar(id+ 9,id+ 9) = 1e-1 * 1e-1;
-                    covar(id+10,id+10) = 1e-1 * 1e-1;
-
-                    // initialize the clock of this sat
-                    // be aware that the estimated one IS the true one
-                    state(id+11) = clock;
+                    rsat_c = t2cRaw * rsat_t;
+                    vsat_c = t2cRaw * vsat_t + t2cDot * rsat_t;
 
-                    // initialize the covariance of clock
-                    covar(id+11,id+11) = 1e+2 * 1e+2;
+                    for(int i=0; i<3; ++i) orbitInit(i+0) = rsat_c(i);
+                    for(int i=0; i<3; ++i) orbitInit(i+3) = vsat_c(i);
 
-                    // setup the index of this sat
-                    satIndex[sat] = id;
-
-                    id = id + 12;
+                    srpcInit = srpc0;
                 }
 
-                // finish filter initialization
-                first = false;
-            }
+                clock = satClock[sat];
 
-            // in the following epoches, if the state size changes,
-            // reset the state, covariance and index of source and sat
-            if(state.size() != numUnknown)
-            {
-                Vector<double> state2(numUnknown,0.0);
-                Matrix<double> covar2(numUnknown,numUnknown,0.0);
-                map<SourceID,int> sourceIndex2;
-                map<SatID,int> satIndex2;
+                id = stateSlots.addSat(sat, 12);
 
-                int id2(0);
+                Vector<double>& state0( stateSlots.getStateVector() );
+                Matrix<double>& covar0( stateSlots.getCovarMatrix() );
 
-                // source-related parameters
-                for(SourceIDSet::iterator itSource = sourceSet.begin();
-                    itSource != sourceSet.end();
-                    ++itSource)
+                // initialize the pos and its covariance of this sat
+                for(int i=0; i<3; ++i)
                 {
-                    source = *itSource;
-                    sourceIndex2[source] = id2;
-
-                    // for old source, initialize it from previous state
-                    if(sourceIndex.find(source) != sourceIndex.end())
-                    {
-                        id = sourceIndex[source];
-
-                        state2(id2+0) = state(id+0);
-                        state2(id2+1) = state(id+1);
-
-                        for(int i=0; i<2; ++i)
-                        {
-                            for(int j=0; j<2; ++j)
-                            {
-                                covar2(id2+i,id2+j) = covar(id+i,id+j);
-                            }
-                        }
-
-                        id2 = id2 + 2;
-                    }
-                    // for new source, initialize it with empirical info
-                    else
-                    {
-                        state2(id2+0) = 0.0;
-                        state2(id2+1) = 0.0;
-
-                        covar2(id2+0,id2+0) = 1e+2 * 1e+2;
-                        covar2(id2+1,id2+1) = 5e-1 * 5e-1;
-
-                        id2 = id2 + 2;
-                    }
+                    state0(id+i) = orbitInit(i);
+                    covar0(id+i,id+i) = 1e+0 * 1e+0;
                 }
 
-
-                // sat-related parameters
-                for(SatIDSet::iterator itSat = satSet.begin();
-                    itSat != satSet.end();
-                    ++itSat)
+                // initialize the vel and its covariance of this sat
+                for(int i=3; i<6; ++i)
                 {
-                    sat = *itSat;
-                    satIndex2[sat] = id2;
-
-                    // for old sat, initialize it from previous state
-                    if(satIndex.find(sat) != satIndex.end())
-                    {
-                        id = satIndex[sat];
-
-                        for(int i=0; i<12; ++i)
-                        {
-                            state2(id2+i) = state(id+i);
-                        }
-
-                        for(int i=0; i<12; ++i)
-                        {
-                            for(int j=0; j<12; ++j)
-                            {
-                                covar2(id2+i,id2+j) = covar(id+i,id+j);
-                            }
-                        }
+                    state0(id+i) = orbitInit(i);
+                    covar0(id+i,id+i) = 1e-2 * 1e-2;
+                }
 
-                        id2 = id2 + 12;
-                    }
-                    // for new sat, initialize it with empirical info
-                    else
-                    {
-                        try
-                        {
-                            rsat_t = sp3Store.getXvt(sat,gps).x.toVector();
-                            vsat_t = sp3Store.getXvt(sat,gps).v.toVector();
-                        }
-                        catch(...)
-                        {
-                            cerr << "new sat initialize error." << endl;
-                            return 1;
-                        }
+                // initialize the srpc and its covariance of this sat
+                for(int i=6; i<11; ++i)
+                {
+                    state0(id+i) = srpcInit(i-6);
+                }
 
-                        rsat_c = t2cRaw * rsat_t;
-                        vsat_c = t2cRaw * vsat_t + t2cDot * rsat_t;
+                covar0(id+ 6,id+ 6) = 1e+0 * 1e+0;
+                covar0(id+ 7,id+ 7) = 1e-1 * 1e-1;
+                covar0(id+ 8,id+ 8) = 1e-1 * 1e-1;
+                covar0(id+ 9,id+ 9) = 1e-1 * 1e-1;
+                covar0(id+10,id+10) = 1e-1 * 1e-1;
 
-                        for(int i=0; i<3; ++i) state2(id2+i+0) = rsat_c(i);
-                        for(int i=0; i<3; ++i) state2(id2+i+3) = vsat_c(i);
-                        for(int i=0; i<5; ++i) state2(id2+i+6) = srpc0(i);
+                // initialize the clock of this sat
+                // be aware that the estimated one IS the true one
+                state0(id+11) = clock;
 
-                        state2(id2+11) = satClock[sat];
+                // initialize the covariance of clock
+                covar0(id+11,id+11) = 1e+2 * 1e+2;
+            }
 
-                        for(int i=0; i<3; ++i)
-                        {
-                            covar2(id2+i,id2+i) = 1e+0 * 1e+0;
-                        }
+            // finish filter initialization
+            first = false;
 
-                        for(int i=3; i<6; ++i)
-                        {
-                            covar2(id2+i,id2+i) = 1e-2 * 1e-2;
-                        }
+            // the index of each source and sat, as adding may have moved
+            // the slots
+            sourceIndex.clear();
+            for(SourceIDSet::iterator itSource = sourceSet.begin();
+                itSource != sourceSet.end();
+                ++itSource)
+            {
+                sourceIndex[*itSource] = stateSlots.getSlot(*itSource);
+            }
 
-                        covar2(id2+ 6,id2+ 6) = 1e+0 * 1e+0;
-                        covar2(id2+ 7,id2+ 7) = 1e-1 * 1e-1;
-                        covar2(id2+ 8,id2+ 8) = 1e-1 * 1e-1;
-                        covar2(id2+ 9,id2+ 9) = 1e-1 * 1e-1;
-                        covar2(id2+10,id2+10) = 1e-1 * 1e-1;
+            satIndex.clear();
+            for(SatIDSet::iterator itSat = satSet.begin();
+                itSat != satSet.end();
+                ++itSat)
+            {
+                satIndex[*itSat] = stateSlots.getSlot(*itSat);
+            }
 
-                        covar2(id2+11,id2+11) = 1e+2 * 1e+2;
+            // state and covariance, including the free slots, whose
+            // rows and columns are zero
+            Vector<double>& state( stateSlots.getStateVector() );
+            Matrix<double>& covar( stateSlots.getCovarMatrix() );
 
-                        id2 = id2 + 12;
-                    }
-                }
+            int numUnknown( stateSlots.size() );
 
-                state = state2;
-                covar = covar2;
-                sourceIndex = sourceIndex2;
-                satIndex = satIndex2;
-            }
+            // slots of the parameters: the loops over the covariance
+            // skip the free ones
+            vector<int> live( stateSlots.getLiveSlots() );
+            int numLive( live.size() );
 
 //            cout << "after initialization" << endl;
 //            for(int i=0; i<numUnknown; i=i+1)
@@ -1316,9 +1244,11 @@ int main(int argc, char* argv[])
             }
 
             double com(0.0);
-            for(int i=numSource*2; i<numUnknown; i=i+12)
+            for(SatIDSet::iterator itSat = satSet.begin();
+                itSat != satSet.end();
+                ++itSat)
             {
-                com += state(i+11);
+                com += state( satIndex[*itSat] + 11 );
             }
 
             // omc
@@ -1329,17 +1259,23 @@ int main(int argc, char* argv[])
 
             // h
             Vector<double> h(numUnknown,0.0);
-            for(int i=numSource*2; i<numUnknown; i=i+12)
+            for(SatIDSet::iterator itSat = satSet.begin();
+                itSat != satSet.end();
+                ++itSat)
             {
-                h(i+11) = 1.0;
+                h( satIndex[*itSat] + 11 ) = 1.0;
             }
 
             // p * h'
             Vector<double> pht(numUnknown,0.0);
-            for(int i=0; i<numUnknown; ++i)
+            for(int a=0; a<numLive; ++a)
             {
-                for(int j=0; j<numUnknown; ++j)
+                int i( live[a] );
+
+                for(int b=0; b<numLive; ++b)
                 {
+                    int j( live[b] );
+
                     if(h(j) != 0.0) pht(i) += covar(i,j) * h(j);
                 }
             }
@@ -1360,12 +1296,16 @@ int main(int argc, char* argv[])
             state = state + gamma*omc;
 
             // covariance update
-            for(int i=0; i<numUnknown; ++i)
+            for(int a=0; a<numLive; ++a)
             {
+                int i( live[a] );
+
                 covar(i,i) = covar(i,i) - gamma(i)*pht(i);
 
-                for(int j=i+1; j<numUnknown; ++j)
+                for(int b=a+1; b<numLive; ++b)
                 {
+                    int j( live[b] );
+
                     covar(i,j) = covar(j,i) = covar(i,j) - gamma(i)*pht(j);
                 }
             }
@@ -1501,10 +1441,14 @@ int main(int argc, char* argv[])
                         // p * h'
                         Vector<double> pht(numUnknown,0.0);
 
-                        for(int i=0; i<numUnknown; ++i)
+                        for(int a=0; a<numLive; ++a)
                         {
-                            for(int j=0; j<numUnknown; ++j)
+                            int i( live[a] );
+
+                            for(int b=0; b<numLive; ++b)
                             {
+                                int j( live[b] );
+
                                 if(h(j) != 0.0) pht(i) += covar(i,j) * h(j);
                             }
                         }
@@ -1526,12 +1470,16 @@ int main(int argc, char* argv[])
                         state = state + gamma*omc;
 
                         // covariance update
-                        for(int i=0; i<numUnknown; ++i)
+                        for(int a=0; a<numLive; ++a)
                         {
+                            int i( live[a] );
+
                             covar(i,i) = covar(i,i) - gamma(i)*pht(i);
 
-                            for(int j=i+1; j<numUnknown; ++j)
+                            for(int b=a+1; b<numLive; ++b)
                             {
+                                int j( live[b] );
+
                                 covar(i,j) = covar(j,i) = covar(i,j) - gamma(i)*pht(j);
                             }
                         }
@@ -1663,8 +1611,8 @@ int main(int argc, char* argv[])
             noise(0,0) = 1e+2 * dt;
             noise(1,1) = 1e-9 * dt;
 
-            Matrix<double> pSource1(2,numUnknown,0.0);
-            Matrix<double> pSource2(numUnknown,2,0.0);
+            Matrix<double> pSource1(2,numLive,0.0);
+            Matrix<double> pSource2(numLive,2,0.0);
 
             for(SourceIDSet::iterator itSource = sourceSet.begin();
                 itSource != sourceSet.end();
@@ -1681,9 +1629,9 @@ int main(int argc, char* argv[])
                 // phi * p
                 for(int i=0; i<2; ++i)
                 {
-                    for(int j=0; j<numUnknown; ++j)
+                    for(int b=0; b<numLive; ++b)
                     {
-                        pSource1(i,j) = covar(idSource+i,j);
+                        pSource1(i,b) = covar(idSource+i,live[b]);
                     }
                 }
 
@@ -1691,28 +1639,28 @@ int main(int argc, char* argv[])
 
                 for(int i=0; i<2; ++i)
                 {
-                    for(int j=0; j<numUnknown; ++j)
+                    for(int b=0; b<numLive; ++b)
                     {
-                        covar(idSource+i,j) = pSource1(i,j);
+                        covar(idSource+i,live[b]) = pSource1(i,b);
                     }
                 }
 
                 // phi * p * phi'
-                for(int i=0; i<numUnknown; ++i)
+                for(int a=0; a<numLive; ++a)
                 {
                     for(int j=0; j<2; ++j)
                     {
-                        pSource2(i,j) = covar(i,idSource+j);
+                        pSource2(a,j) = covar(live[a],idSource+j);
                     }
                 }
 
                 pSource2 = pSource2 * phit;
 
-                for(int i=0; i<numUnknown; ++i)
+                for(int a=0; a<numLive; ++a)
                 {
                     for(int j=0; j<2; ++j)
                     {
-                        covar(i,idSource+j) = pSource2(i,j);
+                        covar(live[a],idSource+j) = pSource2(a,j);
                     }
                 }
 
@@ -1732,8 +1680,8 @@ int main(int argc, char* argv[])
             for(int i=0; i<5; ++i) noise(i+6,i+6) = 1e-14 * dt;
             noise(11,11) = 1e+0 * dt;
 
-            Matrix<double> pSat1(12,numUnknown,0.0);
-            Matrix<double> pSat2(numUnknown,12,0.0);
+            Matrix<double> pSat1(12,numLive,0.0);
+            Matrix<double> pSat2(numLive,12,0.0);
 
             for(SatIDSet::iterator itSat = satSet.begin();
                 itSat != satSet.end();
@@ -1775,9 +1723,9 @@ int main(int argc, char* argv[])
                 // phi * p
                 for(int i=0; i<12; ++i)
                 {
-                    for(int j=0; j<numUnknown; ++j)
+                    for(int b=0; b<numLive; ++b)
                     {
-                        pSat1(i,j) = covar(idSat+i,j);
+                        pSat1(i,b) = covar(idSat+i,live[b]);
                     }
                 }
 
@@ -1785,28 +1733,28 @@ int main(int argc, char* argv[])
 
                 for(int i=0; i<12; ++i)
                 {
-                    for(int j=0; j<numUnknown; ++j)
+                    for(int b=0; b<numLive; ++b)
                     {
-                        covar(idSat+i,j) = pSat1(i,j);
+                        covar(idSat+i,live[b]) = pSat1(i,b);
                     }
                 }
 
                 // phi * p * phi'
-                for(int i=0; i<numUnknown; ++i)
+                for(int a=0; a<numLive; ++a)
                 {
                     for(int j=0; j<12; ++j)
                     {
-                        pSat2(i,j) = covar(i,idSat+j);
+                        pSat2(a,j) = covar(live[a],idSat+j);
                     }
                 }
 
                 pSat2 = pSat2 * phit;
 
-                for(int i=0; i<numUnknown; ++i)
+                for(int a=0; a<numLive; ++a)
                 {
                     for(int j=0; j<12; ++j)
                     {
-                        covar(i,idSat+j) = pSat2(i,j);
+                        covar(live[a],idSat+j) = pSat2(a,j);
                     }
                 }
 
@@ -1817,8 +1765,18 @@ int main(int argc, char* argv[])
                 }
             }
 
-            Matrix<double> covar1( covar );
-            covar = (covar1 + transpose(covar1))/2.0;
+            // symmetrize the covariance
+            for(int a=0; a<numLive; ++a)
+            {
+                int i( live[a] );
+
+                for(int b=a+1; b<numLive; ++b)
+                {
+                    int j( live[b] );
+
+                    covar(i,j) = covar(j,i) = (covar(i,j) + covar(j,i))/2.0;
+                }
+            }
 
 //            cout << "after time update" << endl;
 //            for(int i=0; i<numUnknown; i=i+1)